@@ -0,0 +1,77 @@
+//==============================================================================
+// BenchScratch.h - Scratch Directories for the Benchmark Tools
+//==============================================================================
+//
+// The bench tools never delete what they did not create: the default is a
+// fresh directory from mkdtemp, and a --dir that already holds anything is
+// refused.
+//
+//==============================================================================
+
+#ifndef BENCH_SCRATCH_H
+#define BENCH_SCRATCH_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Prepare Scratch Directory
+// requested is the user's --dir ("" = fresh "<prefix>XXXXXX" under $TMPDIR);
+// created says whether the directory itself is ours to remove
+//------------------------------------------------------------------------------
+inline bool prepareScratch(const std::string& requested, const std::string& prefix,
+                           std::filesystem::path& scratch, bool& created) {
+    std::error_code ec;
+    if (requested.empty()) {
+        std::string pattern = (std::filesystem::temp_directory_path(ec) / (prefix + "XXXXXX")).string();
+        if (ec || mkdtemp(&pattern[0]) == nullptr) {
+            std::cerr << "Error: Cannot create a scratch directory" << std::endl;
+            return false;
+        }
+        scratch = pattern;
+        created = true;
+        return true;
+    }
+
+    scratch = requested;
+    if (!std::filesystem::exists(scratch, ec)) {
+        created = std::filesystem::create_directories(scratch, ec);
+        if (!created) {
+            std::cerr << "Error: Cannot create " << requested << ": " << ec.message() << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (!std::filesystem::is_directory(scratch, ec) || !std::filesystem::is_empty(scratch, ec) || ec) {
+        std::cerr << "Error: --dir must be an empty or new directory: " << requested << std::endl;
+        return false;
+    }
+    created = false;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Remove Scratch Directory
+// Everything under it is the tool's own; the directory itself goes only if
+// prepareScratch() made it
+//------------------------------------------------------------------------------
+inline void removeScratch(const std::filesystem::path& scratch, bool created) {
+    std::error_code ec;
+    if (created) {
+        std::filesystem::remove_all(scratch, ec);
+        return;
+    }
+    for (std::filesystem::directory_iterator it(scratch, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code removeError;
+        std::filesystem::remove_all(it->path(), removeError);
+    }
+}
+
+} // namespace DesktopCleaner
+
+#endif // BENCH_SCRATCH_H
@@ -0,0 +1,180 @@
+//==============================================================================
+// SyntheticTreeBench.cpp - Scanner/Classifier/Mover Workload Benchmark
+//==============================================================================
+//
+// Builds a throwaway directory shaped like a cluttered desktop, then runs the
+// full scan -> classify -> organize pipeline over it. The same workload is the
+// PGO training run (see the pgo-train target in CMakeLists.txt).
+//
+//==============================================================================
+
+#include "BenchScratch.h"
+#include "Config.h"
+#include "FileClassifier.h"
+#include "FileMover.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace DesktopCleaner;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Benchmark Options
+//------------------------------------------------------------------------------
+struct BenchOptions {
+    int fileCount = 20000;              // Files generated per round
+    int rounds = 3;                     // Pipeline repetitions
+    std::string directory;              // Empty or new scratch directory (default: mkdtemp)
+    bool keep = false;                  // Leave the scratch directory behind
+};
+
+//------------------------------------------------------------------------------
+// Helper: Generate a Synthetic Desktop
+// Mix of known extensions, upper-case variants, unknown extensions and
+// extension-less names, with mtimes spread over two years
+//------------------------------------------------------------------------------
+void generateTree(const fs::path& root, int fileCount, std::mt19937& rng) {
+    std::vector<std::string> extensions;
+    for (const auto& [extension, category] : buildExtensionMap()) {
+        extensions.push_back(extension);
+    }
+    extensions.insert(extensions.end(), { ".PDF", ".JPG", ".Mp4", ".dat", ".bak", ".tmp", "" });
+
+    std::uniform_int_distribution<std::size_t> pickExtension(0, extensions.size() - 1);
+    std::uniform_int_distribution<int> pickSize(0, 4096);
+    std::uniform_int_distribution<int> pickAgeDays(0, 730);
+    const std::string payload(4096, 'x');
+    const auto now = fs::file_time_type::clock::now();
+
+    fs::create_directories(root);
+    for (int i = 0; i < fileCount; ++i) {
+        fs::path path = root / ("file_" + std::to_string(i) + extensions[pickExtension(rng)]);
+        {
+            std::ofstream out(path, std::ios::binary);
+            out.write(payload.data(), pickSize(rng));
+        }
+        fs::last_write_time(path, now - std::chrono::hours(24 * pickAgeDays(rng)));
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Milliseconds Since
+//------------------------------------------------------------------------------
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+//------------------------------------------------------------------------------
+// Helper: Parse Arguments
+//------------------------------------------------------------------------------
+bool parseArguments(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        try {
+            if (arg.find("--files=") == 0) {
+                options.fileCount = std::stoi(arg.substr(8));
+            } else if (arg.find("--rounds=") == 0) {
+                options.rounds = std::stoi(arg.substr(9));
+            } else if (arg.find("--dir=") == 0) {
+                options.directory = arg.substr(6);
+            } else if (arg == "--keep") {
+                options.keep = true;
+            } else {
+                std::cerr << "Usage: smartcleaner_bench [--files=N] [--rounds=N] "
+                          << "[--dir=PATH] [--keep]" << std::endl;
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Error: Invalid value: " << arg << std::endl;
+            return false;
+        }
+    }
+    return options.fileCount > 0 && options.rounds > 0;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Main Function
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        return 1;
+    }
+
+    fs::path scratch;
+    bool scratchCreated = false;
+    if (!prepareScratch(options.directory, "smartcleaner_bench_", scratch, scratchCreated)) {
+        return 1;
+    }
+    fs::path tree = scratch / "desktop";
+
+    std::mt19937 rng(42); // Fixed seed: identical workload for every profile run
+    double totalScan = 0.0, totalClassify = 0.0, totalOrganize = 0.0;
+
+    {
+        // Log into the scratch directory so the logging path is exercised too
+        Logger logger((scratch / LOG_DIRECTORY).string(), false);
+
+        for (int round = 0; round < options.rounds; ++round) {
+            fs::remove_all(tree);
+            generateTree(tree, options.fileCount, rng);
+
+            auto start = std::chrono::steady_clock::now();
+            FileScanner scanner(logger);
+            if (!scanner.scanDirectory(tree.string())) {
+                std::cerr << "Error: Scan failed" << std::endl;
+                removeScratch(scratch, scratchCreated);
+                return 1;
+            }
+            double scanMs = millisecondsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            FileClassifier classifier(logger);
+            classifier.classifyFiles(scanner.getFiles());
+            double classifyMs = millisecondsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            FileMover mover(logger, false);
+            mover.organizeFiles(tree.string(), classifier.getCategorizedFiles());
+            double organizeMs = millisecondsSince(start);
+
+            std::cout << "round " << round + 1 << ": "
+                      << std::fixed << std::setprecision(1)
+                      << "scan " << scanMs << " ms, "
+                      << "classify " << classifyMs << " ms, "
+                      << "organize " << organizeMs << " ms ("
+                      << mover.getSuccessCount() << " moved)" << '\n';
+
+            totalScan += scanMs;
+            totalClassify += classifyMs;
+            totalOrganize += organizeMs;
+        }
+    }
+
+    double files = static_cast<double>(options.fileCount) * options.rounds;
+    std::cout << std::fixed << std::setprecision(0)
+              << "scan:     " << files / (totalScan / 1000.0) << " files/s" << '\n'
+              << "classify: " << files / (totalClassify / 1000.0) << " files/s" << '\n'
+              << "organize: " << files / (totalOrganize / 1000.0) << " files/s" << '\n';
+
+    if (options.keep) {
+        std::cout << "Scratch tree kept in " << scratch.string() << '\n';
+    } else {
+        removeScratch(scratch, scratchCreated);
+    }
+    return 0;
+}
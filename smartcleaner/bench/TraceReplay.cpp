@@ -0,0 +1,465 @@
+//==============================================================================
+// TraceReplay.cpp - Replay a Recorded Filesystem Workload
+//==============================================================================
+//
+// Rebuilds the shape of a traced tree (anonymous names, recorded sizes as
+// sparse files) and re-issues the traced operations in start order, either
+// against a scratch directory or an in-memory model of it. Timing can follow
+// the recording or run flat out; the report compares per-operation latency
+// with what was recorded. Replay is single-threaded.
+//
+//==============================================================================
+
+#include "BenchScratch.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace DesktopCleaner;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Replay Options
+//------------------------------------------------------------------------------
+struct ReplayOptions {
+    std::string tracePath;              // Trace to replay
+    std::string backend = "dir";        // "dir" or "memory"
+    std::string directory;              // Empty or new scratch directory (default: fresh temp)
+    bool recordedSpeed = false;         // Honor recorded start times
+    bool keep = false;                  // Leave the scratch directory behind
+};
+
+//------------------------------------------------------------------------------
+// TreeModel Structure
+// What the trace implies about the tree before the first operation
+//------------------------------------------------------------------------------
+struct TreeModel {
+    std::unordered_map<std::uint64_t, std::uint64_t> parentOf;   // Node -> directory
+    std::unordered_set<std::uint64_t> directories;               // Nodes used as directories
+    std::vector<std::uint64_t> initialDirectories;               // Existed before replay
+    std::vector<std::pair<std::uint64_t, long long>> initialFiles;
+
+    std::uint64_t parent(std::uint64_t id) const {
+        auto it = parentOf.find(id);
+        return it == parentOf.end() ? 0 : it->second;
+    }
+};
+
+TreeModel buildModel(const std::vector<TraceRecord>& records) {
+    TreeModel model;
+
+    // Pass 1: parent links and which nodes are directories
+    for (const auto& record : records) {
+        model.parentOf[record.pathHash] = record.parentHash;
+        model.directories.insert(record.parentHash);
+
+        auto op = static_cast<TraceOp>(record.op);
+        if (op == TraceOp::LIST_DIR || op == TraceOp::MKDIR) {
+            model.directories.insert(record.pathHash);
+        }
+        if (op == TraceOp::RENAME) {
+            model.parentOf[record.targetHash] = record.targetParentHash;
+            model.directories.insert(record.targetParentHash);
+        }
+    }
+
+    // Pass 2: a node's first appearance tells whether it existed beforehand
+    std::unordered_set<std::uint64_t> seen;
+    auto firstSeen = [&](std::uint64_t id, bool existed, long long sizeBytes) {
+        if (!seen.insert(id).second || !existed) {
+            return;
+        }
+        if (model.directories.count(id) > 0) {
+            model.initialDirectories.push_back(id);
+        } else {
+            model.initialFiles.emplace_back(id, sizeBytes);
+        }
+    };
+
+    for (const auto& record : records) {
+        bool ok = (record.flags & TRACE_FLAG_OK) != 0;
+        switch (static_cast<TraceOp>(record.op)) {
+            case TraceOp::LIST_DIR: firstSeen(record.pathHash, true, 0); break;
+            case TraceOp::STAT:     firstSeen(record.pathHash, ok, record.sizeBytes); break;
+            case TraceOp::EXISTS:   firstSeen(record.pathHash, ok, 0); break;
+            case TraceOp::MKDIR:    firstSeen(record.pathHash, false, 0); break;
+            case TraceOp::RENAME:
+                firstSeen(record.pathHash, true, record.sizeBytes);
+                firstSeen(record.targetHash, false, 0);
+                break;
+        }
+    }
+    return model;
+}
+
+//------------------------------------------------------------------------------
+// Replay Backends
+//------------------------------------------------------------------------------
+class ReplayBackend {
+public:
+    virtual ~ReplayBackend() = default;
+
+    // Initial state
+    virtual void createDirectory(std::uint64_t id) = 0;
+    virtual void createFile(std::uint64_t id, long long sizeBytes) = 0;
+
+    // Traced operations; return whether each succeeded
+    virtual bool listDirectory(std::uint64_t id) = 0;
+    virtual bool stat(std::uint64_t id) = 0;
+    virtual bool exists(std::uint64_t id) = 0;
+    virtual bool makeDirectory(std::uint64_t id) = 0;
+    virtual bool rename(std::uint64_t from, std::uint64_t to) = 0;
+};
+
+//------------------------------------------------------------------------------
+// DirectoryBackend: real files under a scratch directory
+//------------------------------------------------------------------------------
+class DirectoryBackend : public ReplayBackend {
+public:
+    DirectoryBackend(const TreeModel& model, const fs::path& root) : model_(model), root_(root) {}
+
+    void createDirectory(std::uint64_t id) override {
+        fs::create_directories(pathOf(id));
+    }
+
+    void createFile(std::uint64_t id, long long sizeBytes) override {
+        fs::path path = pathOf(id);
+        fs::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary).flush();
+        fs::resize_file(path, static_cast<std::uintmax_t>(std::max(sizeBytes, 0LL))); // Sparse
+    }
+
+    bool listDirectory(std::uint64_t id) override {
+        std::error_code error;
+        std::size_t entries = 0;
+        for (fs::directory_iterator it(pathOf(id), error), end; !error && it != end; it.increment(error)) {
+            entries++;
+        }
+        checksum_ += entries;
+        return !error;
+    }
+
+    bool stat(std::uint64_t id) override {
+        std::error_code error;
+        fs::path path = pathOf(id);
+        checksum_ += fs::file_size(path, error);
+        if (!error) {
+            checksum_ += static_cast<std::uint64_t>(
+                fs::last_write_time(path, error).time_since_epoch().count());
+        }
+        return !error;
+    }
+
+    bool exists(std::uint64_t id) override {
+        std::error_code error;
+        return fs::exists(pathOf(id), error);
+    }
+
+    bool makeDirectory(std::uint64_t id) override {
+        std::error_code error;
+        return fs::create_directory(pathOf(id), error);
+    }
+
+    bool rename(std::uint64_t from, std::uint64_t to) override {
+        std::error_code error;
+        fs::rename(pathOf(from), pathOf(to), error);
+        return !error;
+    }
+
+private:
+    const TreeModel& model_;
+    fs::path root_;
+    std::unordered_map<std::uint64_t, fs::path> paths_;
+    std::uint64_t checksum_ = 0;    // Keeps the reads from being optimized away
+
+    // Anonymous name per node, nested under its parent chain
+    const fs::path& pathOf(std::uint64_t id, int depth = 0) {
+        auto it = paths_.find(id);
+        if (it != paths_.end()) {
+            return it->second;
+        }
+
+        char name[24];
+        std::snprintf(name, sizeof(name), "n%016llx", static_cast<unsigned long long>(id));
+        std::uint64_t parent = model_.parent(id);
+
+        fs::path path = (parent == 0 || parent == id || depth > 64)
+            ? root_ / name
+            : pathOf(parent, depth + 1) / name;
+        return paths_.emplace(id, path).first->second;
+    }
+};
+
+//------------------------------------------------------------------------------
+// MemoryBackend: the same tree as hash maps, to isolate CPU-side costs
+//------------------------------------------------------------------------------
+class MemoryBackend : public ReplayBackend {
+public:
+    explicit MemoryBackend(const TreeModel& model) : model_(model) {}
+
+    void createDirectory(std::uint64_t id) override {
+        insert(id, Node{ true, 0 });
+    }
+
+    void createFile(std::uint64_t id, long long sizeBytes) override {
+        insert(id, Node{ false, sizeBytes });
+    }
+
+    bool listDirectory(std::uint64_t id) override {
+        auto it = children_.find(id);
+        if (it == children_.end()) {
+            return nodes_.count(id) > 0;
+        }
+        for (std::uint64_t child : it->second) {
+            checksum_ += static_cast<std::uint64_t>(nodes_[child].sizeBytes);
+        }
+        return true;
+    }
+
+    bool stat(std::uint64_t id) override {
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) {
+            return false;
+        }
+        checksum_ += static_cast<std::uint64_t>(it->second.sizeBytes);
+        return true;
+    }
+
+    bool exists(std::uint64_t id) override {
+        return nodes_.count(id) > 0;
+    }
+
+    bool makeDirectory(std::uint64_t id) override {
+        if (nodes_.count(id) > 0) {
+            return false;
+        }
+        insert(id, Node{ true, 0 });
+        return true;
+    }
+
+    bool rename(std::uint64_t from, std::uint64_t to) override {
+        auto it = nodes_.find(from);
+        if (it == nodes_.end()) {
+            return false;
+        }
+        Node node = it->second;
+        nodes_.erase(it);
+        children_[model_.parent(from)].erase(from);
+        insert(to, node);
+        return true;
+    }
+
+    std::uint64_t getChecksum() const { return checksum_; }
+
+private:
+    struct Node {
+        bool isDirectory;
+        long long sizeBytes;
+    };
+
+    const TreeModel& model_;
+    std::unordered_map<std::uint64_t, Node> nodes_;
+    std::unordered_map<std::uint64_t, std::unordered_set<std::uint64_t>> children_;
+    std::uint64_t checksum_ = 0;    // Keeps the reads from being optimized away
+
+    void insert(std::uint64_t id, const Node& node) {
+        nodes_[id] = node;
+        children_[model_.parent(id)].insert(id);
+    }
+};
+
+//------------------------------------------------------------------------------
+// Latency Statistics
+//------------------------------------------------------------------------------
+struct OpStats {
+    std::vector<std::uint64_t> recorded;
+    std::vector<std::uint64_t> replayed;
+    std::size_t mismatches = 0;     // Outcome differed from the recording
+};
+
+double percentileMicros(std::vector<std::uint64_t>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return static_cast<double>(values[index]) / 1000.0;
+}
+
+double totalMillis(const std::vector<std::uint64_t>& values) {
+    double total = 0.0;
+    for (std::uint64_t value : values) {
+        total += static_cast<double>(value);
+    }
+    return total / 1e6;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Parse Arguments
+//------------------------------------------------------------------------------
+bool parseArguments(int argc, char* argv[], ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--backend=") == 0) {
+            options.backend = arg.substr(10);
+        } else if (arg.find("--dir=") == 0) {
+            options.directory = arg.substr(6);
+        } else if (arg == "--speed=recorded") {
+            options.recordedSpeed = true;
+        } else if (arg == "--speed=max") {
+            options.recordedSpeed = false;
+        } else if (arg == "--keep") {
+            options.keep = true;
+        } else if (!arg.empty() && arg[0] != '-' && options.tracePath.empty()) {
+            options.tracePath = arg;
+        } else {
+            options.tracePath.clear();
+            break;
+        }
+    }
+
+    if (options.tracePath.empty() || (options.backend != "dir" && options.backend != "memory")) {
+        std::cerr << "Usage: smartcleaner_replay [--backend=dir|memory] [--dir=PATH] "
+                  << "[--speed=recorded|max] [--keep] TRACE" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Main Function
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<TraceRecord> records;
+    std::string error;
+    if (!TraceRecorder::readTrace(options.tracePath, records, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+
+    // Completion order differs from start order once operations overlap
+    std::stable_sort(records.begin(), records.end(), [](const TraceRecord& a, const TraceRecord& b) {
+        return a.startNs < b.startNs;
+    });
+
+    TreeModel model = buildModel(records);
+
+    fs::path scratch;
+    bool scratchCreated = false;
+
+    std::unique_ptr<ReplayBackend> backend;
+    if (options.backend == "dir") {
+        if (!prepareScratch(options.directory, "smartcleaner_replay_", scratch, scratchCreated)) {
+            return 1;
+        }
+        backend = std::make_unique<DirectoryBackend>(model, scratch);
+    } else {
+        backend = std::make_unique<MemoryBackend>(model);
+    }
+
+    for (std::uint64_t id : model.initialDirectories) {
+        backend->createDirectory(id);
+    }
+    for (const auto& [id, sizeBytes] : model.initialFiles) {
+        backend->createFile(id, sizeBytes);
+    }
+
+    std::cout << "Replaying " << records.size() << " operations ("
+              << model.initialDirectories.size() << " directories, "
+              << model.initialFiles.size() << " files) on " << options.backend
+              << " backend at " << (options.recordedSpeed ? "recorded" : "maximum")
+              << " speed" << '\n';
+
+    std::map<TraceOp, OpStats> stats;
+    auto origin = std::chrono::steady_clock::now();
+
+    for (const auto& record : records) {
+        if (options.recordedSpeed) {
+            std::this_thread::sleep_until(origin + std::chrono::nanoseconds(record.startNs));
+        }
+
+        auto op = static_cast<TraceOp>(record.op);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = false;
+        switch (op) {
+            case TraceOp::LIST_DIR: ok = backend->listDirectory(record.pathHash); break;
+            case TraceOp::STAT:     ok = backend->stat(record.pathHash); break;
+            case TraceOp::EXISTS:   ok = backend->exists(record.pathHash); break;
+            case TraceOp::MKDIR:    ok = backend->makeDirectory(record.pathHash); break;
+            case TraceOp::RENAME:   ok = backend->rename(record.pathHash, record.targetHash); break;
+            default:                continue;
+        }
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        OpStats& opStats = stats[op];
+        opStats.recorded.push_back(record.latencyNs);
+        opStats.replayed.push_back(static_cast<std::uint64_t>(latency));
+        if (ok != ((record.flags & TRACE_FLAG_OK) != 0)) {
+            opStats.mismatches++;
+        }
+    }
+
+    double wallMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - origin).count();
+
+    // Report: recorded vs replayed latency per operation type
+    std::cout << std::left << std::setw(10) << "op" << std::right
+              << std::setw(9) << "count"
+              << std::setw(12) << "rec p50us" << std::setw(12) << "rec p99us"
+              << std::setw(12) << "rec ms"
+              << std::setw(12) << "run p50us" << std::setw(12) << "run p99us"
+              << std::setw(12) << "run ms" << std::setw(11) << "mismatch" << '\n';
+
+    std::size_t totalMismatches = 0;
+    for (auto& [op, opStats] : stats) {
+        std::cout << std::left << std::setw(10) << TraceRecorder::opName(op) << std::right
+                  << std::setw(9) << opStats.recorded.size()
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << percentileMicros(opStats.recorded, 0.50)
+                  << std::setw(12) << percentileMicros(opStats.recorded, 0.99)
+                  << std::setw(12) << totalMillis(opStats.recorded)
+                  << std::setw(12) << percentileMicros(opStats.replayed, 0.50)
+                  << std::setw(12) << percentileMicros(opStats.replayed, 0.99)
+                  << std::setw(12) << totalMillis(opStats.replayed)
+                  << std::setw(11) << opStats.mismatches << '\n';
+        totalMismatches += opStats.mismatches;
+    }
+
+    std::cout << "wall: " << std::fixed << std::setprecision(1) << wallMs << " ms";
+    if (totalMismatches > 0) {
+        std::cout << " (" << totalMismatches << " operations diverged from the recording)";
+    }
+    std::cout << '\n';
+
+    if (options.backend == "dir") {
+        if (options.keep) {
+            std::cout << "Scratch tree kept in " << scratch.string() << '\n';
+        } else {
+            removeScratch(scratch, scratchCreated);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+//==============================================================================
+// ProjectCodePlugin.cpp - Example Classifier Plugin
+//==============================================================================
+//
+// Sends files whose names start with a project code ("ABC-123 budget.xlsx",
+// "OPS-42_notes.txt") to a Projects folder and Jupyter notebooks to Code; has
+// no opinion on anything else. Load it with:
+//
+//     desktop_cleaner --plugin=./libsmartcleaner_project_codes.so ~/Desktop
+//
+// Only the C header is needed to build a plugin; nothing links against
+// libsmartcleaner. The batch function keeps no state, so concurrent calls
+// from the worker pool are safe.
+//
+//==============================================================================
+
+#include "SmartCleanerPlugin.h"
+#include <cstring>
+
+namespace {
+
+const char* const CATEGORIES[] = { "Projects", "Code" };
+const int PROJECTS = 0;
+const int CODE = 1;
+
+//------------------------------------------------------------------------------
+// Helper: Name Starts With 2-5 Capitals, a Dash and a Digit
+//------------------------------------------------------------------------------
+bool hasProjectCode(const char* name) {
+    int letters = 0;
+    while (name[letters] >= 'A' && name[letters] <= 'Z') {
+        letters++;
+    }
+    return letters >= 2 && letters <= 5 && name[letters] == '-' &&
+           name[letters + 1] >= '0' && name[letters + 1] <= '9';
+}
+
+int classifyBatch(void*, sc_plugin_batch* batch) {
+    for (size_t i = 0; i < batch->count; ++i) {
+        if (hasProjectCode(batch->names[i])) {
+            batch->category_ids[i] = PROJECTS;
+        } else if (std::strcmp(batch->extensions[i], ".ipynb") == 0) {
+            batch->category_ids[i] = CODE;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Entry Point
+//------------------------------------------------------------------------------
+extern "C" SC_PLUGIN_EXPORT int sc_classifier_plugin_init(sc_plugin_info* info) {
+    if (info->struct_size < sizeof(sc_plugin_info)) {
+        return 1;
+    }
+    info->abi_version = SC_PLUGIN_ABI_VERSION;
+    info->name = "project-codes";
+    info->category_count = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+    info->categories = CATEGORIES;
+    info->classify_batch = classifyBatch;
+    info->state = nullptr;
+    info->destroy = nullptr;
+    return 0;
+}
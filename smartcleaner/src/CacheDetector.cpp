@@ -0,0 +1,253 @@
+//==============================================================================
+// CacheDetector.cpp - Reclaimable Cache Directory Detection Implementation
+//==============================================================================
+
+#include "CacheDetector.h"
+#include "ConcurrencyController.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <system_error>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+CacheDetector::CacheDetector(Logger& logger, ThreadPool& pool)
+    : logger_(logger), pool_(pool), rules_(getCacheDirectoryRules()), directoriesSearched_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Find Caches
+// Discovery only lists directories; the sizing of all caches then runs at once
+//------------------------------------------------------------------------------
+bool CacheDetector::findCaches(const std::string& rootDirectory) {
+    caches_.clear();
+    directoriesSearched_ = 0;
+
+    std::error_code ec;
+    if (!fs::is_directory(rootDirectory, ec)) {
+        logger_.error("Not a directory: " + rootDirectory);
+        return false;
+    }
+
+    std::vector<std::pair<fs::path, std::string>> found;
+    search(rootDirectory, 0, found);
+    logger_.info("Cache search: " + std::to_string(found.size()) + " caches in " +
+                 std::to_string(directoriesSearched_) + " directories");
+
+    std::vector<std::future<SubtreeTotals>> sizing;
+    for (const auto& [path, kind] : found) {
+        std::string pathText = path.string();
+        std::uint64_t device = ConcurrencyController::deviceOf(path);
+        sizing.push_back(pool_.submit([this, pathText, device]() {
+            return sizeSubtree(pathText, device, 0);
+        }));
+    }
+
+    std::time_t now = std::time(nullptr);
+    for (std::size_t i = 0; i < found.size(); ++i) {
+        pool_.waitFor(sizing[i]);
+        SubtreeTotals totals = sizing[i].get();
+
+        CacheDirectory cache;
+        cache.path = found[i].first.string();
+        cache.kind = found[i].second;
+        cache.sizeBytes = totals.sizeBytes;
+        cache.allocatedBytes = totals.allocatedBytes;
+        cache.fileCount = totals.fileCount;
+        cache.newestModified = totals.newestModified;
+        double staleDays = std::max<double>(0.0, static_cast<double>(now - totals.newestModified)) /
+                           (24.0 * 60 * 60);
+        cache.score = static_cast<double>(totals.allocatedBytes) * (staleDays + 1.0);
+        caches_.push_back(std::move(cache));
+    }
+
+    std::sort(caches_.begin(), caches_.end(), [](const CacheDirectory& a, const CacheDirectory& b) {
+        return a.score != b.score ? a.score > b.score : a.path < b.path;
+    });
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+const std::vector<CacheDirectory>& CacheDetector::getCaches() const {
+    return caches_;
+}
+
+long long CacheDetector::getTotalAllocatedBytes() const {
+    long long total = 0;
+    for (const auto& cache : caches_) {
+        total += cache.allocatedBytes;
+    }
+    return total;
+}
+
+long long CacheDetector::getDirectoriesSearched() const {
+    return directoriesSearched_;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Search for Caches
+// A recognized cache is recorded and not descended into
+//------------------------------------------------------------------------------
+void CacheDetector::search(const fs::path& directory, int depth,
+                           std::vector<std::pair<fs::path, std::string>>& found) {
+    directoriesSearched_++;
+
+    std::error_code ec;
+    fs::directory_iterator it(directory, fs::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        logger_.warning("Cannot list " + directory.string() + ": " + ec.message());
+        return;
+    }
+    for (; it != fs::directory_iterator(); it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        const auto& entry = *it;
+        if (entry.is_symlink(ec) || !entry.is_directory(ec)) {
+            continue;
+        }
+        if (const Rule* rule = matchRule(entry.path())) {
+            found.emplace_back(entry.path(),
+                               rule->first == CACHE_ANY_NAME ? "CACHEDIR.TAG" : rule->first);
+        } else if (depth + 1 < CACHE_SEARCH_MAX_DEPTH) {
+            search(entry.path(), depth + 1, found);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: First Rule a Directory Satisfies
+//------------------------------------------------------------------------------
+const CacheDetector::Rule* CacheDetector::matchRule(const fs::path& directory) const {
+    std::string name = directory.filename().string();
+    std::error_code ec;
+
+    for (const auto& rule : rules_) {
+        if (rule.first != name && rule.first != CACHE_ANY_NAME) {
+            continue;
+        }
+        if (rule.second.empty()) {
+            return &rule;
+        }
+        for (const auto& marker : rule.second) {
+            fs::path markerPath = marker.compare(0, 3, "../") == 0
+                                      ? directory.parent_path() / marker.substr(3)
+                                      : directory / marker;
+            if (fs::exists(markerPath, ec)) {
+                return &rule;
+            }
+        }
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Size a Subtree
+// Near the top of a cache, subdirectories are sized as their own tasks and
+// waited for with waitFor(), which keeps the pool busy instead of blocked;
+// deeper down they are summed inline
+//------------------------------------------------------------------------------
+CacheDetector::SubtreeTotals CacheDetector::sizeSubtree(const std::string& path,
+                                                        std::uint64_t device, int depth) {
+    SubtreeTotals totals;
+    std::vector<std::string> children;
+
+#ifndef _WIN32
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return totals;
+    }
+    int fd = dirfd(dir);
+    while (struct dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        struct stat status;
+        if (fstatat(fd, name, &status, AT_SYMLINK_NOFOLLOW) != 0) {
+            continue;
+        }
+        bool isDirectory = S_ISDIR(status.st_mode);
+        if (isDirectory && static_cast<std::uint64_t>(status.st_dev) != device) {
+            continue;   // Mount point
+        }
+        // Directories count their own blocks and age but not as files
+        totals.allocatedBytes += static_cast<long long>(status.st_blocks) * 512;
+        totals.newestModified = std::max(totals.newestModified, status.st_mtime);
+        if (isDirectory) {
+            children.push_back(path + "/" + name);
+            continue;
+        }
+        totals.sizeBytes += static_cast<long long>(status.st_size);
+        totals.fileCount++;
+    }
+    closedir(dir);
+#else
+    (void)device;
+    std::error_code ec;
+    for (fs::directory_iterator it(path, fs::directory_options::skip_permission_denied, ec), end;
+         !ec && it != end; it.increment(ec)) {
+        if (it->is_symlink(ec)) {
+            continue;
+        }
+        if (it->is_directory(ec)) {
+            children.push_back(it->path().string());
+            continue;
+        }
+        std::uintmax_t size = it->file_size(ec);
+        if (!ec) {
+            totals.sizeBytes += static_cast<long long>(size);
+            totals.allocatedBytes += static_cast<long long>(size);
+            totals.fileCount++;
+        }
+        auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+            it->last_write_time(ec) - fs::file_time_type::clock::now() +
+            std::chrono::system_clock::now());
+        totals.newestModified = std::max(totals.newestModified,
+                                         std::chrono::system_clock::to_time_t(sctp));
+    }
+#endif
+
+    if (depth < CACHE_PARALLEL_DEPTH && children.size() > 1) {
+        std::vector<std::future<SubtreeTotals>> subtrees;
+        for (const auto& child : children) {
+            subtrees.push_back(pool_.submit([this, child, device, depth]() {
+                return sizeSubtree(child, device, depth + 1);
+            }));
+        }
+        for (auto& subtree : subtrees) {
+            pool_.waitFor(subtree);
+            totals.add(subtree.get());
+        }
+    } else {
+        for (const auto& child : children) {
+            totals.add(sizeSubtree(child, device, depth + 1));
+        }
+    }
+    return totals;
+}
+
+void CacheDetector::SubtreeTotals::add(const SubtreeTotals& other) {
+    sizeBytes += other.sizeBytes;
+    allocatedBytes += other.allocatedBytes;
+    fileCount += other.fileCount;
+    newestModified = std::max(newestModified, other.newestModified);
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,82 @@
+//==============================================================================
+// CacheDetector.h - Reclaimable Cache Directory Detection Interface
+//==============================================================================
+
+#ifndef CACHE_DETECTOR_H
+#define CACHE_DETECTOR_H
+
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// CacheDirectory Structure
+// One rebuildable directory and what deleting it would give back
+//------------------------------------------------------------------------------
+struct CacheDirectory {
+    std::string path;
+    std::string kind;               // Rule that matched (e.g. "node_modules")
+    long long sizeBytes = 0;        // Apparent size of everything below
+    long long allocatedBytes = 0;   // Disk space it would free
+    long long fileCount = 0;
+    std::time_t newestModified = 0; // Latest file or directory change inside
+    double score = 0.0;             // allocatedBytes x (days since newestModified + 1)
+};
+
+//------------------------------------------------------------------------------
+// CacheDetector Class
+// Walks the directories below a root, stopping at every directory that
+// getCacheDirectoryRules() recognizes. Each cache is then sized as a tree of
+// pool tasks: a directory lists itself, waits for its subdirectories' totals
+// and adds them up, so only per-directory sums exist, never per-file records.
+// Symlinks are never followed, and sizing stays on the cache's filesystem.
+//------------------------------------------------------------------------------
+class CacheDetector {
+public:
+    // Constructor
+    CacheDetector(Logger& logger, ThreadPool& pool);
+
+    // Find and size the caches below rootDirectory
+    bool findCaches(const std::string& rootDirectory);
+
+    // Results, highest score first
+    const std::vector<CacheDirectory>& getCaches() const;
+    long long getTotalAllocatedBytes() const;
+    long long getDirectoriesSearched() const;
+
+private:
+    // Totals of one subtree, combined bottom-up
+    struct SubtreeTotals {
+        long long sizeBytes = 0;
+        long long allocatedBytes = 0;
+        long long fileCount = 0;
+        std::time_t newestModified = 0;
+        void add(const SubtreeTotals& other);
+    };
+    using Rule = std::pair<std::string, std::vector<std::string>>;
+
+    Logger& logger_;                                // Reference to logger
+    ThreadPool& pool_;                              // Sizing tasks
+    std::vector<Rule> rules_;
+    std::vector<CacheDirectory> caches_;
+    long long directoriesSearched_;
+
+    // Helper methods
+    void search(const std::filesystem::path& directory, int depth,
+                std::vector<std::pair<std::filesystem::path, std::string>>& found);
+    const Rule* matchRule(const std::filesystem::path& directory) const;
+    SubtreeTotals sizeSubtree(const std::string& path, std::uint64_t device, int depth);
+};
+
+} // namespace DesktopCleaner
+
+#endif // CACHE_DETECTOR_H
@@ -0,0 +1,390 @@
+//==============================================================================
+// ChunkAnalyzer.cpp - Content-Defined Chunking / Partial Duplication Implementation
+//==============================================================================
+
+#include "ChunkAnalyzer.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <array>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::size_t GEAR_WINDOW = 64;     // Bytes a gear hash depends on
+
+//------------------------------------------------------------------------------
+// Helper: Gear Table
+// Fixed seed, so cut points (and therefore fingerprints) are stable across runs
+//------------------------------------------------------------------------------
+const std::array<std::uint64_t, 256>& gearTable() {
+    static const std::array<std::uint64_t, 256> table = []() {
+        std::array<std::uint64_t, 256> values{};
+        std::uint64_t state = 0x5C0FFEE5EED5EEDULL;
+        for (auto& value : values) {
+            // splitmix64
+            state += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            value = z ^ (z >> 31);
+        }
+        return values;
+    }();
+    return table;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Cut Masks
+// Bits are spread over the top of the hash, where every window byte counts.
+// The strict mask is the loose mask plus four bits, so a strict match is
+// always a loose match and one scan with the loose mask finds both.
+//------------------------------------------------------------------------------
+std::uint64_t spreadMask(int bits, int offset) {
+    std::uint64_t mask = 0;
+    for (int i = 0; i < bits; ++i) {
+        mask |= 1ULL << (63 - offset - 3 * i);
+    }
+    return mask;
+}
+
+int averageBits() {
+    int bits = 0;
+    while ((std::size_t(1) << (bits + 1)) <= CDC_AVG_CHUNK_BYTES) {
+        bits++;
+    }
+    return bits;
+}
+
+const std::uint64_t LOOSE_MASK = spreadMask(averageBits() - 2, 0);
+const std::uint64_t STRICT_MASK = LOOSE_MASK | spreadMask(4, 1);
+
+// Hash of the window ending at position (position >= GEAR_WINDOW - 1)
+std::uint64_t windowHash(const unsigned char* data, std::uint64_t position) {
+    const auto& gear = gearTable();
+    std::uint64_t hash = 0;
+    for (std::uint64_t i = position + 1 - GEAR_WINDOW; i <= position; ++i) {
+        hash = (hash << 1) + gear[data[i]];
+    }
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// MappedFile Class
+// Read-only mapping so segment tasks share one view of the file
+//------------------------------------------------------------------------------
+class MappedFile {
+public:
+    explicit MappedFile(const fs::path& path) : data_(nullptr), size_(0) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            error_ = "cannot open";
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            error_ = "cannot read size";
+            ::close(fd);
+            return;
+        }
+        size_ = static_cast<std::size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            error_ = "cannot map";
+            size_ = 0;
+            return;
+        }
+        madvise(mapping, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const unsigned char*>(mapping);
+#else
+        (void)path;
+        error_ = "not supported on this platform";
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data_ != nullptr) {
+            munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data_ != nullptr; }
+    const unsigned char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+    const std::string& error() const { return error_; }
+
+private:
+    const unsigned char* data_;
+    std::size_t size_;
+    std::string error_;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ChunkAnalyzer::ChunkAnalyzer(Logger& logger, ThreadPool& pool)
+    : logger_(logger), pool_(pool), totalBytes_(0), uniqueBytes_(0), uniqueChunks_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Analyze Files
+// One file at a time; each file's segments and fingerprints use the pool
+//------------------------------------------------------------------------------
+bool ChunkAnalyzer::analyzeFiles(const std::vector<FileInfo>& files) {
+    table_.clear();
+    files_.clear();
+    pairs_.clear();
+
+    logger_.info("Chunking " + std::to_string(files.size()) + " files (" +
+                 std::to_string(CDC_AVG_CHUNK_BYTES >> 10) + " KB average chunks)...");
+
+    for (const auto& file : files) {
+        try {
+            chunkFile(file, static_cast<std::uint32_t>(files_.size()));
+        } catch (const std::exception& e) {
+            logger_.warning("Cannot chunk " + file.name + ": " + e.what());
+        }
+    }
+
+    buildReport();
+
+    logger_.info("Chunked " + std::to_string(files_.size()) + " files into " +
+                 std::to_string(table_.size()) + " chunks; dedupe would save " +
+                 std::to_string(totalBytes_ - uniqueBytes_) + " of " +
+                 std::to_string(totalBytes_) + " bytes");
+    return !files_.empty();
+}
+
+//------------------------------------------------------------------------------
+// Get Analysis Results
+//------------------------------------------------------------------------------
+const std::vector<ChunkedFile>& ChunkAnalyzer::getFiles() const {
+    return files_;
+}
+
+const std::vector<ChunkPair>& ChunkAnalyzer::getPairs() const {
+    return pairs_;
+}
+
+long long ChunkAnalyzer::getTotalBytes() const {
+    return totalBytes_;
+}
+
+long long ChunkAnalyzer::getUniqueBytes() const {
+    return uniqueBytes_;
+}
+
+std::size_t ChunkAnalyzer::getChunkCount() const {
+    return table_.size();
+}
+
+std::size_t ChunkAnalyzer::getUniqueChunkCount() const {
+    return uniqueChunks_;
+}
+
+//------------------------------------------------------------------------------
+// Find Cut Points
+// Step 1 scans fixed segments in parallel for loose-mask candidates; step 2
+// walks the merged candidates once and applies the FastCDC size rules
+//------------------------------------------------------------------------------
+std::vector<std::uint64_t> ChunkAnalyzer::findCutPoints(const unsigned char* data,
+                                                        std::size_t length) {
+    std::vector<std::uint64_t> cuts;
+    if (length == 0) {
+        return cuts;
+    }
+
+    // Step 1: Candidate positions; each segment re-reads the window before it
+    std::vector<std::future<std::vector<std::uint64_t>>> scans;
+    for (std::size_t begin = 0; begin < length; begin += CDC_SEGMENT_BYTES) {
+        std::size_t end = std::min(length, begin + CDC_SEGMENT_BYTES);
+        std::size_t scanStart = begin >= GEAR_WINDOW - 1 ? begin - (GEAR_WINDOW - 1) : 0;
+        scans.push_back(pool_.submit([data, scanStart, end]() {
+            std::vector<std::uint32_t> positions;
+            SimdKernels::gearScan(data + scanStart, end - scanStart, gearTable().data(),
+                                  LOOSE_MASK, positions);
+            std::vector<std::uint64_t> absolute;
+            absolute.reserve(positions.size());
+            for (std::uint32_t position : positions) {
+                absolute.push_back(scanStart + position);
+            }
+            return absolute;
+        }));
+    }
+
+    std::vector<std::uint64_t> candidates;
+    for (auto& scan : scans) {
+        pool_.waitFor(scan);
+        std::vector<std::uint64_t> part = scan.get();
+        candidates.insert(candidates.end(), part.begin(), part.end());
+    }
+
+    // Step 2: A candidate at position p cuts after p
+    std::size_t next = 0;
+    std::uint64_t start = 0;
+    while (start < length) {
+        if (length - start <= CDC_MIN_CHUNK_BYTES) {
+            cuts.push_back(length);
+            break;
+        }
+
+        const std::uint64_t minEnd = start + CDC_MIN_CHUNK_BYTES;
+        const std::uint64_t normalEnd = start + CDC_AVG_CHUNK_BYTES;
+        const std::uint64_t maxEnd = std::min<std::uint64_t>(length, start + CDC_MAX_CHUNK_BYTES);
+
+        while (next < candidates.size() && candidates[next] + 1 < minEnd) {
+            next++;
+        }
+
+        std::uint64_t end = maxEnd;
+        for (std::size_t k = next; k < candidates.size() && candidates[k] + 1 <= maxEnd; ++k) {
+            std::uint64_t candidateEnd = candidates[k] + 1;
+            if (candidateEnd > normalEnd ||
+                (windowHash(data, candidates[k]) & STRICT_MASK) == 0) {
+                end = candidateEnd;
+                break;
+            }
+        }
+
+        cuts.push_back(end);
+        start = end;
+    }
+    return cuts;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Chunk and Fingerprint One File
+//------------------------------------------------------------------------------
+bool ChunkAnalyzer::chunkFile(const FileInfo& file, std::uint32_t fileIndex) {
+    MappedFile mapped(file.path);
+    if (!mapped.isOpen()) {
+        logger_.warning("Cannot chunk " + file.name + ": " + mapped.error());
+        return false;
+    }
+
+    const unsigned char* data = mapped.data();
+    std::vector<std::uint64_t> cuts = findCutPoints(data, mapped.size());
+
+    // Fingerprint batches of about one segment each
+    std::vector<std::future<std::vector<ChunkEntry>>> batches;
+    std::size_t first = 0;
+    while (first < cuts.size()) {
+        std::uint64_t batchStart = first == 0 ? 0 : cuts[first - 1];
+        std::size_t last = first + 1;
+        while (last < cuts.size() && cuts[last] - batchStart <= CDC_SEGMENT_BYTES) {
+            last++;
+        }
+        batches.push_back(pool_.submit([data, &cuts, first, last, fileIndex]() {
+            std::vector<ChunkEntry> entries;
+            entries.reserve(last - first);
+            for (std::size_t i = first; i < last; ++i) {
+                std::uint64_t chunkStart = i == 0 ? 0 : cuts[i - 1];
+                std::size_t chunkLength = static_cast<std::size_t>(cuts[i] - chunkStart);
+                entries.push_back({ ContentHasher::hashBytes(data + chunkStart, chunkLength),
+                                    static_cast<std::uint32_t>(chunkLength), fileIndex });
+            }
+            return entries;
+        }));
+        first = last;
+    }
+
+    for (auto& batch : batches) {
+        pool_.waitFor(batch);
+        std::vector<ChunkEntry> entries = batch.get();
+        table_.insert(table_.end(), entries.begin(), entries.end());
+    }
+
+    files_.push_back({ file, static_cast<long long>(cuts.size()), 0 });
+    logger_.fileEvent(LogLevel::INFO, "Chunked: " + file.name + " (" +
+                      std::to_string(cuts.size()) + " chunks)");
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Build Report
+// Sorting by fingerprint puts every chunk's copies side by side
+//------------------------------------------------------------------------------
+void ChunkAnalyzer::buildReport() {
+    totalBytes_ = 0;
+    uniqueBytes_ = 0;
+    uniqueChunks_ = 0;
+    for (const auto& entry : files_) {
+        totalBytes_ += entry.file.sizeBytes;
+    }
+
+    std::sort(table_.begin(), table_.end(), [](const ChunkEntry& a, const ChunkEntry& b) {
+        if (a.fingerprint != b.fingerprint) {
+            return a.fingerprint < b.fingerprint;
+        }
+        return a.fileIndex < b.fileIndex;
+    });
+
+    std::unordered_map<std::uint64_t, long long> shared; // (first << 32 | second) -> bytes
+    std::vector<std::uint32_t> owners;
+    for (std::size_t i = 0; i < table_.size();) {
+        std::size_t j = i + 1;
+        while (j < table_.size() && table_[j].fingerprint == table_[i].fingerprint) {
+            j++;
+        }
+
+        const long long length = table_[i].length;
+        uniqueChunks_++;
+        uniqueBytes_ += length;
+
+        if (j - i > 1) {
+            owners.clear();
+            for (std::size_t k = i; k < j; ++k) {
+                files_[table_[k].fileIndex].duplicateBytes += length;
+                if (owners.empty() || owners.back() != table_[k].fileIndex) {
+                    owners.push_back(table_[k].fileIndex);
+                }
+            }
+            if (owners.size() > 1 && owners.size() <= CDC_MAX_PAIR_FANOUT) {
+                for (std::size_t a = 0; a < owners.size(); ++a) {
+                    for (std::size_t b = a + 1; b < owners.size(); ++b) {
+                        shared[(static_cast<std::uint64_t>(owners[a]) << 32) | owners[b]] += length;
+                    }
+                }
+            }
+        }
+        i = j;
+    }
+
+    for (const auto& [key, bytes] : shared) {
+        pairs_.push_back({ static_cast<std::uint32_t>(key >> 32),
+                           static_cast<std::uint32_t>(key & 0xFFFFFFFFu), bytes });
+    }
+    std::sort(pairs_.begin(), pairs_.end(), [](const ChunkPair& a, const ChunkPair& b) {
+        if (a.sharedBytes != b.sharedBytes) {
+            return a.sharedBytes > b.sharedBytes;
+        }
+        return a.first != b.first ? a.first < b.first : a.second < b.second;
+    });
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,92 @@
+//==============================================================================
+// ChunkAnalyzer.h - Content-Defined Chunking / Partial Duplication Interface
+//==============================================================================
+
+#ifndef CHUNK_ANALYZER_H
+#define CHUNK_ANALYZER_H
+
+#include "FileScanner.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// ChunkedFile Structure
+//------------------------------------------------------------------------------
+struct ChunkedFile {
+    FileInfo file;                  // The analyzed file
+    long long chunkCount;           // Chunks it was cut into
+    long long duplicateBytes;       // Bytes whose chunk also occurs elsewhere
+};
+
+//------------------------------------------------------------------------------
+// ChunkPair Structure
+// Indices refer to getFiles(); shared chunks are counted once per pair
+//------------------------------------------------------------------------------
+struct ChunkPair {
+    std::uint32_t first;
+    std::uint32_t second;
+    long long sharedBytes;
+};
+
+//------------------------------------------------------------------------------
+// ChunkAnalyzer Class
+// Cuts files at content-defined boundaries so shared regions line up even
+// after insertions, fingerprints every chunk into one compact table and
+// measures how many bytes block-level dedupe would save.
+//
+// Cut points come from a gear hash over a sliding 64-byte window, so each
+// file is scanned in parallel segments and the cut selection (minimum size,
+// strict mask below the average, loose mask above it, forced maximum) runs
+// over the merged candidate list afterwards.
+//------------------------------------------------------------------------------
+class ChunkAnalyzer {
+public:
+    // Constructor
+    ChunkAnalyzer(Logger& logger, ThreadPool& pool);
+
+    // Main analysis method; false if no file could be chunked
+    bool analyzeFiles(const std::vector<FileInfo>& files);
+
+    // Get analysis results
+    const std::vector<ChunkedFile>& getFiles() const;
+    const std::vector<ChunkPair>& getPairs() const;     // Most shared first
+    long long getTotalBytes() const;
+    long long getUniqueBytes() const;
+    std::size_t getChunkCount() const;
+    std::size_t getUniqueChunkCount() const;
+
+    // Chunk end offsets for one buffer (the last one is always length)
+    std::vector<std::uint64_t> findCutPoints(const unsigned char* data, std::size_t length);
+
+private:
+    // One table row: 16 bytes per chunk
+    struct ChunkEntry {
+        std::uint64_t fingerprint;  // XXH64 of the chunk
+        std::uint32_t length;       // Chunk size (<= CDC_MAX_CHUNK_BYTES)
+        std::uint32_t fileIndex;    // Index into files_
+    };
+
+    Logger& logger_;                        // Reference to logger
+    ThreadPool& pool_;                      // Segment scan / fingerprint workers
+    std::vector<ChunkEntry> table_;         // Every chunk of every file
+    std::vector<ChunkedFile> files_;        // Per-file results
+    std::vector<ChunkPair> pairs_;          // File pairs sharing chunks
+    long long totalBytes_;                  // Sum of file sizes
+    long long uniqueBytes_;                 // Bytes after dedupe
+    std::size_t uniqueChunks_;              // Distinct fingerprints
+
+    // Helper methods
+    bool chunkFile(const FileInfo& file, std::uint32_t fileIndex);
+    void buildReport();
+};
+
+} // namespace DesktopCleaner
+
+#endif // CHUNK_ANALYZER_H
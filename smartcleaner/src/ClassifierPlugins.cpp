@@ -0,0 +1,171 @@
+//==============================================================================
+// ClassifierPlugins.cpp - Batch Classifier Plugin Host Implementation
+//==============================================================================
+
+#include "ClassifierPlugins.h"
+#include "FileClassifier.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#endif
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Constructor & Destructor
+//------------------------------------------------------------------------------
+ClassifierPlugins::ClassifierPlugins(Logger& logger) : logger_(logger) {
+}
+
+ClassifierPlugins::~ClassifierPlugins() {
+    for (auto it = plugins_.rbegin(); it != plugins_.rend(); ++it) {
+        if (it->info.destroy != nullptr) {
+            it->info.destroy(it->info.state);
+        }
+#ifndef _WIN32
+        dlclose(it->handle);
+#endif
+    }
+}
+
+//------------------------------------------------------------------------------
+// Load Plugin
+//------------------------------------------------------------------------------
+bool ClassifierPlugins::load(const std::string& path) {
+#ifndef _WIN32
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        logger_.error("Cannot load plugin " + path + ": " + dlerror());
+        return false;
+    }
+    auto init = reinterpret_cast<sc_plugin_init_fn>(dlsym(handle, SC_PLUGIN_ENTRY));
+    if (init == nullptr) {
+        logger_.error("Plugin " + path + " does not export " + SC_PLUGIN_ENTRY);
+        dlclose(handle);
+        return false;
+    }
+
+    Plugin plugin{ path, handle, sc_plugin_info{}, {} };
+    plugin.info.struct_size = sizeof(sc_plugin_info);
+    if (init(&plugin.info) != 0 || plugin.info.classify_batch == nullptr) {
+        logger_.error("Plugin " + path + " failed to initialize");
+        dlclose(handle);
+        return false;
+    }
+    if (plugin.info.abi_version != SC_PLUGIN_ABI_VERSION) {
+        logger_.error("Plugin " + path + " uses ABI " + std::to_string(plugin.info.abi_version) +
+                      ", expected " + std::to_string(SC_PLUGIN_ABI_VERSION));
+        if (plugin.info.destroy != nullptr) {
+            plugin.info.destroy(plugin.info.state);
+        }
+        dlclose(handle);
+        return false;
+    }
+
+    // Categories become folder names, so anything that is not one plain name is refused
+    for (std::size_t i = 0; i < plugin.info.category_count; ++i) {
+        const char* raw = plugin.info.categories != nullptr ? plugin.info.categories[i] : nullptr;
+        std::string name = raw != nullptr ? raw : "";
+        if (!FileClassifier::isValidCategoryName(name, true)) {
+            logger_.warning("Plugin " + path + ": ignoring category \"" + name + "\"");
+            plugin.categoryIndex.push_back(-1);
+            continue;
+        }
+        auto found = std::find(categories_.begin(), categories_.end(), name);
+        if (found == categories_.end()) {
+            found = categories_.insert(categories_.end(), name);
+        }
+        plugin.categoryIndex.push_back(static_cast<int>(found - categories_.begin()));
+    }
+
+    std::string name = plugin.info.name != nullptr ? plugin.info.name : path;
+    logger_.info("Loaded classifier plugin " + name + " (" +
+                 std::to_string(plugin.categoryIndex.size()) + " categories)");
+    plugins_.push_back(std::move(plugin));
+    return true;
+#else
+    logger_.error("Classifier plugins are not supported on this platform: " + path);
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+const std::vector<std::string>& ClassifierPlugins::getCategories() const {
+    return categories_;
+}
+
+bool ClassifierPlugins::empty() const {
+    return plugins_.empty();
+}
+
+//------------------------------------------------------------------------------
+// Classify
+//------------------------------------------------------------------------------
+std::vector<int> ClassifierPlugins::classify(const std::vector<FileInfo>& files,
+                                             ThreadPool* pool) const {
+    std::vector<int> result(files.size(), -1);
+    if (plugins_.empty()) {
+        return result;
+    }
+
+    runInBatches(pool, files.size(), PLUGIN_BATCH_FILES,
+                 [this, &files, &result](std::size_t begin, std::size_t end) {
+                     classifyBatch(files, begin, end, result);
+                 });
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Classify One Batch
+// Columns are built once and shared by every plugin; each later plugin only
+// matters for files the earlier ones left undecided
+//------------------------------------------------------------------------------
+void ClassifierPlugins::classifyBatch(const std::vector<FileInfo>& files, std::size_t begin,
+                                      std::size_t end, std::vector<int>& result) const {
+    const std::size_t count = end - begin;
+    std::vector<const char*> names(count);
+    std::vector<const char*> extensions(count);
+    std::vector<long long> sizes(count);
+    std::vector<long long> mtimes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const FileInfo& file = files[begin + i];
+        names[i] = file.name.c_str();
+        extensions[i] = file.extension.c_str();
+        sizes[i] = file.sizeBytes;
+        mtimes[i] = static_cast<long long>(file.lastModified);
+    }
+
+    std::vector<int> ids(count);
+    std::size_t undecided = count;
+    for (const auto& plugin : plugins_) {
+        if (undecided == 0) {
+            break;
+        }
+        std::fill(ids.begin(), ids.end(), SC_PLUGIN_NO_CATEGORY);
+        sc_plugin_batch batch{ sizeof(sc_plugin_batch), count, names.data(), extensions.data(),
+                               sizes.data(), mtimes.data(), ids.data() };
+        if (plugin.info.classify_batch(plugin.info.state, &batch) != 0) {
+            logger_.warning("Plugin " + plugin.path + " failed a batch of " +
+                            std::to_string(count) + " files");
+            continue;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            int id = ids[i];
+            if (result[begin + i] >= 0 || id < 0 ||
+                static_cast<std::size_t>(id) >= plugin.categoryIndex.size() ||
+                plugin.categoryIndex[id] < 0) {
+                continue;
+            }
+            result[begin + i] = plugin.categoryIndex[id];
+            undecided--;
+        }
+    }
+}
+
+} // namespace DesktopCleaner
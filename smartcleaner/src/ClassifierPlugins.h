@@ -0,0 +1,64 @@
+//==============================================================================
+// ClassifierPlugins.h - Batch Classifier Plugin Host Interface
+//==============================================================================
+
+#ifndef CLASSIFIER_PLUGINS_H
+#define CLASSIFIER_PLUGINS_H
+
+#include "FileScanner.h"
+#include "SmartCleanerPlugin.h"
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// ClassifierPlugins Class
+// Loads SmartCleanerPlugin.h libraries and runs them over a scan in column
+// batches of PLUGIN_BATCH_FILES on the worker pool. Plugins are asked in load
+// order; the first one with an opinion on a file decides its category.
+//------------------------------------------------------------------------------
+class ClassifierPlugins {
+public:
+    // Constructor & Destructor (destroys plugin state and closes the libraries)
+    explicit ClassifierPlugins(Logger& logger);
+    ~ClassifierPlugins();
+
+    // Prevent copying
+    ClassifierPlugins(const ClassifierPlugins&) = delete;
+    ClassifierPlugins& operator=(const ClassifierPlugins&) = delete;
+
+    // Load one plugin library
+    bool load(const std::string& path);
+
+    // Categories any plugin can assign, in load order without repeats
+    const std::vector<std::string>& getCategories() const;
+    bool empty() const;
+
+    // Index into getCategories() for each file, or -1 where no plugin decided
+    std::vector<int> classify(const std::vector<FileInfo>& files, ThreadPool* pool) const;
+
+private:
+    struct Plugin {
+        std::string path;
+        void* handle;
+        sc_plugin_info info;
+        std::vector<int> categoryIndex;             // Plugin category id -> getCategories() index
+    };
+
+    Logger& logger_;                                // Reference to logger
+    std::vector<Plugin> plugins_;
+    std::vector<std::string> categories_;
+
+    // Helper methods
+    void classifyBatch(const std::vector<FileInfo>& files, std::size_t begin, std::size_t end,
+                       std::vector<int>& result) const;
+};
+
+} // namespace DesktopCleaner
+
+#endif // CLASSIFIER_PLUGINS_H
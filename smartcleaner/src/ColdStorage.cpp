@@ -0,0 +1,542 @@
+//==============================================================================
+// ColdStorage.cpp - Cold-Tier Compression Implementation
+//==============================================================================
+
+#include "ColdStorage.h"
+#include "ContentHash.h"
+#include "FileMover.h"
+#include "Logger.h"
+#include "ProgressReporter.h"
+#include "ResourceLimits.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef SMARTCLEANER_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+#ifdef SMARTCLEANER_WITH_ZSTD
+//------------------------------------------------------------------------------
+// Helper: Read a Byte Range
+// Each task opens its own stream so chunks can be read concurrently
+//------------------------------------------------------------------------------
+std::string readRange(const fs::path& path, long long offset, long long length) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("cannot open for reading");
+    }
+
+    std::string buffer(static_cast<std::size_t>(length), '\0');
+    input.seekg(offset);
+    input.read(&buffer[0], length);
+    buffer.resize(static_cast<std::size_t>(input.gcount()));
+    return buffer;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Compress One Independent zstd Frame
+// Concatenated frames form a valid zstd stream, so chunks never need merging
+//------------------------------------------------------------------------------
+std::string compressFrame(const std::string& data, int level) {
+    std::string frame(ZSTD_compressBound(data.size()), '\0');
+    std::size_t written = ZSTD_compress(&frame[0], frame.size(),
+                                        data.data(), data.size(), level);
+    if (ZSTD_isError(written)) {
+        throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(written));
+    }
+    frame.resize(written);
+    return frame;
+}
+#endif
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructors
+//------------------------------------------------------------------------------
+ColdStorage::ColdStorage(Logger& logger, bool dryRun, std::size_t threadCount)
+    : logger_(logger),
+      progress_(nullptr),
+      dryRun_(dryRun),
+      ownedPool_(std::make_unique<ThreadPool>(threadCount)),
+      pool_(*ownedPool_),
+      skippedCount_(0),
+      failCount_(0),
+      bytesIn_(0),
+      bytesOut_(0) {
+}
+
+ColdStorage::ColdStorage(Logger& logger, ThreadPool& pool, bool dryRun)
+    : logger_(logger),
+      progress_(nullptr),
+      dryRun_(dryRun),
+      pool_(pool),
+      skippedCount_(0),
+      failCount_(0),
+      bytesIn_(0),
+      bytesOut_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Availability Check
+//------------------------------------------------------------------------------
+bool ColdStorage::isAvailable() {
+#ifdef SMARTCLEANER_WITH_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Archive Files
+// Small files are compressed one per task; large files are compressed one at
+// a time from this thread with their chunks spread across the pool.
+//------------------------------------------------------------------------------
+bool ColdStorage::archiveFiles(const std::string& baseDirectory,
+                               const std::vector<FileInfo>& files) {
+    archivedFiles_.clear();
+    archiveJournal_.clear();
+    skippedCount_ = 0;
+    failCount_ = 0;
+    bytesIn_ = 0;
+    bytesOut_ = 0;
+
+    if (!isAvailable()) {
+        logger_.error("Cold tier unavailable: built without zstd support");
+        return false;
+    }
+
+    std::string coldDirectory = baseDirectory + "/" + COLD_DIRECTORY;
+    logger_.info("Archiving " + std::to_string(files.size()) + " old files to " +
+                 COLD_DIRECTORY + "/ using " + std::to_string(pool_.getThreadCount()) +
+                 " threads");
+
+    try {
+        if (dryRun_) {
+            if (!fs::exists(coldDirectory)) {
+                logger_.info("[DRY-RUN] Would create directory: " + COLD_DIRECTORY);
+            }
+        } else if (!fs::exists(coldDirectory)) {
+            fs::create_directory(coldDirectory);
+            logger_.success("Created directory: " + COLD_DIRECTORY);
+        }
+    } catch (const fs::filesystem_error& e) {
+        logger_.error("Failed to create directory: " + COLD_DIRECTORY + " - " + e.what());
+        return false;
+    }
+
+    auto record = [this](const FileInfo& file, const ArchiveResult& result) {
+        switch (result.status) {
+            case ArchiveResult::Status::ARCHIVED:
+                archivedFiles_.push_back(file);
+                if (!result.archivePath.empty()) {
+                    archiveJournal_.push_back({ file, result.archivePath, COLD_DIRECTORY,
+                                                result.bytesOut });
+                }
+                bytesIn_ += file.sizeBytes;
+                bytesOut_ += result.bytesOut;
+                break;
+            case ArchiveResult::Status::SKIPPED:
+                skippedCount_++;
+                break;
+            case ArchiveResult::Status::FAILED:
+                failCount_++;
+                break;
+        }
+    };
+
+    std::vector<std::pair<const FileInfo*, std::future<ArchiveResult>>> pending;
+
+    for (const auto& file : files) {
+        if (file.sizeBytes > COLD_CHUNK_SIZE_BYTES) {
+            record(file, archiveFile(file, coldDirectory, true));
+            if (progress_) {
+                progress_->addFile(file.sizeBytes);
+            }
+        } else {
+            pending.emplace_back(&file, pool_.submit([this, &file, &coldDirectory]() {
+                ArchiveResult result = archiveFile(file, coldDirectory, false);
+                if (progress_) {
+                    progress_->addFile(file.sizeBytes);
+                }
+                return result;
+            }));
+        }
+    }
+
+    for (auto& [file, result] : pending) {
+        record(*file, result.get());
+    }
+
+    logger_.info("Cold tier: " + std::to_string(archivedFiles_.size()) + " archived, " +
+                 std::to_string(skippedCount_) + " skipped, " +
+                 std::to_string(failCount_) + " failed (" +
+                 std::to_string(bytesIn_) + " -> " + std::to_string(bytesOut_) + " bytes)");
+    logger_.flushIndex();
+
+    return failCount_ == 0;
+}
+
+//------------------------------------------------------------------------------
+// Restore File
+// Streams the concatenated frames back through a single decompression stream
+//------------------------------------------------------------------------------
+bool ColdStorage::restoreFile(const std::string& archivePath,
+                              const std::string& targetDirectory) {
+#ifdef SMARTCLEANER_WITH_ZSTD
+    fs::path source(archivePath);
+    if (source.extension() != COLD_FILE_EXTENSION) {
+        logger_.error("Not a cold-tier archive: " + archivePath);
+        return false;
+    }
+
+    std::string originalName = source.stem().string();
+    fs::path target = fs::path(targetDirectory) / originalName;
+    fs::path partial = target;
+    partial += ".part";
+
+    if (fs::exists(target)) {
+        logger_.error("Restore target already exists: " + target.string());
+        return false;
+    }
+
+    if (dryRun_) {
+        logger_.info("[DRY-RUN] Would restore: " + source.filename().string() +
+                     " → " + originalName);
+        return true;
+    }
+
+    ZSTD_DStream* stream = ZSTD_createDStream();
+    if (stream == nullptr) {
+        logger_.error("Failed to allocate zstd decompression stream");
+        return false;
+    }
+
+    bool ok = false;
+    try {
+        std::ifstream input(source, std::ios::binary);
+        std::ofstream output(partial, std::ios::binary | std::ios::trunc);
+        if (!input || !output) {
+            throw std::runtime_error("cannot open archive or restore target");
+        }
+
+        // Large buffers keep the device streaming instead of seeking per call
+        std::vector<char> inBuffer(COLD_CHUNK_SIZE_BYTES / 8);
+        std::vector<char> outBuffer(COLD_CHUNK_SIZE_BYTES / 4);
+        std::size_t lastResult = 0;
+
+        ZSTD_initDStream(stream);
+        for (;;) {
+            input.read(inBuffer.data(), static_cast<std::streamsize>(inBuffer.size()));
+            ZSTD_inBuffer in = { inBuffer.data(), static_cast<std::size_t>(input.gcount()), 0 };
+            const bool endOfInput = in.size == 0;
+            if (endOfInput && lastResult == 0) {
+                break;      // Last frame complete and flushed
+            }
+
+            // A call that fills the output buffer may hold decoded data back
+            // (a non-zero result), so keep calling until the input is used up
+            // and a call leaves room
+            bool outputFull;
+            do {
+                ZSTD_outBuffer out = { outBuffer.data(), outBuffer.size(), 0 };
+                lastResult = ZSTD_decompressStream(stream, &out, &in);
+                if (ZSTD_isError(lastResult)) {
+                    throw std::runtime_error(std::string("zstd: ") +
+                                             ZSTD_getErrorName(lastResult));
+                }
+                output.write(outBuffer.data(), static_cast<std::streamsize>(out.pos));
+                outputFull = out.pos == out.size && lastResult != 0;
+            } while (in.pos < in.size || outputFull);
+
+            if (endOfInput) {
+                break;
+            }
+        }
+
+        if (lastResult != 0) {
+            throw std::runtime_error("archive is truncated");
+        }
+
+        output.close();
+        if (!output) {
+            throw std::runtime_error("write failed");
+        }
+
+        // Same order as archiving: data, then name, then the archive goes
+        fs::last_write_time(partial, fs::last_write_time(source));
+        if (!FileMover::syncFile(partial)) {
+            throw std::runtime_error("cannot sync " + partial.string());
+        }
+        std::error_code renameError;
+        FileMover::renameNoReplace(partial, target, renameError);
+        if (renameError) {
+            throw fs::filesystem_error("rename", partial, target, renameError);
+        }
+        if (!FileMover::syncDirectory(targetDirectory)) {
+            throw std::runtime_error("cannot sync " + targetDirectory + "; archive kept");
+        }
+        fs::remove(source);
+
+        logger_.success("Restored: " + source.filename().string() + " → " + originalName);
+        ok = true;
+
+    } catch (const std::exception& e) {
+        logger_.error("Failed to restore: " + source.filename().string() + " - " + e.what());
+        std::error_code ec;
+        fs::remove(partial, ec);
+    }
+
+    ZSTD_freeDStream(stream);
+    return ok;
+#else
+    (void)targetDirectory;
+    logger_.error("Cannot restore " + archivePath + ": built without zstd support");
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Get Archiving Results
+//------------------------------------------------------------------------------
+const std::vector<FileInfo>& ColdStorage::getArchivedFiles() const { return archivedFiles_; }
+const std::vector<MovedFile>& ColdStorage::getArchiveJournal() const { return archiveJournal_; }
+int ColdStorage::getSkippedCount() const { return skippedCount_; }
+int ColdStorage::getFailCount() const { return failCount_; }
+long long ColdStorage::getBytesIn() const { return bytesIn_; }
+long long ColdStorage::getBytesOut() const { return bytesOut_; }
+
+//------------------------------------------------------------------------------
+// Configuration Setters
+//------------------------------------------------------------------------------
+void ColdStorage::setProgressReporter(ProgressReporter* progress) {
+    progress_ = progress;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Estimate Compression Ratio
+// Compresses a few evenly spaced samples at the fastest level
+//------------------------------------------------------------------------------
+double ColdStorage::estimateRatio(const FileInfo& fileInfo) const {
+#ifdef SMARTCLEANER_WITH_ZSTD
+    const long long sampleTotal = COLD_SAMPLE_BLOCK_BYTES * COLD_SAMPLE_BLOCK_COUNT;
+    long long sampledIn = 0;
+    long long sampledOut = 0;
+
+    if (fileInfo.sizeBytes <= sampleTotal) {
+        std::string data = readRange(fileInfo.path, 0, fileInfo.sizeBytes);
+        sampledIn = static_cast<long long>(data.size());
+        sampledOut = static_cast<long long>(compressFrame(data, 1).size());
+    } else {
+        long long stride = (fileInfo.sizeBytes - COLD_SAMPLE_BLOCK_BYTES) /
+                           (COLD_SAMPLE_BLOCK_COUNT - 1);
+        for (int i = 0; i < COLD_SAMPLE_BLOCK_COUNT; ++i) {
+            std::string data = readRange(fileInfo.path, i * stride, COLD_SAMPLE_BLOCK_BYTES);
+            sampledIn += static_cast<long long>(data.size());
+            sampledOut += static_cast<long long>(compressFrame(data, 1).size());
+        }
+    }
+
+    return sampledIn > 0 ? static_cast<double>(sampledOut) / sampledIn : 1.0;
+#else
+    (void)fileInfo;
+    return 1.0;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Helper: Archive Single File
+//------------------------------------------------------------------------------
+ColdStorage::ArchiveResult ColdStorage::archiveFile(const FileInfo& fileInfo,
+                                                    const std::string& coldDirectory,
+                                                    bool splitAcrossPool) {
+    fs::path partial;
+
+    try {
+        double ratio = estimateRatio(fileInfo);
+        if (ratio > COLD_MAX_SAMPLE_RATIO) {
+            logger_.fileEvent(LogLevel::INFO, "Skipping incompressible file: " + fileInfo.name);
+            return { ArchiveResult::Status::SKIPPED, 0 };
+        }
+
+        if (dryRun_) {
+            logger_.fileEvent(LogLevel::INFO, "[DRY-RUN] Would archive: " + fileInfo.name +
+                              " → " + COLD_DIRECTORY + "/");
+            return { ArchiveResult::Status::ARCHIVED,
+                     static_cast<long long>(fileInfo.sizeBytes * ratio) };
+        }
+
+        // Two old files of the same name may be archived at once, so the
+        // partial name is unique to the source
+        std::ostringstream partialName;
+        partialName << fileInfo.name << COLD_FILE_EXTENSION << "." << std::hex << std::setw(16)
+                    << std::setfill('0') << ContentHasher::hashPath(fileInfo.path.string())
+                    << ".part";
+        partial = fs::path(coldDirectory) / partialName.str();
+
+        std::ofstream output(partial, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw std::runtime_error("cannot create " + partial.string());
+        }
+
+        long long bytesOut = compressToStream(fileInfo, output, splitAcrossPool);
+        output.close();
+        if (!output) {
+            throw std::runtime_error("write failed");
+        }
+
+        // Keep the original mtime so restore can bring it back, and have
+        // the archive on disk before its name is
+        fs::last_write_time(partial, fs::last_write_time(fileInfo.path));
+        if (!FileMover::syncFile(partial)) {
+            throw std::runtime_error("cannot sync " + partial.string());
+        }
+
+        // Publish without replacing: an archive that took the name since it
+        // was chosen moves this one on to the next collision name
+        std::string archivePath;
+        std::error_code renameError;
+        for (int attempt = 0; ; ++attempt) {
+            archivePath = makeArchivePath(coldDirectory, fileInfo.name, attempt);
+            FileMover::renameNoReplace(partial, archivePath, renameError);
+            if (renameError != std::errc::file_exists || attempt >= MAX_COLLISION_RENAMES) {
+                break;
+            }
+        }
+        if (renameError) {
+            throw fs::filesystem_error("rename", partial, archivePath, renameError);
+        }
+        partial.clear();
+
+        // The original goes only once the archive's name is durable too
+        if (!FileMover::syncDirectory(coldDirectory)) {
+            throw std::runtime_error("cannot sync " + COLD_DIRECTORY + "/; original kept");
+        }
+        fs::remove(fileInfo.path);
+
+        logger_.fileRecord(LogLevel::SUCCESS, "Archived: " + fileInfo.name + " → " +
+                           COLD_DIRECTORY + "/" + fs::path(archivePath).filename().string() + " (" +
+                           std::to_string(fileInfo.sizeBytes) + " -> " +
+                           std::to_string(bytesOut) + " bytes)",
+                           fileInfo.path, archivePath);
+        return { ArchiveResult::Status::ARCHIVED, bytesOut, archivePath };
+
+    } catch (const std::exception& e) {
+        logger_.error("Failed to archive: " + fileInfo.name + " - " + e.what());
+        if (!partial.empty()) {
+            std::error_code ec;
+            fs::remove(partial, ec);
+        }
+        return { ArchiveResult::Status::FAILED, 0 };
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Compress File Into Output Stream
+// Returns the number of compressed bytes written
+//------------------------------------------------------------------------------
+long long ColdStorage::compressToStream(const FileInfo& fileInfo, std::ostream& output,
+                                        bool splitAcrossPool) {
+#ifdef SMARTCLEANER_WITH_ZSTD
+    long long bytesOut = 0;
+
+    if (!splitAcrossPool) {
+        std::string frame = compressFrame(readRange(fileInfo.path, 0, fileInfo.sizeBytes),
+                                          COLD_COMPRESSION_LEVEL);
+        output.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        return static_cast<long long>(frame.size());
+    }
+
+    // Two chunks per worker keeps every worker busy; each chunk in flight holds
+    // its input and its frame, and together they stay inside the memory budget
+    const std::size_t budgetChunks = static_cast<std::size_t>(
+        ResourceLimits::workingMemoryBytes() / (2 * COLD_CHUNK_SIZE_BYTES));
+    const std::size_t window = std::max<std::size_t>(
+        1, std::min(pool_.getThreadCount() * 2, budgetChunks));
+    std::deque<std::future<std::string>> inFlight;
+    long long offset = 0;
+
+    auto drainOne = [&]() {
+        std::string frame = inFlight.front().get();
+        inFlight.pop_front();
+        output.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+        bytesOut += static_cast<long long>(frame.size());
+    };
+
+    while (offset < fileInfo.sizeBytes) {
+        long long length = std::min(COLD_CHUNK_SIZE_BYTES, fileInfo.sizeBytes - offset);
+        fs::path path = fileInfo.path;
+        inFlight.push_back(pool_.submit([path, offset, length]() {
+            return compressFrame(readRange(path, offset, length), COLD_COMPRESSION_LEVEL);
+        }));
+        offset += length;
+
+        if (inFlight.size() >= window) {
+            drainOne();
+        }
+    }
+
+    while (!inFlight.empty()) {
+        drainOne();
+    }
+
+    return bytesOut;
+#else
+    (void)fileInfo;
+    (void)output;
+    (void)splitAcrossPool;
+    return 0;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Helper: Choose Archive Path
+// Mirrors FileMover's collision handling with a timestamp suffix, numbered
+// past the first alternative; the caller learns a name is taken from the
+// no-replace rename, not from an existence check
+//------------------------------------------------------------------------------
+std::string ColdStorage::makeArchivePath(const std::string& coldDirectory,
+                                         const std::string& fileName,
+                                         int attempt) const {
+    if (attempt == 0) {
+        return coldDirectory + "/" + fileName + COLD_FILE_EXTENSION;
+    }
+
+    fs::path filePath(fileName);
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    std::tm tm_buf;
+
+#ifdef _WIN32
+    localtime_s(&tm_buf, &time_t);
+#else
+    localtime_r(&time_t, &tm_buf);
+#endif
+
+    std::ostringstream oss;
+    oss << std::put_time(&tm_buf, "%Y%m%d_%H%M%S");
+    if (attempt > 1) {
+        oss << "_" << attempt;
+    }
+
+    std::string newFileName = filePath.stem().string() + "_" + oss.str() +
+                              filePath.extension().string();
+    logger_.warning("Archive collision detected: " + fileName +
+                    " archived as: " + newFileName);
+
+    return coldDirectory + "/" + newFileName + COLD_FILE_EXTENSION;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,87 @@
+//==============================================================================
+// ColdStorage.h - Cold-Tier Compression Interface
+//==============================================================================
+
+#ifndef COLD_STORAGE_H
+#define COLD_STORAGE_H
+
+#include "FileMover.h"
+#include "FileScanner.h"
+#include "ThreadPool.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ProgressReporter;
+
+//------------------------------------------------------------------------------
+// ColdStorage Class
+// Compresses old files into the Cold/ directory and restores them on demand.
+// Requires building with SMARTCLEANER_WITH_ZSTD and linking libzstd.
+//------------------------------------------------------------------------------
+class ColdStorage {
+public:
+    // Constructors (0 threads = hardware concurrency)
+    ColdStorage(Logger& logger, bool dryRun = false, std::size_t threadCount = 0);
+    ColdStorage(Logger& logger, ThreadPool& pool, bool dryRun = false); // Shares a warm pool
+
+    // Whether zstd support was compiled in
+    static bool isAvailable();
+
+    // Main archiving method
+    bool archiveFiles(const std::string& baseDirectory, const std::vector<FileInfo>& files);
+
+    // Restore an archive back into targetDirectory under its original name
+    bool restoreFile(const std::string& archivePath, const std::string& targetDirectory);
+
+    // Get archiving results
+    const std::vector<FileInfo>& getArchivedFiles() const;
+    const std::vector<MovedFile>& getArchiveJournal() const;   // Original -> archive (empty in dry-run)
+    int getSkippedCount() const;
+    int getFailCount() const;
+    long long getBytesIn() const;
+    long long getBytesOut() const;
+
+    // Configuration setters
+    void setProgressReporter(ProgressReporter* progress);
+
+private:
+    // Outcome of archiving a single file
+    struct ArchiveResult {
+        enum class Status { ARCHIVED, SKIPPED, FAILED } status;
+        long long bytesOut;
+        std::string archivePath = {};       // Set once an archive was written
+    };
+
+    Logger& logger_;                        // Reference to logger
+    ProgressReporter* progress_;            // Optional progress sink
+    bool dryRun_;                           // Dry-run mode flag
+    std::unique_ptr<ThreadPool> ownedPool_; // Set when no pool was supplied
+    ThreadPool& pool_;                      // Compression workers
+
+    // Operation results
+    std::vector<FileInfo> archivedFiles_;   // Files replaced by an archive
+    std::vector<MovedFile> archiveJournal_; // Where each of them went
+    int skippedCount_;                      // Incompressible files left in place
+    int failCount_;                         // Failed operations
+    long long bytesIn_;                     // Uncompressed bytes archived
+    long long bytesOut_;                    // Compressed bytes written
+
+    // Helper methods
+    double estimateRatio(const FileInfo& fileInfo) const;
+    ArchiveResult archiveFile(const FileInfo& fileInfo, const std::string& coldDirectory,
+                              bool splitAcrossPool);
+    long long compressToStream(const FileInfo& fileInfo, std::ostream& output,
+                               bool splitAcrossPool);
+    std::string makeArchivePath(const std::string& coldDirectory,
+                                const std::string& fileName,
+                                int attempt) const;     // 0 for the plain name
+};
+
+} // namespace DesktopCleaner
+
+#endif // COLD_STORAGE_H
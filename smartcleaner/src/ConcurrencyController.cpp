@@ -0,0 +1,163 @@
+//==============================================================================
+// ConcurrencyController.cpp - Per-Device Adaptive I/O Concurrency Implementation
+//==============================================================================
+
+#include "ConcurrencyController.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ConcurrencyController::ConcurrencyController(Logger& logger)
+    : logger_(logger),
+      pool_(CONCURRENCY_INITIAL_LIMIT) {
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+std::size_t ConcurrencyController::getLimit(std::uint64_t device) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = windows_.find(device);
+    return found == windows_.end() ? CONCURRENCY_INITIAL_LIMIT
+                                   : static_cast<std::size_t>(found->second.limit);
+}
+
+std::vector<DeviceWindowStats> ConcurrencyController::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<DeviceWindowStats> stats;
+    for (const auto& [device, window] : windows_) {
+        stats.push_back(statsOf(device, window));
+    }
+    return stats;
+}
+
+void ConcurrencyController::logSummary() const {
+    for (const auto& device : getStats()) {
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(1)
+             << "I/O concurrency on device " << device.device << ": " << device.limit
+             << " in flight (peak " << device.peakLimit << ", " << device.decreases
+             << " decreases), " << device.latencyMicros << " us/call vs "
+             << device.baselineMicros << " us baseline, " << std::setprecision(0)
+             << device.callsPerSecond << " calls/s over " << device.calls << " calls";
+        logger_.info(line.str());
+    }
+}
+
+std::uint64_t ConcurrencyController::deviceOf(const std::filesystem::path& path) {
+#ifndef _WIN32
+    struct stat status;
+    if (::stat(path.c_str(), &status) == 0) {
+        return static_cast<std::uint64_t>(status.st_dev);
+    }
+#else
+    (void)path;
+#endif
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Wait for a Slot
+//------------------------------------------------------------------------------
+void ConcurrencyController::acquire(std::uint64_t device) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto [found, created] = windows_.try_emplace(device);
+    Window& window = found->second;
+    if (created) {
+        window.limit = CONCURRENCY_INITIAL_LIMIT;
+        window.peakLimit = CONCURRENCY_INITIAL_LIMIT;
+        window.started = std::chrono::steady_clock::now();
+    } else if (window.inFlight == 0 && window.completions == 0) {
+        // Idle time between batches of work is not the device's throughput
+        window.started = std::chrono::steady_clock::now();
+    }
+
+    released_.wait(lock, [&window]() {
+        return window.inFlight < static_cast<std::size_t>(window.limit);
+    });
+    window.inFlight++;
+
+    // Every admitted call needs a worker, or the limit is never reached
+    std::size_t inFlight = 0;
+    for (const auto& [id, each] : windows_) {
+        inFlight += each.inFlight;
+    }
+    if (inFlight > pool_.getThreadCount()) {
+        pool_.resize(inFlight);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Return a Slot and Adjust the Limit
+// Latency alone would also punish the extra work a larger limit admits, so a
+// latency rise only counts as queueing when throughput did not rise with it
+//------------------------------------------------------------------------------
+void ConcurrencyController::release(std::uint64_t device, std::size_t calls,
+                                    std::chrono::nanoseconds elapsed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Window& window = windows_[device];
+        window.inFlight--;
+        window.completions++;
+        window.calls += std::max<std::size_t>(calls, 1);
+        window.busyNanos += static_cast<double>(elapsed.count());
+
+        if (window.completions >= static_cast<std::size_t>(window.limit)) {
+            auto now = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(now - window.started).count();
+            double latency = window.busyNanos / static_cast<double>(window.calls);
+            double throughput = seconds > 0 ? static_cast<double>(window.calls) / seconds : 0;
+
+            // The baseline drifts up a little each window so it can follow the device
+            window.baselineNanos = window.baselineNanos == 0
+                ? latency
+                : std::min(latency, window.baselineNanos * (1.0 + CONCURRENCY_BASELINE_DRIFT));
+
+            bool inflated = latency > window.baselineNanos * CONCURRENCY_LATENCY_INFLATION;
+            bool gained = throughput > window.lastCallsPerSecond * (1.0 + CONCURRENCY_THROUGHPUT_GAIN);
+            if (inflated && !gained) {
+                window.limit = std::max(1.0, std::floor(window.limit * CONCURRENCY_DECREASE_FACTOR));
+                window.decreases++;
+            } else {
+                window.limit = std::min(static_cast<double>(CONCURRENCY_MAX_LIMIT), window.limit + 1.0);
+            }
+            window.peakLimit = std::max(window.peakLimit, static_cast<std::size_t>(window.limit));
+
+            window.lastLatencyNanos = latency;
+            window.lastCallsPerSecond = throughput;
+            window.totalCalls += window.calls;
+            window.completions = 0;
+            window.calls = 0;
+            window.busyNanos = 0;
+            window.started = now;
+        }
+    }
+    released_.notify_all();
+}
+
+DeviceWindowStats ConcurrencyController::statsOf(std::uint64_t device, const Window& window) {
+    DeviceWindowStats stats;
+    stats.device = device;
+    stats.limit = static_cast<std::size_t>(window.limit);
+    stats.peakLimit = window.peakLimit;
+    stats.baselineMicros = window.baselineNanos / 1000.0;
+    stats.latencyMicros = window.lastLatencyNanos / 1000.0;
+    stats.callsPerSecond = window.lastCallsPerSecond;
+    stats.calls = window.totalCalls + window.calls;
+    stats.decreases = window.decreases;
+    return stats;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,139 @@
+//==============================================================================
+// ConcurrencyController.h - Per-Device Adaptive I/O Concurrency Interface
+//==============================================================================
+
+#ifndef CONCURRENCY_CONTROLLER_H
+#define CONCURRENCY_CONTROLLER_H
+
+#include "ThreadPool.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+
+//------------------------------------------------------------------------------
+// DeviceWindowStats Structure
+//------------------------------------------------------------------------------
+struct DeviceWindowStats {
+    std::uint64_t device;           // st_dev
+    std::size_t limit;              // Current in-flight limit
+    std::size_t peakLimit;          // Highest limit reached
+    double baselineMicros;          // Lowest per-call latency seen (slowly forgotten)
+    double latencyMicros;           // Per-call latency of the last window
+    double callsPerSecond;          // Throughput of the last window
+    std::uint64_t calls;            // Filesystem calls completed
+    std::size_t decreases;          // Multiplicative decreases applied
+};
+
+//------------------------------------------------------------------------------
+// ConcurrencyController Class
+// Blocking filesystem calls (stat, rename) go through here so each device
+// gets the number in flight it can absorb: about 1-2 for a disk, dozens for
+// NVMe or NFS. Every window of `limit` completions the limit grows by one,
+// unless per-call latency rose past CONCURRENCY_LATENCY_INFLATION times the
+// baseline without a matching gain in throughput - then it is cut by
+// CONCURRENCY_DECREASE_FACTOR. The I/O pool grows to the largest limit.
+//------------------------------------------------------------------------------
+class ConcurrencyController {
+public:
+    // Constructor
+    explicit ConcurrencyController(Logger& logger);
+
+    // Prevent copying
+    ConcurrencyController(const ConcurrencyController&) = delete;
+    ConcurrencyController& operator=(const ConcurrencyController&) = delete;
+
+    // Run func on the I/O pool once device has a free slot; func makes `calls`
+    // filesystem calls, so its duration is measured per call. Blocks the caller
+    // while the device is at its limit, so never call from an I/O task.
+    template <typename Func>
+    auto submit(std::uint64_t device, std::size_t calls, Func&& func)
+        -> std::future<decltype(func())>;
+
+    template <typename Result>
+    void waitFor(const std::future<Result>& future);
+
+    // Status methods
+    std::size_t getLimit(std::uint64_t device) const;
+    std::vector<DeviceWindowStats> getStats() const;
+    void logSummary() const;
+
+    // Device a path lives on (0 when unknown)
+    static std::uint64_t deviceOf(const std::filesystem::path& path);
+
+private:
+    //--------------------------------------------------------------------------
+    // Window Structure
+    //--------------------------------------------------------------------------
+    struct Window {
+        double limit;                                   // Fractional between increases
+        std::size_t inFlight = 0;
+        std::size_t peakLimit = 0;
+        double baselineNanos = 0;                       // 0 until the first window closes
+        double lastLatencyNanos = 0;
+        double lastCallsPerSecond = 0;
+        std::uint64_t totalCalls = 0;
+        std::size_t decreases = 0;
+
+        // Current sample
+        std::size_t completions = 0;
+        std::uint64_t calls = 0;
+        double busyNanos = 0;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    Logger& logger_;                                    // Reference to logger
+    mutable std::mutex mutex_;                          // Guards windows_
+    std::condition_variable released_;                  // A slot was freed
+    std::map<std::uint64_t, Window> windows_;           // Keyed by st_dev
+    ThreadPool pool_;                                   // I/O workers
+
+    // Helper methods
+    void acquire(std::uint64_t device);
+    void release(std::uint64_t device, std::size_t calls, std::chrono::nanoseconds elapsed);
+    static DeviceWindowStats statsOf(std::uint64_t device, const Window& window);
+};
+
+//------------------------------------------------------------------------------
+// Submit Task
+// The slot is released even when func throws; the exception reaches the future
+//------------------------------------------------------------------------------
+template <typename Func>
+auto ConcurrencyController::submit(std::uint64_t device, std::size_t calls, Func&& func)
+    -> std::future<decltype(func())> {
+    acquire(device);
+
+    struct Release {
+        ConcurrencyController* owner;
+        std::uint64_t device;
+        std::size_t calls;
+        std::chrono::steady_clock::time_point started;
+        ~Release() {
+            owner->release(device, calls, std::chrono::steady_clock::now() - started);
+        }
+    };
+
+    return pool_.submit([this, device, calls, task = std::forward<Func>(func)]() mutable {
+        Release release{ this, device, calls, std::chrono::steady_clock::now() };
+        return task();
+    });
+}
+
+template <typename Result>
+void ConcurrencyController::waitFor(const std::future<Result>& future) {
+    pool_.waitFor(future);
+}
+
+} // namespace DesktopCleaner
+
+#endif // CONCURRENCY_CONTROLLER_H
@@ -8,6 +8,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace DesktopCleaner {
@@ -24,12 +25,221 @@ const std::string APP_VERSION = "1.0";
 const long long DEFAULT_LARGE_FILE_SIZE_MB = 100;     // Files larger than 100MB
 const int DEFAULT_OLD_FILE_AGE_DAYS = 90;             // Files older than 90 days
 const bool DEFAULT_DRY_RUN = false;                   // Actual move operations
+const int MAX_COLLISION_RENAMES = 100;                // Alternative names tried per moved file
 
 //------------------------------------------------------------------------------
 // Logging Configuration
 //------------------------------------------------------------------------------
 const std::string LOG_DIRECTORY = "logs";
 const std::string LOG_FILE_PREFIX = "cleaner_";
+const std::string LOG_INDEX_EXTENSION = ".idx";       // Sidecar: path hash -> record offset
+const std::size_t LOG_INDEX_SEGMENT_ENTRIES = 65536;  // Entries held before a segment is written
+const std::size_t WHEREIS_MAX_RUNS = 100;             // Most recent runs --whereis searches
+
+//------------------------------------------------------------------------------
+// Cold-Tier Configuration
+// Old files are compressed into COLD_DIRECTORY as zstd streams
+//------------------------------------------------------------------------------
+const std::string COLD_DIRECTORY = "Cold";
+const std::string COLD_FILE_EXTENSION = ".zst";
+const int COLD_COMPRESSION_LEVEL = 3;                 // zstd level for archived data
+const long long COLD_CHUNK_SIZE_BYTES = 8LL << 20;    // Files above this are split across threads
+const long long COLD_SAMPLE_BLOCK_BYTES = 64LL << 10; // Size of each compressibility sample
+const int COLD_SAMPLE_BLOCK_COUNT = 4;                // Samples spread evenly over the file
+const double COLD_MAX_SAMPLE_RATIO = 0.90;            // Skip files whose samples shrink less than 10%
+
+//------------------------------------------------------------------------------
+// Daemon / Shared-Memory Index Configuration
+// The daemon re-indexes every interval and publishes into a POSIX shm segment
+// named after the watched directory, so daemons on different folders coexist
+//------------------------------------------------------------------------------
+const std::string SHM_NAME_PREFIX = "/smartcleaner_"; // Followed by the directory's path hash
+const int DEFAULT_DAEMON_INTERVAL_SECONDS = 60;       // Time between re-index passes
+const int SHM_MAX_CATEGORIES = 16;                    // Category names stored in the header
+const int SHM_CATEGORY_NAME_BYTES = 32;               // Including the terminating NUL
+const int SHM_READ_RETRY_LIMIT = 10000;               // Seqlock retries before a lookup gives up
+
+//------------------------------------------------------------------------------
+// Job Service Configuration
+// Clients submit jobs to the daemon over a Unix socket
+//------------------------------------------------------------------------------
+const std::string SOCKET_FILE_NAME = "smartcleaner.sock";          // In $XDG_RUNTIME_DIR ...
+const std::string SYSTEM_SOCKET_DIRECTORY = "/run/smartcleaner";  // ... or here for a root service
+const int DEFAULT_JOB_PRIORITY = 5;                   // 0 (background) .. MAX_JOB_PRIORITY
+const int MAX_JOB_PRIORITY = 9;
+const int SERVICE_SCAN_CACHE_SECONDS = 30;            // Scan results reused this long
+const std::size_t SERVICE_SCAN_CACHE_MAX_ENTRIES = 64;
+const int SERVICE_REQUEST_TIMEOUT_SECONDS = 5;        // Time a client has to send its whole request
+const std::size_t SERVICE_MAX_PENDING_REQUESTS = 64;  // Connections still sending their request
+
+//------------------------------------------------------------------------------
+// C API Sessions
+//------------------------------------------------------------------------------
+const int API_SCAN_REUSE_SECONDS = 30;                // sc_organize / sc_archive_old reuse a scan this recent
+const std::size_t SERVICE_MAX_LISTED_COPIES = 100;    // Duplicate paths returned by a dedupe job
+
+//------------------------------------------------------------------------------
+// Trace Capture Configuration
+//------------------------------------------------------------------------------
+const std::size_t TRACE_FLUSH_RECORDS = 4096;         // Records buffered per write
+
+//------------------------------------------------------------------------------
+// Near-Duplicate Configuration
+// Superseded versions are moved into NEAR_DUPLICATES_DIRECTORY when resolving
+//------------------------------------------------------------------------------
+const std::string NEAR_DUPLICATES_DIRECTORY = "Near Duplicates";
+const double NEAR_DUPE_SIZE_TOLERANCE = 0.25;         // Max relative size gap inside a cluster
+const long long NEAR_DUPE_SIZE_SLACK_BYTES = 4096;    // Absolute gap always allowed (small files)
+const long long NEAR_DUPE_PREFIX_BYTES = 64LL << 10;  // Bytes compared by content refinement
+const std::size_t NEAR_DUPE_MAX_LISTED = 10;          // Clusters printed to the console
+
+//------------------------------------------------------------------------------
+// Content-Defined Chunking Configuration
+// FastCDC-style cut points with normalized chunking around the average size
+//------------------------------------------------------------------------------
+const std::size_t CDC_MIN_CHUNK_BYTES = 16 << 10;     // No cut before this
+const std::size_t CDC_AVG_CHUNK_BYTES = 64 << 10;     // Power of two; strict mask below, loose above
+const std::size_t CDC_MAX_CHUNK_BYTES = 256 << 10;    // Forced cut
+const std::size_t CDC_SEGMENT_BYTES = 8 << 20;        // Bytes scanned per worker task
+const std::size_t CDC_MAX_PAIR_FANOUT = 16;           // Chunks in more files are too common to pair
+const std::size_t CDC_MAX_LISTED_PAIRS = 10;          // File pairs printed to the console
+
+//------------------------------------------------------------------------------
+// Perceptual Image Hash Configuration
+// 64-bit dHash; images within the distance are treated as the same picture
+//------------------------------------------------------------------------------
+const int PHASH_DEFAULT_MAX_DISTANCE = 8;             // Differing bits still counted as similar
+const int PHASH_MAX_DISTANCE_LIMIT = 32;              // Beyond this matches are noise
+const std::size_t PHASH_MAX_LISTED = 10;              // Groups printed to the console
+
+//------------------------------------------------------------------------------
+// Time-Budget Configuration
+// --time-budget runs stop before the deadline and leave this state file
+//------------------------------------------------------------------------------
+const std::string PLAN_STATE_FILE = ".smartcleaner_plan";
+const int MAX_TIME_BUDGET_MINUTES = 7 * 24 * 60;      // One week
+
+//------------------------------------------------------------------------------
+// File Copy Configuration
+// Used when a move crosses devices and rename() cannot be used
+//------------------------------------------------------------------------------
+const std::size_t COPY_BUFFER_BYTES = 1024 * 1024;    // Per pread/pwrite call
+
+//------------------------------------------------------------------------------
+// Resource Limit Configuration
+// Auto-sized pools and buffers follow the cgroup limits, not the host
+//------------------------------------------------------------------------------
+const std::string CGROUP_MOUNT_POINT = "/sys/fs/cgroup";
+const double WORKING_MEMORY_FRACTION = 0.25;          // Share of the memory limit for in-flight buffers
+const long long DEFAULT_WORKING_MEMORY_BYTES = 1LL << 30; // When no limit can be read
+
+//------------------------------------------------------------------------------
+// Adaptive I/O Concurrency Configuration
+// Stats and renames in flight per device, adjusted by additive increase and
+// multiplicative decrease on latency inflation
+//------------------------------------------------------------------------------
+const std::size_t CONCURRENCY_INITIAL_LIMIT = 4;      // In flight before any measurement
+const std::size_t CONCURRENCY_MAX_LIMIT = 128;        // Per device
+const double CONCURRENCY_LATENCY_INFLATION = 2.0;     // Latency over baseline that means queueing
+const double CONCURRENCY_DECREASE_FACTOR = 0.5;       // Limit kept after inflation
+const double CONCURRENCY_THROUGHPUT_GAIN = 0.05;      // Throughput rise that excuses inflation
+const double CONCURRENCY_BASELINE_DRIFT = 0.01;       // Per window, so old minima fade
+const std::size_t SCAN_STAT_BATCH = 32;               // Files stat'ed per scanner task
+
+//------------------------------------------------------------------------------
+// Classifier Plugin Configuration
+//------------------------------------------------------------------------------
+const std::size_t PLUGIN_BATCH_FILES = 4096;          // Files per plugin call (one pool task)
+
+//------------------------------------------------------------------------------
+// Keyword Sub-Classification Configuration
+// --keywords reads the start of text-like documents and moves those naming a
+// rule's keyword into that rule's folder. Rules are tried in order, so the
+// first matching rule wins. PDFs are read raw: uncompressed metadata and
+// text streams match, Flate-compressed page content does not.
+//------------------------------------------------------------------------------
+const std::size_t KEYWORD_PREFIX_BYTES = 8 * 1024;    // Read from the start of each file
+const std::size_t KEYWORD_BATCH_FILES = 64;           // Files read per pool task
+const std::unordered_set<std::string> KEYWORD_TEXT_EXTENSIONS = {
+    ".txt", ".csv", ".pdf", ".rtf"
+};
+
+inline std::vector<std::pair<std::string, std::vector<std::string>>> getDefaultKeywordRules() {
+    return {
+        { "Payslips",  { "payslip", "pay slip", "salary statement", "gross pay", "net pay" } },
+        { "Invoices",  { "invoice", "amount due", "bill to", "payment terms", "vat no" } },
+        { "Contracts", { "agreement", "contract", "hereinafter", "the parties", "terms and conditions" } }
+    };
+}
+
+//------------------------------------------------------------------------------
+// Persistent Index Configuration
+// --index keeps an LSM-style index of the organized directory: immutable
+// sorted segments, merged in the background once enough small ones pile up
+//------------------------------------------------------------------------------
+const std::string INDEX_DIRECTORY = ".smartcleaner_index";
+const std::string INDEX_MANIFEST_FILE = "MANIFEST";   // Live segments, oldest first
+const std::string INDEX_LOCK_FILE = "LOCK";           // flock()ed by the one writer
+const int INDEX_OPEN_ATTEMPTS = 5;                    // Read-only opens racing a compaction
+const std::size_t INDEX_BLOOM_BITS_PER_KEY = 10;      // ~1% false positives with 7 hashes
+const int INDEX_BLOOM_HASHES = 7;
+const std::size_t INDEX_SPARSE_INTERVAL = 32;         // Records per sparse-index block
+const std::size_t INDEX_COMPACT_FANIN = 4;            // Fewest segments merged at once
+
+//------------------------------------------------------------------------------
+// Live Statistics Configuration
+// --watch keeps per-category, per-subtree, size and age totals current from
+// filesystem events; a timer wheel moves files into older age buckets
+//------------------------------------------------------------------------------
+const std::vector<long long> STATS_SIZE_BUCKET_BYTES = {       // Upper bounds; one more bucket above
+    64LL * 1024, 1024LL * 1024, 16LL * 1024 * 1024, 256LL * 1024 * 1024, 4096LL * 1024 * 1024
+};
+const std::vector<int> STATS_AGE_BUCKET_DAYS = { 1, 7, 30, 90, 365 };  // Upper bounds, as above
+const int STATS_WHEEL_TICK_SECONDS = 60;              // Age rollover granularity
+const std::size_t STATS_WHEEL_SLOTS = 1440;           // One revolution per day at 60 s ticks
+const std::size_t STATS_MAX_LISTED_SUBTREES = 20;     // Largest subtrees in a stats reply
+const int WATCH_POLL_MILLISECONDS = 100;              // Also bounds signal latency
+
+//------------------------------------------------------------------------------
+// Cache Directory Detection Configuration
+// --caches finds rebuildable directories below DIRECTORY by name and marker
+// files and sizes them in parallel; they are reported, never moved
+//------------------------------------------------------------------------------
+const int CACHE_SEARCH_MAX_DEPTH = 8;                 // Levels below DIRECTORY searched for caches
+const int CACHE_PARALLEL_DEPTH = 2;                   // Levels inside a cache sized as separate tasks
+const std::size_t CACHE_MAX_LISTED = 15;
+const std::string CACHE_ANY_NAME = "*";               // Rule matching any directory with its marker
+
+// Directory name -> markers, any of which must exist: "X" inside the
+// directory, "../X" beside it; no markers means the name is enough
+inline std::vector<std::pair<std::string, std::vector<std::string>>> getCacheDirectoryRules() {
+    return {
+        { "node_modules",  {} },
+        { "__pycache__",   {} },
+        { ".pytest_cache", {} },
+        { ".mypy_cache",   {} },
+        { ".tox",          {} },
+        { ".gradle",       {} },
+        { ".venv",         { "pyvenv.cfg" } },
+        { "venv",          { "pyvenv.cfg" } },
+        { "target",        { "CACHEDIR.TAG", "../Cargo.toml", "../pom.xml" } },
+        { "build",         { "CMakeCache.txt", "../CMakeLists.txt", "../build.gradle", "../build.gradle.kts" } },
+        { "Cache",         { "Cache_Data" } },            // Chromium-based browsers
+        { "Code Cache",    {} },
+        { "GPUCache",      {} },
+        { "cache2",        { "entries" } },               // Firefox
+        { CACHE_ANY_NAME,  { "CACHEDIR.TAG" } }           // Cache Directory Tagging convention
+    };
+}
+
+//------------------------------------------------------------------------------
+// Unknown Extension Report Configuration
+// --unknown-report keeps a constant-size sketch of the extensions that fall
+// to Others, saved in DIRECTORY and mergeable across runs and hosts
+//------------------------------------------------------------------------------
+const std::string UNKNOWN_SKETCH_FILE = ".smartcleaner_unknown";
+const std::size_t UNKNOWN_SKETCH_CAPACITY = 256;      // Counters per weight; error <= total / 256
+const std::size_t UNKNOWN_MAX_LISTED = 10;
 
 //------------------------------------------------------------------------------
 // File Category Definitions
@@ -132,6 +342,7 @@ inline std::unordered_map<std::string, std::string> buildExtensionMap() {
 //------------------------------------------------------------------------------
 const std::string CONSOLE_SEPARATOR = "========================================";
 const int CONSOLE_WIDTH = 40;
+const int DEFAULT_PROGRESS_REDRAWS_PER_SECOND = 4;    // Status line refresh cap
 
 } // namespace DesktopCleaner
 
@@ -0,0 +1,468 @@
+//==============================================================================
+// ContentHash.cpp - 64-bit Content and Path Hashing Implementation
+//==============================================================================
+
+#include "ContentHash.h"
+#include "ThreadPool.h"
+#include "ResourceLimits.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+const std::uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+const std::size_t FILE_READ_BUFFER_BYTES = 1 << 20;
+
+const std::size_t TREE_LEAF_BYTES = 1 << 20;
+const std::size_t TREE_MAX_PENDING_LEAVES = 16;     // Leaves buffered while the pool catches up
+const std::uint64_t TREE_PARENT_SEED = 0x706172656E74ULL;   // "parent"
+const std::uint64_t TREE_ROOT_SEED = 0x726F6F74ULL;         // "root"
+const std::size_t DIRECT_IO_ALIGNMENT = 4096;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t read64(const unsigned char* p) {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value; // Little-endian hosts only, like the rest of the on-disk formats
+}
+
+inline std::uint32_t read32(const unsigned char* p) {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t mixRound(std::uint64_t accumulator, std::uint64_t input) {
+    accumulator += input * PRIME2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * PRIME1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t hash, std::uint64_t accumulator) {
+    hash ^= mixRound(0, accumulator);
+    return hash * PRIME1 + PRIME4;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ContentHasher::ContentHasher(std::uint64_t seed)
+    : accumulators_{ seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 },
+      buffer_{},
+      bufferedBytes_(0),
+      totalLength_(0),
+      seed_(seed) {
+}
+
+//------------------------------------------------------------------------------
+// Streaming Update
+//------------------------------------------------------------------------------
+void ContentHasher::update(const void* data, std::size_t length) {
+    const auto* input = static_cast<const unsigned char*>(data);
+    totalLength_ += length;
+
+    // Top up a partial stripe first
+    if (bufferedBytes_ > 0) {
+        std::size_t take = std::min(length, sizeof(buffer_) - bufferedBytes_);
+        std::memcpy(buffer_ + bufferedBytes_, input, take);
+        bufferedBytes_ += take;
+        input += take;
+        length -= take;
+
+        if (bufferedBytes_ < sizeof(buffer_)) {
+            return;
+        }
+        for (int lane = 0; lane < 4; ++lane) {
+            accumulators_[lane] = mixRound(accumulators_[lane], read64(buffer_ + lane * 8));
+        }
+        bufferedBytes_ = 0;
+    }
+
+    // Whole stripes straight from the input
+    while (length >= 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            accumulators_[lane] = mixRound(accumulators_[lane], read64(input + lane * 8));
+        }
+        input += 32;
+        length -= 32;
+    }
+
+    std::memcpy(buffer_, input, length);
+    bufferedBytes_ = length;
+}
+
+//------------------------------------------------------------------------------
+// Digest
+//------------------------------------------------------------------------------
+std::uint64_t ContentHasher::digest() const {
+    std::uint64_t hash;
+
+    if (totalLength_ >= 32) {
+        hash = rotateLeft(accumulators_[0], 1) + rotateLeft(accumulators_[1], 7) +
+               rotateLeft(accumulators_[2], 12) + rotateLeft(accumulators_[3], 18);
+        for (int lane = 0; lane < 4; ++lane) {
+            hash = mergeRound(hash, accumulators_[lane]);
+        }
+    } else {
+        hash = seed_ + PRIME5;
+    }
+    hash += totalLength_;
+
+    const unsigned char* p = buffer_;
+    std::size_t remaining = bufferedBytes_;
+    while (remaining >= 8) {
+        hash ^= mixRound(0, read64(p));
+        hash = rotateLeft(hash, 27) * PRIME1 + PRIME4;
+        p += 8;
+        remaining -= 8;
+    }
+    if (remaining >= 4) {
+        hash ^= static_cast<std::uint64_t>(read32(p)) * PRIME1;
+        hash = rotateLeft(hash, 23) * PRIME2 + PRIME3;
+        p += 4;
+        remaining -= 4;
+    }
+    while (remaining > 0) {
+        hash ^= (*p) * PRIME5;
+        hash = rotateLeft(hash, 11) * PRIME1;
+        p++;
+        remaining--;
+    }
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// One-Shot Helpers
+//------------------------------------------------------------------------------
+std::uint64_t ContentHasher::hashBytes(const void* data, std::size_t length, std::uint64_t seed) {
+    ContentHasher hasher(seed);
+    hasher.update(data, length);
+    return hasher.digest();
+}
+
+std::uint64_t ContentHasher::hashFile(const fs::path& path) {
+    return hashFilePrefix(path, -1);
+}
+
+std::uint64_t ContentHasher::hashFilePrefix(const fs::path& path, long long maxBytes) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("cannot open for hashing: " + path.string());
+    }
+
+    ContentHasher hasher;
+    std::vector<char> buffer(FILE_READ_BUFFER_BYTES);
+    long long remaining = maxBytes;
+    while (input && remaining != 0) {
+        std::streamsize want = static_cast<std::streamsize>(buffer.size());
+        if (remaining > 0 && remaining < want) {
+            want = static_cast<std::streamsize>(remaining);
+        }
+        input.read(buffer.data(), want);
+        hasher.update(buffer.data(), static_cast<std::size_t>(input.gcount()));
+        if (remaining > 0) {
+            remaining -= input.gcount();
+        }
+    }
+    if (input.bad()) {
+        throw std::runtime_error("read error while hashing: " + path.string());
+    }
+    return hasher.digest();
+}
+
+std::uint64_t ContentHasher::hashPath(const std::string& normalizedPath) {
+    std::uint64_t hash = hashBytes(normalizedPath.data(), normalizedPath.size());
+    return hash != 0 ? hash : 1; // 0 marks an empty slot in lookup tables
+}
+
+std::string ContentHasher::normalizePath(const fs::path& path) {
+    std::error_code ec;
+    fs::path absolute = fs::absolute(path, ec);
+    return (ec ? path : absolute).lexically_normal().string();
+}
+
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Helper: Hash of One All-Zero Leaf
+// Full leaves inside sparse-file holes all share this value
+//------------------------------------------------------------------------------
+std::uint64_t zeroLeafHash() {
+    static const std::uint64_t hash = [] {
+        std::vector<unsigned char> zeros(TREE_LEAF_BYTES, 0);
+        return ContentHasher::hashBytes(zeros.data(), zeros.size());
+    }();
+    return hash;
+}
+
+std::shared_ptr<unsigned char[]> allocateLeaf() {
+    return std::shared_ptr<unsigned char[]>(new unsigned char[TREE_LEAF_BYTES]);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// TreeHasher Constructor
+//------------------------------------------------------------------------------
+TreeHasher::TreeHasher(ThreadPool* pool)
+    : pool_(pool),
+      leaf_(allocateLeaf()),
+      leafFill_(0),
+      leafZero_(true),
+      totalLength_(0),
+      maxPending_(std::max<std::size_t>(1, std::min<std::size_t>(TREE_MAX_PENDING_LEAVES,
+          static_cast<std::size_t>(ResourceLimits::workingMemoryBytes()) / TREE_LEAF_BYTES))) {
+}
+
+//------------------------------------------------------------------------------
+// Streaming Update
+//------------------------------------------------------------------------------
+void TreeHasher::update(const void* data, std::size_t length) {
+    const auto* input = static_cast<const unsigned char*>(data);
+    totalLength_ += length;
+
+    while (length > 0) {
+        std::size_t take = std::min(length, TREE_LEAF_BYTES - leafFill_);
+        std::memcpy(leaf_.get() + leafFill_, input, take);
+        leafFill_ += take;
+        leafZero_ = false;
+        input += take;
+        length -= take;
+        if (leafFill_ == TREE_LEAF_BYTES) {
+            finishLeaf();
+        }
+    }
+}
+
+void TreeHasher::updateZeros(std::uint64_t length) {
+    totalLength_ += length;
+
+    while (length > 0) {
+        if (leafFill_ == 0 && length >= TREE_LEAF_BYTES) {
+            leafHashes_.push_back(zeroLeafHash());
+            length -= TREE_LEAF_BYTES;
+            continue;
+        }
+        std::size_t take = static_cast<std::size_t>(
+            std::min<std::uint64_t>(length, TREE_LEAF_BYTES - leafFill_));
+        std::memset(leaf_.get() + leafFill_, 0, take);
+        leafFill_ += take;
+        length -= take;
+        if (leafFill_ == TREE_LEAF_BYTES) {
+            finishLeaf();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Digest
+//------------------------------------------------------------------------------
+std::uint64_t TreeHasher::digest() {
+    if (leafFill_ > 0) {
+        finishLeaf();
+    }
+    drain(0);
+    return combine(leafHashes_, totalLength_);
+}
+
+//------------------------------------------------------------------------------
+// Hash a Whole File in Parallel Leaves
+//------------------------------------------------------------------------------
+std::uint64_t TreeHasher::hashFile(const fs::path& path, ThreadPool* pool, bool direct) {
+#ifndef _WIN32
+    int fd = -1;
+#ifdef O_DIRECT
+    if (direct) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    }
+#endif
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#ifdef POSIX_FADV_DONTNEED
+        if (fd >= 0 && direct) {
+            // No O_DIRECT on this filesystem (tmpfs, some FUSE): drop cached pages instead
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        }
+#endif
+    }
+    if (fd < 0) {
+        throw std::runtime_error("cannot open for hashing: " + path.string());
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("cannot stat for hashing: " + path.string());
+    }
+    const std::uint64_t size = static_cast<std::uint64_t>(status.st_size);
+    const std::size_t leafCount = static_cast<std::size_t>((size + TREE_LEAF_BYTES - 1) / TREE_LEAF_BYTES);
+
+    // Buffers and offsets stay aligned for O_DIRECT; only the last read is short
+    auto hashLeaf = [fd, size, &path](std::size_t index) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, DIRECT_IO_ALIGNMENT, TREE_LEAF_BYTES) != 0) {
+            throw std::bad_alloc();
+        }
+        std::unique_ptr<void, decltype(&std::free)> buffer(memory, &std::free);
+        auto* bytes = static_cast<unsigned char*>(memory);
+        const std::uint64_t offset = static_cast<std::uint64_t>(index) * TREE_LEAF_BYTES;
+        const std::size_t want = static_cast<std::size_t>(
+            std::min<std::uint64_t>(TREE_LEAF_BYTES, size - offset));
+        std::size_t got = 0;
+        while (got < want) {
+            ssize_t n = ::pread(fd, bytes + got, TREE_LEAF_BYTES - got,
+                                static_cast<off_t>(offset + got));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("read error while hashing: " + path.string());
+            }
+            got += static_cast<std::size_t>(n);
+        }
+        return ContentHasher::hashBytes(bytes, want);
+    };
+
+    std::vector<std::uint64_t> leaves(leafCount);
+    std::exception_ptr failure;
+    if (pool == nullptr) {
+        try {
+            for (std::size_t i = 0; i < leafCount; ++i) {
+                leaves[i] = hashLeaf(i);
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+    } else {
+        std::vector<std::future<std::uint64_t>> futures;
+        futures.reserve(leafCount);
+        for (std::size_t i = 0; i < leafCount; ++i) {
+            futures.push_back(pool->submit([&hashLeaf, i]() { return hashLeaf(i); }));
+        }
+        // Every task must finish before fd is closed, even after a failure
+        for (std::size_t i = 0; i < leafCount; ++i) {
+            pool->waitFor(futures[i]);
+            try {
+                leaves[i] = futures[i].get();
+            } catch (...) {
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+    }
+    ::close(fd);
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return combine(std::move(leaves), size);
+#else
+    (void)direct;
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("cannot open for hashing: " + path.string());
+    }
+    TreeHasher hasher(pool);
+    std::vector<char> buffer(FILE_READ_BUFFER_BYTES);
+    while (input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hasher.update(buffer.data(), static_cast<std::size_t>(input.gcount()));
+    }
+    if (input.bad()) {
+        throw std::runtime_error("read error while hashing: " + path.string());
+    }
+    return hasher.digest();
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Fold Leaves into the Root
+// Pairs are hashed level by level; an odd node moves up unchanged
+//------------------------------------------------------------------------------
+std::uint64_t TreeHasher::combine(std::vector<std::uint64_t> leaves, std::uint64_t totalLength) {
+    while (leaves.size() > 1) {
+        std::size_t parents = 0;
+        for (std::size_t i = 0; i + 1 < leaves.size(); i += 2) {
+            std::uint64_t pair[2] = { leaves[i], leaves[i + 1] };
+            leaves[parents++] = ContentHasher::hashBytes(pair, sizeof(pair), TREE_PARENT_SEED);
+        }
+        if (leaves.size() % 2 == 1) {
+            leaves[parents++] = leaves.back();
+        }
+        leaves.resize(parents);
+    }
+    std::uint64_t root[2] = { leaves.empty() ? 0 : leaves[0], totalLength };
+    return ContentHasher::hashBytes(root, sizeof(root), TREE_ROOT_SEED);
+}
+
+//------------------------------------------------------------------------------
+// Helper: Close the Current Leaf
+// Full zero leaves use the cached hash; others go to the pool with their buffer
+//------------------------------------------------------------------------------
+void TreeHasher::finishLeaf() {
+    std::size_t index = leafHashes_.size();
+    leafHashes_.push_back(0);
+
+    if (leafZero_ && leafFill_ == TREE_LEAF_BYTES) {
+        leafHashes_[index] = zeroLeafHash();
+    } else if (pool_ == nullptr) {
+        leafHashes_[index] = ContentHasher::hashBytes(leaf_.get(), leafFill_);
+    } else {
+        std::shared_ptr<unsigned char[]> buffer = std::move(leaf_);
+        std::size_t length = leafFill_;
+        pending_.emplace_back(index, pool_->submit([buffer, length]() {
+            return ContentHasher::hashBytes(buffer.get(), length);
+        }));
+        leaf_ = allocateLeaf();
+        drain(maxPending_);
+    }
+    leafFill_ = 0;
+    leafZero_ = true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Collect Finished Leaves Until At Most `keep` Are Pending
+//------------------------------------------------------------------------------
+void TreeHasher::drain(std::size_t keep) {
+    while (pending_.size() > keep) {
+        auto& [index, future] = pending_.front();
+        pool_->waitFor(future);
+        leafHashes_[index] = future.get();
+        pending_.pop_front();
+    }
+}
+
+} // namespace DesktopCleaner
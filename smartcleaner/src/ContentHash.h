@@ -0,0 +1,98 @@
+//==============================================================================
+// ContentHash.h - 64-bit Content and Path Hashing Interface
+//==============================================================================
+
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// ContentHasher Class
+// Streaming XXH64: feed data with update(), read the result with digest().
+// Fast enough to hash at disk speed; not a cryptographic hash.
+//------------------------------------------------------------------------------
+class ContentHasher {
+public:
+    // Constructor
+    explicit ContentHasher(std::uint64_t seed = 0);
+
+    // Streaming interface
+    void update(const void* data, std::size_t length);
+    std::uint64_t digest() const;
+
+    // One-shot helpers
+    static std::uint64_t hashBytes(const void* data, std::size_t length, std::uint64_t seed = 0);
+    static std::uint64_t hashFile(const std::filesystem::path& path); // Throws on I/O error
+    static std::uint64_t hashFilePrefix(const std::filesystem::path& path,
+                                        long long maxBytes);           // Negative = whole file
+
+    // Key used for path lookups; callers normalize paths with normalizePath() first
+    static std::uint64_t hashPath(const std::string& normalizedPath);
+    static std::string normalizePath(const std::filesystem::path& path);
+
+private:
+    std::uint64_t accumulators_[4];     // Lane states for 32-byte stripes
+    unsigned char buffer_[32];          // Partial stripe
+    std::size_t bufferedBytes_;         // Bytes waiting in buffer_
+    std::uint64_t totalLength_;         // Bytes fed so far
+    std::uint64_t seed_;                // Seed for short inputs
+};
+
+//------------------------------------------------------------------------------
+// TreeHasher Class
+// BLAKE3-style tree over XXH64: the stream is cut into 1 MB leaves that are
+// hashed independently (on the pool when one is given), then folded pairwise
+// into one root together with the total length. The result does not depend
+// on how the data was fed, so a copy hashed while streaming can be compared
+// with a file re-read in parallel leaves.
+//------------------------------------------------------------------------------
+class TreeHasher {
+public:
+    // Constructor (no pool = hash leaves on the calling thread)
+    explicit TreeHasher(ThreadPool* pool = nullptr);
+
+    // Streaming interface
+    void update(const void* data, std::size_t length);
+    void updateZeros(std::uint64_t length);     // Holes, without a buffer
+    std::uint64_t digest();                     // Ends the stream
+
+    // Hash a whole file, one read per leaf; direct = bypass the page cache
+    // (O_DIRECT where the filesystem allows it). Throws on I/O error.
+    static std::uint64_t hashFile(const std::filesystem::path& path, ThreadPool* pool,
+                                  bool direct);
+
+    // Fold leaf hashes into the root
+    static std::uint64_t combine(std::vector<std::uint64_t> leaves, std::uint64_t totalLength);
+
+private:
+    ThreadPool* pool_;                                  // Optional leaf workers
+    std::shared_ptr<unsigned char[]> leaf_;             // Leaf being filled (shared with its task)
+    std::size_t leafFill_;                              // Bytes in leaf_
+    bool leafZero_;                                     // leaf_ holds only hole bytes
+    std::vector<std::uint64_t> leafHashes_;             // In stream order
+    std::deque<std::pair<std::size_t, std::future<std::uint64_t>>> pending_; // Leaves on the pool
+    std::uint64_t totalLength_;                         // Bytes fed so far
+    std::size_t maxPending_;                            // Leaf buffers on the pool at once
+
+    // Helper methods
+    void finishLeaf();
+    void drain(std::size_t keep);
+};
+
+} // namespace DesktopCleaner
+
+#endif // CONTENT_HASH_H
@@ -0,0 +1,125 @@
+//==============================================================================
+// DirectoryWatcher.cpp - Filesystem Change Notification Implementation
+//==============================================================================
+
+#include "DirectoryWatcher.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace DesktopCleaner {
+
+#ifdef __linux__
+namespace {
+
+// Writes that finish, renames and metadata changes update a file; creation
+// is reported too so an empty file shows up before anything is written
+const uint32_t WATCH_MASK = IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_ATTRIB |
+                            IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF |
+                            IN_ONLYDIR;
+
+} // namespace
+#endif
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+DirectoryWatcher::DirectoryWatcher(Logger& logger)
+    : logger_(logger), fd_(-1), watch_(-1) {
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Start
+//------------------------------------------------------------------------------
+bool DirectoryWatcher::start(const std::string& directory) {
+#ifdef __linux__
+    fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd_ < 0) {
+        logger_.error("Cannot create inotify instance: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    watch_ = inotify_add_watch(fd_, directory.c_str(), WATCH_MASK);
+    if (watch_ < 0) {
+        logger_.error("Cannot watch " + directory + ": " + std::strerror(errno));
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    logger_.info("Watching " + directory + " for changes");
+    return true;
+#else
+    logger_.warning("Watching " + directory + " needs inotify; using periodic scans only");
+    return false;
+#endif
+}
+
+bool DirectoryWatcher::isActive() const {
+    return fd_ >= 0;
+}
+
+//------------------------------------------------------------------------------
+// Poll
+// Drains everything queued once the descriptor is readable
+//------------------------------------------------------------------------------
+bool DirectoryWatcher::poll(int timeoutMs, std::vector<std::string>& names) {
+#ifdef __linux__
+    if (fd_ < 0) {
+        return true;
+    }
+
+    struct pollfd request = { fd_, POLLIN, 0 };
+    if (::poll(&request, 1, timeoutMs) <= 0) {
+        return true;    // Timeout or EINTR from a stop signal
+    }
+
+    bool complete = true;
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    while (true) {
+        ssize_t length = read(fd_, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;      // EAGAIN: queue drained
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                logger_.warning("Change notifications overflowed; events were lost");
+                complete = false;
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                logger_.warning("Watched directory was removed or moved; watching stopped");
+                close(fd_);
+                fd_ = -1;
+                return false;
+            }
+            if ((event->mask & IN_ISDIR) || event->len == 0) {
+                continue;
+            }
+            names.emplace_back(event->name);
+        }
+    }
+    return complete;
+#else
+    (void)timeoutMs;
+    (void)names;
+    return true;
+#endif
+}
+
+} // namespace DesktopCleaner
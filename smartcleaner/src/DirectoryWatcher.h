@@ -0,0 +1,49 @@
+//==============================================================================
+// DirectoryWatcher.h - Filesystem Change Notification Interface
+//==============================================================================
+
+#ifndef DIRECTORY_WATCHER_H
+#define DIRECTORY_WATCHER_H
+
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+
+//------------------------------------------------------------------------------
+// DirectoryWatcher Class
+// Reports which files directly in one directory (the level the scanner
+// reads) were created, changed, moved or deleted. Only names are reported:
+// by the time a caller looks, the file's current state is what counts.
+// Uses inotify on Linux; elsewhere start() fails and callers fall back to
+// periodic scans.
+//------------------------------------------------------------------------------
+class DirectoryWatcher {
+public:
+    // Constructor / Destructor
+    explicit DirectoryWatcher(Logger& logger);
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    bool start(const std::string& directory);
+    bool isActive() const;
+
+    // Wait up to timeoutMs and append the names of changed files; returns
+    // false when events were lost (queue overflow or the directory went
+    // away), in which case only a full scan gives correct totals
+    bool poll(int timeoutMs, std::vector<std::string>& names);
+
+private:
+    Logger& logger_;                // Reference to logger
+    int fd_;                        // Notification descriptor, -1 when inactive
+    int watch_;                     // Watch on the directory
+};
+
+} // namespace DesktopCleaner
+
+#endif // DIRECTORY_WATCHER_H
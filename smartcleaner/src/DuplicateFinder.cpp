@@ -0,0 +1,134 @@
+//==============================================================================
+// DuplicateFinder.cpp - Exact Duplicate Detection Implementation
+//==============================================================================
+
+#include "DuplicateFinder.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <future>
+#include <map>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Duplicate Status Names
+//------------------------------------------------------------------------------
+const char* duplicateStatusName(DuplicateStatus status) {
+    switch (status) {
+        case DuplicateStatus::UNIQUE:   return "unique";
+        case DuplicateStatus::ORIGINAL: return "original";
+        case DuplicateStatus::COPY:     return "copy";
+        default:                        return "unknown";
+    }
+}
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+DuplicateFinder::DuplicateFinder(Logger& logger, ThreadPool& pool)
+    : logger_(logger), pool_(pool) {
+}
+
+//------------------------------------------------------------------------------
+// Find Duplicates
+//------------------------------------------------------------------------------
+void DuplicateFinder::findDuplicates(const std::vector<FileInfo>& files) {
+    groups_.clear();
+    statuses_.clear();
+
+    // Step 1: Only files sharing a size can be duplicates (empty files never count)
+    std::unordered_map<long long, std::vector<const FileInfo*>> bySize;
+    for (const auto& file : files) {
+        if (file.sizeBytes > 0) {
+            bySize[file.sizeBytes].push_back(&file);
+        }
+    }
+
+    std::vector<const FileInfo*> candidates;
+    for (const auto& [size, sameSize] : bySize) {
+        if (sameSize.size() > 1) {
+            candidates.insert(candidates.end(), sameSize.begin(), sameSize.end());
+        }
+    }
+
+    logger_.info("Hashing " + std::to_string(candidates.size()) +
+                 " duplicate candidates...");
+
+    // Step 2: Hash candidates in parallel
+    std::vector<std::future<std::uint64_t>> hashes;
+    hashes.reserve(candidates.size());
+    for (const FileInfo* file : candidates) {
+        hashes.push_back(pool_.submit([file]() { return ContentHasher::hashFile(file->path); }));
+    }
+
+    std::map<std::pair<long long, std::uint64_t>, std::vector<const FileInfo*>> byContent;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        try {
+            pool_.waitFor(hashes[i]);
+            byContent[{ candidates[i]->sizeBytes, hashes[i].get() }].push_back(candidates[i]);
+        } catch (const std::exception& e) {
+            logger_.warning(std::string("Could not hash file: ") + e.what());
+            statuses_[candidates[i]->path.string()] = { DuplicateStatus::UNKNOWN, 0 };
+        }
+    }
+
+    // Step 3: Build groups, oldest file first
+    for (auto& [key, members] : byContent) {
+        if (members.size() < 2) {
+            continue;
+        }
+
+        std::sort(members.begin(), members.end(), [](const FileInfo* a, const FileInfo* b) {
+            if (a->lastModified != b->lastModified) {
+                return a->lastModified < b->lastModified;
+            }
+            return a->name < b->name;
+        });
+
+        DuplicateGroup group;
+        group.sizeBytes = key.first;
+        group.contentHash = key.second;
+
+        auto groupIndex = static_cast<std::uint32_t>(groups_.size());
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            group.files.push_back(*members[i]);
+            statuses_[members[i]->path.string()] = {
+                i == 0 ? DuplicateStatus::ORIGINAL : DuplicateStatus::COPY, groupIndex };
+        }
+        groups_.push_back(std::move(group));
+    }
+
+    logger_.info("Found " + std::to_string(groups_.size()) + " duplicate groups (" +
+                 std::to_string(getReclaimableBytes()) + " reclaimable bytes)");
+}
+
+//------------------------------------------------------------------------------
+// Get Detection Results
+//------------------------------------------------------------------------------
+const std::vector<DuplicateGroup>& DuplicateFinder::getGroups() const {
+    return groups_;
+}
+
+DuplicateStatus DuplicateFinder::getStatus(const std::string& path,
+                                           std::uint32_t* groupIndex) const {
+    auto it = statuses_.find(path);
+    if (it == statuses_.end()) {
+        return DuplicateStatus::UNIQUE;
+    }
+    if (groupIndex != nullptr) {
+        *groupIndex = it->second.groupIndex;
+    }
+    return it->second.status;
+}
+
+long long DuplicateFinder::getReclaimableBytes() const {
+    long long total = 0;
+    for (const auto& group : groups_) {
+        total += group.sizeBytes * static_cast<long long>(group.files.size() - 1);
+    }
+    return total;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,76 @@
+//==============================================================================
+// DuplicateFinder.h - Exact Duplicate Detection Interface
+//==============================================================================
+
+#ifndef DUPLICATE_FINDER_H
+#define DUPLICATE_FINDER_H
+
+#include "FileScanner.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// Duplicate Status
+// Values are part of the shared-memory table format; append only
+//------------------------------------------------------------------------------
+enum class DuplicateStatus : std::uint32_t {
+    UNIQUE = 0,       // No other file has the same content
+    ORIGINAL = 1,     // Oldest copy in its duplicate group
+    COPY = 2,         // Newer copy of an ORIGINAL
+    UNKNOWN = 3       // Could not be hashed
+};
+
+// Lowercase name for display ("unique", "original", "copy", "unknown")
+const char* duplicateStatusName(DuplicateStatus status);
+
+//------------------------------------------------------------------------------
+// DuplicateGroup Structure
+// Files with identical size and content hash; files[0] is the original
+//------------------------------------------------------------------------------
+struct DuplicateGroup {
+    std::uint64_t contentHash;      // XXH64 of the file contents
+    long long sizeBytes;            // Size shared by every member
+    std::vector<FileInfo> files;    // Oldest first
+};
+
+//------------------------------------------------------------------------------
+// DuplicateFinder Class
+// Groups by size first so only size collisions are ever read and hashed
+//------------------------------------------------------------------------------
+class DuplicateFinder {
+public:
+    // Constructor
+    DuplicateFinder(Logger& logger, ThreadPool& pool);
+
+    // Main detection method
+    void findDuplicates(const std::vector<FileInfo>& files);
+
+    // Get detection results
+    const std::vector<DuplicateGroup>& getGroups() const;
+    DuplicateStatus getStatus(const std::string& path, std::uint32_t* groupIndex = nullptr) const;
+    long long getReclaimableBytes() const;
+
+private:
+    // Per-file outcome keyed by path
+    struct PathStatus {
+        DuplicateStatus status;
+        std::uint32_t groupIndex;
+    };
+
+    Logger& logger_;                                        // Reference to logger
+    ThreadPool& pool_;                                      // Hashing workers
+    std::vector<DuplicateGroup> groups_;                    // Groups of 2+ identical files
+    std::unordered_map<std::string, PathStatus> statuses_;  // Non-unique files only
+};
+
+} // namespace DesktopCleaner
+
+#endif // DUPLICATE_FINDER_H
@@ -0,0 +1,319 @@
+//==============================================================================
+// ExtensionSketch.cpp - Unknown Extension Heavy-Hitter Sketch Implementation
+//==============================================================================
+//
+// Sketch file (text, one counter per line):
+//
+//   smartcleaner-unknown-sketch 1
+//   total <files> <bytes>
+//   files <weight> <error> <extension>     extension "-" = none
+//   bytes <weight> <error> <extension>
+//
+//==============================================================================
+
+#include "ExtensionSketch.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::string SKETCH_HEADER = "smartcleaner-unknown-sketch 1";
+const std::string NO_EXTENSION = "-";
+
+bool heavierFirst(const ExtensionEstimate& a, const ExtensionEstimate& b) {
+    return a.weight != b.weight ? a.weight > b.weight : a.extension < b.extension;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ExtensionSketch::ExtensionSketch(Logger& logger)
+    : logger_(logger), totalFiles_(0), totalBytes_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Add Files
+//------------------------------------------------------------------------------
+void ExtensionSketch::addFiles(const std::vector<FileInfo>& files) {
+    for (const auto& file : files) {
+        files_.add(file.extension, 1);
+        bytes_.add(file.extension, file.sizeBytes);
+        totalFiles_++;
+        totalBytes_ += file.sizeBytes;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Merge
+//------------------------------------------------------------------------------
+void ExtensionSketch::merge(const ExtensionSketch& other) {
+    files_.merge(other.files_);
+    bytes_.merge(other.bytes_);
+    totalFiles_ += other.totalFiles_;
+    totalBytes_ += other.totalBytes_;
+}
+
+bool ExtensionSketch::mergeFile(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        logger_.error("Cannot open extension sketch: " + path);
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(input, line) || line != SKETCH_HEADER) {
+        logger_.error("Not an extension sketch: " + path);
+        return false;
+    }
+
+    ExtensionSketch loaded(logger_);
+    std::vector<ExtensionEstimate> files;
+    std::vector<ExtensionEstimate> bytes;
+    int lineNumber = 1;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (line.empty()) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "total") {
+            fields >> loaded.totalFiles_ >> loaded.totalBytes_;
+        } else if (key == "files" || key == "bytes") {
+            ExtensionEstimate counter;
+            fields >> counter.weight >> counter.error >> std::ws;
+            std::getline(fields, counter.extension);
+            if (counter.extension == NO_EXTENSION) {
+                counter.extension.clear();
+            }
+            (key == "files" ? files : bytes).push_back(std::move(counter));
+        }
+        if (fields.fail()) {
+            logger_.error("Extension sketch " + path + ":" + std::to_string(lineNumber) +
+                          ": unreadable line");
+            return false;
+        }
+    }
+
+    loaded.files_.assign(std::move(files));
+    loaded.bytes_.assign(std::move(bytes));
+    merge(loaded);
+    logger_.info("Merged extension sketch " + path + " (" + std::to_string(loaded.totalFiles_) +
+                 " files)");
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Save
+//------------------------------------------------------------------------------
+bool ExtensionSketch::save(const std::string& path) const {
+    fs::path temporary = path + ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::trunc);
+        if (!output) {
+            logger_.error("Cannot write extension sketch: " + temporary.string());
+            return false;
+        }
+        output << SKETCH_HEADER << '\n';
+        output << "total " << totalFiles_ << ' ' << totalBytes_ << '\n';
+        for (const auto& [name, summary] : { std::make_pair("files", &files_),
+                                             std::make_pair("bytes", &bytes_) }) {
+            for (const auto& counter : summary->getCounters()) {
+                if (counter.extension.find('\n') != std::string::npos) {
+                    continue;
+                }
+                output << name << ' ' << counter.weight << ' ' << counter.error << ' '
+                       << (counter.extension.empty() ? NO_EXTENSION : counter.extension) << '\n';
+            }
+        }
+        if (!output.flush()) {
+            logger_.error("Cannot write extension sketch: " + temporary.string());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, path, error);
+    if (error) {
+        logger_.error("Cannot save extension sketch: " + path + " - " + error.message());
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+std::vector<ExtensionEstimate> ExtensionSketch::topByFiles(std::size_t limit) const {
+    return files_.top(limit);
+}
+
+std::vector<ExtensionEstimate> ExtensionSketch::topByBytes(std::size_t limit) const {
+    return bytes_.top(limit);
+}
+
+long long ExtensionSketch::getTotalFiles() const {
+    return totalFiles_;
+}
+
+long long ExtensionSketch::getTotalBytes() const {
+    return totalBytes_;
+}
+
+//------------------------------------------------------------------------------
+// Summary: Add
+// A tracked key grows in place; otherwise it gets a free counter or takes
+// over the smallest one, whose weight becomes its error
+//------------------------------------------------------------------------------
+ExtensionSketch::Summary::Summary() {
+    heap_.reserve(UNKNOWN_SKETCH_CAPACITY);
+}
+
+void ExtensionSketch::Summary::add(const std::string& key, long long weight) {
+    if (weight <= 0) {
+        return;
+    }
+
+    auto found = position_.find(key);
+    if (found != position_.end()) {
+        heap_[found->second].weight += weight;
+        siftDown(found->second);
+        return;
+    }
+
+    if (heap_.size() < UNKNOWN_SKETCH_CAPACITY) {
+        heap_.push_back(ExtensionEstimate{ key, weight, 0 });
+        position_[key] = heap_.size() - 1;
+        siftUp(heap_.size() - 1);
+        return;
+    }
+
+    ExtensionEstimate& smallest = heap_[0];
+    position_.erase(smallest.extension);
+    smallest.error = smallest.weight;
+    smallest.weight += weight;
+    smallest.extension = key;
+    position_[key] = 0;
+    siftDown(0);
+}
+
+//------------------------------------------------------------------------------
+// Summary: Merge
+// A key missing from a full summary may still have weighed up to its
+// smallest counter there, so that much is added to both weight and error
+//------------------------------------------------------------------------------
+void ExtensionSketch::Summary::merge(const Summary& other) {
+    long long ownFloor = floor();
+    long long otherFloor = other.floor();
+
+    std::unordered_map<std::string, ExtensionEstimate> combined;
+    for (const auto& counter : heap_) {
+        combined[counter.extension] = ExtensionEstimate{ counter.extension,
+                                                         counter.weight + otherFloor,
+                                                         counter.error + otherFloor };
+    }
+    for (const auto& counter : other.heap_) {
+        auto found = combined.find(counter.extension);
+        if (found != combined.end()) {
+            found->second.weight += counter.weight - otherFloor;
+            found->second.error += counter.error - otherFloor;
+        } else {
+            combined[counter.extension] = ExtensionEstimate{ counter.extension,
+                                                             counter.weight + ownFloor,
+                                                             counter.error + ownFloor };
+        }
+    }
+
+    std::vector<ExtensionEstimate> counters;
+    counters.reserve(combined.size());
+    for (auto& [key, counter] : combined) {
+        counters.push_back(std::move(counter));
+    }
+    assign(std::move(counters));
+}
+
+//------------------------------------------------------------------------------
+// Summary: Assign
+// An ascending array already satisfies the min-heap order
+//------------------------------------------------------------------------------
+void ExtensionSketch::Summary::assign(std::vector<ExtensionEstimate> counters) {
+    std::sort(counters.begin(), counters.end(), heavierFirst);
+    if (counters.size() > UNKNOWN_SKETCH_CAPACITY) {
+        counters.resize(UNKNOWN_SKETCH_CAPACITY);
+    }
+    std::reverse(counters.begin(), counters.end());
+
+    heap_ = std::move(counters);
+    position_.clear();
+    for (std::size_t i = 0; i < heap_.size(); ++i) {
+        position_[heap_[i].extension] = i;
+    }
+}
+
+std::vector<ExtensionEstimate> ExtensionSketch::Summary::top(std::size_t limit) const {
+    std::vector<ExtensionEstimate> result(heap_);
+    std::size_t count = std::min(limit, result.size());
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(count),
+                      result.end(), heavierFirst);
+    result.resize(count);
+    return result;
+}
+
+const std::vector<ExtensionEstimate>& ExtensionSketch::Summary::getCounters() const {
+    return heap_;
+}
+
+//------------------------------------------------------------------------------
+// Summary: Heap Helpers
+//------------------------------------------------------------------------------
+long long ExtensionSketch::Summary::floor() const {
+    return heap_.size() < UNKNOWN_SKETCH_CAPACITY ? 0 : heap_[0].weight;
+}
+
+void ExtensionSketch::Summary::siftUp(std::size_t index) {
+    while (index > 0) {
+        std::size_t parent = (index - 1) / 2;
+        if (heap_[parent].weight <= heap_[index].weight) {
+            break;
+        }
+        swapNodes(parent, index);
+        index = parent;
+    }
+}
+
+void ExtensionSketch::Summary::siftDown(std::size_t index) {
+    while (true) {
+        std::size_t smallest = index;
+        for (std::size_t child = 2 * index + 1; child <= 2 * index + 2 && child < heap_.size();
+             ++child) {
+            if (heap_[child].weight < heap_[smallest].weight) {
+                smallest = child;
+            }
+        }
+        if (smallest == index) {
+            return;
+        }
+        swapNodes(index, smallest);
+        index = smallest;
+    }
+}
+
+void ExtensionSketch::Summary::swapNodes(std::size_t a, std::size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    position_[heap_[a].extension] = a;
+    position_[heap_[b].extension] = b;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,89 @@
+//==============================================================================
+// ExtensionSketch.h - Unknown Extension Heavy-Hitter Sketch Interface
+//==============================================================================
+
+#ifndef EXTENSION_SKETCH_H
+#define EXTENSION_SKETCH_H
+
+#include "FileScanner.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+
+//------------------------------------------------------------------------------
+// ExtensionEstimate Structure
+// A tracked extension; the true weight lies in [weight - error, weight]
+//------------------------------------------------------------------------------
+struct ExtensionEstimate {
+    std::string extension;          // Lowercase, "" for files without one
+    long long weight = 0;
+    long long error = 0;
+};
+
+//------------------------------------------------------------------------------
+// ExtensionSketch Class
+// Space-Saving summaries of the extensions that fell to Others, one weighted
+// by file count and one by bytes, each with UNKNOWN_SKETCH_CAPACITY counters
+// whatever the number of distinct extensions. An untracked extension takes
+// over the smallest counter and inherits its value as error, so any weight
+// above total / capacity is always tracked. Sketches from other runs or hosts
+// merge counter by counter and stay within the same bounds.
+//------------------------------------------------------------------------------
+class ExtensionSketch {
+public:
+    // Constructor
+    explicit ExtensionSketch(Logger& logger);
+
+    // Count files (normally the Others category)
+    void addFiles(const std::vector<FileInfo>& files);
+
+    // Fold in another sketch, or one saved to a file
+    void merge(const ExtensionSketch& other);
+    bool mergeFile(const std::string& path);
+
+    // Written to a temporary file and renamed
+    bool save(const std::string& path) const;
+
+    // Heaviest extensions first
+    std::vector<ExtensionEstimate> topByFiles(std::size_t limit) const;
+    std::vector<ExtensionEstimate> topByBytes(std::size_t limit) const;
+    long long getTotalFiles() const;
+    long long getTotalBytes() const;
+
+private:
+    // One weighted Space-Saving summary: counters in an indexed min-heap, so
+    // an update or a takeover of the smallest counter costs O(log capacity)
+    class Summary {
+    public:
+        Summary();
+        void add(const std::string& key, long long weight);
+        void merge(const Summary& other);
+        void assign(std::vector<ExtensionEstimate> counters);   // Keeps the heaviest
+        std::vector<ExtensionEstimate> top(std::size_t limit) const;
+        const std::vector<ExtensionEstimate>& getCounters() const;
+
+    private:
+        std::vector<ExtensionEstimate> heap_;                   // Smallest weight at the root
+        std::unordered_map<std::string, std::size_t> position_; // Key -> heap index
+        long long floor() const;                                // Weight an untracked key may have
+        void siftUp(std::size_t index);
+        void siftDown(std::size_t index);
+        void swapNodes(std::size_t a, std::size_t b);
+    };
+
+    Logger& logger_;                // Reference to logger
+    Summary files_;
+    Summary bytes_;
+    long long totalFiles_;
+    long long totalBytes_;
+};
+
+} // namespace DesktopCleaner
+
+#endif // EXTENSION_SKETCH_H
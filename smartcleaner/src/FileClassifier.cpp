@@ -3,6 +3,8 @@
 //==============================================================================
 
 #include "FileClassifier.h"
+#include "ClassifierPlugins.h"
+#include "KeywordClassifier.h"
 #include "Logger.h"
 #include <algorithm>
 
@@ -12,7 +14,8 @@ namespace DesktopCleaner {
 // Constructor
 //------------------------------------------------------------------------------
 FileClassifier::FileClassifier(Logger& logger) 
-    : logger_(logger), extensionMap_(buildExtensionMap()) {
+    : logger_(logger), extensionMap_(buildExtensionMap()), plugins_(nullptr),
+      keywords_(nullptr), pool_(nullptr) {
 }
 
 //------------------------------------------------------------------------------
@@ -22,18 +25,34 @@ void FileClassifier::classifyFiles(const std::vector<FileInfo>& files) {
     categorizedFiles_.clear();
     
     // Initialize categories with empty vectors
-    for (const auto& category : getAllCategories()) {
+    for (const auto& category : getCategoryNames()) {
         categorizedFiles_[category] = std::vector<FileInfo>();
     }
     
     logger_.info("Classifying " + std::to_string(files.size()) + " files...");
     
+    // Plugins decide first, in batches; -1 leaves a file to the extension rules
+    std::vector<int> pluginCategories;
+    if (plugins_ != nullptr && !plugins_->empty()) {
+        pluginCategories = plugins_->classify(files, pool_);
+    }
+    
     // Classify each file
-    for (const auto& file : files) {
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const FileInfo& file = files[i];
+        if (!pluginCategories.empty() && pluginCategories[i] >= 0) {
+            categorizedFiles_[plugins_->getCategories()[pluginCategories[i]]].push_back(file);
+            continue;
+        }
         std::string category = classifyFile(file);
         categorizedFiles_[category].push_back(file);
     }
     
+    // Documents whose text names a rule keyword move to that rule's category
+    if (keywords_ != nullptr) {
+        refineDocuments();
+    }
+    
     // Log classification results
     logClassificationResults();
 }
@@ -57,6 +76,51 @@ std::vector<FileInfo> FileClassifier::getFilesInCategory(const std::string& cate
     return std::vector<FileInfo>();
 }
 
+//------------------------------------------------------------------------------
+// Get Category Names
+//------------------------------------------------------------------------------
+std::vector<std::string> FileClassifier::getCategoryNames() const {
+    std::vector<std::string> names = getAllCategories();
+    if (plugins_ != nullptr) {
+        for (const auto& category : plugins_->getCategories()) {
+            if (std::find(names.begin(), names.end(), category) == names.end()) {
+                names.push_back(category);
+            }
+        }
+    }
+    if (keywords_ != nullptr) {
+        for (const auto& category : keywords_->getCategories()) {
+            if (std::find(names.begin(), names.end(), category) == names.end()) {
+                names.push_back(category);
+            }
+        }
+    }
+    return names;
+}
+
+//------------------------------------------------------------------------------
+// Configuration Setters
+//------------------------------------------------------------------------------
+void FileClassifier::setPlugins(const ClassifierPlugins* plugins, ThreadPool* pool) {
+    plugins_ = plugins;
+    pool_ = pool;
+}
+
+void FileClassifier::setKeywordClassifier(const KeywordClassifier* keywords) {
+    keywords_ = keywords;
+}
+
+//------------------------------------------------------------------------------
+// Validate Category Name
+//------------------------------------------------------------------------------
+bool FileClassifier::isValidCategoryName(const std::string& name, bool allowDocuments) {
+    return !name.empty() && name != "." && name != ".." &&
+           name.size() < static_cast<std::size_t>(SHM_CATEGORY_NAME_BYTES) &&
+           name.find_first_of("/\\") == std::string::npos &&
+           name != COLD_DIRECTORY && name != NEAR_DUPLICATES_DIRECTORY &&
+           (allowDocuments || name != CATEGORY_DOCUMENTS);
+}
+
 //------------------------------------------------------------------------------
 // Helper: Classify Single File
 //------------------------------------------------------------------------------
@@ -73,13 +137,34 @@ std::string FileClassifier::classifyFile(const FileInfo& fileInfo) const {
     }
 }
 
+//------------------------------------------------------------------------------
+// Helper: Refine Documents by Keywords
+//------------------------------------------------------------------------------
+void FileClassifier::refineDocuments() {
+    std::vector<FileInfo>& documents = categorizedFiles_[CATEGORY_DOCUMENTS];
+    std::vector<int> matches = keywords_->classify(documents, pool_);
+    
+    std::vector<FileInfo> unmatched;
+    for (std::size_t i = 0; i < documents.size(); ++i) {
+        if (matches[i] >= 0) {
+            categorizedFiles_[keywords_->getCategories()[matches[i]]].push_back(documents[i]);
+        } else {
+            unmatched.push_back(std::move(documents[i]));
+        }
+    }
+    logger_.info("Keyword rules matched " + 
+                 std::to_string(documents.size() - unmatched.size()) + " of " +
+                 std::to_string(documents.size()) + " documents");
+    documents = std::move(unmatched);
+}
+
 //------------------------------------------------------------------------------
 // Helper: Log Classification Results
 //------------------------------------------------------------------------------
 void FileClassifier::logClassificationResults() const {
     logger_.info("Classification results:");
     
-    for (const auto& category : getAllCategories()) {
+    for (const auto& category : getCategoryNames()) {
         auto it = categorizedFiles_.find(category);
         if (it != categorizedFiles_.end() && !it->second.empty()) {
             logger_.info("  " + category + ": " + 
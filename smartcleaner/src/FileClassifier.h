@@ -14,12 +14,16 @@
 
 namespace DesktopCleaner {
 
-// Forward declaration
+// Forward declarations
 class Logger;
+class ClassifierPlugins;
+class KeywordClassifier;
+class ThreadPool;
 
 //------------------------------------------------------------------------------
 // FileClassifier Class
-// Categorizes files based on extension rules
+// Categorizes files based on extension rules; loaded plugins are asked first,
+// and keyword rules can then move text documents out of Documents
 //------------------------------------------------------------------------------
 class FileClassifier {
 public:
@@ -32,14 +36,27 @@ public:
     // Get classification results
     const std::map<std::string, std::vector<FileInfo>>& getCategorizedFiles() const;
     std::vector<FileInfo> getFilesInCategory(const std::string& category) const;
+    std::vector<std::string> getCategoryNames() const;  // Built-in, plugin, then keyword categories
+    
+    // Configuration setters (the pool runs plugin batches and keyword reads)
+    void setPlugins(const ClassifierPlugins* plugins, ThreadPool* pool);
+    void setKeywordClassifier(const KeywordClassifier* keywords);
+    
+    // Categories become folder names: one plain name, not a reserved folder.
+    // Keyword rules pass allowDocuments = false, since they move files out of it.
+    static bool isValidCategoryName(const std::string& name, bool allowDocuments);
     
 private:
     Logger& logger_;                                                // Reference to logger
     std::unordered_map<std::string, std::string> extensionMap_;     // Extension -> Category mapping
     std::map<std::string, std::vector<FileInfo>> categorizedFiles_; // Category -> Files mapping
+    const ClassifierPlugins* plugins_;                              // Optional custom classifiers
+    const KeywordClassifier* keywords_;                             // Optional Documents refinement
+    ThreadPool* pool_;                                              // Optional plugin workers
     
     // Helper methods
     std::string classifyFile(const FileInfo& fileInfo) const;
+    void refineDocuments();
     void logClassificationResults() const;
 };
 
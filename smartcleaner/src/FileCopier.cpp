@@ -0,0 +1,278 @@
+//==============================================================================
+// FileCopier.cpp - Hole-Preserving File Copy Implementation
+//==============================================================================
+
+#include "FileCopier.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "Config.h"
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+#ifndef _WIN32
+namespace {
+
+//------------------------------------------------------------------------------
+// Helper: Copy One Extent
+// pread/pwrite at the same offset, so skipped holes never get written; each
+// buffer is hashed between the read and the write
+//------------------------------------------------------------------------------
+bool copyRange(int in, int out, off_t start, off_t end, std::vector<char>& buffer,
+               TreeHasher& hasher) {
+    while (start < end) {
+        std::size_t want = static_cast<std::size_t>(
+            std::min<off_t>(end - start, static_cast<off_t>(buffer.size())));
+        ssize_t got = ::pread(in, buffer.data(), want, start);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            if (got == 0) {
+                errno = EIO;    // File shrank while being copied
+            }
+            return false;
+        }
+        hasher.update(buffer.data(), static_cast<std::size_t>(got));
+        for (ssize_t written = 0; written < got;) {
+            ssize_t put = ::pwrite(out, buffer.data() + written,
+                                   static_cast<std::size_t>(got - written), start + written);
+            if (put < 0 && errno == EINTR) {
+                continue;
+            }
+            if (put <= 0) {
+                return false;
+            }
+            written += put;
+        }
+        start += got;
+    }
+    return true;
+}
+
+} // namespace
+#endif
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+FileCopier::FileCopier(Logger& logger)
+    : logger_(logger),
+      pool_(nullptr),
+      paranoid_(false),
+      digest_(0),
+      dataBytes_(0),
+      holeBytes_(0),
+      targetExisted_(false) {
+}
+
+//------------------------------------------------------------------------------
+// Configuration
+//------------------------------------------------------------------------------
+void FileCopier::setThreadPool(ThreadPool* pool) {
+    pool_ = pool;
+}
+
+void FileCopier::setParanoid(bool paranoid) {
+    paranoid_ = paranoid;
+}
+
+//------------------------------------------------------------------------------
+// Copy File
+//------------------------------------------------------------------------------
+bool FileCopier::copyFile(const fs::path& source, const fs::path& target) {
+    dataBytes_ = 0;
+    holeBytes_ = 0;
+    digest_ = 0;
+    targetExisted_ = false;
+
+#ifndef _WIN32
+    int in = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        logger_.error("Cannot open for copy: " + source.string() + " - " + std::strerror(errno));
+        return false;
+    }
+    struct stat status;
+    if (fstat(in, &status) != 0) {
+        logger_.error("Cannot stat for copy: " + source.string() + " - " + std::strerror(errno));
+        ::close(in);
+        return false;
+    }
+    int out = ::open(target.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC,
+                     status.st_mode & 07777);
+    if (out < 0) {
+        if (errno == EEXIST) {
+            targetExisted_ = true;      // The caller picks another name
+        } else {
+            logger_.error("Cannot create copy: " + target.string() + " - " + std::strerror(errno));
+        }
+        ::close(in);
+        return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    std::vector<char> buffer(COPY_BUFFER_BYTES);
+    TreeHasher hasher(pool_);
+    const off_t size = status.st_size;
+    off_t position = 0;
+    bool ok = true;
+    while (ok && position < size) {
+        off_t dataStart = lseek(in, position, SEEK_DATA);
+        off_t dataEnd = size;
+        if (dataStart < 0) {
+            if (errno == ENXIO) {
+                break;              // Only a hole remains
+            }
+            dataStart = position;   // No SEEK_DATA support: copy everything
+        } else {
+            dataEnd = lseek(in, dataStart, SEEK_HOLE);
+            if (dataEnd < 0 || dataEnd > size) {
+                dataEnd = size;
+            }
+        }
+        hasher.updateZeros(static_cast<std::uint64_t>(dataStart - position));
+        ok = copyRange(in, out, dataStart, dataEnd, buffer, hasher);
+        if (ok) {
+            dataBytes_ += dataEnd - dataStart;
+            position = dataEnd;
+        }
+    }
+
+    // The hash only vouches for the source if nothing wrote to it meanwhile
+    struct stat after;
+    bool sourceChanged = ok && (fstat(in, &after) != 0 || after.st_size != status.st_size ||
+                                after.st_mtim.tv_sec != status.st_mtim.tv_sec ||
+                                after.st_mtim.tv_nsec != status.st_mtim.tv_nsec);
+    if (sourceChanged) {
+        ok = false;
+        errno = EAGAIN;
+    }
+
+    // A trailing hole is created by the size change alone
+    if (ok) {
+        hasher.updateZeros(static_cast<std::uint64_t>(size - position));
+        digest_ = hasher.digest();
+        struct timespec times[2] = { status.st_atim, status.st_mtim };
+        ok = ftruncate(out, size) == 0 && fchmod(out, status.st_mode & 07777) == 0 &&
+             futimens(out, times) == 0 && fsync(out) == 0;
+    }
+    int savedErrno = errno;
+    ::close(in);
+    if (::close(out) != 0 && ok) {
+        ok = false;
+        savedErrno = errno;
+    }
+    if (!ok) {
+        logger_.error("Copy failed: " + source.string() + " → " + target.string() + " - " +
+                      (sourceChanged ? "source changed during copy" : std::strerror(savedErrno)));
+        ::unlink(target.c_str());
+        return false;
+    }
+    holeBytes_ = size - dataBytes_;
+
+    if (paranoid_ && !verifyTarget(target)) {
+        ::unlink(target.c_str());
+        return false;
+    }
+    return true;
+#else
+    std::error_code error;
+    if (!fs::copy_file(source, target, fs::copy_options::none, error)) {
+        if (error == std::errc::file_exists) {
+            targetExisted_ = true;
+            return false;
+        }
+        logger_.error("Copy failed: " + source.string() + " → " + target.string() +
+                      " - " + error.message());
+        return false;
+    }
+    fs::last_write_time(target, fs::last_write_time(source, error), error);
+    dataBytes_ = static_cast<long long>(fs::file_size(target, error));
+    try {
+        digest_ = TreeHasher::hashFile(source, pool_, false);
+    } catch (const std::exception& e) {
+        logger_.error("Cannot hash copy source: " + std::string(e.what()));
+        fs::remove(target, error);
+        return false;
+    }
+    if (paranoid_ && !verifyTarget(target)) {
+        fs::remove(target, error);
+        return false;
+    }
+    return true;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Move File (copy + unlink)
+//------------------------------------------------------------------------------
+bool FileCopier::moveFile(const fs::path& source, const fs::path& target) {
+    if (!copyFile(source, target)) {
+        return false;
+    }
+    std::error_code error;
+    if (!fs::remove(source, error)) {
+        logger_.error("Cannot remove source after copy: " + source.string() +
+                      " - " + error.message());
+        fs::remove(target, error);
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Get Copy Statistics
+//------------------------------------------------------------------------------
+long long FileCopier::getDataBytes() const {
+    return dataBytes_;
+}
+
+long long FileCopier::getHoleBytes() const {
+    return holeBytes_;
+}
+
+std::uint64_t FileCopier::getDigest() const {
+    return digest_;
+}
+
+bool FileCopier::targetExisted() const {
+    return targetExisted_;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Verify Target Against the Streamed Digest
+//------------------------------------------------------------------------------
+bool FileCopier::verifyTarget(const fs::path& target) {
+    std::uint64_t onDisk = 0;
+    try {
+        onDisk = TreeHasher::hashFile(target, pool_, true);
+    } catch (const std::exception& e) {
+        logger_.error("Cannot verify copy: " + std::string(e.what()));
+        return false;
+    }
+    if (onDisk != digest_) {
+        std::ostringstream message;
+        message << "Copy verification failed: " << target.string() << " - expected "
+                << std::hex << digest_ << ", read back " << onDisk;
+        logger_.error(message.str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,64 @@
+//==============================================================================
+// FileCopier.h - Hole-Preserving File Copy Interface
+//==============================================================================
+
+#ifndef FILE_COPIER_H
+#define FILE_COPIER_H
+
+#include <cstdint>
+#include <filesystem>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// FileCopier Class
+// Copies files when a rename cannot (the target is on another device).
+// Only data extents are transferred: SEEK_DATA/SEEK_HOLE skip the holes of
+// sparse files, and the target is extended to full size without writing
+// them, so a 100 GB VM image with 3 GB of data stays 3 GB on disk.
+//
+// Data is tree-hashed as it streams through (leaves on the pool), and the
+// source must be unchanged at the end, so a move costs one read. Paranoid
+// mode also re-reads the target bypassing the page cache and compares.
+//------------------------------------------------------------------------------
+class FileCopier {
+public:
+    // Constructor
+    explicit FileCopier(Logger& logger);
+
+    // Configuration
+    void setThreadPool(ThreadPool* pool);   // Leaf hashing workers (optional)
+    void setParanoid(bool paranoid);        // Re-read and compare every copy
+
+    // Copy source to a new target, keeping holes, mode and mtime
+    bool copyFile(const std::filesystem::path& source, const std::filesystem::path& target);
+
+    // Copy, then unlink the source; the target is removed again on failure
+    bool moveFile(const std::filesystem::path& source, const std::filesystem::path& target);
+
+    // Byte counts of the last copy
+    long long getDataBytes() const;     // Bytes read and written
+    long long getHoleBytes() const;     // Bytes skipped as holes
+    std::uint64_t getDigest() const;    // Tree hash of the copied content
+    bool targetExisted() const;         // Last copy refused an existing target
+
+private:
+    Logger& logger_;            // Reference to logger
+    ThreadPool* pool_;          // Optional leaf hashing workers
+    bool paranoid_;             // Verify targets from disk
+    std::uint64_t digest_;      // Tree hash of the last copy
+    long long dataBytes_;       // Data extents copied
+    long long holeBytes_;       // Holes left unwritten
+    bool targetExisted_;        // Target name was taken (not logged)
+
+    // Helper methods
+    bool verifyTarget(const std::filesystem::path& target);
+};
+
+} // namespace DesktopCleaner
+
+#endif // FILE_COPIER_H
@@ -0,0 +1,857 @@
+//==============================================================================
+// FileIndex.cpp - Persistent Segmented File Index Implementation
+//==============================================================================
+//
+// Segment file layout (native byte order, like the log sidecar index):
+//
+//   magic[8] | record count | bloom words | sparse count | data end
+//   bloom words (64-bit)
+//   records, sorted by path:  u32 path length, path, u16 category length,
+//                             category, i64 size, i64 mtime, u8 tombstone
+//   sparse index:             u64 record offset, u32 key length, key
+//
+//==============================================================================
+
+#include "FileIndex.h"
+#include "FileClassifier.h"
+#include "FileMover.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const char SEGMENT_MAGIC[8] = { 'S', 'C', 'I', 'D', 'X', 'S', 'G', '1' };
+const std::uint64_t SEGMENT_HEADER_BYTES = sizeof(SEGMENT_MAGIC) + 4 * sizeof(std::uint64_t);
+const std::string SEGMENT_PREFIX = "segment_";
+const std::string SEGMENT_EXTENSION = ".sst";
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool get(const std::string& in, std::size_t& position, T& value) {
+    if (position + sizeof(value) > in.size()) {
+        return false;
+    }
+    std::memcpy(&value, in.data() + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+}
+
+bool getString(const std::string& in, std::size_t& position, std::size_t length,
+               std::string& value) {
+    if (position + length > in.size()) {
+        return false;
+    }
+    value.assign(in, position, length);
+    position += length;
+    return true;
+}
+
+void putRecord(std::string& out, const IndexRecord& record) {
+    put(out, static_cast<std::uint32_t>(record.path.size()));
+    out += record.path;
+    put(out, static_cast<std::uint16_t>(record.category.size()));
+    out += record.category;
+    put(out, static_cast<std::int64_t>(record.sizeBytes));
+    put(out, static_cast<std::int64_t>(record.lastModified));
+    put(out, static_cast<std::uint8_t>(record.deleted ? 1 : 0));
+}
+
+bool getRecord(const std::string& in, std::size_t& position, IndexRecord& record) {
+    std::uint32_t pathLength = 0;
+    std::uint16_t categoryLength = 0;
+    std::int64_t size = 0;
+    std::int64_t mtime = 0;
+    std::uint8_t deleted = 0;
+    if (!get(in, position, pathLength) || !getString(in, position, pathLength, record.path) ||
+        !get(in, position, categoryLength) ||
+        !getString(in, position, categoryLength, record.category) ||
+        !get(in, position, size) || !get(in, position, mtime) || !get(in, position, deleted)) {
+        return false;
+    }
+    record.sizeBytes = size;
+    record.lastModified = static_cast<std::time_t>(mtime);
+    record.deleted = deleted != 0;
+    return true;
+}
+
+// Byte range [begin, end) of an open file (of path where there are no descriptors)
+bool readRange(int fd, const std::string& path, std::uint64_t begin, std::uint64_t end,
+               std::string& bytes) {
+    if (end < begin) {
+        return false;
+    }
+    bytes.resize(static_cast<std::size_t>(end - begin));
+#ifndef _WIN32
+    (void)path;
+    std::size_t done = 0;
+    while (done < bytes.size()) {
+        ssize_t count = pread(fd, &bytes[done], bytes.size() - done,
+                              static_cast<off_t>(begin + done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        done += static_cast<std::size_t>(count);
+    }
+    return true;
+#else
+    (void)fd;
+    std::ifstream input(path, std::ios::binary);
+    input.seekg(static_cast<std::streamoff>(begin));
+    return input && static_cast<bool>(input.read(&bytes[0], static_cast<std::streamsize>(bytes.size())));
+#endif
+}
+
+// Whole file on disk before it is renamed into place; returns a descriptor
+// still open on it, or -1
+int writeDurably(const fs::path& path, const std::string& data) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return -1;
+    }
+    std::size_t done = 0;
+    while (done < data.size()) {
+        ssize_t count = ::write(fd, data.data() + done, data.size() - done);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            ::close(fd);
+            return -1;
+        }
+        done += static_cast<std::size_t>(count);
+    }
+    if (fsync(fd) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+#else
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return output.flush() ? 0 : -1;
+#endif
+}
+
+void closeDescriptor(int fd) {
+#ifndef _WIN32
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#else
+    (void)fd;
+#endif
+}
+
+// Double hashing: probe i sets bit (h1 + i * h2) mod bits
+void bloomProbes(const std::string& path, std::uint64_t bits, std::uint64_t* out) {
+    std::uint64_t hash = ContentHasher::hashPath(path);
+    std::uint64_t h1 = hash & 0xFFFFFFFFull;
+    std::uint64_t h2 = (hash >> 32) | 1;
+    for (int i = 0; i < INDEX_BLOOM_HASHES; ++i) {
+        out[i] = (h1 + static_cast<std::uint64_t>(i) * h2) % bits;
+    }
+}
+
+bool sameContents(const IndexRecord& a, const IndexRecord& b) {
+    return a.category == b.category && a.sizeBytes == b.sizeBytes &&
+           a.lastModified == b.lastModified;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+FileIndex::FileIndex(Logger& logger, const std::string& baseDirectory)
+    : logger_(logger),
+      lockFd_(-1),
+      readOnly_(false),
+      nextSequence_(1),
+      directoryLoaded_(false),
+      compactRequested_(false),
+      stopping_(false) {
+    fs::path base(ContentHasher::normalizePath(baseDirectory));
+    if (!base.has_filename()) {
+        base = base.parent_path();                  // "/a/b/" -> "/a/b"
+    }
+    baseDirectory_ = base.string();
+    directory_ = (base / INDEX_DIRECTORY).string();
+}
+
+FileIndex::~FileIndex() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    compactCondition_.notify_all();
+    if (compactThread_.joinable()) {
+        compactThread_.join();
+    }
+    closeDescriptor(lockFd_);   // Releases the writer lock
+}
+
+FileIndex::Segment::~Segment() {
+    closeDescriptor(fd);
+}
+
+//------------------------------------------------------------------------------
+// Open
+// Segment files the manifest does not list are leftovers of an interrupted
+// write or compaction and are removed; only the lock holder may do that, as
+// another writer's may be on their way into the manifest
+//------------------------------------------------------------------------------
+bool FileIndex::open() {
+    std::error_code error;
+    fs::create_directories(directory_, error);
+    if (error) {
+        logger_.error("Cannot create index directory " + directory_ + ": " + error.message());
+        return false;
+    }
+
+#ifndef _WIN32
+    if (lockFd_ < 0) {
+        std::string lockPath = (fs::path(directory_) / INDEX_LOCK_FILE).string();
+        int fd = ::open(lockPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0 || flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            logger_.error("Index " + directory_ + " is open for writing elsewhere");
+            closeDescriptor(fd);
+            return false;
+        }
+        lockFd_ = fd;
+    }
+#endif
+
+    SegmentList segments;
+    std::vector<std::string> listed;
+    if (!loadManifest(segments, listed)) {
+        return false;
+    }
+
+    std::uint64_t nextSequence = 1;
+    for (const auto& segment : segments) {
+        nextSequence = std::max(nextSequence, segment->sequence + 1);
+    }
+    for (const auto& entry : fs::directory_iterator(directory_, error)) {
+        std::string file = entry.path().filename().string();
+        if (file.rfind(SEGMENT_PREFIX, 0) == 0 &&
+            std::find(listed.begin(), listed.end(), file) == listed.end()) {
+            fs::remove(entry.path(), error);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_ = std::move(segments);
+    nextSequence_ = nextSequence;
+    directoryLoaded_ = false;
+    readOnly_ = false;
+    logger_.info("Index " + directory_ + ": " + std::to_string(segments_.size()) + " segments");
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Open Read-Only
+// A writer's compaction may remove a listed segment before it is opened
+// here; the manifest it wrote first then names the replacement
+//------------------------------------------------------------------------------
+bool FileIndex::openReadOnly() {
+    SegmentList segments;
+    std::vector<std::string> listed;
+    bool loaded = false;
+    for (int attempt = 0; attempt < INDEX_OPEN_ATTEMPTS && !loaded; ++attempt) {
+        loaded = loadManifest(segments, listed);
+    }
+    if (!loaded) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    segments_ = std::move(segments);
+    directoryLoaded_ = false;
+    readOnly_ = true;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Apply Changes
+//------------------------------------------------------------------------------
+bool FileIndex::apply(std::vector<IndexRecord> changes) {
+    if (readOnly_) {
+        logger_.error("Index " + directory_ + " is open read-only");
+        return false;
+    }
+    if (changes.empty()) {
+        return true;
+    }
+
+    // Sorted by path; of repeated paths the last change stays
+    std::stable_sort(changes.begin(), changes.end(),
+                     [](const IndexRecord& a, const IndexRecord& b) { return a.path < b.path; });
+    std::vector<IndexRecord> sorted;
+    for (auto& change : changes) {
+        if (!sorted.empty() && sorted.back().path == change.path) {
+            sorted.back() = std::move(change);
+        } else {
+            sorted.push_back(std::move(change));
+        }
+    }
+
+    std::uint64_t sequence;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sequence = nextSequence_++;
+    }
+    auto segment = writeSegment(sequence, sorted);
+    if (!segment) {
+        logger_.error("Cannot write index segment in " + directory_);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    SegmentList updated = segments_;
+    updated.push_back(segment);
+    if (!writeManifest(updated)) {
+        logger_.error("Cannot update index manifest in " + directory_);
+        return false;
+    }
+    segments_ = std::move(updated);
+
+    if (directoryLoaded_) {
+        for (const auto& record : sorted) {
+            if (!isDirectChild(record.path)) {
+                continue;
+            }
+            if (record.deleted) {
+                directoryState_.erase(record.path);
+            } else {
+                directoryState_[record.path] = record;
+            }
+        }
+    }
+
+    if (!compactThread_.joinable()) {
+        compactThread_ = std::thread(&FileIndex::compactLoop, this);
+    }
+    compactRequested_ = true;
+    compactCondition_.notify_all();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Sync Directory
+// The first call reads the index once; later calls diff against the copy
+// apply() keeps current
+//------------------------------------------------------------------------------
+long long FileIndex::syncDirectory(const FileClassifier& classifier) {
+    bool loaded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loaded = directoryLoaded_;
+    }
+    if (!loaded) {
+        std::unordered_map<std::string, IndexRecord> state;
+        for (auto& record : loadAll()) {
+            if (isDirectChild(record.path)) {
+                state.emplace(record.path, std::move(record));
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        directoryState_ = std::move(state);
+        directoryLoaded_ = true;
+    }
+
+    std::vector<IndexRecord> changes;
+    std::unordered_map<std::string, bool> seen;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [category, files] : classifier.getCategorizedFiles()) {
+            for (const auto& file : files) {
+                IndexRecord record;
+                record.path = ContentHasher::normalizePath(file.path);
+                record.category = category;
+                record.sizeBytes = file.sizeBytes;
+                record.lastModified = file.lastModified;
+                seen[record.path] = true;
+
+                auto known = directoryState_.find(record.path);
+                if (known == directoryState_.end() || !sameContents(known->second, record)) {
+                    changes.push_back(std::move(record));
+                }
+            }
+        }
+        for (const auto& [path, record] : directoryState_) {
+            if (seen.count(path) == 0) {
+                IndexRecord tombstone;
+                tombstone.path = path;
+                tombstone.deleted = true;
+                changes.push_back(std::move(tombstone));
+            }
+        }
+    }
+
+    long long changeCount = static_cast<long long>(changes.size());
+    return apply(std::move(changes)) ? changeCount : -1;
+}
+
+//------------------------------------------------------------------------------
+// Apply Moves
+// A rename keeps size and mtime, so the scanned values still hold; an archive
+// keeps the mtime and brings its own size
+//------------------------------------------------------------------------------
+bool FileIndex::applyMoves(const std::vector<MovedFile>& journal) {
+    std::vector<IndexRecord> changes;
+    changes.reserve(journal.size() * 2);
+    for (const auto& move : journal) {
+        IndexRecord source;
+        source.path = ContentHasher::normalizePath(move.source.path);
+        source.deleted = true;
+        changes.push_back(std::move(source));
+
+        IndexRecord target;
+        target.path = ContentHasher::normalizePath(move.targetPath);
+        target.category = move.category;
+        target.sizeBytes = move.targetBytes >= 0 ? move.targetBytes : move.source.sizeBytes;
+        target.lastModified = move.source.lastModified;
+        changes.push_back(std::move(target));
+    }
+    return apply(std::move(changes));
+}
+
+//------------------------------------------------------------------------------
+// Lookup
+// Newest segment first; the filter rules most segments out without a read
+//------------------------------------------------------------------------------
+bool FileIndex::lookup(const std::string& normalizedPath, IndexRecord& record) const {
+    SegmentList segments;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        segments = segments_;
+    }
+
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        const Segment& segment = **it;
+        if (segment.sparseKeys.empty() || !bloomMayContain(segment, normalizedPath)) {
+            continue;
+        }
+
+        // Block whose first key is the last one <= path
+        auto upper = std::upper_bound(segment.sparseKeys.begin(), segment.sparseKeys.end(),
+                                      normalizedPath);
+        if (upper == segment.sparseKeys.begin()) {
+            continue;
+        }
+        std::size_t block = static_cast<std::size_t>(upper - segment.sparseKeys.begin()) - 1;
+        std::uint64_t begin = segment.sparseOffsets[block];
+        std::uint64_t end = block + 1 < segment.sparseOffsets.size()
+                                ? segment.sparseOffsets[block + 1] : segment.dataEnd;
+
+        std::string bytes;
+        if (!readRange(segment.fd, (fs::path(directory_) / segment.fileName).string(), begin, end,
+                       bytes)) {
+            logger_.warning("Index segment unreadable: " + segment.fileName);
+            continue;
+        }
+        std::size_t position = 0;
+        IndexRecord candidate;
+        while (getRecord(bytes, position, candidate)) {
+            if (candidate.path == normalizedPath) {
+                record = candidate;
+                return !candidate.deleted;
+            }
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Load All Live Records
+//------------------------------------------------------------------------------
+std::vector<IndexRecord> FileIndex::loadAll() const {
+    SegmentList segments;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        segments = segments_;
+    }
+
+    std::map<std::string, IndexRecord> merged;
+    for (auto it = segments.rbegin(); it != segments.rend(); ++it) {
+        std::vector<IndexRecord> records;
+        if (!readRecords(**it, records)) {
+            logger_.warning("Index segment unreadable: " + (*it)->fileName);
+            continue;
+        }
+        for (auto& record : records) {
+            merged.emplace(record.path, std::move(record));  // Newer segments came first
+        }
+    }
+
+    std::vector<IndexRecord> live;
+    for (auto& [path, record] : merged) {
+        if (!record.deleted) {
+            live.push_back(std::move(record));
+        }
+    }
+    return live;
+}
+
+//------------------------------------------------------------------------------
+// Index Information
+//------------------------------------------------------------------------------
+std::size_t FileIndex::getSegmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_.size();
+}
+
+const std::string& FileIndex::getDirectory() const {
+    return directory_;
+}
+
+std::string FileIndex::findIndexFor(const fs::path& path) {
+    fs::path directory = fs::path(ContentHasher::normalizePath(path)).parent_path();
+    std::error_code error;
+    while (!directory.empty()) {
+        if (fs::exists(directory / INDEX_DIRECTORY / INDEX_MANIFEST_FILE, error)) {
+            return directory.string();
+        }
+        if (directory == directory.parent_path()) {
+            break;
+        }
+        directory = directory.parent_path();
+    }
+    return "";
+}
+
+//------------------------------------------------------------------------------
+// Helper: Write Segment
+// Written under a temporary name and renamed, so a listed segment is whole
+//------------------------------------------------------------------------------
+std::shared_ptr<const FileIndex::Segment> FileIndex::writeSegment(
+    std::uint64_t sequence, const std::vector<IndexRecord>& sorted) const {
+    auto segment = std::make_shared<Segment>();
+    segment->sequence = sequence;
+    segment->fileName = SEGMENT_PREFIX + std::to_string(sequence) + SEGMENT_EXTENSION;
+    segment->recordCount = sorted.size();
+
+    std::uint64_t bits = std::max<std::uint64_t>(64, sorted.size() * INDEX_BLOOM_BITS_PER_KEY);
+    segment->bloom.assign(static_cast<std::size_t>((bits + 63) / 64), 0);
+    bits = segment->bloom.size() * 64;
+    const std::uint64_t dataStart = SEGMENT_HEADER_BYTES + segment->bloom.size() * 8;
+
+    std::string data;
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        std::uint64_t probes[INDEX_BLOOM_HASHES];
+        bloomProbes(sorted[i].path, bits, probes);
+        for (std::uint64_t probe : probes) {
+            segment->bloom[probe / 64] |= 1ull << (probe % 64);
+        }
+        if (i % INDEX_SPARSE_INTERVAL == 0) {
+            segment->sparseKeys.push_back(sorted[i].path);
+            segment->sparseOffsets.push_back(dataStart + data.size());
+        }
+        putRecord(data, sorted[i]);
+    }
+    segment->dataEnd = dataStart + data.size();
+
+    std::string file;
+    file.append(SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+    put(file, segment->recordCount);
+    put(file, static_cast<std::uint64_t>(segment->bloom.size()));
+    put(file, static_cast<std::uint64_t>(segment->sparseKeys.size()));
+    put(file, segment->dataEnd);
+    file.append(reinterpret_cast<const char*>(segment->bloom.data()), segment->bloom.size() * 8);
+    file += data;
+    for (std::size_t i = 0; i < segment->sparseKeys.size(); ++i) {
+        put(file, segment->sparseOffsets[i]);
+        put(file, static_cast<std::uint32_t>(segment->sparseKeys[i].size()));
+        file += segment->sparseKeys[i];
+    }
+
+    fs::path target = fs::path(directory_) / segment->fileName;
+    fs::path temporary = target;
+    temporary += ".tmp";
+    segment->fd = writeDurably(temporary, file);
+    if (segment->fd < 0) {
+        return nullptr;
+    }
+    std::error_code error;
+    fs::rename(temporary, target, error);
+    if (error || !FileMover::syncDirectory(directory_)) {
+        return nullptr;
+    }
+    return segment;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Read Segment Header, Filter and Sparse Index
+//------------------------------------------------------------------------------
+std::shared_ptr<const FileIndex::Segment> FileIndex::readSegment(const std::string& fileName) const {
+    std::string path = (fs::path(directory_) / fileName).string();
+    auto segment = std::make_shared<Segment>();
+    std::uint64_t fileSize = 0;
+#ifndef _WIN32
+    segment->fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if (segment->fd < 0 || fstat(segment->fd, &status) != 0) {
+        return nullptr;
+    }
+    fileSize = static_cast<std::uint64_t>(status.st_size);
+#else
+    std::error_code error;
+    fileSize = fs::file_size(path, error);
+    if (error) {
+        return nullptr;
+    }
+#endif
+    std::string bytes;
+    if (!readRange(segment->fd, path, 0, fileSize, bytes) ||
+        bytes.compare(0, sizeof(SEGMENT_MAGIC), SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0) {
+        return nullptr;
+    }
+
+    segment->fileName = fileName;
+    std::size_t digits = SEGMENT_PREFIX.size();
+    segment->sequence = std::strtoull(fileName.c_str() + digits, nullptr, 10);
+
+    std::size_t position = sizeof(SEGMENT_MAGIC);
+    std::uint64_t bloomWords = 0;
+    std::uint64_t sparseCount = 0;
+    if (!get(bytes, position, segment->recordCount) || !get(bytes, position, bloomWords) ||
+        !get(bytes, position, sparseCount) || !get(bytes, position, segment->dataEnd) ||
+        segment->dataEnd > bytes.size() || bloomWords == 0 ||
+        SEGMENT_HEADER_BYTES + bloomWords * 8 > segment->dataEnd) {
+        return nullptr;
+    }
+    segment->bloom.resize(static_cast<std::size_t>(bloomWords));
+    std::memcpy(segment->bloom.data(), bytes.data() + position, bloomWords * 8);
+
+    position = static_cast<std::size_t>(segment->dataEnd);
+    for (std::uint64_t i = 0; i < sparseCount; ++i) {
+        std::uint64_t offset = 0;
+        std::uint32_t length = 0;
+        std::string key;
+        if (!get(bytes, position, offset) || !get(bytes, position, length) ||
+            !getString(bytes, position, length, key) || offset >= segment->dataEnd) {
+            return nullptr;
+        }
+        segment->sparseOffsets.push_back(offset);
+        segment->sparseKeys.push_back(std::move(key));
+    }
+    return segment;
+}
+
+bool FileIndex::readRecords(const Segment& segment, std::vector<IndexRecord>& records) const {
+    const std::uint64_t dataStart = SEGMENT_HEADER_BYTES + segment.bloom.size() * 8;
+    std::string bytes;
+    if (!readRange(segment.fd, (fs::path(directory_) / segment.fileName).string(), dataStart,
+                   segment.dataEnd, bytes)) {
+        return false;
+    }
+    records.clear();
+    records.reserve(static_cast<std::size_t>(segment.recordCount));
+    std::size_t position = 0;
+    IndexRecord record;
+    while (position < bytes.size()) {
+        if (!getRecord(bytes, position, record)) {
+            return false;
+        }
+        records.push_back(record);
+    }
+    return records.size() == segment.recordCount;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Load the Manifest
+// False if a listed segment is missing or unreadable
+//------------------------------------------------------------------------------
+bool FileIndex::loadManifest(SegmentList& segments, std::vector<std::string>& listed) const {
+    segments.clear();
+    listed.clear();
+    std::ifstream manifest(fs::path(directory_) / INDEX_MANIFEST_FILE);
+    std::string name;
+    while (std::getline(manifest, name)) {
+        if (name.empty()) {
+            continue;
+        }
+        auto segment = readSegment(name);
+        if (!segment) {
+            logger_.error("Index segment unreadable: " + name);
+            return false;
+        }
+        listed.push_back(name);
+        segments.push_back(segment);
+    }
+    return true;
+}
+
+bool FileIndex::writeManifest(const SegmentList& segments) const {
+    fs::path target = fs::path(directory_) / INDEX_MANIFEST_FILE;
+    fs::path temporary = target;
+    temporary += ".tmp";
+    std::string text;
+    for (const auto& segment : segments) {
+        text += segment->fileName + '\n';
+    }
+    int fd = writeDurably(temporary, text);
+    if (fd < 0) {
+        return false;
+    }
+    closeDescriptor(fd);
+    std::error_code error;
+    fs::rename(temporary, target, error);
+    return !error && FileMover::syncDirectory(directory_);
+}
+
+//------------------------------------------------------------------------------
+// Helper: Background Compaction
+//------------------------------------------------------------------------------
+void FileIndex::compactLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        compactCondition_.wait(lock, [this]() { return compactRequested_ || stopping_; });
+        if (stopping_) {
+            return;
+        }
+        compactRequested_ = false;
+        lock.unlock();
+        while (compactOnce()) {
+            // One merge can complete a run in the next tier up
+        }
+        lock.lock();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Merge the Newest Segments
+// Segments are merged like the digits of a binary counter carry, so a record
+// is rewritten O(log n) times and O(log n) segments stay live. Only this
+// thread removes segments and apply() only appends, so the run is still the
+// same slice when it is swapped for the merged segment. Tombstones can be
+// dropped once nothing older is left beneath them.
+//------------------------------------------------------------------------------
+bool FileIndex::compactOnce() {
+    SegmentList segments;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return false;
+        }
+        segments = segments_;
+    }
+
+    // Newest segments back to the first one bigger than all newer ones together
+    std::size_t runStart = segments.size();
+    std::uint64_t newerRecords = 0;
+    while (runStart > 0) {
+        std::uint64_t count = segments[runStart - 1]->recordCount;
+        if (runStart < segments.size() && count > newerRecords) {
+            break;
+        }
+        newerRecords += count;
+        runStart--;
+    }
+    const std::size_t runLength = segments.size() - runStart;
+    if (runLength < INDEX_COMPACT_FANIN) {
+        return false;
+    }
+
+    std::map<std::string, IndexRecord> merged;
+    for (std::size_t k = runStart + runLength; k-- > runStart;) {
+        std::vector<IndexRecord> records;
+        if (!readRecords(*segments[k], records)) {
+            logger_.warning("Index compaction skipped: unreadable " + segments[k]->fileName);
+            return false;
+        }
+        for (auto& record : records) {
+            merged.emplace(record.path, std::move(record));
+        }
+    }
+    std::vector<IndexRecord> sorted;
+    sorted.reserve(merged.size());
+    for (auto& [path, record] : merged) {
+        if (!(record.deleted && runStart == 0)) {
+            sorted.push_back(std::move(record));
+        }
+    }
+
+    std::shared_ptr<const Segment> output;
+    if (!sorted.empty()) {
+        std::uint64_t sequence;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sequence = nextSequence_++;
+        }
+        output = writeSegment(sequence, sorted);
+        if (!output) {
+            logger_.warning("Index compaction failed to write a segment");
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        SegmentList updated(segments_.begin(), segments_.begin() + runStart);
+        if (output) {
+            updated.push_back(output);
+        }
+        updated.insert(updated.end(), segments_.begin() + runStart + runLength, segments_.end());
+        if (!writeManifest(updated)) {
+            logger_.warning("Index compaction failed to update the manifest");
+            return false;
+        }
+        segments_ = std::move(updated);
+    }
+
+    std::error_code error;
+    for (std::size_t k = runStart; k < runStart + runLength; ++k) {
+        fs::remove(fs::path(directory_) / segments[k]->fileName, error);
+    }
+    logger_.info("Index compacted " + std::to_string(runLength) + " segments into " +
+                 std::to_string(sorted.size()) + " records");
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper Functions
+//------------------------------------------------------------------------------
+bool FileIndex::isDirectChild(const std::string& path) const {
+    return fs::path(path).parent_path().string() == baseDirectory_;
+}
+
+bool FileIndex::bloomMayContain(const Segment& segment, const std::string& path) {
+    std::uint64_t probes[INDEX_BLOOM_HASHES];
+    bloomProbes(path, segment.bloom.size() * 64, probes);
+    for (std::uint64_t probe : probes) {
+        if ((segment.bloom[probe / 64] & (1ull << (probe % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,140 @@
+//==============================================================================
+// FileIndex.h - Persistent Segmented File Index Interface
+//==============================================================================
+
+#ifndef FILE_INDEX_H
+#define FILE_INDEX_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class FileClassifier;
+struct MovedFile;
+
+//------------------------------------------------------------------------------
+// IndexRecord Structure
+// One file as last seen, or a tombstone saying it is gone
+//------------------------------------------------------------------------------
+struct IndexRecord {
+    std::string path;               // ContentHasher::normalizePath() of the file
+    std::string category;           // Category folder it belongs to
+    long long sizeBytes = 0;
+    std::time_t lastModified = 0;
+    bool deleted = false;           // Tombstone: hides older records of the path
+};
+
+//------------------------------------------------------------------------------
+// FileIndex Class
+// LSM-style index kept in INDEX_DIRECTORY under the organized directory.
+// Every apply() writes the changes alone as a new immutable segment sorted by
+// path, so an update costs in proportion to the churn, never the tree. Each
+// segment carries a Bloom filter and a sparse key index: a lookup asks the
+// newest segment first and opens only those whose filter admits the path.
+// A background thread merges the newest segments once INDEX_COMPACT_FANIN of
+// them are each no bigger than everything newer, which keeps the segment
+// count logarithmic in the index size. One process at a time writes: open()
+// holds a lock on INDEX_LOCK_FILE, which guards removing leftovers too.
+// Segments are read through descriptors opened with them, so a compaction
+// may remove a file that a reader is still using.
+//------------------------------------------------------------------------------
+class FileIndex {
+public:
+    // Constructor / Destructor (the destructor finishes a running compaction)
+    FileIndex(Logger& logger, const std::string& baseDirectory);
+    ~FileIndex();
+
+    FileIndex(const FileIndex&) = delete;
+    FileIndex& operator=(const FileIndex&) = delete;
+
+    // Read the manifest and segment headers; creates an empty index if none.
+    // Fails while another process has the index open for writing.
+    bool open();
+
+    // For queries next to a live writer: no lock, nothing created or removed
+    bool openReadOnly();
+
+    // Write one segment with these changes (the last one per path wins)
+    bool apply(std::vector<IndexRecord> changes);
+
+    // Diff a classification of the base directory against the files indexed
+    // directly in it and apply only the differences; returns changes written
+    // or -1 on failure
+    long long syncDirectory(const FileClassifier& classifier);
+
+    // Record a mover's journal as one segment: each source becomes a
+    // tombstone and each target a record built from the scanned metadata,
+    // so no file is touched again
+    bool applyMoves(const std::vector<MovedFile>& journal);     // Also cold-tier archives
+
+    // Queries
+    bool lookup(const std::string& normalizedPath, IndexRecord& record) const;
+    std::vector<IndexRecord> loadAll() const;       // Live records, sorted by path
+
+    // Index information
+    std::size_t getSegmentCount() const;
+    const std::string& getDirectory() const;
+
+    // Nearest parent of path with an index (its base directory), or ""
+    static std::string findIndexFor(const std::filesystem::path& path);
+
+private:
+    // One immutable segment: filter and sparse keys in memory, records on disk
+    struct Segment {
+        ~Segment();
+        int fd = -1;                                // Open for reads until the last user drops it
+        std::string fileName;
+        std::uint64_t sequence = 0;
+        std::uint64_t recordCount = 0;
+        std::vector<std::uint64_t> bloom;
+        std::vector<std::string> sparseKeys;        // Every INDEX_SPARSE_INTERVAL-th path
+        std::vector<std::uint64_t> sparseOffsets;   // Their record offsets in the file
+        std::uint64_t dataEnd = 0;                  // Offset just past the last record
+    };
+    using SegmentList = std::vector<std::shared_ptr<const Segment>>;
+
+    Logger& logger_;                                // Reference to logger
+    std::string baseDirectory_;                     // Normalized organized directory
+    std::string directory_;                         // baseDirectory_/INDEX_DIRECTORY
+    int lockFd_;                                    // INDEX_LOCK_FILE, held by a writer
+    bool readOnly_;
+
+    mutable std::mutex mutex_;                      // Guards everything below
+    SegmentList segments_;                          // Oldest first
+    std::uint64_t nextSequence_;
+    bool directoryLoaded_;                          // directoryState_ filled
+    std::unordered_map<std::string, IndexRecord> directoryState_; // Live files directly in base
+
+    std::thread compactThread_;                     // Started by the first apply()
+    std::condition_variable compactCondition_;
+    bool compactRequested_;
+    bool stopping_;
+
+    // Helper methods
+    bool loadManifest(SegmentList& segments, std::vector<std::string>& listed) const;
+    std::shared_ptr<const Segment> writeSegment(std::uint64_t sequence,
+                                                const std::vector<IndexRecord>& sorted) const;
+    std::shared_ptr<const Segment> readSegment(const std::string& fileName) const;
+    bool readRecords(const Segment& segment, std::vector<IndexRecord>& records) const;
+    bool writeManifest(const SegmentList& segments) const;
+    void compactLoop();
+    bool compactOnce();
+    bool isDirectChild(const std::string& path) const;
+    static bool bloomMayContain(const Segment& segment, const std::string& path);
+};
+
+} // namespace DesktopCleaner
+
+#endif // FILE_INDEX_H
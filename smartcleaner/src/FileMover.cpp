@@ -3,11 +3,29 @@
 //==============================================================================
 
 #include "FileMover.h"
+#include "ConcurrencyController.h"
 #include "Logger.h"
+#include "ProgressReporter.h"
+#include "TraceRecorder.h"
+#include "Config.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <chrono>
+#include <cerrno>
+#include <system_error>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#ifndef RENAME_NOREPLACE
+#define RENAME_NOREPLACE (1 << 0)
+#endif
+#endif
 
 namespace fs = std::filesystem;
 
@@ -18,10 +36,16 @@ namespace DesktopCleaner {
 //------------------------------------------------------------------------------
 FileMover::FileMover(Logger& logger, bool dryRun) 
     : logger_(logger), 
+      progress_(nullptr),
+      trace_(nullptr),
       dryRun_(dryRun),
+      copier_(logger),
+      controller_(nullptr),
       successCount_(0),
       failCount_(0),
-      warningCount_(0) {
+      warningCount_(0),
+      attemptedCount_(0),
+      stoppedAtDeadline_(false) {
 }
 
 //------------------------------------------------------------------------------
@@ -41,6 +65,7 @@ bool FileMover::organizeFiles(
     successCount_ = 0;
     failCount_ = 0;
     warningCount_ = 0;
+    journal_.clear();
     
     try {
         // Step 1: Create category directories
@@ -49,7 +74,11 @@ bool FileMover::organizeFiles(
             return false;
         }
         
-        // Step 2: Move files to their categories
+        // Step 2: Move files to their categories; with a controller the renames
+        // run in parallel, as many at once as the device keeps up with
+        const std::uint64_t device = controller_ && !dryRun_
+            ? ConcurrencyController::deviceOf(baseDirectory) : 0;
+        std::vector<std::future<bool>> moves;
         for (const auto& [category, files] : categorizedFiles) {
             if (files.empty()) {
                 continue; // Skip empty categories
@@ -58,9 +87,18 @@ bool FileMover::organizeFiles(
             std::string targetDir = baseDirectory + "/" + category;
             
             for (const auto& file : files) {
-                moveFile(file, targetDir);
+                if (controller_ && !dryRun_) {
+                    moves.push_back(controller_->submit(device, 1, [this, &file, targetDir]() {
+                        return moveFile(file, targetDir);
+                    }));
+                } else {
+                    moveFile(file, targetDir);
+                }
             }
         }
+        for (auto& move : moves) {
+            controller_->waitFor(move);
+        }
         
         // Log summary
         logger_.logSummary(
@@ -69,6 +107,77 @@ bool FileMover::organizeFiles(
             failCount_,
             warningCount_
         );
+        logger_.flushIndex();
+        
+        return true;
+        
+    } catch (const std::exception& e) {
+        logger_.error("Unexpected error during organization: " + std::string(e.what()));
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Organize Files Within a Deadline
+// The next move starts only if the average move so far still fits
+//------------------------------------------------------------------------------
+bool FileMover::organizePlanned(
+    const std::string& baseDirectory,
+    const std::vector<PlannedMove>& plan,
+    std::chrono::steady_clock::time_point deadline) {
+    
+    logger_.info("Starting time-budgeted organization of " + std::to_string(plan.size()) + " files...");
+    
+    if (dryRun_) {
+        logger_.info("[DRY-RUN MODE] No files will be actually moved");
+    }
+    
+    // Reset counters
+    successCount_ = 0;
+    failCount_ = 0;
+    warningCount_ = 0;
+    attemptedCount_ = 0;
+    failedPaths_.clear();
+    stoppedAtDeadline_ = false;
+    journal_.clear();
+    
+    try {
+        std::map<std::string, std::vector<FileInfo>> byCategory;
+        for (const auto& move : plan) {
+            byCategory[move.category].push_back(move.file);
+        }
+        if (!createCategoryDirectories(baseDirectory, byCategory)) {
+            logger_.error("Failed to create category directories");
+            return false;
+        }
+        
+        std::chrono::duration<double> spent(0);
+        for (const auto& move : plan) {
+            auto started = std::chrono::steady_clock::now();
+            auto estimate = attemptedCount_ > 0 ? spent / static_cast<double>(attemptedCount_)
+                                                : std::chrono::duration<double>(0);
+            if (started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(estimate) >= deadline) {
+                stoppedAtDeadline_ = true;
+                logger_.info("Time budget reached with " + std::to_string(plan.size() - attemptedCount_) +
+                             " moves left");
+                break;
+            }
+            
+            if (!moveFile(move.file, baseDirectory + "/" + move.category)) {
+                failedPaths_.push_back(move.file.path.string());
+            }
+            attemptedCount_++;
+            spent += std::chrono::steady_clock::now() - started;
+        }
+        
+        // Log summary
+        logger_.logSummary(
+            successCount_ + failCount_,
+            successCount_,
+            failCount_,
+            warningCount_
+        );
+        logger_.flushIndex();
         
         return true;
         
@@ -85,6 +194,62 @@ int FileMover::getSuccessCount() const { return successCount_; }
 int FileMover::getFailCount() const { return failCount_; }
 int FileMover::getWarningCount() const { return warningCount_; }
 
+std::size_t FileMover::getAttemptedCount() const { return attemptedCount_; }
+const std::vector<std::string>& FileMover::getFailedPaths() const { return failedPaths_; }
+bool FileMover::stoppedAtDeadline() const { return stoppedAtDeadline_; }
+const std::vector<MovedFile>& FileMover::getMoveJournal() const { return journal_; }
+
+//------------------------------------------------------------------------------
+// Configuration Setters
+//------------------------------------------------------------------------------
+void FileMover::setProgressReporter(ProgressReporter* progress) {
+    progress_ = progress;
+}
+
+void FileMover::setTraceRecorder(TraceRecorder* trace) {
+    trace_ = trace;
+}
+
+void FileMover::setThreadPool(ThreadPool* pool) {
+    copier_.setThreadPool(pool);
+}
+
+void FileMover::setParanoid(bool paranoid) {
+    copier_.setParanoid(paranoid);
+}
+
+void FileMover::setConcurrencyController(ConcurrencyController* controller) {
+    controller_ = controller;
+}
+
+void FileMover::setRecordedBase(const std::string& actualBase, const std::string& recordedBase) {
+    actualBase_ = actualBase;
+    recordedBase_ = recordedBase;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Path as Recorded
+// The job service moves through /proc/self/fd/N; the log names the real path
+//------------------------------------------------------------------------------
+std::string FileMover::recordedPath(const std::string& path) const {
+    if (actualBase_.empty() || path.compare(0, actualBase_.size(), actualBase_) != 0) {
+        return path;
+    }
+    return recordedBase_ + path.substr(actualBase_.size());
+}
+
+//------------------------------------------------------------------------------
+// Helper: Traced Existence Check
+//------------------------------------------------------------------------------
+bool FileMover::pathExists(const fs::path& path) const {
+    std::uint64_t started = trace_ ? trace_->now() : 0;
+    bool exists = fs::exists(path);
+    if (trace_) {
+        trace_->record(TraceOp::EXISTS, path, 0, started, exists);
+    }
+    return exists;
+}
+
 //------------------------------------------------------------------------------
 // Helper: Create Category Directories
 //------------------------------------------------------------------------------
@@ -104,13 +269,17 @@ bool FileMover::createCategoryDirectories(
         
         try {
             if (dryRun_) {
-                if (!fs::exists(categoryPath)) {
+                if (!pathExists(categoryPath)) {
                     logger_.info("[DRY-RUN] Would create directory: " + category);
                 }
             } else {
                 // Create directory if it doesn't exist
-                if (!fs::exists(categoryPath)) {
+                if (!pathExists(categoryPath)) {
+                    std::uint64_t started = trace_ ? trace_->now() : 0;
                     fs::create_directory(categoryPath);
+                    if (trace_) {
+                        trace_->record(TraceOp::MKDIR, categoryPath, 0, started);
+                    }
                     logger_.success("Created directory: " + category);
                 } else {
                     logger_.info("Directory already exists: " + category);
@@ -129,42 +298,180 @@ bool FileMover::createCategoryDirectories(
 //------------------------------------------------------------------------------
 // Helper: Move Single File
 //------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
 bool FileMover::moveFile(const FileInfo& fileInfo, const std::string& targetDirectory) {
     try {
         std::string targetPath = targetDirectory + "/" + fileInfo.name;
         
-        // Check if target file already exists
-        if (fs::exists(targetPath)) {
-            // Handle collision: append timestamp
-            targetPath = handleFileCollision(targetDirectory, fileInfo.name);
-            warningCount_++;
-        }
-        
         if (dryRun_) {
+            // Check if target file already exists
+            if (pathExists(targetPath)) {
+                // Handle collision: append timestamp
+                targetPath = handleFileCollision(targetDirectory, fileInfo.name, 1);
+                warningCount_++;
+            }
+            
             // Dry-run: just log what would happen
-            logger_.info("[DRY-RUN] Would move: " + fileInfo.name + " → " + 
-                        fs::path(targetDirectory).filename().string() + "/");
+            logger_.fileEvent(LogLevel::INFO, "[DRY-RUN] Would move: " + fileInfo.name + " → " + 
+                             fs::path(targetDirectory).filename().string() + "/");
             successCount_++;
+            if (progress_) {
+                progress_->addFile(fileInfo.sizeBytes);
+            }
             return true;
         }
         
-        // Actual move operation
-        fs::rename(fileInfo.path, targetPath);
+        // Actual move operation: the existence check and the rename are one
+        // step, so a file that appears under the target name is never
+        // overwritten; a taken name moves on to the next collision name
+        std::uint64_t started = trace_ ? trace_->now() : 0;
+        std::error_code renameError;
+        bool copied = false;
+        std::uint64_t digest = 0;
+        for (int attempt = 1; ; ++attempt) {
+            renameNoReplace(fileInfo.path, targetPath, renameError);
+            if (renameError == std::errc::cross_device_link) {
+                // Category folder is on another device: copy data extents, then unlink
+                std::lock_guard<std::mutex> lock(copierMutex_);
+                copied = copier_.moveFile(fileInfo.path, targetPath);
+                if (copied) {
+                    renameError.clear();
+                    digest = copier_.getDigest();
+                } else if (copier_.targetExisted()) {
+                    renameError = std::make_error_code(std::errc::file_exists);
+                }
+            }
+            if (renameError != std::errc::file_exists || attempt > MAX_COLLISION_RENAMES) {
+                break;
+            }
+            if (attempt == 1) {
+                warningCount_++;
+            }
+            targetPath = handleFileCollision(targetDirectory, fileInfo.name, attempt);
+        }
+        if (trace_) {
+            fs::path target(targetPath);
+            trace_->record(TraceOp::RENAME, fileInfo.path, fileInfo.sizeBytes, started,
+                           !renameError, &target);
+        }
+        if (renameError) {
+            throw fs::filesystem_error("rename", fileInfo.path, targetPath, renameError);
+        }
         
-        logger_.success("Moved: " + fileInfo.name + " → " + 
-                       fs::path(targetDirectory).filename().string() + "/");
+        std::string moved = fileInfo.name + " → " + fs::path(targetDirectory).filename().string() + "/";
+        std::string finalName = fs::path(targetPath).filename().string();
+        if (finalName != fileInfo.name) {
+            moved += finalName;
+        }
+        if (copied) {
+            std::ostringstream hash;
+            hash << std::hex << std::setw(16) << std::setfill('0') << digest;
+            moved = "Copied across devices: " + moved + " (tree hash " + hash.str() + ")";
+        } else {
+            moved = "Moved: " + moved;
+        }
+        FileInfo recorded = fileInfo;
+        recorded.path = recordedPath(fileInfo.path.string());
+        std::string recordedTarget = recordedPath(targetPath);
+        logger_.fileRecord(LogLevel::SUCCESS, moved, recorded.path, recordedTarget);
+        {
+            std::lock_guard<std::mutex> lock(journalMutex_);
+            journal_.push_back({ recorded, recordedTarget, fs::path(targetDirectory).filename().string() });
+        }
         successCount_++;
+        if (progress_) {
+            progress_->addFile(fileInfo.sizeBytes);
+        }
         return true;
         
     } catch (const fs::filesystem_error& e) {
         logger_.error("Failed to move: " + fileInfo.name + " - " + e.what());
         failCount_++;
+        if (progress_) {
+            progress_->addFile(0);
+        }
         return false;
     } catch (const std::exception& e) {
         logger_.error("Unexpected error moving: " + fileInfo.name + " - " + e.what());
         failCount_++;
+        if (progress_) {
+            progress_->addFile(0);
+        }
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Rename Without Replacing
+// Fails with file_exists rather than overwrite a target created after its
+// name was chosen. Where the filesystem lacks RENAME_NOREPLACE, link + unlink
+// is just as exclusive; only one without hard links falls back to a check
+//------------------------------------------------------------------------------
+void FileMover::renameNoReplace(const fs::path& source, const fs::path& target,
+                                std::error_code& error) {
+    error.clear();
+#ifndef _WIN32
+#ifdef SYS_renameat2
+    if (syscall(SYS_renameat2, AT_FDCWD, source.c_str(), AT_FDCWD, target.c_str(),
+                RENAME_NOREPLACE) == 0) {
+        return;
+    }
+    if (errno != EINVAL && errno != ENOSYS) {
+        error.assign(errno, std::generic_category());
+        return;
+    }
+#endif
+    if (::link(source.c_str(), target.c_str()) == 0) {
+        if (::unlink(source.c_str()) != 0) {
+            error.assign(errno, std::generic_category());
+            ::unlink(target.c_str());   // Leave the file under its old name only
+        }
+        return;
+    }
+    if (errno != EPERM && errno != ENOTSUP && errno != EOPNOTSUPP) {
+        error.assign(errno, std::generic_category());
+        return;
+    }
+#endif
+    if (fs::exists(target, error)) {
+        error = std::make_error_code(std::errc::file_exists);
+        return;
+    }
+    fs::rename(source, target, error);
+}
+
+//------------------------------------------------------------------------------
+// Durability Helpers
+// fsync through a descriptor of our own reaches data written by any stream
+//------------------------------------------------------------------------------
+bool FileMover::syncFile(const fs::path& path) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
         return false;
     }
+    bool synced = fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#else
+    (void)path;
+    return true;
+#endif
+}
+
+bool FileMover::syncDirectory(const fs::path& directory) {
+#ifndef _WIN32
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#else
+    (void)directory;
+    return true;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -172,7 +479,8 @@ bool FileMover::moveFile(const FileInfo& fileInfo, const std::string& targetDire
 //------------------------------------------------------------------------------
 std::string FileMover::handleFileCollision(
     const std::string& targetDirectory, 
-    const std::string& fileName) {
+    const std::string& fileName,
+    int attempt) {
     
     // Extract file name and extension
     fs::path filePath(fileName);
@@ -193,7 +501,11 @@ std::string FileMover::handleFileCollision(
     std::ostringstream oss;
     oss << std::put_time(&tm_buf, "%Y%m%d_%H%M%S");
     
-    // Create new filename: original_stem_timestamp.extension
+    // Create new filename: original_stem_timestamp.extension, numbered when
+    // that name is taken as well
+    if (attempt > 1) {
+        oss << "_" << attempt;
+    }
     std::string newFileName = stem + "_" + oss.str() + extension;
     std::string newPath = targetDirectory + "/" + newFileName;
     
@@ -6,14 +6,36 @@
 #define FILE_MOVER_H
 
 #include "FileScanner.h"
+#include "FileCopier.h"
+#include "WorkPlanner.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
 #include <string>
 #include <map>
+#include <system_error>
 #include <vector>
 
 namespace DesktopCleaner {
 
-// Forward declaration
+// Forward declarations
 class Logger;
+class ProgressReporter;
+class TraceRecorder;
+class ThreadPool;
+class ConcurrencyController;
+
+//------------------------------------------------------------------------------
+// MovedFile Structure
+// One completed move, as recorded in the mover's journal
+//------------------------------------------------------------------------------
+struct MovedFile {
+    FileInfo source;            // File as scanned before the move
+    std::string targetPath;     // Where it now lives (after collision renaming)
+    std::string category;       // Category folder it moved into
+    long long targetBytes = -1; // Size at the target when it differs (archives)
+};
 
 //------------------------------------------------------------------------------
 // FileMover Class
@@ -30,19 +52,67 @@ public:
         const std::map<std::string, std::vector<FileInfo>>& categorizedFiles
     );
     
+    // Time-budgeted organization: moves in plan order until the deadline
+    bool organizePlanned(
+        const std::string& baseDirectory,
+        const std::vector<PlannedMove>& plan,
+        std::chrono::steady_clock::time_point deadline
+    );
+    
     // Get operation statistics
     int getSuccessCount() const;
     int getFailCount() const;
     int getWarningCount() const;
     
+    // Get planned-run results
+    std::size_t getAttemptedCount() const;                  // Plan entries handled
+    const std::vector<std::string>& getFailedPaths() const;
+    bool stoppedAtDeadline() const;
+    
+    // Completed moves of the last organize call, in completion order (empty in dry-run)
+    const std::vector<MovedFile>& getMoveJournal() const;
+    
+    // Configuration setters
+    void setProgressReporter(ProgressReporter* progress);
+    void setTraceRecorder(TraceRecorder* trace);
+    void setThreadPool(ThreadPool* pool);     // Hashes cross-device copies
+    void setParanoid(bool paranoid);          // Re-read cross-device copies
+    void setConcurrencyController(ConcurrencyController* controller); // Parallel renames
+    void setRecordedBase(const std::string& actualBase,       // Log and journal paths under
+                         const std::string& recordedBase);    // actualBase as under recordedBase
+    
+    // Rename that fails with file_exists rather than replace the target
+    static void renameNoReplace(const std::filesystem::path& source,
+                                const std::filesystem::path& target, std::error_code& error);
+    
+    // fsync a file's data, or a directory's entries, so they survive a crash
+    static bool syncFile(const std::filesystem::path& path);
+    static bool syncDirectory(const std::filesystem::path& directory);
+    
 private:
     Logger& logger_;          // Reference to logger
+    ProgressReporter* progress_; // Optional progress sink
+    TraceRecorder* trace_;       // Optional workload trace
     bool dryRun_;            // Dry-run mode flag
+    FileCopier copier_;      // Fallback for moves across devices
+    std::mutex copierMutex_; // One cross-device copy at a time
+    ConcurrencyController* controller_; // Optional; renames run in parallel through it
+    std::string actualBase_;            // Directory the moves go through ...
+    std::string recordedBase_;          // ... and the one the records name
+    
+    // Operation counters (bumped from I/O workers)
+    std::atomic<int> successCount_;   // Successfully moved files
+    std::atomic<int> failCount_;      // Failed operations
+    std::atomic<int> warningCount_;   // Warnings (e.g., file collisions)
+    
+    // Planned-run state
+    std::size_t attemptedCount_;            // Plan entries handled
+    std::vector<std::string> failedPaths_;  // Sources that failed to move
+    bool stoppedAtDeadline_;                // Stopped with plan entries left
     
-    // Operation counters
-    int successCount_;       // Successfully moved files
-    int failCount_;          // Failed operations
-    int warningCount_;       // Warnings (e.g., file collisions)
+    // Move journal (appended from I/O workers)
+    std::mutex journalMutex_;
+    std::vector<MovedFile> journal_;
     
     // Helper methods
     bool createCategoryDirectories(
@@ -51,10 +121,13 @@ private:
     );
     
     bool moveFile(const FileInfo& fileInfo, const std::string& targetDirectory);
+    bool pathExists(const std::filesystem::path& path) const;
+    std::string recordedPath(const std::string& path) const;
     
     std::string handleFileCollision(
         const std::string& targetDirectory,
-        const std::string& fileName
+        const std::string& fileName,
+        int attempt                     // 1 for the first alternative name
     );
 };
 
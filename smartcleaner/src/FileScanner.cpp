@@ -3,9 +3,20 @@
 //==============================================================================
 
 #include "FileScanner.h"
+#include "ConcurrencyController.h"
 #include "Logger.h"
+#include "ProgressReporter.h"
+#include "SimdKernels.h"
+#include "TraceRecorder.h"
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <sys/stat.h>
+#endif
 
 namespace fs = std::filesystem;
 
@@ -16,6 +27,9 @@ namespace DesktopCleaner {
 //------------------------------------------------------------------------------
 FileScanner::FileScanner(Logger& logger) 
     : logger_(logger), 
+      progress_(nullptr),
+      trace_(nullptr),
+      controller_(nullptr),
       largeFileSizeMB_(DEFAULT_LARGE_FILE_SIZE_MB),
       oldFileAgeDays_(DEFAULT_OLD_FILE_AGE_DAYS) {
 }
@@ -42,31 +56,79 @@ bool FileScanner::scanDirectory(const std::string& directoryPath) {
         
         logger_.info("Scanning directory: " + directoryPath);
         
+        // Traced listing time excludes the per-file stats, which are traced separately
+        std::uint64_t listStarted = trace_ ? trace_->now() : 0;
+        std::uint64_t statNanos = 0;
+        long long entryCount = 0;
+        
+        // With a controller the stats are batched onto its I/O pool while listing
+        // continues; statNanos is then the time listing waited for a free slot
+        const std::uint64_t device = controller_ ? ConcurrencyController::deviceOf(directoryPath) : 0;
+        std::vector<fs::directory_entry> pending;
+        std::vector<std::future<std::vector<std::pair<bool, FileInfo>>>> batches;
+        
         // Iterate through directory entries
         for (const auto& entry : fs::directory_iterator(directoryPath)) {
+            entryCount++;
             try {
                 // Only process regular files (skip directories, symlinks, etc.)
-                if (entry.is_regular_file()) {
-                    FileInfo fileInfo = extractFileInfo(entry);
-                    files_.push_back(fileInfo);
-                    
-                    // Check if file is large
-                    if (isLargeFile(fileInfo)) {
-                        largeFiles_.push_back(fileInfo);
-                    }
-                    
-                    // Check if file is old
-                    if (isOldFile(fileInfo)) {
-                        oldFiles_.push_back(fileInfo);
-                    }
+                // and leave a --time-budget plan state and the unknown-extension
+                // sketch where they are
+                if (!entry.is_regular_file() || entry.path().filename() == PLAN_STATE_FILE ||
+                    entry.path().filename() == UNKNOWN_SKETCH_FILE) {
+                    continue;
                 }
             } catch (const std::exception& e) {
-                // Log individual file errors but continue scanning
                 logger_.warning("Error processing file: " + entry.path().string() + 
                               " - " + e.what());
+                continue;
+            }
+            
+            if (controller_) {
+                pending.push_back(entry);
+                if (pending.size() == SCAN_STAT_BATCH) {
+                    std::uint64_t waitStarted = trace_ ? trace_->now() : 0;
+                    batches.push_back(submitStatBatch(std::move(pending), device));
+                    pending.clear();
+                    statNanos += trace_ ? trace_->now() - waitStarted : 0;
+                }
+                continue;
+            }
+            
+            std::uint64_t statStarted = trace_ ? trace_->now() : 0;
+            FileInfo fileInfo;
+            if (statEntry(entry, fileInfo)) {
+                files_.push_back(fileInfo);
             }
+            if (trace_) {
+                statNanos += trace_->now() - statStarted;
+            }
+        }
+        if (controller_) {
+            std::uint64_t waitStarted = trace_ ? trace_->now() : 0;
+            if (!pending.empty()) {
+                batches.push_back(submitStatBatch(std::move(pending), device));
+            }
+            for (auto& batch : batches) {
+                controller_->waitFor(batch);
+                for (auto& [ok, info] : batch.get()) {
+                    if (ok) {
+                        files_.push_back(std::move(info));
+                    }
+                }
+            }
+            statNanos += trace_ ? trace_->now() - waitStarted : 0;
+        }
+        
+        if (trace_) {
+            std::uint64_t listNanos = trace_->now() - listStarted;
+            trace_->recordSpan(TraceOp::LIST_DIR, directoryPath, entryCount, listStarted,
+                               listNanos > statNanos ? listNanos - statNanos : 0);
         }
         
+        // Large/old checks run as one vectorized pass over all files
+        selectLargeAndOldFiles();
+        
         logger_.info("Found " + std::to_string(files_.size()) + " files");
         
         return true;
@@ -108,6 +170,18 @@ void FileScanner::setOldFileAgeDays(int ageDays) {
     logger_.info("Old file threshold set to: " + std::to_string(ageDays) + " days");
 }
 
+void FileScanner::setProgressReporter(ProgressReporter* progress) {
+    progress_ = progress;
+}
+
+void FileScanner::setTraceRecorder(TraceRecorder* trace) {
+    trace_ = trace;
+}
+
+void FileScanner::setConcurrencyController(ConcurrencyController* controller) {
+    controller_ = controller;
+}
+
 //------------------------------------------------------------------------------
 // Helper: Extract File Information
 //------------------------------------------------------------------------------
@@ -120,11 +194,22 @@ FileInfo FileScanner::extractFileInfo(const fs::directory_entry& entry) const {
         info.extension = entry.path().extension().string();
         
         // Convert extension to lowercase for consistent matching
-        std::transform(info.extension.begin(), info.extension.end(), 
-                      info.extension.begin(), ::tolower);
+        SimdKernels::asciiToLower(&info.extension[0], info.extension.size());
         
-        // Get file size
+#ifndef _WIN32
+        // One stat gives size, allocation and mtime; st_blocks counts 512-byte units
+        struct stat status;
+        if (::stat(entry.path().c_str(), &status) != 0) {
+            throw fs::filesystem_error("stat", entry.path(),
+                                       std::error_code(errno, std::generic_category()));
+        }
+        info.sizeBytes = static_cast<long long>(status.st_size);
+        info.allocatedBytes = static_cast<long long>(status.st_blocks) * 512;
+        info.lastModified = status.st_mtime;
+#else
+        // Get file size (no sparse accounting here)
         info.sizeBytes = fs::file_size(entry.path());
+        info.allocatedBytes = info.sizeBytes;
         
         // Get last write time
         auto ftime = fs::last_write_time(entry.path());
@@ -135,6 +220,7 @@ FileInfo FileScanner::extractFileInfo(const fs::directory_entry& entry) const {
             ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now()
         );
         info.lastModified = std::chrono::system_clock::to_time_t(sctp);
+#endif
         
     } catch (const std::exception& e) {
         logger_.warning("Error extracting info for: " + entry.path().string());
@@ -144,11 +230,113 @@ FileInfo FileScanner::extractFileInfo(const fs::directory_entry& entry) const {
     return info;
 }
 
+//------------------------------------------------------------------------------
+// Helper: Stat One Entry
+// Traces and reports progress for the entry; false (with a warning) on error
+//------------------------------------------------------------------------------
+bool FileScanner::statEntry(const fs::directory_entry& entry, FileInfo& info) const {
+    std::uint64_t statStarted = trace_ ? trace_->now() : 0;
+    try {
+        info = extractFileInfo(entry);
+        if (trace_) {
+            trace_->record(TraceOp::STAT, entry.path(), info.sizeBytes, statStarted);
+        }
+        if (progress_) {
+            progress_->addFile(info.sizeBytes);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        if (trace_) {
+            trace_->record(TraceOp::STAT, entry.path(), 0, statStarted, false);
+        }
+        // Log individual file errors but continue scanning
+        logger_.warning("Error processing file: " + entry.path().string() + 
+                      " - " + e.what());
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Submit a Batch of Stats
+// The controller decides how many batches run at once on this device;
+// results come back in directory order
+//------------------------------------------------------------------------------
+std::future<std::vector<std::pair<bool, FileInfo>>> FileScanner::submitStatBatch(
+    std::vector<fs::directory_entry> entries, std::uint64_t device) {
+    std::size_t count = entries.size();
+    return controller_->submit(device, count, [this, entries = std::move(entries)]() {
+        std::vector<std::pair<bool, FileInfo>> results(entries.size());
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            results[i].first = statEntry(entries[i], results[i].second);
+        }
+        return results;
+    });
+}
+
+//------------------------------------------------------------------------------
+// Helper: Select Large and Old Files
+// Same predicates as isLargeFile/isOldFile, expressed as range filters over
+// columnar sizes and mtimes so SimdKernels can evaluate them in bulk. Size
+// means allocated bytes, so sparse images are judged by what they occupy
+//------------------------------------------------------------------------------
+void FileScanner::selectLargeAndOldFiles() {
+    const std::size_t count = files_.size();
+    std::vector<std::int64_t> sizes(count);
+    std::vector<std::int64_t> mtimes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sizes[i] = files_[i].allocatedBytes;
+        mtimes[i] = static_cast<std::int64_t>(files_[i].lastModified);
+    }
+    
+    std::vector<std::uint32_t> indices(count);
+    
+    // allocatedBytes / 1MB >= threshold  <=>  allocatedBytes >= threshold * 1MB
+    std::int64_t minLargeBytes = static_cast<std::int64_t>(largeFileSizeMB_) * 1024 * 1024;
+    std::size_t found = SimdKernels::selectInRange(sizes.data(), count, minLargeBytes,
+                                                   INT64_MAX, indices.data());
+    for (std::size_t i = 0; i < found; ++i) {
+        largeFiles_.push_back(files_[indices[i]]);
+    }
+    std::stable_sort(largeFiles_.begin(), largeFiles_.end(),
+                     [](const FileInfo& a, const FileInfo& b) {
+                         return a.allocatedBytes > b.allocatedBytes;
+                     });
+    
+    // ageDays >= threshold  <=>  lastModified <= now - threshold days
+    auto nowTimeT = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::int64_t cutoff = static_cast<std::int64_t>(nowTimeT) -
+                          static_cast<std::int64_t>(oldFileAgeDays_) * 60 * 60 * 24;
+    found = SimdKernels::selectInRange(mtimes.data(), count, INT64_MIN, cutoff, indices.data());
+    for (std::size_t i = 0; i < found; ++i) {
+        oldFiles_.push_back(files_[indices[i]]);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Stat One File
+// A file that vanished before the stat is expected (watch events race with
+// deletes), so only the unexpected errors are logged
+//------------------------------------------------------------------------------
+bool FileScanner::statFile(const fs::path& path, FileInfo& info) const {
+    std::error_code ec;
+    fs::directory_entry entry(path, ec);
+    if (ec || !entry.is_regular_file(ec) || ec || path.filename() == PLAN_STATE_FILE ||
+        path.filename() == UNKNOWN_SKETCH_FILE) {
+        return false;
+    }
+    try {
+        info = extractFileInfo(entry);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 //------------------------------------------------------------------------------
 // Helper: Check if File is Large
 //------------------------------------------------------------------------------
 bool FileScanner::isLargeFile(const FileInfo& fileInfo) const {
-    long long sizeMB = fileInfo.sizeBytes / (1024 * 1024);
+    long long sizeMB = fileInfo.allocatedBytes / (1024 * 1024);
     return sizeMB >= largeFileSizeMB_;
 }
 
@@ -9,12 +9,18 @@
 #include <string>
 #include <vector>
 #include <filesystem>
+#include <cstdint>
 #include <ctime>
+#include <future>
+#include <utility>
 
 namespace DesktopCleaner {
 
-// Forward declaration
+// Forward declarations
 class Logger;
+class ProgressReporter;
+class TraceRecorder;
+class ConcurrencyController;
 
 //------------------------------------------------------------------------------
 // FileInfo Structure
@@ -24,7 +30,8 @@ struct FileInfo {
     std::filesystem::path path;     // Full path to file
     std::string name;               // File name with extension
     std::string extension;          // File extension (lowercase)
-    long long sizeBytes;            // File size in bytes
+    long long sizeBytes;            // File size in bytes (apparent)
+    long long allocatedBytes;       // Bytes allocated on disk (holes excluded)
     std::time_t lastModified;       // Last modification time
 };
 
@@ -48,11 +55,25 @@ public:
     // Configuration setters
     void setLargeFileSizeMB(long long sizeMB);
     void setOldFileAgeDays(int ageDays);
+    void setProgressReporter(ProgressReporter* progress);
+    void setTraceRecorder(TraceRecorder* trace);
+    void setConcurrencyController(ConcurrencyController* controller); // Parallel stats
+    
+    // Single-file predicates (the scan applies the same rules in bulk)
+    bool isLargeFile(const FileInfo& fileInfo) const;
+    bool isOldFile(const FileInfo& fileInfo) const;
+    
+    // Metadata of one file as a scan would record it; false if the scan
+    // would skip the path or it is gone
+    bool statFile(const std::filesystem::path& path, FileInfo& info) const;
     
 private:
     Logger& logger_;                        // Reference to logger
+    ProgressReporter* progress_;            // Optional progress sink
+    TraceRecorder* trace_;                  // Optional workload trace
+    ConcurrencyController* controller_;     // Optional; stats run in parallel through it
     std::vector<FileInfo> files_;           // All scanned files
-    std::vector<FileInfo> largeFiles_;      // Files exceeding size threshold
+    std::vector<FileInfo> largeFiles_;      // Files exceeding size threshold, most allocated first
     std::vector<FileInfo> oldFiles_;        // Files exceeding age threshold
     
     // Configuration
@@ -61,8 +82,10 @@ private:
     
     // Helper methods
     FileInfo extractFileInfo(const std::filesystem::directory_entry& entry) const;
-    bool isLargeFile(const FileInfo& fileInfo) const;
-    bool isOldFile(const FileInfo& fileInfo) const;
+    bool statEntry(const std::filesystem::directory_entry& entry, FileInfo& info) const;
+    std::future<std::vector<std::pair<bool, FileInfo>>> submitStatBatch(
+        std::vector<std::filesystem::directory_entry> entries, std::uint64_t device);
+    void selectLargeAndOldFiles();
 };
 
 } // namespace DesktopCleaner
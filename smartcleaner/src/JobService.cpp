@@ -0,0 +1,1036 @@
+//==============================================================================
+// JobService.cpp - Unix-Socket Job Service Implementation
+//==============================================================================
+
+#include "JobService.h"
+#include "ContentHash.h"
+#include "DuplicateFinder.h"
+#include "FileClassifier.h"
+#include "FileMover.h"
+#include "LiveStats.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <grp.h>
+#include <poll.h>
+#include <pwd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::size_t MAX_REQUEST_BYTES = 4096;
+const int ACCEPT_POLL_MILLISECONDS = 200;
+
+//------------------------------------------------------------------------------
+// Helper: Job Type Names (wire format)
+//------------------------------------------------------------------------------
+const char* jobTypeName(JobType type) {
+    switch (type) {
+        case JobType::SCAN:     return "scan";
+        case JobType::ORGANIZE: return "organize";
+        case JobType::DEDUPE:   return "dedupe";
+        case JobType::QUERY:    return "query";
+        default:                return "stats";
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Normalize a Directory Key ("/a/b/" and "/a/b" are the same)
+//------------------------------------------------------------------------------
+std::string normalizeDirectory(const std::string& directory) {
+    fs::path normalized(ContentHasher::normalizePath(directory));
+    if (normalized.filename().empty() && normalized.has_parent_path() &&
+        normalized != normalized.root_path()) {
+        normalized = normalized.parent_path();
+    }
+    return normalized.string();
+}
+
+#ifndef _WIN32
+//------------------------------------------------------------------------------
+// Helper: Does the Client Have the Daemon's Rights Anyway?
+//------------------------------------------------------------------------------
+bool clientIsTrusted(long uid) {
+    return uid == 0 || uid == static_cast<long>(geteuid());
+}
+
+//------------------------------------------------------------------------------
+// Helper: May This Client Read (or Change) path?
+// The service runs with the daemon's rights, so it must not lend them out
+//------------------------------------------------------------------------------
+bool clientMayAccess(long uid, long gid, const std::vector<long>& groups,
+                     const struct stat& info, bool write) {
+    if (clientIsTrusted(uid) || static_cast<long>(info.st_uid) == uid) {
+        return true;
+    }
+    if (write) {
+        return false;
+    }
+    long owningGroup = static_cast<long>(info.st_gid);
+    if (owningGroup == gid || std::find(groups.begin(), groups.end(), owningGroup) != groups.end()) {
+        return (info.st_mode & S_IRGRP) != 0;
+    }
+    return (info.st_mode & S_IROTH) != 0;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Supplementary Groups of a User
+//------------------------------------------------------------------------------
+std::vector<long> supplementaryGroups(long uid, long gid) {
+    std::vector<long> groups;
+    long bufferSize = sysconf(_SC_GETPW_R_SIZE_MAX);
+    std::vector<char> buffer(bufferSize > 0 ? static_cast<std::size_t>(bufferSize) : 16384);
+    passwd entry{};
+    passwd* found = nullptr;
+    if (getpwuid_r(static_cast<uid_t>(uid), &entry, buffer.data(), buffer.size(), &found) != 0 ||
+        found == nullptr) {
+        return groups;
+    }
+
+    int count = 64;
+    std::vector<gid_t> ids(static_cast<std::size_t>(count));
+    if (getgrouplist(found->pw_name, static_cast<gid_t>(gid), ids.data(), &count) < 0) {
+        ids.resize(static_cast<std::size_t>(count));
+        if (getgrouplist(found->pw_name, static_cast<gid_t>(gid), ids.data(), &count) < 0) {
+            return groups;
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        groups.push_back(static_cast<long>(ids[static_cast<std::size_t>(i)]));
+    }
+    return groups;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Path That Reaches an Open Directory
+// Names below /proc/self/fd/N resolve against the directory itself, whatever
+// has since been renamed or swapped at its original path
+//------------------------------------------------------------------------------
+std::string pinnedPath(int directoryFd, const std::string& path) {
+#ifdef __linux__
+    std::string pinned = "/proc/self/fd/" + std::to_string(directoryFd);
+    std::error_code ec;
+    if (fs::is_directory(pinned, ec)) {
+        return pinned;
+    }
+#else
+    (void)directoryFd;
+#endif
+    return path;
+}
+
+// Closes a descriptor when the job is done with it
+struct DescriptorGuard {
+    int fd;
+    ~DescriptorGuard() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+#endif
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+JobService::JobService(Logger& logger, ThreadPool& pool, const std::string& socketPath)
+    : logger_(logger),
+      pool_(pool),
+      socketPath_(socketPath.empty() ? defaultSocketPath(true) : socketPath),
+      listenFd_(-1),
+      stopping_(false),
+      runningJobs_(0),
+      readingRequests_(0),
+      nextJobId_(1),
+      completedJobs_(0),
+      mergedJobs_(0),
+      cacheHits_(0),
+      scansRun_(0),
+      largeFileSizeMB_(DEFAULT_LARGE_FILE_SIZE_MB),
+      oldFileAgeDays_(DEFAULT_OLD_FILE_AGE_DAYS),
+      liveStats_(nullptr) {
+}
+
+JobService::~JobService() {
+    stop();
+}
+
+//------------------------------------------------------------------------------
+// Configuration Setters
+//------------------------------------------------------------------------------
+void JobService::setLargeFileSizeMB(long long sizeMB) {
+    largeFileSizeMB_ = sizeMB;
+}
+
+void JobService::setOldFileAgeDays(int ageDays) {
+    oldFileAgeDays_ = ageDays;
+}
+
+void JobService::setLiveStats(const LiveStats* liveStats) {
+    liveStats_ = liveStats;
+}
+
+const std::string& JobService::getSocketPath() const {
+    return socketPath_;
+}
+
+//------------------------------------------------------------------------------
+// Default Socket Path
+//------------------------------------------------------------------------------
+std::string JobService::defaultSocketPath(bool listening) {
+    std::string system = SYSTEM_SOCKET_DIRECTORY + "/" + SOCKET_FILE_NAME;
+#ifndef _WIN32
+    if (listening && geteuid() == 0) {
+        return system;
+    }
+    const char* runtime = std::getenv("XDG_RUNTIME_DIR");
+    if (runtime != nullptr && fs::path(runtime).is_absolute()) {
+        std::string own = std::string(runtime) + "/" + SOCKET_FILE_NAME;
+        std::error_code ec;
+        if (listening || fs::exists(own, ec)) {
+            return own;
+        }
+    }
+#else
+    (void)listening;
+#endif
+    return system;
+}
+
+//------------------------------------------------------------------------------
+// Start Listening
+//------------------------------------------------------------------------------
+bool JobService::start() {
+#ifndef _WIN32
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(address.sun_path)) {
+        logger_.error("Socket path too long: " + socketPath_);
+        return false;
+    }
+    std::strncpy(address.sun_path, socketPath_.c_str(), sizeof(address.sun_path) - 1);
+
+    std::error_code ec;
+    fs::path socketDirectory = fs::path(socketPath_).parent_path();
+    if (socketDirectory.string() == SYSTEM_SOCKET_DIRECTORY && !fs::exists(socketDirectory, ec)) {
+        // Readable by all, writable only by the service
+        if (mkdir(socketDirectory.c_str(), 0755) != 0 && errno != EEXIST) {
+            logger_.error("Cannot create " + socketDirectory.string() + ": " + std::strerror(errno));
+            return false;
+        }
+    }
+
+    // Refuse to steal a live service's socket or anything another user owns;
+    // clear a socket of ours left by a crash
+    struct stat existing;
+    if (lstat(socketPath_.c_str(), &existing) == 0) {
+        if (existing.st_uid != geteuid()) {
+            logger_.error("Refusing socket path owned by uid " + std::to_string(existing.st_uid) +
+                          ": " + socketPath_);
+            return false;
+        }
+        if (!S_ISSOCK(existing.st_mode)) {
+            logger_.error("Refusing socket path that is not a socket: " + socketPath_);
+            return false;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+        bool live = probe >= 0 &&
+                    connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) {
+            ::close(probe);
+        }
+        if (live) {
+            logger_.error("Another service is already listening on " + socketPath_);
+            return false;
+        }
+        if (!fs::remove(socketPath_, ec) && ec) {
+            logger_.error("Cannot remove stale socket " + socketPath_ + ": " + ec.message());
+            return false;
+        }
+    }
+
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        logger_.error("Cannot create socket: " + std::string(std::strerror(errno)));
+        return false;
+    }
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd_, 64) != 0) {
+        logger_.error("Cannot listen on " + socketPath_ + ": " + std::strerror(errno));
+        ::close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+
+    // Every local user who can reach the directory may connect; requests are
+    // checked against the caller's credentials
+    chmod(socketPath_.c_str(), 0666);
+
+    stopping_ = false;
+    acceptThread_ = std::thread(&JobService::acceptLoop, this);
+    dispatchThread_ = std::thread(&JobService::dispatchLoop, this);
+
+    logger_.info("Job service listening on " + socketPath_);
+    return true;
+#else
+    logger_.error("Job service is not supported on this platform");
+    return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Stop: finish running jobs, fail queued ones, remove the socket
+//------------------------------------------------------------------------------
+void JobService::stop() {
+    if (listenFd_ < 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+    if (dispatchThread_.joinable()) {
+        dispatchThread_.join();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this]() { return runningJobs_ == 0 && readingRequests_ == 0; });
+
+    for (auto& [uid, client] : clients_) {
+        for (const auto& job : client.queue) {
+            for (int fd : job->clientFds) {
+                sendAndClose(fd, "ERROR service stopping\n");
+            }
+        }
+        client.queue.clear();
+    }
+    lock.unlock();
+
+#ifndef _WIN32
+    ::close(listenFd_);
+    unlink(socketPath_.c_str());
+#endif
+    listenFd_ = -1;
+    logger_.info("Job service stopped");
+}
+
+//------------------------------------------------------------------------------
+// Seed the Scan Cache
+//------------------------------------------------------------------------------
+void JobService::seedScanCache(const std::string& directory, const FileScanner& scanner) {
+    auto snapshot = std::make_shared<ScanSnapshot>();
+    snapshot->files = scanner.getFiles();
+    snapshot->largeCount = scanner.getLargeFiles().size();
+    snapshot->oldCount = scanner.getOldFiles().size();
+    snapshot->takenAt = std::chrono::steady_clock::now();
+
+    // Requests name directories with symlinks resolved
+    std::error_code ec;
+    fs::path canonical = fs::canonical(directory, ec);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    scanCache_[ec ? normalizeDirectory(directory) : canonical.string()] = snapshot;
+}
+
+//------------------------------------------------------------------------------
+// Accept Loop: read every connection's request at once, each against its own
+// deadline, so a slow client holds up nobody but itself; complete requests
+// are checked and queued on the pool
+//------------------------------------------------------------------------------
+void JobService::acceptLoop() {
+#ifndef _WIN32
+    struct PendingRequest {
+        std::string text;
+        std::chrono::steady_clock::time_point deadline;
+    };
+    std::map<int, PendingRequest> pending;
+
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                break;
+            }
+        }
+
+        std::vector<pollfd> waiting{ pollfd{ listenFd_, POLLIN, 0 } };
+        for (const auto& [fd, request] : pending) {
+            waiting.push_back(pollfd{ fd, POLLIN, 0 });
+        }
+        poll(waiting.data(), waiting.size(), ACCEPT_POLL_MILLISECONDS);
+
+        for (std::size_t i = 1; i < waiting.size(); ++i) {
+            if (waiting[i].revents == 0) {
+                continue;
+            }
+            int clientFd = waiting[i].fd;
+            PendingRequest& request = pending[clientFd];
+            char buffer[512];
+            ssize_t count = recv(clientFd, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                continue;
+            }
+            if (count > 0) {
+                request.text.append(buffer, static_cast<std::size_t>(count));
+            }
+            bool complete = count <= 0 || request.text.find('\n') != std::string::npos ||
+                            request.text.size() >= MAX_REQUEST_BYTES;
+            if (!complete) {
+                continue;
+            }
+
+            std::string line = request.text.substr(0, request.text.find('\n'));
+            pending.erase(clientFd);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                readingRequests_++;
+            }
+            pool_.submit([this, clientFd, line]() {
+                try {
+                    readRequest(clientFd, line);
+                } catch (const std::exception& e) {
+                    logger_.error("Bad job request: " + std::string(e.what()));
+                    sendAndClose(clientFd, "ERROR " + std::string(e.what()) + "\n");
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    readingRequests_--;
+                }
+                condition_.notify_all();
+            });
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (now >= it->second.deadline) {
+                sendAndClose(it->first, "ERROR request timed out\n");
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if ((waiting[0].revents & POLLIN) != 0) {
+            int clientFd = accept(listenFd_, nullptr, nullptr);
+            if (clientFd < 0) {
+                continue;
+            }
+            if (pending.size() >= SERVICE_MAX_PENDING_REQUESTS) {
+                sendAndClose(clientFd, "ERROR service busy\n");
+                continue;
+            }
+            pending[clientFd].deadline = now + std::chrono::seconds(SERVICE_REQUEST_TIMEOUT_SECONDS);
+        }
+    }
+
+    for (const auto& [fd, request] : pending) {
+        sendAndClose(fd, "ERROR service stopping\n");
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Check and Queue a Request
+//------------------------------------------------------------------------------
+void JobService::readRequest(int clientFd, const std::string& line) {
+#ifndef _WIN32
+    auto job = std::make_shared<Job>();
+    std::istringstream fields(line);
+    std::string typeName;
+    std::string flags;
+    if (!(fields >> typeName >> job->priority >> flags) || !parseJobType(typeName, job->type)) {
+        throw std::runtime_error("malformed request");
+    }
+    std::getline(fields >> std::ws, job->path);
+    job->priority = std::clamp(job->priority, 0, MAX_JOB_PRIORITY);
+    job->dryRun = (flags == "dry-run");
+
+    // Who is asking (fair share and permission checks)
+#ifdef SO_PEERCRED
+    ucred credentials{};
+    socklen_t length = sizeof(credentials);
+    if (getsockopt(clientFd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0) {
+        job->clientUid = static_cast<long>(credentials.uid);
+        job->clientGid = static_cast<long>(credentials.gid);
+    }
+#else
+    uid_t peerUid;
+    gid_t peerGid;
+    if (getpeereid(clientFd, &peerUid, &peerGid) == 0) {
+        job->clientUid = static_cast<long>(peerUid);
+        job->clientGid = static_cast<long>(peerGid);
+    }
+#endif
+
+    if (job->type == JobType::STATS) {
+        sendAndClose(clientFd, formatStats() + "OK\n");
+        return;
+    }
+
+    if (job->path.empty() || !fs::path(job->path).is_absolute()) {
+        throw std::runtime_error("path must be absolute");
+    }
+    if (job->clientUid >= 0 && !clientIsTrusted(job->clientUid)) {
+        job->clientGroups = supplementaryGroups(job->clientUid, job->clientGid);
+    }
+
+    // Symlinks are resolved once, here; the directory checked below is then
+    // pinned by device and inode, and execute() insists on that very one
+    fs::path requested(ContentHasher::normalizePath(job->path));
+    bool query = job->type == JobType::QUERY;
+    std::error_code ec;
+    fs::path directory = fs::canonical(query ? requested.parent_path() : requested, ec);
+    if (ec) {
+        throw std::runtime_error("cannot access " + job->path);
+    }
+    job->path = query ? (directory / requested.filename()).string() : directory.string();
+
+    struct stat info;
+    if (lstat(directory.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        throw std::runtime_error("cannot access " + job->path);
+    }
+    if (!clientMayAccess(job->clientUid, job->clientGid, job->clientGroups, info,
+                         job->type == JobType::ORGANIZE && !job->dryRun)) {
+        throw std::runtime_error("permission denied for " + job->path);
+    }
+    job->device = static_cast<std::uint64_t>(info.st_dev);
+    job->inode = static_cast<std::uint64_t>(info.st_ino);
+    job->clientFds.push_back(clientFd);
+
+    enqueue(job);
+#else
+    (void)clientFd;
+    (void)line;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Enqueue: merge into an identical waiting job, else queue for the client
+//------------------------------------------------------------------------------
+void JobService::enqueue(const std::shared_ptr<Job>& job) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& [uid, client] : clients_) {
+        for (auto& queued : client.queue) {
+            // Replies are filtered by what the client may read, so only
+            // requests with the same rights share one
+            bool sameRights = queued->clientUid == job->clientUid ||
+                              (clientIsTrusted(queued->clientUid) && clientIsTrusted(job->clientUid));
+            if (queued->type == job->type && queued->path == job->path &&
+                queued->dryRun == job->dryRun && sameRights) {
+                queued->clientFds.push_back(job->clientFds.front());
+                queued->priority = std::max(queued->priority, job->priority);
+                mergedJobs_++;
+                logger_.fileEvent(LogLevel::INFO, "Merged " + std::string(jobTypeName(job->type)) +
+                                  " job for " + job->path);
+                return;
+            }
+        }
+    }
+
+    ClientState& client = clients_[job->clientUid];
+    if (client.queue.empty()) {
+        // A returning client starts level with the busiest one; idle time is not banked
+        double floor = -1.0;
+        for (const auto& [uid, other] : clients_) {
+            if (!other.queue.empty() && (floor < 0.0 || other.virtualTime < floor)) {
+                floor = other.virtualTime;
+            }
+        }
+        client.virtualTime = std::max(client.virtualTime, floor);
+    }
+
+    job->id = nextJobId_++;
+    client.queue.push_back(job);
+    logger_.fileEvent(LogLevel::INFO, "Queued " + std::string(jobTypeName(job->type)) +
+                      " job " + std::to_string(job->id) + " for " + job->path +
+                      " (uid " + std::to_string(job->clientUid) + ")");
+    condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// Dispatch Loop: fair share, then priority, one job per device
+//------------------------------------------------------------------------------
+void JobService::dispatchLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+        std::shared_ptr<Job> next;
+        ClientState* owner = nullptr;
+        std::size_t position = 0;
+
+        condition_.wait(lock, [&]() {
+            if (stopping_) {
+                return true;
+            }
+            if (runningJobs_ >= pool_.getThreadCount()) {
+                return false;
+            }
+
+            next.reset();
+            owner = nullptr;
+            for (auto& [uid, client] : clients_) {
+                if (owner != nullptr && client.virtualTime >= owner->virtualTime) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < client.queue.size(); ++i) {
+                    const auto& candidate = client.queue[i];
+                    if (busyDevices_.count(candidate->device) > 0) {
+                        continue;
+                    }
+                    bool better = owner != &client || candidate->priority > next->priority ||
+                                  (candidate->priority == next->priority && candidate->id < next->id);
+                    if (better) {
+                        next = candidate;
+                        owner = &client;
+                        position = i;
+                    }
+                }
+            }
+            return next != nullptr;
+        });
+
+        if (stopping_) {
+            return;
+        }
+
+        owner->queue.erase(owner->queue.begin() + static_cast<std::ptrdiff_t>(position));
+        busyDevices_[next->device] = true;
+        runningJobs_++;
+
+        pool_.submit([this, next]() { runJob(next); });
+    }
+}
+
+//------------------------------------------------------------------------------
+// Run a Job and Reply to Every Merged Client
+//------------------------------------------------------------------------------
+void JobService::runJob(const std::shared_ptr<Job>& job) {
+    auto start = std::chrono::steady_clock::now();
+    std::string output;
+
+    try {
+        execute(*job, output);
+    } catch (const std::exception& e) {
+        logger_.error("Job " + std::to_string(job->id) + " failed: " + e.what());
+        output += "ERROR " + std::string(e.what()) + "\n";
+    }
+
+    std::vector<int> clientFds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clientFds = job->clientFds; // Late merges are impossible once running
+    }
+    for (int fd : clientFds) {
+        sendAndClose(fd, output);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busyDevices_.erase(job->device);
+        runningJobs_--;
+        completedJobs_ += clientFds.size();
+        clients_[job->clientUid].virtualTime += elapsed;
+    }
+    condition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// Execute One Job
+//------------------------------------------------------------------------------
+bool JobService::execute(const Job& job, std::string& output) {
+    std::ostringstream out;
+
+#ifndef _WIN32
+    DescriptorGuard directory{ -1 };
+    if (job.type != JobType::STATS) {
+        directory.fd = openJobDirectory(job, job.type == JobType::QUERY
+                                                 ? fs::path(job.path).parent_path().string()
+                                                 : job.path);
+    }
+#endif
+
+    switch (job.type) {
+        case JobType::SCAN: {
+            auto snapshot = getSnapshot(job.path);
+            long long totalBytes = 0;
+            for (const auto& file : snapshot->files) {
+                totalBytes += file.sizeBytes;
+            }
+            out << "files " << snapshot->files.size() << '\n'
+                << "large " << snapshot->largeCount << '\n'
+                << "old " << snapshot->oldCount << '\n'
+                << "bytes " << totalBytes << '\n';
+            break;
+        }
+
+        case JobType::ORGANIZE: {
+            // Scan and move through the open directory, so a path swapped for
+            // a symlink after the check cannot redirect the moves
+#ifndef _WIN32
+            std::string base = pinnedPath(directory.fd, job.path);
+#else
+            std::string base = job.path;
+#endif
+            FileScanner scanner(logger_);
+            scanner.setLargeFileSizeMB(largeFileSizeMB_);
+            scanner.setOldFileAgeDays(oldFileAgeDays_);
+            if (!scanner.scanDirectory(base)) {
+                throw std::runtime_error("scan failed: " + job.path);
+            }
+            FileClassifier classifier(logger_);
+            classifier.classifyFiles(scanner.getFiles());
+
+            FileMover mover(logger_, job.dryRun);
+            mover.setRecordedBase(base, job.path);
+            bool organized = mover.organizeFiles(base, classifier.getCategorizedFiles());
+            if (!job.dryRun) {
+                invalidateSnapshot(job.path);
+            }
+
+            out << "moved " << mover.getSuccessCount() << '\n'
+                << "failed " << mover.getFailCount() << '\n'
+                << "warnings " << mover.getWarningCount() << '\n';
+            if (!organized) {
+                output = out.str() + "ERROR organize failed\n";
+                return false;
+            }
+            break;
+        }
+
+        case JobType::DEDUPE: {
+            auto snapshot = getSnapshot(job.path);
+            std::unique_ptr<DuplicateFinder> filtered;
+            const DuplicateFinder& duplicates = getDuplicates(job, *snapshot, filtered);
+            out << "groups " << duplicates.getGroups().size() << '\n'
+                << "reclaimable " << duplicates.getReclaimableBytes() << '\n';
+
+            std::size_t listed = 0;
+            for (const auto& group : duplicates.getGroups()) {
+                for (std::size_t i = 1; i < group.files.size() && listed < SERVICE_MAX_LISTED_COPIES; ++i) {
+                    out << "copy " << group.files[i].path.string() << '\n';
+                    listed++;
+                }
+            }
+            break;
+        }
+
+        case JobType::QUERY: {
+            fs::path file(job.path);
+            auto snapshot = getSnapshot(file.parent_path().string());
+
+            auto it = std::find_if(snapshot->files.begin(), snapshot->files.end(),
+                                   [&file](const FileInfo& info) {
+                                       return info.name == file.filename().string();
+                                   });
+            if (it == snapshot->files.end()) {
+                output = "ERROR not a regular file: " + job.path + "\n";
+                return false;
+            }
+            std::vector<FileInfo> readable;
+            if (!readableFiles(job, { *it }, readable) && readable.empty()) {
+                output = "ERROR permission denied for " + job.path + "\n";
+                return false;
+            }
+
+            FileClassifier classifier(logger_);
+            classifier.classifyFiles({ *it });
+            std::string category = CATEGORY_OTHERS;
+            for (const auto& [name, files] : classifier.getCategorizedFiles()) {
+                if (!files.empty()) {
+                    category = name;
+                }
+            }
+
+            std::unique_ptr<DuplicateFinder> filtered;
+            DuplicateStatus status = getDuplicates(job, *snapshot, filtered).getStatus(it->path.string());
+            out << "category " << category << '\n'
+                << "duplicate " << duplicateStatusName(status) << '\n'
+                << "size " << it->sizeBytes << '\n';
+            break;
+        }
+
+        case JobType::STATS:
+            out << formatStats();
+            break;
+    }
+
+    output = out.str() + "OK\n";
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Scan Cache
+//------------------------------------------------------------------------------
+std::shared_ptr<JobService::ScanSnapshot> JobService::getSnapshot(const std::string& directory) {
+    auto now = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = scanCache_.find(directory);
+        if (it != scanCache_.end() &&
+            now - it->second->takenAt < std::chrono::seconds(SERVICE_SCAN_CACHE_SECONDS)) {
+            cacheHits_++;
+            return it->second;
+        }
+    }
+
+    // Jobs on one device never overlap, so no two scans of a directory race here
+    FileScanner scanner(logger_);
+    scanner.setLargeFileSizeMB(largeFileSizeMB_);
+    scanner.setOldFileAgeDays(oldFileAgeDays_);
+    if (!scanner.scanDirectory(directory)) {
+        throw std::runtime_error("scan failed: " + directory);
+    }
+
+    auto snapshot = std::make_shared<ScanSnapshot>();
+    snapshot->files = scanner.getFiles();
+    snapshot->largeCount = scanner.getLargeFiles().size();
+    snapshot->oldCount = scanner.getOldFiles().size();
+    snapshot->takenAt = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    scansRun_++;
+    if (scanCache_.size() >= SERVICE_SCAN_CACHE_MAX_ENTRIES && scanCache_.count(directory) == 0) {
+        auto oldest = std::min_element(scanCache_.begin(), scanCache_.end(),
+                                       [](const auto& a, const auto& b) {
+                                           return a.second->takenAt < b.second->takenAt;
+                                       });
+        scanCache_.erase(oldest);
+    }
+    scanCache_[directory] = snapshot;
+    return snapshot;
+}
+
+const DuplicateFinder& JobService::getDuplicates(ScanSnapshot& snapshot) {
+    std::lock_guard<std::mutex> lock(snapshot.duplicatesMutex);
+    if (!snapshot.duplicates) {
+        snapshot.duplicates = std::make_unique<DuplicateFinder>(logger_, pool_);
+        snapshot.duplicates->findDuplicates(snapshot.files);
+    }
+    return *snapshot.duplicates;
+}
+
+//------------------------------------------------------------------------------
+// Duplicates a Client May See
+// Hashes of files the client cannot read would tell it about their content,
+// so such files are left out and the groups found among the rest
+//------------------------------------------------------------------------------
+const DuplicateFinder& JobService::getDuplicates(const Job& job, ScanSnapshot& snapshot,
+                                                 std::unique_ptr<DuplicateFinder>& filtered) {
+    std::vector<FileInfo> readable;
+    if (readableFiles(job, snapshot.files, readable)) {
+        return getDuplicates(snapshot);
+    }
+    filtered = std::make_unique<DuplicateFinder>(logger_, pool_);
+    filtered->findDuplicates(readable);
+    return *filtered;
+}
+
+//------------------------------------------------------------------------------
+// Files the Client May Read
+// Returns true (and leaves readable empty) when that is all of them. The
+// check follows symlinks, as the hashing does.
+//------------------------------------------------------------------------------
+bool JobService::readableFiles(const Job& job, const std::vector<FileInfo>& files,
+                               std::vector<FileInfo>& readable) const {
+    readable.clear();
+#ifndef _WIN32
+    if (clientIsTrusted(job.clientUid)) {
+        return true;
+    }
+    for (const auto& file : files) {
+        struct stat info;
+        if (stat(file.path.c_str(), &info) == 0 &&
+            clientMayAccess(job.clientUid, job.clientGid, job.clientGroups, info, false)) {
+            readable.push_back(file);
+        }
+    }
+    if (readable.size() == files.size()) {
+        readable.clear();
+        return true;
+    }
+    return false;
+#else
+    (void)job;
+    (void)files;
+    return true;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Open a Job's Directory
+// It must still be the directory checked when the job was queued, and the
+// client must still have its rights there
+//------------------------------------------------------------------------------
+int JobService::openJobDirectory(const Job& job, const std::string& directory) {
+#ifndef _WIN32
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        throw std::runtime_error("cannot access " + directory);
+    }
+    if (static_cast<std::uint64_t>(info.st_dev) != job.device ||
+        static_cast<std::uint64_t>(info.st_ino) != job.inode) {
+        ::close(fd);
+        throw std::runtime_error("directory replaced since the request: " + directory);
+    }
+    if (!clientMayAccess(job.clientUid, job.clientGid, job.clientGroups, info,
+                         job.type == JobType::ORGANIZE && !job.dryRun)) {
+        ::close(fd);
+        throw std::runtime_error("permission denied for " + directory);
+    }
+    return fd;
+#else
+    (void)job;
+    (void)directory;
+    return -1;
+#endif
+}
+
+void JobService::invalidateSnapshot(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    scanCache_.erase(directory);
+}
+
+//------------------------------------------------------------------------------
+// Service Statistics
+//------------------------------------------------------------------------------
+std::string JobService::formatStats() {
+    std::ostringstream out;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t queued = 0;
+        for (const auto& [uid, client] : clients_) {
+            queued += client.queue.size();
+        }
+        out << "queued " << queued << '\n'
+            << "running " << runningJobs_ << '\n'
+            << "completed " << completedJobs_ << '\n'
+            << "merged " << mergedJobs_ << '\n';
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    out << "scans " << scansRun_ << '\n'
+        << "cache-hits " << cacheHits_ << '\n'
+        << "cached-directories " << scanCache_.size() << '\n';
+    if (liveStats_) {
+        out << liveStats_->format();
+    }
+    return out.str();
+}
+
+//------------------------------------------------------------------------------
+// Client Side
+//------------------------------------------------------------------------------
+bool JobService::parseJobType(const std::string& name, JobType& type) {
+    for (JobType candidate : { JobType::SCAN, JobType::ORGANIZE, JobType::DEDUPE,
+                               JobType::QUERY, JobType::STATS }) {
+        if (name == jobTypeName(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobService::submitJob(const std::string& requestedPath, const std::string& request,
+                           std::string& response) {
+#ifndef _WIN32
+    std::string socketPath = requestedPath.empty() ? defaultSocketPath(false) : requestedPath;
+
+    // Only a root service or one of our own may receive our paths
+    struct stat owner;
+    if (lstat(socketPath.c_str(), &owner) == 0 && owner.st_uid != 0 && owner.st_uid != geteuid()) {
+        response = "ERROR refusing socket owned by uid " + std::to_string(owner.st_uid) + ": " +
+                   socketPath + "\n";
+        return false;
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        response = "ERROR socket path too long\n";
+        return false;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        response = "ERROR no service listening on " + socketPath + "\n";
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    std::string line = request + "\n";
+    send(fd, line.data(), line.size(), MSG_NOSIGNAL);
+    shutdown(fd, SHUT_WR);
+
+    response.clear();
+    char buffer[4096];
+    ssize_t count;
+    while ((count = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<std::size_t>(count));
+    }
+    ::close(fd);
+    return true;
+#else
+    (void)requestedPath;
+    (void)request;
+    response = "ERROR job service is not supported on this platform\n";
+    return false;
+#endif
+}
+
+void JobService::sendAndClose(int fd, const std::string& text) {
+#ifndef _WIN32
+    std::size_t sent = 0;
+    while (sent < text.size()) {
+        ssize_t count = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (count <= 0) {
+            break; // Client went away; the job result is in the log
+        }
+        sent += static_cast<std::size_t>(count);
+    }
+    ::close(fd);
+#else
+    (void)fd;
+    (void)text;
+#endif
+}
+
+} // namespace DesktopCleaner
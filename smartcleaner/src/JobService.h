@@ -0,0 +1,165 @@
+//==============================================================================
+// JobService.h - Unix-Socket Job Service Interface
+//==============================================================================
+//
+// Wire format (one job per connection, text, '\n'-terminated lines):
+//   request:  <type> <priority 0-9> <flags> <absolute path>
+//             type  = scan | organize | dedupe | query | stats
+//             flags = "-" or "dry-run"
+//   response: zero or more "<key> <value>" lines, then "OK" or "ERROR <message>"
+//
+//==============================================================================
+
+#ifndef JOB_SERVICE_H
+#define JOB_SERVICE_H
+
+#include "FileScanner.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+class DuplicateFinder;
+class LiveStats;
+
+//------------------------------------------------------------------------------
+// Job Types
+//------------------------------------------------------------------------------
+enum class JobType {
+    SCAN,
+    ORGANIZE,
+    DEDUPE,
+    QUERY,
+    STATS
+};
+
+//------------------------------------------------------------------------------
+// JobService Class
+// Accepts jobs on a Unix socket and runs them on the shared ThreadPool.
+// Scheduling: fair share between client users (least virtual run time goes
+// first), then job priority, then arrival. At most one job per device runs
+// at a time; identical queued jobs are merged, and recent scans are reused.
+//------------------------------------------------------------------------------
+class JobService {
+public:
+    // Constructor / Destructor (an empty socketPath means defaultSocketPath(true))
+    JobService(Logger& logger, ThreadPool& pool, const std::string& socketPath);
+    ~JobService();
+
+    JobService(const JobService&) = delete;
+    JobService& operator=(const JobService&) = delete;
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Configuration setters (scan thresholds for jobs)
+    void setLargeFileSizeMB(long long sizeMB);
+    void setOldFileAgeDays(int ageDays);
+    void setLiveStats(const LiveStats* liveStats);  // Appended to stats replies; set before start()
+
+    // Share a scan the daemon already did, so jobs on that directory skip it
+    void seedScanCache(const std::string& directory, const FileScanner& scanner);
+
+    const std::string& getSocketPath() const;
+
+    // Client side: send one request, copy the response lines to output
+    static bool submitJob(const std::string& socketPath, const std::string& request,
+                          std::string& response);
+    static bool parseJobType(const std::string& name, JobType& type);
+
+    // A root service listens in SYSTEM_SOCKET_DIRECTORY, anyone else in
+    // $XDG_RUNTIME_DIR; a client tries its own runtime directory first
+    static std::string defaultSocketPath(bool listening);
+
+private:
+    // One scan of one directory, shared by every job that reads it
+    struct ScanSnapshot {
+        std::vector<FileInfo> files;
+        std::size_t largeCount = 0;
+        std::size_t oldCount = 0;
+        std::chrono::steady_clock::time_point takenAt;
+        std::mutex duplicatesMutex;                 // Guards lazy duplicate detection
+        std::unique_ptr<DuplicateFinder> duplicates;
+    };
+
+    struct Job {
+        std::uint64_t id = 0;
+        JobType type = JobType::SCAN;
+        int priority = 0;
+        bool dryRun = false;
+        std::string path;
+        std::uint64_t device = 0;                   // st_dev of path (serialization key)
+        std::uint64_t inode = 0;                    // st_ino of the directory checked at queue time
+        long clientUid = -1;
+        long clientGid = -1;
+        std::vector<long> clientGroups;             // Supplementary groups, for read checks
+        std::vector<int> clientFds;                 // Merged requests share one run
+    };
+
+    struct ClientState {
+        double virtualTime = 0.0;                   // Seconds of service consumed
+        std::deque<std::shared_ptr<Job>> queue;     // Waiting jobs
+    };
+
+    Logger& logger_;                                // Reference to logger
+    ThreadPool& pool_;                              // Shared executor
+    std::string socketPath_;                        // Listening socket path
+    int listenFd_;                                  // -1 when not listening
+    std::thread acceptThread_;                      // Reads requests, all at once
+    std::thread dispatchThread_;                    // Picks the next job
+
+    std::mutex mutex_;                              // Guards everything below
+    std::condition_variable condition_;             // Queue / completion changes
+    bool stopping_;
+    std::map<long, ClientState> clients_;           // By client uid
+    std::map<std::uint64_t, bool> busyDevices_;     // Devices with a running job
+    std::size_t runningJobs_;
+    std::size_t readingRequests_;                   // Requests being checked on the pool
+    std::uint64_t nextJobId_;
+    std::uint64_t completedJobs_;
+    std::uint64_t mergedJobs_;
+
+    std::mutex cacheMutex_;                         // Guards the scan cache
+    std::map<std::string, std::shared_ptr<ScanSnapshot>> scanCache_;
+    std::uint64_t cacheHits_;
+    std::uint64_t scansRun_;
+
+    long long largeFileSizeMB_;
+    int oldFileAgeDays_;
+    const LiveStats* liveStats_;                    // Optional watch-mode totals
+
+    // Helper methods
+    void acceptLoop();
+    void dispatchLoop();
+    void readRequest(int clientFd, const std::string& line);
+    void enqueue(const std::shared_ptr<Job>& job);
+    void runJob(const std::shared_ptr<Job>& job);
+    bool execute(const Job& job, std::string& output);
+    int openJobDirectory(const Job& job, const std::string& directory);
+    bool readableFiles(const Job& job, const std::vector<FileInfo>& files,
+                       std::vector<FileInfo>& readable) const;
+    const DuplicateFinder& getDuplicates(const Job& job, ScanSnapshot& snapshot,
+                                         std::unique_ptr<DuplicateFinder>& filtered);
+    std::shared_ptr<ScanSnapshot> getSnapshot(const std::string& directory);
+    const DuplicateFinder& getDuplicates(ScanSnapshot& snapshot);
+    void invalidateSnapshot(const std::string& directory);
+    std::string formatStats();
+    static void sendAndClose(int fd, const std::string& text);
+};
+
+} // namespace DesktopCleaner
+
+#endif // JOB_SERVICE_H
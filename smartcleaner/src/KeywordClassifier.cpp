@@ -0,0 +1,273 @@
+//==============================================================================
+// KeywordClassifier.cpp - Keyword Sub-Classification Implementation
+//==============================================================================
+
+#include "KeywordClassifier.h"
+#include "FileClassifier.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::int32_t NO_RULE = std::numeric_limits<std::int32_t>::max();
+
+unsigned char foldCase(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+std::string trim(const std::string& text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    std::size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+KeywordClassifier::KeywordClassifier(Logger& logger)
+    : logger_(logger), byteClass_{}, classCount_(1), firstBytes_{} {
+    setRules(getDefaultKeywordRules());
+}
+
+//------------------------------------------------------------------------------
+// Load Rules File
+//------------------------------------------------------------------------------
+bool KeywordClassifier::loadRules(const std::string& path) {
+    std::ifstream input(path);
+    if (!input) {
+        logger_.error("Cannot open keyword rules: " + path);
+        return false;
+    }
+
+    std::vector<Rule> rules;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            logger_.error("Keyword rules " + path + ":" + std::to_string(lineNumber) +
+                          ": expected \"Category: keyword, keyword\"");
+            return false;
+        }
+
+        Rule rule{ trim(line.substr(0, colon)), {} };
+        std::size_t start = colon + 1;
+        while (start <= line.size()) {
+            std::size_t comma = line.find(',', start);
+            if (comma == std::string::npos) {
+                comma = line.size();
+            }
+            std::string keyword = trim(line.substr(start, comma - start));
+            if (!keyword.empty()) {
+                rule.second.push_back(keyword);
+            }
+            start = comma + 1;
+        }
+        rules.push_back(std::move(rule));
+    }
+
+    if (!setRules(rules)) {
+        return false;
+    }
+    logger_.info("Loaded " + std::to_string(categories_.size()) + " keyword rules from " + path);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Set Rules
+// Builds the trie, then completes it breadth-first: a missing transition
+// borrows the one of the longest proper suffix that is also a trie node,
+// which leaves a DFA with one table load per input byte
+//------------------------------------------------------------------------------
+bool KeywordClassifier::setRules(const std::vector<Rule>& rules) {
+    // Category index per rule; repeated categories share one index
+    std::vector<std::string> categories;
+    std::vector<std::vector<std::string>> keywords;
+    for (const auto& [category, words] : rules) {
+        if (!FileClassifier::isValidCategoryName(category, false)) {
+            logger_.error("Invalid keyword category \"" + category + "\"");
+            return false;
+        }
+        auto found = std::find(categories.begin(), categories.end(), category);
+        if (found == categories.end()) {
+            found = categories.insert(categories.end(), category);
+            keywords.emplace_back();
+        }
+        auto& list = keywords[static_cast<std::size_t>(found - categories.begin())];
+        for (const auto& word : words) {
+            std::string folded;
+            for (unsigned char c : word) {
+                folded.push_back(static_cast<char>(foldCase(c)));
+            }
+            if (!folded.empty()) {
+                list.push_back(folded);
+            }
+        }
+    }
+
+    // Byte classes: one per distinct keyword byte, both cases of a letter alike
+    std::fill(std::begin(byteClass_), std::end(byteClass_), 0);
+    classCount_ = 1;
+    std::vector<unsigned char> firstBytes;
+    for (const auto& list : keywords) {
+        for (const auto& word : list) {
+            for (unsigned char c : word) {
+                if (byteClass_[c] == 0) {
+                    byteClass_[c] = static_cast<std::uint8_t>(classCount_++);
+                }
+            }
+            firstBytes.push_back(static_cast<unsigned char>(word[0]));
+        }
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        byteClass_[c] = byteClass_[c | 0x20];
+        if (byteClass_[c] != 0 &&
+            std::find(firstBytes.begin(), firstBytes.end(), c | 0x20) != firstBytes.end()) {
+            firstBytes.push_back(static_cast<unsigned char>(c));
+        }
+    }
+
+    // Trie
+    std::vector<std::int32_t> transitions(classCount_, -1);
+    std::vector<std::int32_t> bestRule(1, NO_RULE);
+    for (std::size_t rule = 0; rule < keywords.size(); ++rule) {
+        for (const auto& word : keywords[rule]) {
+            std::int32_t state = 0;
+            for (unsigned char c : word) {
+                std::int32_t& next = transitions[state * classCount_ + byteClass_[c]];
+                if (next < 0) {
+                    next = static_cast<std::int32_t>(bestRule.size());
+                    bestRule.push_back(NO_RULE);
+                    transitions.resize(transitions.size() + classCount_, -1);
+                }
+                state = transitions[state * classCount_ + byteClass_[c]];
+            }
+            bestRule[state] = std::min(bestRule[state], static_cast<std::int32_t>(rule));
+        }
+    }
+
+    // Failure links folded into the transition table
+    std::vector<std::int32_t> failure(bestRule.size(), 0);
+    std::vector<std::int32_t> queue;
+    for (std::size_t c = 0; c < classCount_; ++c) {
+        std::int32_t& next = transitions[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        std::int32_t state = queue[head];
+        std::int32_t fail = failure[state];
+        bestRule[state] = std::min(bestRule[state], bestRule[fail]);
+        for (std::size_t c = 0; c < classCount_; ++c) {
+            std::int32_t& next = transitions[state * classCount_ + c];
+            std::int32_t fallback = transitions[fail * classCount_ + c];
+            if (next < 0) {
+                next = fallback;
+            } else {
+                failure[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    categories_ = std::move(categories);
+    transitions_ = std::move(transitions);
+    bestRule_ = std::move(bestRule);
+    firstBytes_ = SimdKernels::makeByteSet(firstBytes);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+const std::vector<std::string>& KeywordClassifier::getCategories() const {
+    return categories_;
+}
+
+//------------------------------------------------------------------------------
+// Match
+// The first-rule keyword cannot be beaten, so its hit ends the scan early
+//------------------------------------------------------------------------------
+int KeywordClassifier::match(const unsigned char* data, std::size_t length) const {
+    const std::int32_t* table = transitions_.data();
+    std::int32_t best = NO_RULE;
+    std::int32_t state = 0;
+
+    std::size_t i = 0;
+    while (i < length) {
+        if (state == 0) {
+            i += SimdKernels::findInSet(data + i, length - i, firstBytes_);
+            if (i >= length) {
+                break;
+            }
+        }
+        state = table[state * classCount_ + byteClass_[data[i++]]];
+        if (bestRule_[state] < best) {
+            best = bestRule_[state];
+            if (best == 0) {
+                break;
+            }
+        }
+    }
+    return best == NO_RULE ? -1 : best;
+}
+
+//------------------------------------------------------------------------------
+// Classify
+//------------------------------------------------------------------------------
+std::vector<int> KeywordClassifier::classify(const std::vector<FileInfo>& files,
+                                             ThreadPool* pool) const {
+    std::vector<int> result(files.size(), -1);
+    if (categories_.empty()) {
+        return result;
+    }
+
+    runInBatches(pool, files.size(), KEYWORD_BATCH_FILES,
+                 [this, &files, &result](std::size_t begin, std::size_t end) {
+                     classifyRange(files, begin, end, result);
+                 });
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Classify a Range of Files
+// One prefix buffer per task; unreadable files simply stay unmatched
+//------------------------------------------------------------------------------
+void KeywordClassifier::classifyRange(const std::vector<FileInfo>& files, std::size_t begin,
+                                      std::size_t end, std::vector<int>& result) const {
+    std::vector<char> buffer(KEYWORD_PREFIX_BYTES);
+    for (std::size_t i = begin; i < end; ++i) {
+        const FileInfo& file = files[i];
+        if (file.sizeBytes <= 0 || KEYWORD_TEXT_EXTENSIONS.count(file.extension) == 0) {
+            continue;
+        }
+        std::ifstream input(file.path, std::ios::binary);
+        if (!input) {
+            continue;
+        }
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::size_t length = static_cast<std::size_t>(input.gcount());
+        result[i] = match(reinterpret_cast<const unsigned char*>(buffer.data()), length);
+    }
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,68 @@
+//==============================================================================
+// KeywordClassifier.h - Keyword Sub-Classification Interface
+//==============================================================================
+
+#ifndef KEYWORD_CLASSIFIER_H
+#define KEYWORD_CLASSIFIER_H
+
+#include "FileScanner.h"
+#include "SimdKernels.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// KeywordClassifier Class
+// Matches every rule keyword at once with an Aho-Corasick automaton over the
+// first KEYWORD_PREFIX_BYTES of each text-like file. ASCII letters match
+// case-insensitively. While the automaton sits at its root, a SIMD byte-set
+// search skips straight to the next byte that can start a keyword.
+//------------------------------------------------------------------------------
+class KeywordClassifier {
+public:
+    using Rule = std::pair<std::string, std::vector<std::string>>;  // Category -> keywords
+
+    // Constructor (starts with getDefaultKeywordRules())
+    explicit KeywordClassifier(Logger& logger);
+
+    // Rule configuration: "Category: keyword, keyword" lines, # comments
+    bool loadRules(const std::string& path);
+    bool setRules(const std::vector<Rule>& rules);
+
+    // Categories in rule order
+    const std::vector<std::string>& getCategories() const;
+
+    // Index into getCategories() for each file, or -1 where nothing matched
+    // or the file is not text-like
+    std::vector<int> classify(const std::vector<FileInfo>& files, ThreadPool* pool) const;
+
+    // Lowest rule index with a keyword in data, or -1
+    int match(const unsigned char* data, std::size_t length) const;
+
+private:
+    Logger& logger_;                                // Reference to logger
+    std::vector<std::string> categories_;
+
+    // Automaton: a dense DFA over byte classes; class 0 is every byte that
+    // appears in no keyword and always leads back to the root
+    std::uint8_t byteClass_[256];
+    std::size_t classCount_;
+    std::vector<std::int32_t> transitions_;         // state * classCount_ + class -> state
+    std::vector<std::int32_t> bestRule_;            // Lowest rule ending at state or a suffix
+    ByteSet firstBytes_;                            // Bytes that leave the root
+
+    // Helper methods
+    void classifyRange(const std::vector<FileInfo>& files, std::size_t begin, std::size_t end,
+                       std::vector<int>& result) const;
+};
+
+} // namespace DesktopCleaner
+
+#endif // KEYWORD_CLASSIFIER_H
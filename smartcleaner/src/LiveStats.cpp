@@ -0,0 +1,325 @@
+//==============================================================================
+// LiveStats.cpp - Incrementally Maintained Statistics Implementation
+//==============================================================================
+
+#include "LiveStats.h"
+#include "FileClassifier.h"
+#include "Config.h"
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::time_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+std::string formatBytesBound(long long bytes) {
+    const long long MB = 1024 * 1024;
+    return bytes % MB == 0 ? std::to_string(bytes / MB) + "M" : std::to_string(bytes / 1024) + "K";
+}
+
+std::size_t sizeBucketFor(long long bytes) {
+    std::size_t bucket = 0;
+    while (bucket < STATS_SIZE_BUCKET_BYTES.size() && bytes >= STATS_SIZE_BUCKET_BYTES[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+LiveStats::LiveStats(const std::string& baseDirectory, int oldFileAgeDays)
+    : baseDirectory_(fs::path(baseDirectory).lexically_normal().string()),
+      oldAgeSeconds_(static_cast<std::time_t>(oldFileAgeDays) * SECONDS_PER_DAY),
+      sizeBuckets_(STATS_SIZE_BUCKET_BYTES.size() + 1),
+      ageBuckets_(STATS_AGE_BUCKET_DAYS.size() + 1),
+      wheel_(STATS_WHEEL_SLOTS),
+      wheelTick_(static_cast<long long>(std::time(nullptr)) / STATS_WHEEL_TICK_SECONDS),
+      nextGeneration_(0) {
+    while (baseDirectory_.size() > 1 && baseDirectory_.back() == fs::path::preferred_separator) {
+        baseDirectory_.pop_back();
+    }
+
+    for (int days : STATS_AGE_BUCKET_DAYS) {
+        boundaries_.push_back(static_cast<std::time_t>(days) * SECONDS_PER_DAY);
+    }
+    if (oldAgeSeconds_ > 0) {
+        boundaries_.push_back(oldAgeSeconds_);
+    }
+    std::sort(boundaries_.begin(), boundaries_.end());
+    boundaries_.erase(std::unique(boundaries_.begin(), boundaries_.end()), boundaries_.end());
+}
+
+//------------------------------------------------------------------------------
+// Public Updates
+//------------------------------------------------------------------------------
+void LiveStats::upsert(const FileInfo& file, const std::string& category, bool large,
+                       std::time_t now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    update(file, category, large, now);
+}
+
+void LiveStats::remove(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    erase(path);
+}
+
+//------------------------------------------------------------------------------
+// Advance
+// Visits each slot passed since the last call, at most one revolution's
+// worth. A slot holds every timer hashed to it, due this revolution or a
+// later one; only those due by now fire, and stale ones are dropped on sight.
+//------------------------------------------------------------------------------
+void LiveStats::advance(std::time_t now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    long long target = static_cast<long long>(now) / STATS_WHEEL_TICK_SECONDS;
+    if (target <= wheelTick_) {
+        return;
+    }
+    long long first = wheelTick_ + 1;
+    long long steps = std::min(target - wheelTick_, static_cast<long long>(STATS_WHEEL_SLOTS));
+    wheelTick_ = target;    // Rescheduled timers land after the ticks being processed
+
+    for (long long tick = first; tick < first + steps; ++tick) {
+        std::vector<Timer> timers;
+        timers.swap(wheel_[static_cast<std::size_t>(tick) % STATS_WHEEL_SLOTS]);
+        for (auto& timer : timers) {
+            auto it = files_.find(timer.path);
+            if (it == files_.end() || it->second.generation != timer.generation) {
+                continue;
+            }
+            if (timer.due > now) {
+                wheel_[static_cast<std::size_t>(tick) % STATS_WHEEL_SLOTS].push_back(std::move(timer));
+                continue;
+            }
+            Entry& entry = it->second;
+            account(it->first, entry, -1);
+            applyAge(entry, now);
+            account(it->first, entry, +1);
+            schedule(it->first, entry, now);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Reconcile
+// Unchanged files cost a lookup each; only differences touch the totals
+//------------------------------------------------------------------------------
+void LiveStats::reconcile(const FileClassifier& classifier, const FileScanner& scanner,
+                          std::time_t now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::unordered_set<std::string> seen;
+    for (const auto& [category, files] : classifier.getCategorizedFiles()) {
+        for (const auto& file : files) {
+            update(file, category, scanner.isLargeFile(file), now);
+            seen.insert(file.path.string());
+        }
+    }
+
+    std::vector<std::string> gone;
+    for (const auto& [path, entry] : files_) {
+        if (seen.count(path) == 0) {
+            gone.push_back(path);
+        }
+    }
+    for (const auto& path : gone) {
+        erase(path);
+    }
+}
+
+//------------------------------------------------------------------------------
+// Format
+//------------------------------------------------------------------------------
+std::string LiveStats::format() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    out << "live-files " << total_.files << '\n'
+        << "live-bytes " << total_.bytes << '\n'
+        << "live-large " << total_.large << '\n'
+        << "live-old " << total_.old << '\n';
+
+    // Counts first: category names and paths may contain spaces
+    for (std::size_t i = 0; i < categories_.size(); ++i) {
+        const Totals& totals = categories_[i];
+        if (totals.files > 0) {
+            out << "live-category " << totals.files << ' ' << totals.bytes << ' '
+                << totals.large << ' ' << totals.old << ' ' << categoryNames_[i] << '\n';
+        }
+    }
+
+    std::vector<std::pair<std::string, Totals>> subtrees(subtrees_.begin(), subtrees_.end());
+    std::size_t listed = std::min(subtrees.size(), STATS_MAX_LISTED_SUBTREES);
+    std::partial_sort(subtrees.begin(), subtrees.begin() + static_cast<std::ptrdiff_t>(listed),
+                      subtrees.end(), [](const auto& a, const auto& b) {
+                          return a.second.bytes != b.second.bytes ? a.second.bytes > b.second.bytes
+                                                                  : a.first < b.first;
+                      });
+    for (std::size_t i = 0; i < listed; ++i) {
+        out << "live-subtree " << subtrees[i].second.files << ' ' << subtrees[i].second.bytes
+            << ' ' << subtrees[i].first << '\n';
+    }
+
+    for (std::size_t i = 0; i < sizeBuckets_.size(); ++i) {
+        std::string label = i < STATS_SIZE_BUCKET_BYTES.size()
+                                ? "<" + formatBytesBound(STATS_SIZE_BUCKET_BYTES[i])
+                                : ">=" + formatBytesBound(STATS_SIZE_BUCKET_BYTES.back());
+        out << "live-size " << sizeBuckets_[i].files << ' ' << sizeBuckets_[i].bytes << ' '
+            << label << '\n';
+    }
+
+    for (std::size_t i = 0; i < ageBuckets_.size(); ++i) {
+        std::string label = i < STATS_AGE_BUCKET_DAYS.size()
+                                ? "<" + std::to_string(STATS_AGE_BUCKET_DAYS[i]) + "d"
+                                : ">=" + std::to_string(STATS_AGE_BUCKET_DAYS.back()) + "d";
+        out << "live-age " << ageBuckets_[i].files << ' ' << ageBuckets_[i].bytes << ' '
+            << label << '\n';
+    }
+    return out.str();
+}
+
+std::size_t LiveStats::getFileCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return files_.size();
+}
+
+//------------------------------------------------------------------------------
+// Helper: Update One File (caller holds mutex_)
+//------------------------------------------------------------------------------
+void LiveStats::update(const FileInfo& file, const std::string& category, bool large,
+                       std::time_t now) {
+    std::string path = file.path.string();
+    std::size_t categoryId = categoryFor(category);
+
+    auto it = files_.find(path);
+    if (it != files_.end()) {
+        const Entry& current = it->second;
+        if (current.category == categoryId && current.sizeBytes == file.sizeBytes &&
+            current.lastModified == file.lastModified && current.large == large) {
+            return;
+        }
+        account(path, current, -1);
+    } else {
+        it = files_.emplace(path, Entry{}).first;
+    }
+
+    Entry& entry = it->second;
+    entry.category = categoryId;
+    entry.sizeBytes = file.sizeBytes;
+    entry.lastModified = file.lastModified;
+    entry.large = large;
+    entry.sizeBucket = sizeBucketFor(file.sizeBytes);
+    entry.generation = ++nextGeneration_;
+    applyAge(entry, now);
+    account(path, entry, +1);
+    schedule(path, entry, now);
+}
+
+//------------------------------------------------------------------------------
+// Helper: Erase One File (caller holds mutex_); its timer goes stale
+//------------------------------------------------------------------------------
+void LiveStats::erase(const std::string& path) {
+    auto it = files_.find(path);
+    if (it == files_.end()) {
+        return;
+    }
+    account(path, it->second, -1);
+    files_.erase(it);
+}
+
+//------------------------------------------------------------------------------
+// Helper: Add or Subtract a File's Contribution
+// One step per aggregate, plus one per directory between the file and the base
+//------------------------------------------------------------------------------
+void LiveStats::account(const std::string& path, const Entry& entry, int sign) {
+    auto apply = [&](Totals& totals) {
+        totals.files += sign;
+        totals.bytes += sign * entry.sizeBytes;
+        totals.large += entry.large ? sign : 0;
+        totals.old += entry.old ? sign : 0;
+    };
+
+    apply(total_);
+    apply(categories_[entry.category]);
+    apply(sizeBuckets_[entry.sizeBucket]);
+    apply(ageBuckets_[entry.ageBucket]);
+
+    auto applySubtree = [&](const std::string& key) {
+        Totals& totals = subtrees_[key];
+        apply(totals);
+        if (totals.files == 0) {
+            subtrees_.erase(key);
+        }
+    };
+    applySubtree(".");
+    std::string relative = fs::path(path).parent_path().lexically_relative(baseDirectory_)
+                               .generic_string();
+    if (relative.empty() || relative == "." || relative.compare(0, 2, "..") == 0) {
+        return;
+    }
+    for (std::size_t slash = relative.find('/'); slash != std::string::npos;
+         slash = relative.find('/', slash + 1)) {
+        applySubtree(relative.substr(0, slash));
+    }
+    applySubtree(relative);
+}
+
+//------------------------------------------------------------------------------
+// Helper: Schedule a File's Next Age Boundary
+// Boundaries already passed need no timer; past the last one, none is set
+//------------------------------------------------------------------------------
+void LiveStats::schedule(const std::string& path, const Entry& entry, std::time_t now) {
+    std::time_t age = now - entry.lastModified;
+    auto next = std::upper_bound(boundaries_.begin(), boundaries_.end(), age);
+    if (next == boundaries_.end()) {
+        return;
+    }
+
+    std::time_t due = entry.lastModified + *next;
+    long long tick = (static_cast<long long>(due) + STATS_WHEEL_TICK_SECONDS - 1) /
+                     STATS_WHEEL_TICK_SECONDS;
+    tick = std::max(tick, wheelTick_ + 1);
+    wheel_[static_cast<std::size_t>(tick) % STATS_WHEEL_SLOTS].push_back(
+        Timer{ path, entry.generation, due });
+}
+
+//------------------------------------------------------------------------------
+// Helper: Age Bucket and Old Flag at a Given Time
+//------------------------------------------------------------------------------
+void LiveStats::applyAge(Entry& entry, std::time_t now) const {
+    std::time_t age = now - entry.lastModified;
+    std::size_t bucket = 0;
+    while (bucket < STATS_AGE_BUCKET_DAYS.size() &&
+           age >= static_cast<std::time_t>(STATS_AGE_BUCKET_DAYS[bucket]) * SECONDS_PER_DAY) {
+        bucket++;
+    }
+    entry.ageBucket = bucket;
+    entry.old = age >= oldAgeSeconds_;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Category Index, Registering New Names
+//------------------------------------------------------------------------------
+std::size_t LiveStats::categoryFor(const std::string& name) {
+    auto it = categoryIndex_.find(name);
+    if (it != categoryIndex_.end()) {
+        return it->second;
+    }
+    std::size_t index = categoryNames_.size();
+    categoryNames_.push_back(name);
+    categories_.emplace_back();
+    categoryIndex_.emplace(name, index);
+    return index;
+}
+
+} // namespace DesktopCleaner
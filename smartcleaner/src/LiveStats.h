@@ -0,0 +1,108 @@
+//==============================================================================
+// LiveStats.h - Incrementally Maintained Statistics Interface
+//==============================================================================
+
+#ifndef LIVE_STATS_H
+#define LIVE_STATS_H
+
+#include "FileScanner.h"
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class FileClassifier;
+
+//------------------------------------------------------------------------------
+// LiveStats Class
+// Totals by category, directory subtree, size bucket and age bucket, kept
+// current one file at a time: an update subtracts the file's old contribution
+// and adds the new one, which touches one entry per aggregate plus one per
+// ancestor directory. Age buckets move with the clock through a hashed timer
+// wheel holding each file's next age boundary, so no pass over the files is
+// needed to age them. Reading the totals costs nothing but formatting.
+//------------------------------------------------------------------------------
+class LiveStats {
+public:
+    // Old-file threshold as in FileScanner::isOldFile()
+    LiveStats(const std::string& baseDirectory, int oldFileAgeDays);
+
+    LiveStats(const LiveStats&) = delete;
+    LiveStats& operator=(const LiveStats&) = delete;
+
+    // Add or replace one file; large is FileScanner::isLargeFile() of it
+    void upsert(const FileInfo& file, const std::string& category, bool large, std::time_t now);
+    void remove(const std::string& path);
+
+    // Fire the timers due by now, moving files into older age buckets
+    void advance(std::time_t now);
+
+    // Make the totals match a full pass, covering any events that were lost
+    void reconcile(const FileClassifier& classifier, const FileScanner& scanner, std::time_t now);
+
+    // "key value" lines for the job service's stats reply
+    std::string format() const;
+    std::size_t getFileCount() const;
+
+private:
+    struct Totals {
+        long long files = 0;
+        long long bytes = 0;
+        long long large = 0;
+        long long old = 0;
+    };
+
+    // One file's contribution to every aggregate
+    struct Entry {
+        std::size_t category = 0;
+        long long sizeBytes = 0;
+        std::time_t lastModified = 0;
+        bool large = false;
+        bool old = false;
+        std::size_t sizeBucket = 0;
+        std::size_t ageBucket = 0;
+        std::uint64_t generation = 0;               // Timers of earlier generations are stale
+    };
+
+    struct Timer {
+        std::string path;
+        std::uint64_t generation;
+        std::time_t due;                            // When the file crosses its next boundary
+    };
+
+    mutable std::mutex mutex_;                      // Guards everything below
+    std::string baseDirectory_;
+    std::time_t oldAgeSeconds_;
+    std::vector<std::time_t> boundaries_;           // Every age that changes a bucket, ascending
+
+    std::unordered_map<std::string, Entry> files_;  // Path -> contribution
+    std::vector<std::string> categoryNames_;
+    std::unordered_map<std::string, std::size_t> categoryIndex_;
+    std::vector<Totals> categories_;
+    std::unordered_map<std::string, Totals> subtrees_;  // Relative directory ("." is the base)
+    std::vector<Totals> sizeBuckets_;
+    std::vector<Totals> ageBuckets_;
+    Totals total_;
+
+    std::vector<std::vector<Timer>> wheel_;         // STATS_WHEEL_SLOTS slots of timers
+    long long wheelTick_;                           // Last tick advance() processed
+    std::uint64_t nextGeneration_;
+
+    // Helper methods
+    void update(const FileInfo& file, const std::string& category, bool large, std::time_t now);
+    void erase(const std::string& path);
+    void account(const std::string& path, const Entry& entry, int sign);
+    void schedule(const std::string& path, const Entry& entry, std::time_t now);
+    void applyAge(Entry& entry, std::time_t now) const;
+    std::size_t categoryFor(const std::string& name);
+};
+
+} // namespace DesktopCleaner
+
+#endif // LIVE_STATS_H
@@ -0,0 +1,103 @@
+//==============================================================================
+// LogIndex.cpp - Per-Run Log Sidecar Index Implementation
+//==============================================================================
+
+#include "LogIndex.h"
+#include "ContentHash.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const char INDEX_MAGIC[8] = { 'S', 'C', 'L', 'O', 'G', 'I', 'X', '1' };
+const std::uint64_t HEADER_BYTES = sizeof(INDEX_MAGIC) + sizeof(std::uint64_t);
+
+bool readEntry(std::ifstream& input, std::uint64_t index, LogIndexEntry& entry) {
+    input.seekg(static_cast<std::streamoff>(HEADER_BYTES + index * sizeof(LogIndexEntry)));
+    return static_cast<bool>(input.read(reinterpret_cast<char*>(&entry), sizeof(entry)));
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Write Index
+// Written under a temporary name and renamed, so readers never see half a file
+//------------------------------------------------------------------------------
+bool LogIndex::write(const std::string& indexPath, std::vector<LogIndexEntry> entries) {
+    std::sort(entries.begin(), entries.end(), [](const LogIndexEntry& a, const LogIndexEntry& b) {
+        return a.pathHash != b.pathHash ? a.pathHash < b.pathHash : a.offset < b.offset;
+    });
+
+    std::string temporary = indexPath + ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::binary | std::ios::trunc);
+        std::uint64_t count = entries.size();
+        output.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        output.write(reinterpret_cast<const char*>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(LogIndexEntry)));
+        if (!output.flush()) {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, indexPath, error);
+    return !error;
+}
+
+//------------------------------------------------------------------------------
+// Lookup
+//------------------------------------------------------------------------------
+bool LogIndex::lookup(const std::string& indexPath, std::uint64_t pathHash,
+                      std::vector<std::uint64_t>& offsets) {
+    offsets.clear();
+    std::ifstream input(indexPath, std::ios::binary);
+    char magic[sizeof(INDEX_MAGIC)];
+    std::uint64_t count = 0;
+    if (!input.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        !input.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        return false;
+    }
+    std::error_code error;
+    if (fs::file_size(indexPath, error) != HEADER_BYTES + count * sizeof(LogIndexEntry) || error) {
+        return false;
+    }
+
+    // First entry with hash >= pathHash
+    std::uint64_t low = 0;
+    std::uint64_t high = count;
+    LogIndexEntry entry;
+    while (low < high) {
+        std::uint64_t middle = low + (high - low) / 2;
+        if (!readEntry(input, middle, entry)) {
+            return false;
+        }
+        if (entry.pathHash < pathHash) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    for (std::uint64_t i = low; i < count; ++i) {
+        if (!readEntry(input, i, entry) || entry.pathHash != pathHash) {
+            break;
+        }
+        offsets.push_back(entry.offset);
+    }
+    return true;
+}
+
+std::uint64_t LogIndex::keyFor(const fs::path& path) {
+    return ContentHasher::hashPath(ContentHasher::normalizePath(path));
+}
+
+} // namespace DesktopCleaner
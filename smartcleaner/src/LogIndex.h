@@ -0,0 +1,45 @@
+//==============================================================================
+// LogIndex.h - Per-Run Log Sidecar Index Interface
+//==============================================================================
+
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// LogIndexEntry Structure
+//------------------------------------------------------------------------------
+struct LogIndexEntry {
+    std::uint64_t pathHash;     // LogIndex::keyFor() of a source or target path
+    std::uint64_t offset;       // Byte offset of the record in the log file
+};
+
+//------------------------------------------------------------------------------
+// LogIndex Class
+// Sidecar segments written next to each cleaner_*.log (same name + ".<n>" +
+// LOG_INDEX_EXTENSION): an 8-byte magic, an entry count and the entries sorted
+// by path hash, so a lookup is a binary search of a few reads however large
+// the log is.
+//------------------------------------------------------------------------------
+class LogIndex {
+public:
+    // Write entries (sorted here) to a new index file
+    static bool write(const std::string& indexPath, std::vector<LogIndexEntry> entries);
+
+    // Record offsets indexed under pathHash, in log order; false if unreadable
+    static bool lookup(const std::string& indexPath, std::uint64_t pathHash,
+                       std::vector<std::uint64_t>& offsets);
+
+    // Key for a path as the user may type it (made absolute and normalized)
+    static std::uint64_t keyFor(const std::filesystem::path& path);
+};
+
+} // namespace DesktopCleaner
+
+#endif // LOG_INDEX_H
@@ -4,25 +4,47 @@
 
 #include "Logger.h"
 #include "Config.h"
+#include "PerfCounters.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <ctime>
 #include <sstream>
 #include <filesystem>
+#include <utility>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace fs = std::filesystem;
 
 namespace DesktopCleaner {
 
 //------------------------------------------------------------------------------
-// Constructor
+// Constructors
 //------------------------------------------------------------------------------
-Logger::Logger() : consoleOutput_(true) {
+Logger::Logger() : Logger(LOG_DIRECTORY, true) {
+}
+
+Logger::Logger(const std::string& logDirectory, bool consoleOutput)
+    : logDirectory_(logDirectory),
+      consoleOutput_(consoleOutput),
+      consoleVerbose_(false),
+      statusLineShown_(false),
+      perf_(nullptr),
+      indexSegments_(0) {
+    // Embedders may run without a log file
+    if (logDirectory_.empty()) {
+        return;
+    }
+    
     // Create logs directory if it doesn't exist
     try {
-        if (!fs::exists(LOG_DIRECTORY)) {
-            fs::create_directory(LOG_DIRECTORY);
+        if (!fs::exists(logDirectory_)) {
+            fs::create_directories(logDirectory_);
         }
         
         // Generate log file path with timestamp
@@ -52,6 +74,9 @@ Logger::~Logger() {
         log(LogLevel::INFO, "Session Ended");
         logSeparator();
         logFile_.close();
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        writeIndexSegment();
     }
 }
 
@@ -63,7 +88,7 @@ void Logger::log(LogLevel level, const std::string& message) {
     std::string levelStr = levelToString(level);
     std::string logEntry = "[" + timestamp + "] " + levelStr + ": " + message;
     
-    writeLog(levelStr, logEntry);
+    writeLog(levelStr, logEntry, consoleOutput_);
 }
 
 //------------------------------------------------------------------------------
@@ -89,11 +114,86 @@ void Logger::debug(const std::string& message) {
     log(LogLevel::DEBUG, message);
 }
 
+//------------------------------------------------------------------------------
+// Per-File Event Logging
+// Keeps the console quiet on large runs; the log file still gets every event
+//------------------------------------------------------------------------------
+void Logger::fileEvent(LogLevel level, const std::string& message) {
+    std::string levelStr = levelToString(level);
+    std::string logEntry = "[" + getCurrentTimestamp() + "] " + levelStr + ": " + message;
+    
+    writeLog(levelStr, logEntry, consoleOutput_ && consoleVerbose_);
+}
+
+void Logger::fileRecord(LogLevel level, const std::string& message,
+                        const fs::path& source, const fs::path& target) {
+    std::string levelStr = levelToString(level);
+    std::string logEntry = "[" + getCurrentTimestamp() + "] " + levelStr + ": " + message;
+    
+    // Keys are hashed outside the lock
+    std::uint64_t sourceKey = LogIndex::keyFor(source);
+    std::uint64_t targetKey = target.empty() ? 0 : LogIndex::keyFor(target);
+    writeLog(levelStr, logEntry, consoleOutput_ && consoleVerbose_, sourceKey, targetKey);
+}
+
+//------------------------------------------------------------------------------
+// Log Index Segments
+// Each segment is a complete sorted sidecar (<log>.<n>.idx); --whereis
+// searches every segment of a run, so nothing waits for the run to end
+//------------------------------------------------------------------------------
+void Logger::flushIndex() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeIndexSegment();
+}
+
+void Logger::writeIndexSegment() {
+    if (index_.empty() || logFilePath_.empty()) {
+        return;
+    }
+    std::ostringstream segmentPath;
+    segmentPath << logFilePath_ << "." << std::setw(4) << std::setfill('0')
+                << ++indexSegments_ << LOG_INDEX_EXTENSION;
+    if (!LogIndex::write(segmentPath.str(), std::move(index_))) {
+        std::cerr << "Warning: Could not write log index for " << logFilePath_ << std::endl;
+    }
+    index_.clear();
+}
+
+//------------------------------------------------------------------------------
+// Console Control
+//------------------------------------------------------------------------------
+void Logger::setVerboseConsole(bool verbose) {
+    consoleVerbose_ = verbose;
+}
+
+void Logger::setPerfCounters(PerfCounters* perf) {
+    perf_ = perf;
+}
+
+void Logger::writeStatusLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Let buffered stdout catch up first so the status line stays last
+    std::cout.flush();
+    std::cerr << "\r\033[K" << line << std::flush;
+    statusLineShown_ = true;
+}
+
+void Logger::clearStatusLine() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (statusLineShown_) {
+        std::cerr << "\r\033[K" << std::flush;
+        statusLineShown_ = false;
+    }
+}
+
 //------------------------------------------------------------------------------
 // Log Separator
 //------------------------------------------------------------------------------
 void Logger::logSeparator() {
     std::string separator(70, '=');
+    std::lock_guard<std::mutex> lock(mutex_);
     if (logFile_.is_open()) {
         logFile_ << separator << std::endl;
     }
@@ -139,11 +239,17 @@ std::string Logger::generateLogFilePath() const {
     localtime_r(&time_t, &tm_buf);
 #endif
     
-    // Format: cleaner_YYYYMMDD_HHMMSS.log
+    // Format: cleaner_YYYYMMDD_HHMMSS_<pid>.log (runs in the same second
+    // would otherwise share, and append to, one log)
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
     std::ostringstream oss;
-    oss << LOG_DIRECTORY << "/" << LOG_FILE_PREFIX
+    oss << logDirectory_ << "/" << LOG_FILE_PREFIX
         << std::put_time(&tm_buf, "%Y%m%d_%H%M%S")
-        << ".log";
+        << "_" << pid << ".log";
     
     return oss.str();
 }
@@ -184,19 +290,41 @@ std::string Logger::levelToString(LogLevel level) const {
 //------------------------------------------------------------------------------
 // Helper: Write to File and Console
 //------------------------------------------------------------------------------
-void Logger::writeLog(const std::string& prefix, const std::string& message) {
+void Logger::writeLog(const std::string& prefix, const std::string& message, bool toConsole,
+                      std::uint64_t sourceKey, std::uint64_t targetKey) {
+    PerfCounters::ScopedPhase phase(perf_, PerfPhase::LOG);
+    std::lock_guard<std::mutex> lock(mutex_);
+    
     // Write to file
     if (logFile_.is_open()) {
+        // Every write is flushed, so tellp() is where this record starts
+        if (sourceKey != 0) {
+            auto offset = static_cast<std::uint64_t>(logFile_.tellp());
+            index_.push_back({ sourceKey, offset });
+            if (targetKey != 0) {
+                index_.push_back({ targetKey, offset });
+            }
+        }
         logFile_ << message << std::endl;
         logFile_.flush(); // Ensure immediate write
+        
+        // A long run (the daemon) never holds more than one segment's worth
+        if (index_.size() >= LOG_INDEX_SEGMENT_ENTRIES) {
+            writeIndexSegment();
+        }
     }
     
     // Write to console with color coding (simple version)
-    if (consoleOutput_) {
+    // stdout is left buffered; cerr is tied to cout so ordering is preserved
+    if (toConsole) {
+        if (statusLineShown_) {
+            std::cerr << "\r\033[K";
+            statusLineShown_ = false;
+        }
         if (prefix == "ERROR") {
             std::cerr << message << std::endl;
         } else {
-            std::cout << message << std::endl;
+            std::cout << message << '\n';
         }
     }
 }
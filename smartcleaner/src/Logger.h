@@ -5,11 +5,18 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "LogIndex.h"
 #include <string>
 #include <fstream>
+#include <filesystem>
+#include <mutex>
+#include <vector>
 
 namespace DesktopCleaner {
 
+// Forward declaration
+class PerfCounters;
+
 //------------------------------------------------------------------------------
 // Log Level Enumeration
 //------------------------------------------------------------------------------
@@ -29,6 +36,7 @@ class Logger {
 public:
     // Constructor & Destructor
     Logger();
+    Logger(const std::string& logDirectory, bool consoleOutput); // Empty directory = no log file
     ~Logger();
     
     // Prevent copying
@@ -45,24 +53,53 @@ public:
     void error(const std::string& message);
     void debug(const std::string& message);
     
+    // Per-file events: always written to the log file, console only if verbose
+    void fileEvent(LogLevel level, const std::string& message);
+    
+    // Per-file event also indexed under its paths for --whereis
+    void fileRecord(LogLevel level, const std::string& message,
+                    const std::filesystem::path& source,
+                    const std::filesystem::path& target = std::filesystem::path());
+    
+    // Write the records indexed so far as the next sidecar segment; called
+    // after each batch of moves, so --whereis sees them while the run goes on
+    void flushIndex();
+    
     // Utility methods
     void logSeparator();
     void logSummary(int totalFiles, int successCount, int failCount, int warningCount);
     
+    // Console control
+    void setVerboseConsole(bool verbose);
+    void writeStatusLine(const std::string& line);
+    void clearStatusLine();
+    
+    // Charge log writes to the counters' LOG phase (null = off)
+    void setPerfCounters(PerfCounters* perf);
+    
     // Status methods
     bool isOpen() const;
     std::string getLogFilePath() const;
     
 private:
     std::ofstream logFile_;        // Log file stream
+    std::string logDirectory_;     // Directory holding log files
     std::string logFilePath_;      // Path to current log file
     bool consoleOutput_;           // Enable console output
+    bool consoleVerbose_;          // Echo per-file events to console
+    bool statusLineShown_;         // A progress line is on stderr
+    std::mutex mutex_;             // Serializes writes from worker threads
+    PerfCounters* perf_;           // Optional per-phase counters
+    std::vector<LogIndexEntry> index_; // Not yet written to a sidecar segment
+    int indexSegments_;            // Segments written so far
     
     // Helper methods
     std::string generateLogFilePath() const;
     std::string getCurrentTimestamp() const;
     std::string levelToString(LogLevel level) const;
-    void writeLog(const std::string& prefix, const std::string& message);
+    void writeIndexSegment();      // Caller holds mutex_
+    void writeLog(const std::string& prefix, const std::string& message, bool toConsole,
+                  std::uint64_t sourceKey = 0, std::uint64_t targetKey = 0);
 };
 
 } // namespace DesktopCleaner
@@ -0,0 +1,360 @@
+//==============================================================================
+// NearDuplicateFinder.cpp - Near-Duplicate Filename Clustering Implementation
+//==============================================================================
+
+#include "NearDuplicateFinder.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Name Tokens
+// A stem is split on spaces, '_', '-' and brackets; each token remembers
+// whether it was bracketed, so "report (2)" can be told from "Chapter 2"
+//------------------------------------------------------------------------------
+struct NameToken {
+    std::string text;       // Lowercased
+    bool bracketed;         // Inside (...) or [...]
+};
+
+// Words that mark a copy or a revision rather than the document itself
+const std::unordered_set<std::string> MARKER_WORDS = {
+    "copy", "final", "new", "old", "draft", "edited", "edit",
+    "backup", "bak", "latest", "updated", "revised"
+};
+
+// Words that may be followed by a separate number ("copy 2", "version 3")
+const std::unordered_set<std::string> NUMBERED_WORDS = {
+    "copy", "v", "ver", "version", "rev"
+};
+
+bool isDigits(const std::string& text) {
+    return !text.empty() &&
+           std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+// "v2", "v1.3", "ver2", "rev10", "version3"
+bool isVersionTag(const std::string& text) {
+    for (const char* prefix : { "version", "ver", "rev", "v" }) {
+        std::string tag(prefix);
+        if (text.size() > tag.size() && text.compare(0, tag.size(), tag) == 0) {
+            std::string rest = text.substr(tag.size());
+            bool digitsAndDots = std::all_of(rest.begin(), rest.end(), [](unsigned char c) {
+                return std::isdigit(c) || c == '.';
+            });
+            return digitsAndDots && std::isdigit(static_cast<unsigned char>(rest.front()));
+        }
+    }
+    return false;
+}
+
+std::vector<NameToken> tokenize(const std::string& stem) {
+    std::vector<NameToken> tokens;
+    NameToken current{ "", false };
+    bool inBracket = false;
+
+    auto flush = [&]() {
+        if (!current.text.empty()) {
+            tokens.push_back(current);
+            current.text.clear();
+        }
+    };
+
+    for (unsigned char c : stem) {
+        switch (c) {
+            case '(': case '[':
+                flush();
+                inBracket = true;
+                break;
+            case ')': case ']':
+                flush();
+                inBracket = false;
+                break;
+            case ' ': case '\t': case '_': case '-':
+                flush();
+                break;
+            default:
+                if (current.text.empty()) {
+                    current.bracketed = inBracket;
+                }
+                current.text += static_cast<char>(std::tolower(c));
+                break;
+        }
+    }
+    flush();
+    return tokens;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Newest First, Then Shortest Name
+//------------------------------------------------------------------------------
+bool keepOrder(const FileInfo* a, const FileInfo* b) {
+    if (a->lastModified != b->lastModified) {
+        return a->lastModified > b->lastModified;
+    }
+    if (a->name.size() != b->name.size()) {
+        return a->name.size() < b->name.size();
+    }
+    return a->name < b->name;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+NearDuplicateFinder::NearDuplicateFinder(Logger& logger, ThreadPool& pool)
+    : logger_(logger), pool_(pool), refine_(NearDuplicateRefine::NONE) {
+}
+
+//------------------------------------------------------------------------------
+// Configuration
+//------------------------------------------------------------------------------
+void NearDuplicateFinder::setRefinement(NearDuplicateRefine refine) {
+    refine_ = refine;
+}
+
+//------------------------------------------------------------------------------
+// Find Clusters
+// One pass to key every file, then only multi-member keys are refined
+//------------------------------------------------------------------------------
+void NearDuplicateFinder::findClusters(const std::vector<FileInfo>& files) {
+    clusters_.clear();
+
+    std::unordered_map<std::string, std::vector<const FileInfo*>> byKey;
+    byKey.reserve(files.size());
+    for (const auto& file : files) {
+        byKey[normalizedKey(file.name)].push_back(&file);
+    }
+
+    // Content refinement hashes every candidate in one parallel batch
+    std::unordered_map<const FileInfo*, std::uint64_t> prefixes;
+    if (refine_ == NearDuplicateRefine::CONTENT) {
+        std::vector<const FileInfo*> candidates;
+        for (const auto& [key, members] : byKey) {
+            if (members.size() > 1) {
+                candidates.insert(candidates.end(), members.begin(), members.end());
+            }
+        }
+        prefixes = hashPrefixes(candidates);
+    }
+
+    for (auto& [key, members] : byKey) {
+        if (members.size() < 2) {
+            continue;
+        }
+
+        std::vector<std::vector<const FileInfo*>> groups;
+        switch (refine_) {
+            case NearDuplicateRefine::SIZE:    groups = splitBySize(members); break;
+            case NearDuplicateRefine::CONTENT: groups = splitByContent(members, prefixes); break;
+            default:                           groups.push_back(members); break;
+        }
+
+        for (auto& group : groups) {
+            if (group.size() < 2) {
+                continue;
+            }
+            std::sort(group.begin(), group.end(), keepOrder);
+
+            NearDuplicateCluster cluster;
+            cluster.key = key;
+            for (const FileInfo* file : group) {
+                cluster.files.push_back(*file);
+            }
+            clusters_.push_back(std::move(cluster));
+        }
+    }
+
+    // Biggest clusters first; key order keeps the output stable
+    std::stable_sort(clusters_.begin(), clusters_.end(),
+                     [](const NearDuplicateCluster& a, const NearDuplicateCluster& b) {
+                         if (a.files.size() != b.files.size()) {
+                             return a.files.size() > b.files.size();
+                         }
+                         return a.key < b.key;
+                     });
+
+    logger_.info("Found " + std::to_string(clusters_.size()) + " near-duplicate clusters (" +
+                 std::to_string(getSupersededBytes()) + " bytes in superseded versions)");
+}
+
+//------------------------------------------------------------------------------
+// Get Clustering Results
+//------------------------------------------------------------------------------
+const std::vector<NearDuplicateCluster>& NearDuplicateFinder::getClusters() const {
+    return clusters_;
+}
+
+std::vector<FileInfo> NearDuplicateFinder::getSuperseded() const {
+    std::vector<FileInfo> superseded;
+    for (const auto& cluster : clusters_) {
+        superseded.insert(superseded.end(), cluster.files.begin() + 1, cluster.files.end());
+    }
+    return superseded;
+}
+
+long long NearDuplicateFinder::getSupersededBytes() const {
+    long long total = 0;
+    for (const auto& cluster : clusters_) {
+        for (std::size_t i = 1; i < cluster.files.size(); ++i) {
+            total += cluster.files[i].allocatedBytes;
+        }
+    }
+    return total;
+}
+
+//------------------------------------------------------------------------------
+// Normalized Name Key
+// "Copy of Report (1).PDF", "report_final_v2.pdf" and "report - Copy.pdf" all
+// become "report.pdf"; at least one stem token always survives
+//------------------------------------------------------------------------------
+std::string NearDuplicateFinder::normalizedKey(const std::string& fileName) {
+    fs::path name(fileName);
+    std::string stem = name.stem().string();
+    std::string extension = name.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    std::vector<NameToken> tokens = tokenize(stem);
+
+    // Leading "copy of" / "copy 2 of"
+    if (tokens.size() > 2 && tokens[0].text == "copy") {
+        if (tokens[1].text == "of") {
+            tokens.erase(tokens.begin(), tokens.begin() + 2);
+        } else if (tokens.size() > 3 && isDigits(tokens[1].text) && tokens[2].text == "of") {
+            tokens.erase(tokens.begin(), tokens.begin() + 3);
+        }
+    }
+
+    // Trailing markers, innermost last: "report_final_v2 (1)" peels "1", "v2", "final".
+    // A bare number ("Track 01", "Chapter 2") is a sequence, not a copy marker
+    while (tokens.size() > 1) {
+        const NameToken& last = tokens.back();
+        if (MARKER_WORDS.count(last.text) > 0 || isVersionTag(last.text)) {
+            tokens.pop_back();
+            continue;
+        }
+        if (isDigits(last.text)) {
+            if (last.bracketed) {
+                tokens.pop_back();
+                continue;
+            }
+            if (tokens.size() > 2 && NUMBERED_WORDS.count(tokens[tokens.size() - 2].text) > 0) {
+                tokens.pop_back();
+                tokens.pop_back();
+                continue;
+            }
+        }
+        break;
+    }
+
+    std::string key;
+    for (const auto& token : tokens) {
+        key += token.text;
+    }
+    return key + extension;
+}
+
+//------------------------------------------------------------------------------
+// Parse Refinement Name
+//------------------------------------------------------------------------------
+bool NearDuplicateFinder::parseRefinement(const std::string& name, NearDuplicateRefine& refine) {
+    if (name == "none") {
+        refine = NearDuplicateRefine::NONE;
+    } else if (name == "size") {
+        refine = NearDuplicateRefine::SIZE;
+    } else if (name == "content") {
+        refine = NearDuplicateRefine::CONTENT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Refinement: Size Proximity
+// Sorted by size, a new group starts wherever the gap to the previous member
+// exceeds the tolerance
+//------------------------------------------------------------------------------
+std::vector<std::vector<const FileInfo*>> NearDuplicateFinder::splitBySize(
+    std::vector<const FileInfo*> members) const {
+    std::sort(members.begin(), members.end(), [](const FileInfo* a, const FileInfo* b) {
+        return a->sizeBytes < b->sizeBytes;
+    });
+
+    std::vector<std::vector<const FileInfo*>> groups;
+    for (const FileInfo* file : members) {
+        if (!groups.empty()) {
+            long long previous = groups.back().back()->sizeBytes;
+            long long allowed = static_cast<long long>(previous * NEAR_DUPE_SIZE_TOLERANCE) +
+                                NEAR_DUPE_SIZE_SLACK_BYTES;
+            if (file->sizeBytes - previous <= allowed) {
+                groups.back().push_back(file);
+                continue;
+            }
+        }
+        groups.push_back({ file });
+    }
+    return groups;
+}
+
+//------------------------------------------------------------------------------
+// Refinement: Shared Prefix
+// Members are grouped by a hash of their first NEAR_DUPE_PREFIX_BYTES bytes;
+// unreadable files (no entry in prefixes) drop out of the cluster
+//------------------------------------------------------------------------------
+std::unordered_map<const FileInfo*, std::uint64_t> NearDuplicateFinder::hashPrefixes(
+    const std::vector<const FileInfo*>& candidates) const {
+    std::vector<std::future<std::uint64_t>> hashes;
+    hashes.reserve(candidates.size());
+    for (const FileInfo* file : candidates) {
+        hashes.push_back(pool_.submit([file]() {
+            return ContentHasher::hashFilePrefix(file->path, NEAR_DUPE_PREFIX_BYTES);
+        }));
+    }
+
+    std::unordered_map<const FileInfo*, std::uint64_t> prefixes;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        try {
+            pool_.waitFor(hashes[i]);
+            prefixes[candidates[i]] = hashes[i].get();
+        } catch (const std::exception& e) {
+            logger_.warning(std::string("Could not hash file: ") + e.what());
+        }
+    }
+    return prefixes;
+}
+
+std::vector<std::vector<const FileInfo*>> NearDuplicateFinder::splitByContent(
+    const std::vector<const FileInfo*>& members,
+    const std::unordered_map<const FileInfo*, std::uint64_t>& prefixes) const {
+    std::map<std::uint64_t, std::vector<const FileInfo*>> byPrefix;
+    for (const FileInfo* file : members) {
+        auto it = prefixes.find(file);
+        if (it != prefixes.end()) {
+            byPrefix[it->second].push_back(file);
+        }
+    }
+
+    std::vector<std::vector<const FileInfo*>> groups;
+    for (auto& [prefix, group] : byPrefix) {
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+} // namespace DesktopCleaner
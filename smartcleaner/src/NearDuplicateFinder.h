@@ -0,0 +1,85 @@
+//==============================================================================
+// NearDuplicateFinder.h - Near-Duplicate Filename Clustering Interface
+//==============================================================================
+
+#ifndef NEAR_DUPLICATE_FINDER_H
+#define NEAR_DUPLICATE_FINDER_H
+
+#include "FileScanner.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// Cluster Refinement
+// Name keys alone over-group; refinement splits clusters whose members
+// clearly differ
+//------------------------------------------------------------------------------
+enum class NearDuplicateRefine {
+    NONE,       // Same normalized name is enough
+    SIZE,       // Members must also be close in size
+    CONTENT     // Members must also share their first bytes
+};
+
+//------------------------------------------------------------------------------
+// NearDuplicateCluster Structure
+// Files whose names normalize to the same key; files[0] is the one to keep
+//------------------------------------------------------------------------------
+struct NearDuplicateCluster {
+    std::string key;                // Normalized name key
+    std::vector<FileInfo> files;    // Newest first
+};
+
+//------------------------------------------------------------------------------
+// NearDuplicateFinder Class
+// Finds "report.pdf", "report (1).pdf", "report_final_v2.pdf" and
+// "Copy of report.pdf" as one cluster in a single pass: every name is reduced
+// to a key with copy markers, version suffixes and separators stripped, and
+// files are grouped by key in a hash map.
+//------------------------------------------------------------------------------
+class NearDuplicateFinder {
+public:
+    // Constructor (the pool is only used for CONTENT refinement)
+    NearDuplicateFinder(Logger& logger, ThreadPool& pool);
+
+    // Configuration
+    void setRefinement(NearDuplicateRefine refine);
+
+    // Main clustering method
+    void findClusters(const std::vector<FileInfo>& files);
+
+    // Get clustering results
+    const std::vector<NearDuplicateCluster>& getClusters() const;
+    std::vector<FileInfo> getSuperseded() const;   // Every member but files[0]
+    long long getSupersededBytes() const;
+
+    // Helpers
+    static std::string normalizedKey(const std::string& fileName);
+    static bool parseRefinement(const std::string& name, NearDuplicateRefine& refine);
+
+private:
+    Logger& logger_;                                // Reference to logger
+    ThreadPool& pool_;                              // Prefix-hashing workers
+    NearDuplicateRefine refine_;                    // How clusters are split
+    std::vector<NearDuplicateCluster> clusters_;    // Clusters of 2+ files
+
+    // Refinement passes: split one candidate group into confirmed groups
+    std::vector<std::vector<const FileInfo*>> splitBySize(
+        std::vector<const FileInfo*> members) const;
+    std::unordered_map<const FileInfo*, std::uint64_t> hashPrefixes(
+        const std::vector<const FileInfo*>& candidates) const;
+    std::vector<std::vector<const FileInfo*>> splitByContent(
+        const std::vector<const FileInfo*>& members,
+        const std::unordered_map<const FileInfo*, std::uint64_t>& prefixes) const;
+};
+
+} // namespace DesktopCleaner
+
+#endif // NEAR_DUPLICATE_FINDER_H
@@ -0,0 +1,507 @@
+//==============================================================================
+// PerceptualHash.cpp - Near-Duplicate Image Detection Implementation
+//==============================================================================
+
+#include "PerceptualHash.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <bitset>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <map>
+#include <unordered_map>
+
+#ifdef SMARTCLEANER_WITH_JPEG
+#include <csetjmp>
+#include <jpeglib.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const int HASH_WIDTH = 9;           // 9 columns give 8 left/right differences
+const int HASH_HEIGHT = 8;
+const int BMP_SAMPLE_GRID = 64;     // BMPs are sampled down to about this many rows/columns
+const int MAX_IMAGE_SIDE = 1 << 16; // Larger headers are treated as corrupt
+
+//------------------------------------------------------------------------------
+// GrayImage Structure
+//------------------------------------------------------------------------------
+struct GrayImage {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;   // Row-major, width * height
+};
+
+#ifdef SMARTCLEANER_WITH_JPEG
+//------------------------------------------------------------------------------
+// JPEG Decoding
+// libjpeg reports fatal errors through a callback; it longjmps back here
+//------------------------------------------------------------------------------
+struct JpegErrorManager {
+    jpeg_error_mgr base;
+    std::jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void jpegErrorExit(j_common_ptr info) {
+    auto* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+    (*info->err->format_message)(info, manager->message);
+    std::longjmp(manager->jump, 1);
+}
+
+void jpegQuietMessage(j_common_ptr) {
+    // Corrupt-data warnings are expected on real photo folders
+}
+
+bool decodeJpeg(const fs::path& path, GrayImage& image, int& fullWidth, int& fullHeight,
+                std::string& error) {
+    std::FILE* file = std::fopen(path.string().c_str(), "rb");
+    if (file == nullptr) {
+        error = "cannot open";
+        return false;
+    }
+
+    jpeg_decompress_struct info;
+    JpegErrorManager errors;
+    info.err = jpeg_std_error(&errors.base);
+    errors.base.error_exit = jpegErrorExit;
+    errors.base.output_message = jpegQuietMessage;
+    if (setjmp(errors.jump)) {
+        error = errors.message;
+        jpeg_destroy_decompress(&info);
+        std::fclose(file);
+        return false;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_stdio_src(&info, file);
+    jpeg_read_header(&info, TRUE);
+    fullWidth = static_cast<int>(info.image_width);
+    fullHeight = static_cast<int>(info.image_height);
+
+    // Scale in the DCT domain: at 1/8 each 8x8 block decodes to one pixel
+    unsigned int denominator = 8;
+    while (denominator > 1 && (info.image_width / denominator < HASH_WIDTH ||
+                               info.image_height / denominator < HASH_HEIGHT)) {
+        denominator /= 2;
+    }
+    info.scale_num = 1;
+    info.scale_denom = denominator;
+    info.out_color_space = JCS_GRAYSCALE;   // Luma only; chroma is never converted
+    info.dct_method = JDCT_IFAST;
+    info.do_fancy_upsampling = FALSE;
+    info.do_block_smoothing = FALSE;
+
+    jpeg_start_decompress(&info);
+    image.width = static_cast<int>(info.output_width);
+    image.height = static_cast<int>(info.output_height);
+    image.pixels.resize(static_cast<std::size_t>(image.width) * image.height);
+    while (info.output_scanline < info.output_height) {
+        JSAMPROW row = image.pixels.data() +
+                       static_cast<std::size_t>(info.output_scanline) * image.width;
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+    std::fclose(file);
+    return true;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// BMP Decoding
+// Uncompressed 8/24/32-bit bitmaps; only a sample grid of rows and columns is
+// read, so large bitmaps cost little more than small ones
+//------------------------------------------------------------------------------
+std::uint32_t readLe32(const unsigned char* bytes) {
+    return static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8) |
+           (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+}
+
+std::uint16_t readLe16(const unsigned char* bytes) {
+    return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+bool decodeBmp(const fs::path& path, GrayImage& image, int& fullWidth, int& fullHeight,
+               std::string& error) {
+    std::ifstream input(path, std::ios::binary);
+    unsigned char header[54];
+    if (!input.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+        header[0] != 'B' || header[1] != 'M') {
+        error = "not a BMP file";
+        return false;
+    }
+
+    std::uint32_t pixelOffset = readLe32(header + 10);
+    std::uint32_t infoSize = readLe32(header + 14);
+    std::int32_t width = static_cast<std::int32_t>(readLe32(header + 18));
+    std::int32_t height = static_cast<std::int32_t>(readLe32(header + 22));
+    std::uint16_t bitCount = readLe16(header + 28);
+    std::uint32_t compression = readLe32(header + 30);
+
+    bool topDown = height < 0;
+    height = topDown ? -height : height;
+    bool supportedCompression = compression == 0 || (compression == 3 && bitCount == 32);
+    if (infoSize < 40 || width <= 0 || height <= 0 || width > MAX_IMAGE_SIDE ||
+        height > MAX_IMAGE_SIDE || !supportedCompression ||
+        (bitCount != 8 && bitCount != 24 && bitCount != 32)) {
+        error = "unsupported BMP variant";
+        return false;
+    }
+    fullWidth = width;
+    fullHeight = height;
+
+    // 8-bit images index a BGRA palette right after the info header
+    std::vector<std::uint8_t> paletteGray(256, 0);
+    if (bitCount == 8) {
+        unsigned char palette[256 * 4] = {};
+        input.seekg(14 + infoSize);
+        input.read(reinterpret_cast<char*>(palette), sizeof(palette));
+        for (int i = 0; i < 256; ++i) {
+            paletteGray[i] = static_cast<std::uint8_t>(
+                (palette[i * 4] * 29 + palette[i * 4 + 1] * 150 + palette[i * 4 + 2] * 77) >> 8);
+        }
+        input.clear();
+    }
+
+    const int bytesPerPixel = bitCount / 8;
+    const std::size_t stride = ((static_cast<std::size_t>(width) * bitCount + 31) / 32) * 4;
+    const int step = std::max(1, std::min(width, height) / BMP_SAMPLE_GRID);
+
+    image.width = (width + step - 1) / step;
+    image.height = (height + step - 1) / step;
+    image.pixels.resize(static_cast<std::size_t>(image.width) * image.height);
+
+    std::vector<unsigned char> row(stride);
+    for (int y = 0; y < image.height; ++y) {
+        int sourceRow = y * step;
+        int fileRow = topDown ? sourceRow : height - 1 - sourceRow;
+        input.seekg(static_cast<std::streamoff>(pixelOffset + stride * fileRow));
+        if (!input.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(stride))) {
+            error = "truncated BMP";
+            return false;
+        }
+        for (int x = 0; x < image.width; ++x) {
+            const unsigned char* pixel = row.data() + static_cast<std::size_t>(x) * step * bytesPerPixel;
+            image.pixels[static_cast<std::size_t>(y) * image.width + x] = bitCount == 8
+                ? paletteGray[pixel[0]]
+                : static_cast<std::uint8_t>((pixel[0] * 29 + pixel[1] * 150 + pixel[2] * 77) >> 8);
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Difference Hash
+// Box-average to 9x8, then one bit per row neighbour: left darker than right
+//------------------------------------------------------------------------------
+std::uint64_t differenceHash(const GrayImage& image) {
+    double cells[HASH_HEIGHT][HASH_WIDTH];
+    for (int cy = 0; cy < HASH_HEIGHT; ++cy) {
+        int y0 = cy * image.height / HASH_HEIGHT;
+        int y1 = std::max(y0 + 1, (cy + 1) * image.height / HASH_HEIGHT);
+        for (int cx = 0; cx < HASH_WIDTH; ++cx) {
+            int x0 = cx * image.width / HASH_WIDTH;
+            int x1 = std::max(x0 + 1, (cx + 1) * image.width / HASH_WIDTH);
+            long long sum = 0;
+            for (int y = y0; y < y1; ++y) {
+                const std::uint8_t* line = image.pixels.data() + static_cast<std::size_t>(y) * image.width;
+                for (int x = x0; x < x1; ++x) {
+                    sum += line[x];
+                }
+            }
+            cells[cy][cx] = static_cast<double>(sum) / ((y1 - y0) * (x1 - x0));
+        }
+    }
+
+    std::uint64_t hash = 0;
+    for (int cy = 0; cy < HASH_HEIGHT; ++cy) {
+        for (int cx = 0; cx + 1 < HASH_WIDTH; ++cx) {
+            hash = (hash << 1) | (cells[cy][cx] < cells[cy][cx + 1] ? 1u : 0u);
+        }
+    }
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// BkTree Class
+// Metric tree over Hamming distance: a query only descends into children
+// whose edge distance is within the radius of the query's distance to the node
+//------------------------------------------------------------------------------
+class BkTree {
+public:
+    void insert(std::uint64_t hash, std::uint32_t id) {
+        if (nodes_.empty()) {
+            nodes_.push_back({ hash, id, {} });
+            return;
+        }
+        std::uint32_t current = 0;
+        while (true) {
+            int d = PerceptualHasher::distance(hash, nodes_[current].hash);
+            auto& children = nodes_[current].children;
+            auto child = std::find_if(children.begin(), children.end(),
+                                      [d](const std::pair<int, std::uint32_t>& edge) {
+                                          return edge.first == d;
+                                      });
+            if (child != children.end()) {
+                current = child->second;
+                continue;
+            }
+            auto index = static_cast<std::uint32_t>(nodes_.size());
+            children.push_back({ d, index });
+            nodes_.push_back({ hash, id, {} }); // After the push: children may move
+            return;
+        }
+    }
+
+    template <typename Visit>
+    void query(std::uint64_t hash, int radius, Visit&& visit) const {
+        if (nodes_.empty()) {
+            return;
+        }
+        std::vector<std::uint32_t> pending = { 0 };
+        while (!pending.empty()) {
+            const Node& node = nodes_[pending.back()];
+            pending.pop_back();
+            int d = PerceptualHasher::distance(hash, node.hash);
+            if (d <= radius) {
+                visit(node.id);
+            }
+            for (const auto& [edge, child] : node.children) {
+                if (edge >= d - radius && edge <= d + radius) {
+                    pending.push_back(child);
+                }
+            }
+        }
+    }
+
+private:
+    struct Node {
+        std::uint64_t hash;
+        std::uint32_t id;
+        std::vector<std::pair<int, std::uint32_t>> children;   // (distance, node)
+    };
+    std::vector<Node> nodes_;
+};
+
+//------------------------------------------------------------------------------
+// Helper: Union-Find Root with Path Halving
+//------------------------------------------------------------------------------
+std::uint32_t findRoot(std::vector<std::uint32_t>& parent, std::uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// Worker result for one image
+struct HashOutcome {
+    bool ok;
+    ImageHash image;
+    std::string error;
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+PerceptualHasher::PerceptualHasher(Logger& logger, ThreadPool& pool)
+    : logger_(logger),
+      pool_(pool),
+      maxDistance_(PHASH_DEFAULT_MAX_DISTANCE),
+      hashedCount_(0),
+      skippedCount_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Configuration
+//------------------------------------------------------------------------------
+void PerceptualHasher::setMaxDistance(int bits) {
+    maxDistance_ = std::clamp(bits, 0, PHASH_MAX_DISTANCE_LIMIT);
+}
+
+//------------------------------------------------------------------------------
+// Find Similar Images
+//------------------------------------------------------------------------------
+void PerceptualHasher::findSimilar(const std::vector<FileInfo>& images) {
+    groups_.clear();
+    hashedCount_ = 0;
+    skippedCount_ = 0;
+
+    // Step 1: Decode and hash in parallel
+    std::vector<std::future<HashOutcome>> pending;
+    for (const auto& file : images) {
+        if (!isSupported(file.extension)) {
+            skippedCount_++;
+            continue;
+        }
+        const FileInfo* source = &file;
+        pending.push_back(pool_.submit([source]() {
+            HashOutcome outcome;
+            outcome.image.file = *source;
+            outcome.ok = hashImage(source->path, outcome.image, outcome.error);
+            return outcome;
+        }));
+    }
+
+    std::vector<ImageHash> hashed;
+    hashed.reserve(pending.size());
+    for (auto& future : pending) {
+        pool_.waitFor(future);
+        HashOutcome outcome = future.get();
+        if (outcome.ok) {
+            hashed.push_back(std::move(outcome.image));
+        } else {
+            skippedCount_++;
+            logger_.fileEvent(LogLevel::WARNING, "Cannot hash image: " +
+                              outcome.image.file.name + " - " + outcome.error);
+        }
+    }
+    hashedCount_ = hashed.size();
+
+    // Step 2: Identical hashes share one tree node
+    std::unordered_map<std::uint64_t, std::uint32_t> uniqueIndex;
+    std::vector<std::uint64_t> uniqueHashes;
+    std::vector<std::uint32_t> imageToUnique(hashed.size());
+    for (std::size_t i = 0; i < hashed.size(); ++i) {
+        auto [it, inserted] = uniqueIndex.emplace(hashed[i].hash,
+                                                  static_cast<std::uint32_t>(uniqueHashes.size()));
+        if (inserted) {
+            uniqueHashes.push_back(hashed[i].hash);
+        }
+        imageToUnique[i] = it->second;
+    }
+
+    BkTree tree;
+    for (std::size_t u = 0; u < uniqueHashes.size(); ++u) {
+        tree.insert(uniqueHashes[u], static_cast<std::uint32_t>(u));
+    }
+
+    // Step 3: Join every hash with its neighbours
+    std::vector<std::uint32_t> parent(uniqueHashes.size());
+    for (std::size_t u = 0; u < parent.size(); ++u) {
+        parent[u] = static_cast<std::uint32_t>(u);
+    }
+    for (std::size_t u = 0; u < uniqueHashes.size(); ++u) {
+        tree.query(uniqueHashes[u], maxDistance_, [&](std::uint32_t other) {
+            std::uint32_t a = findRoot(parent, static_cast<std::uint32_t>(u));
+            std::uint32_t b = findRoot(parent, other);
+            if (a != b) {
+                parent[std::max(a, b)] = std::min(a, b);
+            }
+        });
+    }
+
+    // Step 4: Build groups, best copy first
+    std::map<std::uint32_t, std::vector<std::size_t>> byRoot;
+    for (std::size_t i = 0; i < hashed.size(); ++i) {
+        byRoot[findRoot(parent, imageToUnique[i])].push_back(i);
+    }
+    for (auto& [root, members] : byRoot) {
+        if (members.size() < 2) {
+            continue;
+        }
+        SimilarImageGroup group;
+        for (std::size_t i : members) {
+            group.images.push_back(hashed[i]);
+        }
+        std::sort(group.images.begin(), group.images.end(),
+                  [](const ImageHash& a, const ImageHash& b) {
+                      long long pixelsA = static_cast<long long>(a.width) * a.height;
+                      long long pixelsB = static_cast<long long>(b.width) * b.height;
+                      if (pixelsA != pixelsB) {
+                          return pixelsA > pixelsB;
+                      }
+                      if (a.file.sizeBytes != b.file.sizeBytes) {
+                          return a.file.sizeBytes > b.file.sizeBytes;
+                      }
+                      return a.file.name < b.file.name;
+                  });
+        groups_.push_back(std::move(group));
+    }
+    std::stable_sort(groups_.begin(), groups_.end(),
+                     [](const SimilarImageGroup& a, const SimilarImageGroup& b) {
+                         return a.images.size() > b.images.size();
+                     });
+
+    logger_.info("Hashed " + std::to_string(hashedCount_) + " images (" +
+                 std::to_string(skippedCount_) + " skipped), " +
+                 std::to_string(groups_.size()) + " groups of similar images");
+}
+
+//------------------------------------------------------------------------------
+// Get Detection Results
+//------------------------------------------------------------------------------
+const std::vector<SimilarImageGroup>& PerceptualHasher::getGroups() const {
+    return groups_;
+}
+
+std::size_t PerceptualHasher::getHashedCount() const {
+    return hashedCount_;
+}
+
+std::size_t PerceptualHasher::getSkippedCount() const {
+    return skippedCount_;
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+bool PerceptualHasher::isSupported(const std::string& extension) {
+#ifdef SMARTCLEANER_WITH_JPEG
+    if (extension == ".jpg" || extension == ".jpeg") {
+        return true;
+    }
+#endif
+    return extension == ".bmp";
+}
+
+bool PerceptualHasher::hashImage(const fs::path& path, ImageHash& result, std::string& error) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    GrayImage image;
+    int fullWidth = 0;
+    int fullHeight = 0;
+    bool decoded = false;
+    if (extension == ".bmp") {
+        decoded = decodeBmp(path, image, fullWidth, fullHeight, error);
+    } else if (extension == ".jpg" || extension == ".jpeg") {
+#ifdef SMARTCLEANER_WITH_JPEG
+        decoded = decodeJpeg(path, image, fullWidth, fullHeight, error);
+#else
+        error = "built without JPEG support";
+#endif
+    } else {
+        error = "unsupported image format";
+    }
+    if (!decoded) {
+        return false;
+    }
+    if (image.width < 1 || image.height < 1) {
+        error = "empty image";
+        return false;
+    }
+
+    result.hash = differenceHash(image);
+    result.width = fullWidth;
+    result.height = fullHeight;
+    return true;
+}
+
+int PerceptualHasher::distance(std::uint64_t a, std::uint64_t b) {
+    return static_cast<int>(std::bitset<64>(a ^ b).count());
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,82 @@
+//==============================================================================
+// PerceptualHash.h - Near-Duplicate Image Detection Interface
+//==============================================================================
+
+#ifndef PERCEPTUAL_HASH_H
+#define PERCEPTUAL_HASH_H
+
+#include "FileScanner.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class ThreadPool;
+
+//------------------------------------------------------------------------------
+// ImageHash Structure
+//------------------------------------------------------------------------------
+struct ImageHash {
+    FileInfo file;                  // The image file
+    std::uint64_t hash;             // 64-bit dHash
+    int width;                      // Full-size dimensions from the header
+    int height;
+};
+
+//------------------------------------------------------------------------------
+// SimilarImageGroup Structure
+// images[0] is the copy to keep (most pixels, then largest file)
+//------------------------------------------------------------------------------
+struct SimilarImageGroup {
+    std::vector<ImageHash> images;
+};
+
+//------------------------------------------------------------------------------
+// PerceptualHasher Class
+// Matches resized and re-encoded copies of the same picture. Each image is
+// decoded at reduced scale (JPEGs straight from the DCT coefficients at 1/8
+// size), shrunk to 9x8 grayscale and turned into a 64-bit difference hash.
+// Hashes within the Hamming distance are found with a BK-tree and joined
+// into groups.
+//
+// JPEG needs a build with SMARTCLEANER_WITH_JPEG (libjpeg); BMP is built in.
+//------------------------------------------------------------------------------
+class PerceptualHasher {
+public:
+    // Constructor
+    PerceptualHasher(Logger& logger, ThreadPool& pool);
+
+    // Configuration
+    void setMaxDistance(int bits);
+
+    // Main detection method
+    void findSimilar(const std::vector<FileInfo>& images);
+
+    // Get detection results
+    const std::vector<SimilarImageGroup>& getGroups() const;
+    std::size_t getHashedCount() const;
+    std::size_t getSkippedCount() const;
+
+    // Helpers
+    static bool isSupported(const std::string& extension);
+    static bool hashImage(const std::filesystem::path& path, ImageHash& result,
+                          std::string& error);
+    static int distance(std::uint64_t a, std::uint64_t b);
+
+private:
+    Logger& logger_;                            // Reference to logger
+    ThreadPool& pool_;                          // Decoding workers
+    int maxDistance_;                           // Hamming threshold
+    std::vector<SimilarImageGroup> groups_;     // Groups of 2+ images
+    std::size_t hashedCount_;                   // Images decoded and hashed
+    std::size_t skippedCount_;                  // Unsupported or unreadable
+};
+
+} // namespace DesktopCleaner
+
+#endif // PERCEPTUAL_HASH_H
@@ -0,0 +1,290 @@
+//==============================================================================
+// PerfCounters.cpp - Per-Phase Hardware Counter Implementation
+//==============================================================================
+
+#include "PerfCounters.h"
+#include "Logger.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace DesktopCleaner {
+
+namespace {
+
+const char* const EVENT_HEADINGS[] = {
+    "cycles", "instr", "cache-miss", "branch-miss", "ctx-sw", "faults"
+};
+
+#ifdef __linux__
+struct EventSpec {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+// Order matches PerfEvent
+const EventSpec EVENT_SPECS[] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+};
+
+//------------------------------------------------------------------------------
+// Helper: Open One Counter for the Calling Thread (-1 on failure, errno set)
+// Inherited by every thread it starts afterwards; reading the counter sums
+// them, so pool workers are charged to the phase the owner is in
+//------------------------------------------------------------------------------
+int openEvent(const EventSpec& spec, bool includeKernel) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.exclude_kernel = includeKernel ? 0 : 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    // Enabled/running times let us scale readings when the PMU is multiplexed
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1,
+                                    PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Helper: Compact Count ("12.3M")
+//------------------------------------------------------------------------------
+std::string formatCount(double value) {
+    const char* suffixes[] = { "", "K", "M", "G", "T" };
+    int index = 0;
+    while (value >= 1000.0 && index < 4) {
+        value /= 1000.0;
+        index++;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), index == 0 ? "%.0f%s" : "%.1f%s", value, suffixes[index]);
+    return buffer;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+PerfCounters::PerfCounters(Logger& logger)
+    : logger_(logger),
+      active_(false),
+      kernelCounted_(false),
+      lastValues_(),
+      lastSwitch_(std::chrono::steady_clock::now()),
+      totals_(),
+      seconds_() {
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        fds_[i] = -1;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    if (active_) {
+        logger_.setPerfCounters(nullptr);
+    }
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            ::close(fds_[i]);
+        }
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Open
+//------------------------------------------------------------------------------
+bool PerfCounters::open() {
+    if (active_) {
+        return true;
+    }
+
+#ifdef __linux__
+    // Prefer user+kernel counts; perf_event_paranoid >= 2 only allows user
+    int opened = 0;
+    int lastError = 0;
+    for (int attempt = 0; attempt < 2 && opened == 0; attempt++) {
+        bool includeKernel = (attempt == 0);
+        for (int i = 0; i < EVENT_COUNT; i++) {
+            fds_[i] = openEvent(EVENT_SPECS[i], includeKernel);
+            if (fds_[i] >= 0) {
+                opened++;
+            } else {
+                lastError = errno;
+            }
+        }
+        kernelCounted_ = includeKernel;
+    }
+
+    if (opened == 0) {
+        unavailableReason_ = std::strerror(lastError);
+        logger_.warning("Performance counters unavailable: " + unavailableReason_);
+        return false;
+    }
+
+    active_ = true;
+    owner_ = std::this_thread::get_id();
+    readValues(lastValues_);
+    lastSwitch_ = std::chrono::steady_clock::now();
+    logger_.setPerfCounters(this);
+    logger_.info("Performance counters: " + std::to_string(opened) + "/" +
+                 std::to_string(EVENT_COUNT) + " events" +
+                 (kernelCounted_ ? "" : " (user-space only)"));
+    return true;
+#else
+    unavailableReason_ = "not supported on this platform";
+    logger_.warning("Performance counters unavailable: " + unavailableReason_);
+    return false;
+#endif
+}
+
+bool PerfCounters::isActive() const {
+    return active_;
+}
+
+//------------------------------------------------------------------------------
+// Phase Stack
+//------------------------------------------------------------------------------
+void PerfCounters::pushPhase(PerfPhase phase) {
+    if (!active_ || std::this_thread::get_id() != owner_) {
+        return;
+    }
+    charge();
+    stack_.push_back(phase);
+}
+
+void PerfCounters::popPhase() {
+    if (!active_ || std::this_thread::get_id() != owner_) {
+        return;
+    }
+    charge();
+    if (!stack_.empty()) {
+        stack_.pop_back();
+    }
+}
+
+PerfCounters::ScopedPhase::ScopedPhase(PerfCounters* counters, PerfPhase phase)
+    : counters_(counters) {
+    if (counters_ != nullptr) {
+        counters_->pushPhase(phase);
+    }
+}
+
+PerfCounters::ScopedPhase::~ScopedPhase() {
+    if (counters_ != nullptr) {
+        counters_->popPhase();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Reporting
+//------------------------------------------------------------------------------
+void PerfCounters::report(std::ostream& out) {
+    if (!active_) {
+        out << "Performance counters: unavailable ("
+            << (unavailableReason_.empty() ? "not enabled" : unavailableReason_) << ")\n";
+        return;
+    }
+    if (std::this_thread::get_id() == owner_) {
+        charge();
+    }
+
+    out << "Performance counters (all threads"
+        << (kernelCounted_ ? "" : ", user-space only") << "):\n";
+    out << "  " << std::left << std::setw(10) << "phase" << std::right
+        << std::setw(10) << "time ms";
+    for (int e = 0; e < EVENT_COUNT; e++) {
+        out << std::setw(12) << EVENT_HEADINGS[e];
+    }
+    out << std::setw(7) << "IPC" << '\n';
+
+    for (int p = 0; p < PHASE_COUNT; p++) {
+        if (seconds_[p] <= 0.0) {
+            continue;
+        }
+        char milliseconds[32];
+        std::snprintf(milliseconds, sizeof(milliseconds), "%.1f", seconds_[p] * 1000.0);
+        out << "  " << std::left << std::setw(10) << phaseName(static_cast<PerfPhase>(p))
+            << std::right << std::setw(10) << milliseconds;
+        for (int e = 0; e < EVENT_COUNT; e++) {
+            out << std::setw(12) << (fds_[e] >= 0 ? formatCount(totals_[p][e]) : std::string("-"));
+        }
+
+        double cycles = totals_[p][static_cast<int>(PerfEvent::CYCLES)];
+        double instructions = totals_[p][static_cast<int>(PerfEvent::INSTRUCTIONS)];
+        char ipc[16] = "-";
+        if (cycles > 0.0 && fds_[static_cast<int>(PerfEvent::INSTRUCTIONS)] >= 0) {
+            std::snprintf(ipc, sizeof(ipc), "%.2f", instructions / cycles);
+        }
+        out << std::setw(7) << ipc << '\n';
+    }
+}
+
+const char* PerfCounters::phaseName(PerfPhase phase) {
+    switch (phase) {
+        case PerfPhase::OTHER:    return "other";
+        case PerfPhase::SCAN:     return "scan";
+        case PerfPhase::CLASSIFY: return "classify";
+        case PerfPhase::ANALYZE:  return "analyze";
+        case PerfPhase::MOVE:     return "move";
+        case PerfPhase::LOG:      return "log";
+        default:                  return "unknown";
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+void PerfCounters::readValues(double* values) const {
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        values[i] = 0.0;
+#ifdef __linux__
+        if (fds_[i] < 0) {
+            continue;
+        }
+        std::uint64_t reading[3] = { 0, 0, 0 }; // value, time enabled, time running
+        if (::read(fds_[i], reading, sizeof(reading)) != static_cast<ssize_t>(sizeof(reading))) {
+            continue;
+        }
+        if (reading[2] > 0) {
+            values[i] = static_cast<double>(reading[0]) *
+                        (static_cast<double>(reading[1]) / static_cast<double>(reading[2]));
+        }
+#endif
+    }
+}
+
+void PerfCounters::charge() {
+    double current[EVENT_COUNT];
+    readValues(current);
+    auto now = std::chrono::steady_clock::now();
+
+    int phase = stack_.empty() ? static_cast<int>(PerfPhase::OTHER)
+                               : static_cast<int>(stack_.back());
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (current[i] > lastValues_[i]) {
+            totals_[phase][i] += current[i] - lastValues_[i];
+        }
+        lastValues_[i] = current[i];
+    }
+    seconds_[phase] += std::chrono::duration<double>(now - lastSwitch_).count();
+    lastSwitch_ = now;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,111 @@
+//==============================================================================
+// PerfCounters.h - Per-Phase Hardware Counter Interface
+//==============================================================================
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declaration
+class Logger;
+
+//------------------------------------------------------------------------------
+// Pipeline Phases
+//------------------------------------------------------------------------------
+enum class PerfPhase {
+    OTHER,          // Anything outside a named phase
+    SCAN,
+    CLASSIFY,
+    ANALYZE,
+    MOVE,
+    LOG,
+    COUNT           // Number of phases, not a phase
+};
+
+//------------------------------------------------------------------------------
+// Counted Events
+//------------------------------------------------------------------------------
+enum class PerfEvent {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    CONTEXT_SWITCHES,
+    PAGE_FAULTS,
+    COUNT           // Number of events, not an event
+};
+
+//------------------------------------------------------------------------------
+// PerfCounters Class
+// Counts events with perf_event_open for the owning thread and every thread
+// it starts after open() (pool workers included), and charges them to the
+// owner's innermost active phase. Phases nest (a log write during a scan
+// counts as LOG); phase calls from other threads are ignored. Without
+// permission or kernel support every method is a cheap no-op.
+//------------------------------------------------------------------------------
+class PerfCounters {
+public:
+    // Constructor / Destructor
+    explicit PerfCounters(Logger& logger);
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Open the counters for the calling thread and the threads it starts
+    // later (so before any pool), and hook the logger's writes into the LOG
+    // phase; false = collection unavailable
+    bool open();
+    bool isActive() const;
+
+    // Phase stack
+    void pushPhase(PerfPhase phase);
+    void popPhase();
+
+    // RAII helper: counts a scope as one phase (null counters = no-op)
+    class ScopedPhase {
+    public:
+        ScopedPhase(PerfCounters* counters, PerfPhase phase);
+        ~ScopedPhase();
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+    private:
+        PerfCounters* counters_;
+    };
+
+    // Reporting
+    void report(std::ostream& out);
+    static const char* phaseName(PerfPhase phase);
+
+private:
+    static const int PHASE_COUNT = static_cast<int>(PerfPhase::COUNT);
+    static const int EVENT_COUNT = static_cast<int>(PerfEvent::COUNT);
+
+    Logger& logger_;                                        // Reference to logger
+    int fds_[EVENT_COUNT];                                  // -1 = event unavailable
+    bool active_;                                           // At least one event opened
+    bool kernelCounted_;                                    // Kernel-mode events included
+    std::thread::id owner_;                                 // Thread being counted
+    std::vector<PerfPhase> stack_;                          // Active phases, innermost last
+    double lastValues_[EVENT_COUNT];                        // Readings at the last switch
+    std::chrono::steady_clock::time_point lastSwitch_;      // Time of the last switch
+    double totals_[PHASE_COUNT][EVENT_COUNT];               // Per-phase event totals
+    double seconds_[PHASE_COUNT];                           // Per-phase wall time
+    std::string unavailableReason_;                         // Why open() failed
+
+    // Helper methods
+    void readValues(double* values) const;
+    void charge();
+};
+
+} // namespace DesktopCleaner
+
+#endif // PERF_COUNTERS_H
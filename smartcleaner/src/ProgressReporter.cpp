@@ -0,0 +1,175 @@
+//==============================================================================
+// ProgressReporter.cpp - Rate-Limited Progress Display Implementation
+//==============================================================================
+
+#include "ProgressReporter.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <io.h>
+#define SMARTCLEANER_ISATTY(fd) _isatty(fd)
+#define SMARTCLEANER_FILENO(f) _fileno(f)
+#else
+#include <unistd.h>
+#define SMARTCLEANER_ISATTY(fd) isatty(fd)
+#define SMARTCLEANER_FILENO(f) fileno(f)
+#endif
+
+namespace DesktopCleaner {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Helper: Format Byte Rate
+//------------------------------------------------------------------------------
+std::string formatBytes(double bytes) {
+    const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        unit++;
+    }
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << bytes << " " << units[unit];
+    return oss.str();
+}
+
+//------------------------------------------------------------------------------
+// Helper: Format Duration as H:MM:SS
+//------------------------------------------------------------------------------
+std::string formatDuration(long long seconds) {
+    std::ostringstream oss;
+    oss << seconds / 3600 << ":" << std::setfill('0')
+        << std::setw(2) << (seconds / 60) % 60 << ":"
+        << std::setw(2) << seconds % 60;
+    return oss.str();
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+// The status line is only drawn when stderr is an interactive terminal
+//------------------------------------------------------------------------------
+ProgressReporter::ProgressReporter(Logger& logger, int redrawsPerSecond)
+    : logger_(logger),
+      redrawInterval_(redrawsPerSecond > 0 ? 1000 / std::min(redrawsPerSecond, 1000) : 0),
+      enabled_(redrawsPerSecond > 0 && SMARTCLEANER_ISATTY(SMARTCLEANER_FILENO(stderr))),
+      totalFiles_(0),
+      totalBytes_(0),
+      filesDone_(0),
+      bytesDone_(0),
+      stopping_(false) {
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+//------------------------------------------------------------------------------
+ProgressReporter::~ProgressReporter() {
+    endPhase();
+}
+
+//------------------------------------------------------------------------------
+// Begin Phase
+//------------------------------------------------------------------------------
+void ProgressReporter::beginPhase(const std::string& label, long long totalFiles,
+                                  long long totalBytes) {
+    endPhase();
+
+    label_ = label;
+    totalFiles_ = totalFiles;
+    totalBytes_ = totalBytes;
+    filesDone_ = 0;
+    bytesDone_ = 0;
+    startTime_ = std::chrono::steady_clock::now();
+
+    if (enabled_) {
+        stopping_ = false;
+        drawThread_ = std::thread(&ProgressReporter::drawLoop, this);
+    }
+}
+
+//------------------------------------------------------------------------------
+// End Phase
+// Stops the redraw thread and erases the status line
+//------------------------------------------------------------------------------
+void ProgressReporter::endPhase() {
+    if (!drawThread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    drawThread_.join();
+
+    logger_.clearStatusLine();
+}
+
+//------------------------------------------------------------------------------
+// Counter Update
+//------------------------------------------------------------------------------
+void ProgressReporter::addFile(long long bytes) {
+    filesDone_.fetch_add(1, std::memory_order_relaxed);
+    bytesDone_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+bool ProgressReporter::isEnabled() const {
+    return enabled_;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Redraw Loop
+//------------------------------------------------------------------------------
+void ProgressReporter::drawLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!condition_.wait_for(lock, redrawInterval_, [this]() { return stopping_; })) {
+        logger_.writeStatusLine(formatStatus());
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helper: Format Status Line
+//------------------------------------------------------------------------------
+std::string ProgressReporter::formatStatus() const {
+    long long files = filesDone_.load(std::memory_order_relaxed);
+    long long bytes = bytesDone_.load(std::memory_order_relaxed);
+    double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime_).count();
+
+    double filesPerSecond = elapsed > 0.0 ? files / elapsed : 0.0;
+    double bytesPerSecond = elapsed > 0.0 ? bytes / elapsed : 0.0;
+
+    std::ostringstream oss;
+    oss << "[" << label_ << "] " << files;
+    if (totalFiles_ > 0) {
+        oss << "/" << totalFiles_;
+    }
+    oss << " files  " << std::fixed << std::setprecision(1) << filesPerSecond << " files/s  "
+        << formatBytes(bytesPerSecond) << "/s";
+
+    // Prefer bytes for the ETA since large files dominate I/O time
+    double remaining = -1.0;
+    if (totalBytes_ > 0 && bytesPerSecond > 0.0) {
+        remaining = (totalBytes_ - bytes) / bytesPerSecond;
+    } else if (totalFiles_ > 0 && filesPerSecond > 0.0) {
+        remaining = (totalFiles_ - files) / filesPerSecond;
+    }
+    if (remaining >= 0.0) {
+        oss << "  ETA " << formatDuration(static_cast<long long>(remaining));
+    }
+
+    return oss.str();
+}
+
+} // namespace DesktopCleaner
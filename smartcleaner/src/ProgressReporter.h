@@ -0,0 +1,71 @@
+//==============================================================================
+// ProgressReporter.h - Rate-Limited Progress Display Interface
+//==============================================================================
+
+#ifndef PROGRESS_REPORTER_H
+#define PROGRESS_REPORTER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace DesktopCleaner {
+
+// Forward declaration
+class Logger;
+
+//------------------------------------------------------------------------------
+// ProgressReporter Class
+// Workers bump atomic counters; a background thread redraws one status line
+// at most redrawsPerSecond times, so terminal speed never gates the workers.
+//------------------------------------------------------------------------------
+class ProgressReporter {
+public:
+    // Constructor & Destructor (0 redraws per second = disabled)
+    ProgressReporter(Logger& logger, int redrawsPerSecond);
+    ~ProgressReporter();
+
+    // Prevent copying
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    // Phase control (totals of 0 mean unknown, which hides the ETA)
+    void beginPhase(const std::string& label, long long totalFiles = 0, long long totalBytes = 0);
+    void endPhase();
+
+    // Counter update, safe from any thread
+    void addFile(long long bytes);
+
+    // Status methods
+    bool isEnabled() const;
+
+private:
+    Logger& logger_;                                    // Owns the console
+    std::chrono::milliseconds redrawInterval_;          // Minimum time between redraws
+    bool enabled_;                                      // Console is a terminal and rate > 0
+
+    // Current phase
+    std::string label_;                                 // Phase name shown in the line
+    long long totalFiles_;                              // Expected files (0 = unknown)
+    long long totalBytes_;                              // Expected bytes (0 = unknown)
+    std::chrono::steady_clock::time_point startTime_;   // Phase start
+    std::atomic<long long> filesDone_;                  // Files completed
+    std::atomic<long long> bytesDone_;                  // Bytes completed
+
+    // Redraw thread
+    std::thread drawThread_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+
+    // Helper methods
+    void drawLoop();
+    std::string formatStatus() const;
+};
+
+} // namespace DesktopCleaner
+
+#endif // PROGRESS_REPORTER_H
@@ -0,0 +1,282 @@
+//==============================================================================
+// ResourceLimits.cpp - Container-Aware CPU and Memory Limits Implementation
+//==============================================================================
+
+#include "ResourceLimits.h"
+#include "Config.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Snapshot Structure
+//------------------------------------------------------------------------------
+struct Snapshot {
+    std::size_t cpus = 1;
+    std::string cpuSource = "hardware";
+    long long memoryBytes = 0;
+    std::string memorySource = "unknown";
+
+    bool operator==(const Snapshot& other) const {
+        return cpus == other.cpus && memoryBytes == other.memoryBytes;
+    }
+};
+
+std::mutex g_mutex;
+Snapshot g_current;
+bool g_loaded = false;
+
+bool readFirstLine(const fs::path& path, std::string& line) {
+    std::ifstream input(path);
+    return static_cast<bool>(std::getline(input, line));
+}
+
+#ifdef __linux__
+//------------------------------------------------------------------------------
+// Helper: This Process's Cgroup Directory
+// v2 lists "0::<path>"; v1 lists "<id>:<controllers>:<path>" per hierarchy.
+// Inside a cgroup namespace the path is "/" and the mount is the leaf itself.
+//------------------------------------------------------------------------------
+fs::path cgroupDirectory(const fs::path& mount, const std::string& controller) {
+    std::ifstream input("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(input, line)) {
+        std::size_t first = line.find(':');
+        std::size_t second = line.find(':', first + 1);
+        if (first == std::string::npos || second == std::string::npos) {
+            continue;
+        }
+        std::string controllers = "," + line.substr(first + 1, second - first - 1) + ",";
+        bool matches = controller.empty() ? line.compare(0, 3, "0::") == 0
+                                          : controllers.find("," + controller + ",") != std::string::npos;
+        if (matches) {
+            fs::path relative = fs::path(line.substr(second + 1)).relative_path();
+            fs::path directory = mount / relative;
+            std::error_code error;
+            return !relative.empty() && fs::is_directory(directory, error) ? directory : mount;
+        }
+    }
+    return mount;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Walk From the Leaf Cgroup Up to the Mount
+// Every ancestor's limit applies, so the tightest one wins
+//------------------------------------------------------------------------------
+template <typename Reader>
+void walkUp(const fs::path& mount, fs::path directory, Reader read) {
+    for (;;) {
+        read(directory);
+        if (directory == mount || !directory.has_parent_path() ||
+            directory.parent_path() == directory) {
+            return;
+        }
+        directory = directory.parent_path();
+    }
+}
+
+std::size_t countCpuList(const std::string& list) {
+    std::size_t count = 0;
+    std::stringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        if (range.empty()) {
+            continue;
+        }
+        std::size_t dash = range.find('-');
+        try {
+            long first = std::stol(range.substr(0, dash));
+            long last = dash == std::string::npos ? first : std::stol(range.substr(dash + 1));
+            if (last >= first) {
+                count += static_cast<std::size_t>(last - first + 1);
+            }
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    return count;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Apply Cgroup Limits
+// Prefers the unified (v2) hierarchy; falls back to the v1 cpu/memory mounts
+//------------------------------------------------------------------------------
+void applyCgroupLimits(Snapshot& snapshot) {
+    const fs::path mount(CGROUP_MOUNT_POINT);
+    std::error_code error;
+    auto lowerCpus = [&snapshot](std::size_t cpus, const char* source) {
+        if (cpus > 0 && cpus < snapshot.cpus) {
+            snapshot.cpus = cpus;
+            snapshot.cpuSource = source;
+        }
+    };
+    auto lowerMemory = [&snapshot](long long bytes, const char* source) {
+        if (bytes > 0 && (snapshot.memoryBytes == 0 || bytes < snapshot.memoryBytes)) {
+            snapshot.memoryBytes = bytes;
+            snapshot.memorySource = source;
+        }
+    };
+
+    if (fs::exists(mount / "cgroup.controllers", error)) {
+        fs::path leaf = cgroupDirectory(mount, "");
+        walkUp(mount, leaf, [&](const fs::path& directory) {
+            std::string line;
+            // cpu.max: "<quota> <period>" or "max <period>"
+            if (readFirstLine(directory / "cpu.max", line) && line.compare(0, 3, "max") != 0) {
+                std::istringstream fields(line);
+                long long quota = 0;
+                long long period = 0;
+                if (fields >> quota >> period && quota > 0 && period > 0) {
+                    lowerCpus(static_cast<std::size_t>((quota + period - 1) / period), "cpu.max");
+                }
+            }
+            if (readFirstLine(directory / "memory.max", line) && line != "max") {
+                try {
+                    lowerMemory(std::stoll(line), "memory.max");
+                } catch (const std::exception&) {
+                }
+            }
+        });
+        std::string cpus;
+        if (readFirstLine(leaf / "cpuset.cpus.effective", cpus)) {
+            lowerCpus(countCpuList(cpus), "cpuset");
+        }
+        return;
+    }
+
+    // v1: "unlimited" is -1 for the quota and a huge page-rounded value for memory
+    const fs::path cpuMount = mount / "cpu";
+    walkUp(cpuMount, cgroupDirectory(cpuMount, "cpu"), [&](const fs::path& directory) {
+        std::string quota;
+        std::string period;
+        if (readFirstLine(directory / "cpu.cfs_quota_us", quota) &&
+            readFirstLine(directory / "cpu.cfs_period_us", period)) {
+            try {
+                long long q = std::stoll(quota);
+                long long p = std::stoll(period);
+                if (q > 0 && p > 0) {
+                    lowerCpus(static_cast<std::size_t>((q + p - 1) / p), "cpu.cfs_quota_us");
+                }
+            } catch (const std::exception&) {
+            }
+        }
+    });
+    const fs::path memoryMount = mount / "memory";
+    walkUp(memoryMount, cgroupDirectory(memoryMount, "memory"), [&](const fs::path& directory) {
+        std::string limit;
+        if (readFirstLine(directory / "memory.limit_in_bytes", limit)) {
+            try {
+                long long bytes = std::stoll(limit);
+                if (bytes < (1LL << 62)) {
+                    lowerMemory(bytes, "memory.limit_in_bytes");
+                }
+            } catch (const std::exception&) {
+            }
+        }
+    });
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Helper: Detect Current Limits
+//------------------------------------------------------------------------------
+Snapshot detect() {
+    Snapshot snapshot;
+    snapshot.cpus = std::max(1u, std::thread::hardware_concurrency());
+
+#ifndef _WIN32
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && pageSize > 0) {
+        snapshot.memoryBytes = static_cast<long long>(pages) * pageSize;
+        snapshot.memorySource = "physical";
+    }
+#endif
+
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        std::size_t allowed = static_cast<std::size_t>(CPU_COUNT(&mask));
+        if (allowed > 0 && allowed < snapshot.cpus) {
+            snapshot.cpus = allowed;
+            snapshot.cpuSource = "affinity";
+        }
+    }
+    applyCgroupLimits(snapshot);
+#endif
+
+    return snapshot;
+}
+
+Snapshot current() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    if (!g_loaded) {
+        g_current = detect();
+        g_loaded = true;
+    }
+    return g_current;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Refresh
+//------------------------------------------------------------------------------
+bool ResourceLimits::refresh() {
+    Snapshot fresh = detect();
+    std::lock_guard<std::mutex> lock(g_mutex);
+    bool changed = g_loaded && !(fresh == g_current);
+    g_current = fresh;
+    g_loaded = true;
+    return changed;
+}
+
+//------------------------------------------------------------------------------
+// Limits
+//------------------------------------------------------------------------------
+std::size_t ResourceLimits::cpuCount() {
+    return current().cpus;
+}
+
+long long ResourceLimits::memoryLimitBytes() {
+    return current().memoryBytes;
+}
+
+long long ResourceLimits::workingMemoryBytes() {
+    long long limit = memoryLimitBytes();
+    if (limit <= 0) {
+        return DEFAULT_WORKING_MEMORY_BYTES;
+    }
+    return static_cast<long long>(static_cast<double>(limit) * WORKING_MEMORY_FRACTION);
+}
+
+std::string ResourceLimits::describe() {
+    Snapshot snapshot = current();
+    std::ostringstream text;
+    text << snapshot.cpus << (snapshot.cpus == 1 ? " CPU (" : " CPUs (") << snapshot.cpuSource << "), ";
+    if (snapshot.memoryBytes > 0) {
+        text << (snapshot.memoryBytes >> 20) << " MB (" << snapshot.memorySource << ")";
+    } else {
+        text << "memory unknown";
+    }
+    return text.str();
+}
+
+} // namespace DesktopCleaner
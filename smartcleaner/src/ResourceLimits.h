@@ -0,0 +1,40 @@
+//==============================================================================
+// ResourceLimits.h - Container-Aware CPU and Memory Limits Interface
+//==============================================================================
+
+#ifndef RESOURCE_LIMITS_H
+#define RESOURCE_LIMITS_H
+
+#include <cstddef>
+#include <string>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// ResourceLimits Class
+// What this process may actually use, as opposed to what the host has: the
+// cgroup cpu.max quota, cpuset and affinity mask bound the CPU count, and
+// memory.max (or the host's memory) bounds working buffers. Read once on
+// first use; refresh() re-reads for long-running processes.
+//------------------------------------------------------------------------------
+class ResourceLimits {
+public:
+    // Re-read the limits; true if they differ from the previous reading
+    static bool refresh();
+
+    // Threads an auto-sized pool should run (at least 1)
+    static std::size_t cpuCount();
+
+    // Memory the process may use in bytes; 0 if unknown
+    static long long memoryLimitBytes();
+
+    // Bytes of in-flight buffers a stage may hold at once
+    static long long workingMemoryBytes();
+
+    // One-line summary for logs, e.g. "2 CPUs (cpu.max), 512 MB (memory.max)"
+    static std::string describe();
+};
+
+} // namespace DesktopCleaner
+
+#endif // RESOURCE_LIMITS_H
@@ -0,0 +1,721 @@
+//==============================================================================
+// SharedFileTable.cpp - Shared-Memory File Index Implementation
+//==============================================================================
+
+#include "SharedFileTable.h"
+#include "ContentHash.h"
+#include "FileClassifier.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DesktopCleaner {
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Segment Layout
+// [TableHeader][bucketCount x TableEntry][path strings]
+// Version bumps whenever either struct changes.
+//------------------------------------------------------------------------------
+const std::uint64_t TABLE_MAGIC = 0x4C42544E41454C43ULL; // "CLEANTBL"
+const std::uint32_t TABLE_VERSION = 1;
+const std::uint64_t MIN_BUCKET_COUNT = 64;
+
+struct TableHeader {
+    std::uint64_t magic;                    // TABLE_MAGIC
+    std::uint32_t version;                  // TABLE_VERSION
+    std::uint32_t entryBytes;               // sizeof(TableEntry), layout check
+    std::atomic<std::uint64_t> sequence;    // Seqlock; odd while a publish is running
+    std::uint64_t segmentBytes;             // Segment size; readers remap when it grows
+    std::uint64_t bucketCount;              // Power of two
+    std::uint64_t entryCount;               // Occupied buckets
+    std::uint64_t stringsOffset;            // Start of the path string area
+    std::uint64_t stringsBytes;             // Length of the path string area
+    std::int64_t publishedAt;               // Unix time of the last publish
+    std::uint32_t categoryCount;            // Valid rows in categories
+    std::uint32_t closed;                   // Non-zero once the daemon has exited
+    char categories[SHM_MAX_CATEGORIES][SHM_CATEGORY_NAME_BYTES];
+};
+
+struct TableEntry {
+    std::uint64_t pathHash;                 // ContentHasher::hashPath; 0 = empty bucket
+    std::int64_t sizeBytes;
+    std::int64_t lastModified;
+    std::uint64_t pathOffset;               // Normalized path, for collision checks
+    std::uint32_t pathLength;
+    std::uint32_t duplicateGroup;
+    std::uint16_t category;                 // Row in TableHeader::categories
+    std::uint16_t duplicateStatus;          // DuplicateStatus value
+    std::uint32_t reserved;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "seqlock needs a lock-free 64-bit atomic in shared memory");
+
+const std::size_t ENTRIES_OFFSET = (sizeof(TableHeader) + 63) & ~std::size_t(63);
+const std::size_t PAGE_BYTES = 4096;
+const int LOCK_ATTEMPTS = 3;            // Retries when the name moves while we lock
+
+//------------------------------------------------------------------------------
+// Helper: Read a Field Another Process May Be Writing
+// A single load, so bounds checks and uses see the same value
+//------------------------------------------------------------------------------
+template <typename T>
+T readShared(const T& field) {
+    return *static_cast<const volatile T*>(&field);
+}
+
+std::uint64_t nextPowerOfTwo(std::uint64_t value) {
+    std::uint64_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Default Segment Name
+// Both the daemon and find-by-path clients derive it from the directory
+//------------------------------------------------------------------------------
+std::string SharedFileTable::defaultName(const std::filesystem::path& directory) {
+    std::string normalized = ContentHasher::normalizePath(directory);
+    while (normalized.size() > 1 && normalized.back() == std::filesystem::path::preferred_separator) {
+        normalized.pop_back();
+    }
+    std::ostringstream name;
+    name << SHM_NAME_PREFIX << std::hex << std::setw(16) << std::setfill('0')
+         << ContentHasher::hashPath(normalized);
+    return name.str();
+}
+
+#ifndef _WIN32
+
+//==============================================================================
+// SharedFileTable (publisher)
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+SharedFileTable::SharedFileTable(Logger& logger, const std::string& name)
+    : logger_(logger), name_(name), fd_(-1), mapping_(nullptr),
+      mappedBytes_(0), entryCount_(0), owned_(false) {
+}
+
+SharedFileTable::~SharedFileTable() {
+    if (mapping_ != nullptr) {
+        // Tell attached clients to drop their mapping
+        auto* header = static_cast<TableHeader*>(mapping_);
+        std::uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+        header->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        header->closed = 1;
+        header->sequence.store(sequence + 2, std::memory_order_release);
+    }
+    // Unlink while the lock is still held, so a daemon waiting to take the
+    // name over sees it gone and creates a fresh segment
+    if (owned_) {
+        shm_unlink(name_.c_str());
+    }
+    close();
+}
+
+//------------------------------------------------------------------------------
+// Create the Segment
+//------------------------------------------------------------------------------
+bool SharedFileTable::create() {
+    if (!openLocked()) {
+        return false;
+    }
+
+    // A segment left behind by a crashed daemon is reused in place, so any
+    // client still attached to it picks up the new contents; one that is not
+    // ours is never mapped. Holding the lock means no other daemon writes it,
+    // and whatever the old header says is overwritten below; the segment is
+    // never shrunk, so attached clients cannot fault.
+    struct stat info;
+    if (fstat(fd_, &info) != 0 || info.st_uid != geteuid()) {
+        logger_.error("Refusing shared memory " + name_ + " owned by another user");
+        close();
+        return false;
+    }
+    fchmod(fd_, 0600);
+    owned_ = true;
+
+    std::size_t existingBytes = static_cast<std::size_t>(std::max<off_t>(info.st_size, 0));
+    std::size_t initialBytes = ENTRIES_OFFSET + MIN_BUCKET_COUNT * sizeof(TableEntry);
+    if (existingBytes >= initialBytes) {
+        void* mapping = mmap(nullptr, existingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            logger_.error("Cannot map shared memory " + name_ + ": " + std::strerror(errno));
+            close();
+            return false;
+        }
+        mapping_ = mapping;
+        mappedBytes_ = existingBytes;
+    } else if (!ensureCapacity(initialBytes)) {
+        close();
+        return false;
+    }
+
+    auto* header = static_cast<TableHeader*>(mapping_);
+    std::uint64_t sequence = 0;
+    if (header->magic == TABLE_MAGIC && header->version == TABLE_VERSION) {
+        sequence = header->sequence.load(std::memory_order_relaxed) & ~std::uint64_t(1);
+    }
+
+    // Publish an empty table
+    header->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = TABLE_MAGIC;
+    header->version = TABLE_VERSION;
+    header->entryBytes = sizeof(TableEntry);
+    header->segmentBytes = mappedBytes_;
+    header->bucketCount = MIN_BUCKET_COUNT;
+    header->entryCount = 0;
+    header->stringsOffset = ENTRIES_OFFSET + MIN_BUCKET_COUNT * sizeof(TableEntry);
+    header->stringsBytes = 0;
+    header->publishedAt = 0;
+    header->categoryCount = 0;
+    header->closed = 0;
+    std::memset(static_cast<char*>(mapping_) + ENTRIES_OFFSET, 0,
+                MIN_BUCKET_COUNT * sizeof(TableEntry));
+    header->sequence.store(sequence + 2, std::memory_order_release);
+
+    logger_.info("Shared memory index created: " + name_);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Publish the Current File Table
+//------------------------------------------------------------------------------
+bool SharedFileTable::publish(const FileClassifier& classifier,
+                              const DuplicateFinder* duplicates) {
+    if (mapping_ == nullptr) {
+        logger_.error("Shared memory index is not open");
+        return false;
+    }
+
+    try {
+        const auto& categorizedFiles = classifier.getCategorizedFiles();
+
+        // Category rows: the fixed categories first, so indices stay stable
+        std::vector<std::string> categories = getAllCategories();
+        std::size_t fileCount = 0;
+        for (const auto& [category, files] : categorizedFiles) {
+            fileCount += files.size();
+            if (std::find(categories.begin(), categories.end(), category) == categories.end()) {
+                categories.push_back(category);
+            }
+        }
+        if (categories.size() > static_cast<std::size_t>(SHM_MAX_CATEGORIES)) {
+            logger_.warning("Too many categories for shared memory index; extra ones are skipped");
+            categories.resize(SHM_MAX_CATEGORIES);
+        }
+
+        // Build the table privately, then copy it in under the seqlock
+        std::uint64_t bucketCount = nextPowerOfTwo(std::max<std::uint64_t>(MIN_BUCKET_COUNT,
+                                                                           fileCount * 2));
+        std::uint64_t mask = bucketCount - 1;
+        std::vector<TableEntry> entries(bucketCount);
+        std::string strings;
+        std::size_t entryCount = 0;
+
+        for (std::size_t row = 0; row < categories.size(); ++row) {
+            auto it = categorizedFiles.find(categories[row]);
+            if (it == categorizedFiles.end()) {
+                continue;
+            }
+            for (const auto& file : it->second) {
+                std::string normalized = ContentHasher::normalizePath(file.path);
+
+                TableEntry entry{};
+                entry.pathHash = ContentHasher::hashPath(normalized);
+                entry.sizeBytes = file.sizeBytes;
+                entry.lastModified = static_cast<std::int64_t>(file.lastModified);
+                entry.pathOffset = strings.size();
+                entry.pathLength = static_cast<std::uint32_t>(normalized.size());
+                entry.category = static_cast<std::uint16_t>(row);
+                entry.duplicateStatus = static_cast<std::uint16_t>(DuplicateStatus::UNIQUE);
+                if (duplicates != nullptr) {
+                    entry.duplicateStatus = static_cast<std::uint16_t>(
+                        duplicates->getStatus(file.path.string(), &entry.duplicateGroup));
+                }
+                strings += normalized;
+
+                std::uint64_t bucket = entry.pathHash & mask;
+                while (entries[bucket].pathHash != 0) {
+                    bucket = (bucket + 1) & mask;
+                }
+                entries[bucket] = entry;
+                entryCount++;
+            }
+        }
+
+        std::size_t stringsOffset = ENTRIES_OFFSET + bucketCount * sizeof(TableEntry);
+        if (!ensureCapacity(stringsOffset + strings.size())) {
+            return false;
+        }
+
+        auto* header = static_cast<TableHeader*>(mapping_);
+        char* base = static_cast<char*>(mapping_);
+        std::uint64_t sequence = header->sequence.load(std::memory_order_relaxed);
+
+        header->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        header->segmentBytes = mappedBytes_;
+        header->bucketCount = bucketCount;
+        header->entryCount = entryCount;
+        header->stringsOffset = stringsOffset;
+        header->stringsBytes = strings.size();
+        header->publishedAt = static_cast<std::int64_t>(std::time(nullptr));
+        header->categoryCount = static_cast<std::uint32_t>(categories.size());
+        for (std::size_t row = 0; row < categories.size(); ++row) {
+            std::memset(header->categories[row], 0, SHM_CATEGORY_NAME_BYTES);
+            std::strncpy(header->categories[row], categories[row].c_str(),
+                         SHM_CATEGORY_NAME_BYTES - 1);
+        }
+        std::memcpy(base + ENTRIES_OFFSET, entries.data(), bucketCount * sizeof(TableEntry));
+        std::memcpy(base + stringsOffset, strings.data(), strings.size());
+
+        header->sequence.store(sequence + 2, std::memory_order_release);
+
+        entryCount_ = entryCount;
+        logger_.info("Published " + std::to_string(entryCount) + " files to " + name_);
+        return true;
+
+    } catch (const std::exception& e) {
+        logger_.error("Failed to publish shared memory index: " + std::string(e.what()));
+        return false;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Open the Segment Under an Exclusive Lock
+// The flock lives as long as fd_ and dies with the process, so a crashed
+// daemon's segment is free again at once. An exiting daemon unlinks before
+// unlocking; if the name moved while we waited, try again on the new one.
+//------------------------------------------------------------------------------
+bool SharedFileTable::openLocked() {
+    for (int attempt = 0; attempt < LOCK_ATTEMPTS; ++attempt) {
+        fd_ = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd_ < 0 && errno == EEXIST) {
+            fd_ = shm_open(name_.c_str(), O_RDWR, 0);
+        }
+        if (fd_ < 0) {
+            logger_.error("Cannot create shared memory " + name_ + ": " + std::strerror(errno));
+            return false;
+        }
+
+        if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+            if (errno == EWOULDBLOCK) {
+                logger_.error("Shared memory " + name_ + " is in use by another daemon");
+            } else {
+                logger_.error("Cannot lock shared memory " + name_ + ": " + std::strerror(errno));
+            }
+            close();
+            return false;
+        }
+
+        struct stat locked;
+        struct stat current;
+        int check = shm_open(name_.c_str(), O_RDONLY, 0);
+        bool same = check >= 0 && fstat(fd_, &locked) == 0 && fstat(check, &current) == 0 &&
+                    locked.st_dev == current.st_dev && locked.st_ino == current.st_ino;
+        if (check >= 0) {
+            ::close(check);
+        }
+        if (same) {
+            return true;
+        }
+        close();
+    }
+
+    logger_.error("Shared memory " + name_ + " kept changing while it was being locked");
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Grow the Segment (never shrinks, so stale reader mappings stay valid)
+//------------------------------------------------------------------------------
+bool SharedFileTable::ensureCapacity(std::size_t requiredBytes) {
+    if (requiredBytes <= mappedBytes_) {
+        return true;
+    }
+
+    std::size_t newBytes = std::max(requiredBytes, mappedBytes_ + mappedBytes_ / 2);
+    newBytes = (newBytes + PAGE_BYTES - 1) & ~(PAGE_BYTES - 1);
+
+    if (ftruncate(fd_, static_cast<off_t>(newBytes)) != 0) {
+        logger_.error("Cannot grow shared memory " + name_ + ": " + std::strerror(errno));
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        logger_.error("Cannot map shared memory " + name_ + ": " + std::strerror(errno));
+        return false;
+    }
+
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mappedBytes_);
+    }
+    mapping_ = mapping;
+    mappedBytes_ = newBytes;
+    return true;
+}
+
+void SharedFileTable::close() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mappedBytes_);
+        mapping_ = nullptr;
+        mappedBytes_ = 0;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+//==============================================================================
+// SharedFileTableClient (reader)
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+SharedFileTableClient::SharedFileTableClient(const std::string& name)
+    : name_(name), findByPath_(name.empty()), fd_(-1), mapping_(nullptr), mappedBytes_(0),
+      generation_(0) {
+}
+
+SharedFileTableClient::~SharedFileTableClient() {
+    close();
+}
+
+//------------------------------------------------------------------------------
+// Attach to the Segment
+//------------------------------------------------------------------------------
+bool SharedFileTableClient::open() {
+    close();
+
+    fd_ = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd_ < 0) {
+        lastError_ = "no daemon is publishing " + name_;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd_, &info) != 0 || static_cast<std::size_t>(info.st_size) < ENTRIES_OFFSET) {
+        lastError_ = "shared memory " + name_ + " is not initialized";
+        close();
+        return false;
+    }
+    if (!remap(static_cast<std::size_t>(info.st_size))) {
+        close();
+        return false;
+    }
+
+    const auto* header = static_cast<const TableHeader*>(mapping_);
+    if (readShared(header->magic) != TABLE_MAGIC ||
+        readShared(header->version) != TABLE_VERSION ||
+        readShared(header->entryBytes) != sizeof(TableEntry)) {
+        lastError_ = "shared memory " + name_ + " has an incompatible layout";
+        close();
+        return false;
+    }
+
+    lastError_.clear();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Lookup
+//------------------------------------------------------------------------------
+bool SharedFileTableClient::lookup(const std::filesystem::path& path, SharedFileRecord& record) {
+    return lookupNormalized(ContentHasher::normalizePath(path), record);
+}
+
+bool SharedFileTableClient::lookupNormalized(const std::string& normalizedPath,
+                                             SharedFileRecord& record) {
+    if (findByPath_ && !findDaemonFor(normalizedPath)) {
+        return false;
+    }
+    if (mapping_ == nullptr && !open()) {
+        directory_.clear();     // Search again next time; a parent may be watched
+        return false;
+    }
+
+    const std::uint64_t hash = ContentHasher::hashPath(normalizedPath);
+
+    for (int attempt = 0; attempt < SHM_READ_RETRY_LIMIT; ++attempt) {
+        const auto* header = static_cast<const TableHeader*>(mapping_);
+        const char* base = static_cast<const char*>(mapping_);
+
+        std::uint64_t before = header->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::uint64_t segmentBytes = readShared(header->segmentBytes);
+        if (segmentBytes > mappedBytes_) {
+            if (!remap(segmentBytes)) {
+                return false;
+            }
+            continue;
+        }
+
+        // Everything below may be torn; check bounds, then trust it only if
+        // the sequence did not move
+        std::uint64_t bucketCount = readShared(header->bucketCount);
+        std::uint64_t stringsOffset = readShared(header->stringsOffset);
+        std::uint64_t stringsBytes = readShared(header->stringsBytes);
+        std::uint32_t categoryCount = readShared(header->categoryCount);
+        bool closed = readShared(header->closed) != 0;
+
+        bool consistent = bucketCount > 0 && (bucketCount & (bucketCount - 1)) == 0 &&
+                          ENTRIES_OFFSET + bucketCount * sizeof(TableEntry) <= mappedBytes_ &&
+                          stringsOffset <= mappedBytes_ &&
+                          stringsBytes <= mappedBytes_ - stringsOffset &&
+                          categoryCount <= static_cast<std::uint32_t>(SHM_MAX_CATEGORIES);
+
+        bool found = false;
+        TableEntry entry{};
+        char category[SHM_CATEGORY_NAME_BYTES] = {};
+
+        if (consistent && !closed) {
+            std::uint64_t mask = bucketCount - 1;
+            std::uint64_t bucket = hash & mask;
+            for (std::uint64_t probe = 0; probe < bucketCount; ++probe) {
+                std::memcpy(&entry, base + ENTRIES_OFFSET + bucket * sizeof(TableEntry),
+                            sizeof(TableEntry));
+                if (entry.pathHash == 0) {
+                    break;
+                }
+                if (entry.pathHash == hash && entry.pathLength == normalizedPath.size() &&
+                    entry.pathOffset <= stringsBytes &&
+                    entry.pathLength <= stringsBytes - entry.pathOffset &&
+                    std::memcmp(base + stringsOffset + entry.pathOffset,
+                                normalizedPath.data(), normalizedPath.size()) == 0) {
+                    found = true;
+                    break;
+                }
+                bucket = (bucket + 1) & mask;
+            }
+            if (found && entry.category < categoryCount) {
+                std::memcpy(category, header->categories[entry.category], sizeof(category));
+                category[sizeof(category) - 1] = '\0';
+            }
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->sequence.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+
+        generation_ = before / 2;
+        if (closed) {
+            lastError_ = "daemon stopped publishing " + name_;
+            close();
+            return false;
+        }
+        if (!consistent) {
+            lastError_ = "shared memory " + name_ + " is corrupt";
+            return false;
+        }
+        if (!found) {
+            lastError_ = "not indexed: " + normalizedPath;
+            return false;
+        }
+
+        record.category = category;
+        record.duplicateStatus = static_cast<DuplicateStatus>(entry.duplicateStatus);
+        record.duplicateGroup = entry.duplicateGroup;
+        record.sizeBytes = entry.sizeBytes;
+        record.lastModified = static_cast<std::time_t>(entry.lastModified);
+        lastError_.clear();
+        return true;
+    }
+
+    lastError_ = "shared memory " + name_ + " stayed busy; try again";
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Client Helpers
+//------------------------------------------------------------------------------
+
+// Nearest directory above the path with a segment of its own; paths under
+// the directory already found cost no system call
+bool SharedFileTableClient::findDaemonFor(const std::string& normalizedPath) {
+    const char separator = std::filesystem::path::preferred_separator;
+    if (!directory_.empty() && normalizedPath.size() > directory_.size() &&
+        normalizedPath.compare(0, directory_.size(), directory_) == 0 &&
+        (directory_.back() == separator || normalizedPath[directory_.size()] == separator)) {
+        return true;
+    }
+
+    close();
+    name_.clear();
+    directory_.clear();
+    std::filesystem::path directory = std::filesystem::path(normalizedPath).parent_path();
+    while (!directory.empty()) {
+        std::string candidate = SharedFileTable::defaultName(directory);
+        int fd = shm_open(candidate.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            ::close(fd);
+            name_ = candidate;
+            directory_ = directory.string();
+            return true;
+        }
+        if (directory == directory.parent_path()) {
+            break;
+        }
+        directory = directory.parent_path();
+    }
+
+    lastError_ = "no daemon is watching a directory above " + normalizedPath;
+    return false;
+}
+
+bool SharedFileTableClient::remap(std::size_t bytes) {
+    // Map what the segment really holds; touching beyond it would fault
+    struct stat info;
+    if (fstat(fd_, &info) != 0 || static_cast<std::size_t>(info.st_size) < bytes) {
+        lastError_ = "shared memory " + name_ + " shrank unexpectedly";
+        return false;
+    }
+    bytes = static_cast<std::size_t>(info.st_size);
+
+    void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        lastError_ = "cannot map " + name_ + ": " + std::strerror(errno);
+        return false;
+    }
+    if (mapping_ != nullptr) {
+        munmap(const_cast<void*>(mapping_), mappedBytes_);
+    }
+    mapping_ = mapping;
+    mappedBytes_ = bytes;
+    return true;
+}
+
+void SharedFileTableClient::close() {
+    if (mapping_ != nullptr) {
+        munmap(const_cast<void*>(mapping_), mappedBytes_);
+        mapping_ = nullptr;
+        mappedBytes_ = 0;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+#else // _WIN32
+
+//==============================================================================
+// POSIX shared memory is not available; both sides report that and do nothing
+//==============================================================================
+
+SharedFileTable::SharedFileTable(Logger& logger, const std::string& name)
+    : logger_(logger), name_(name), fd_(-1), mapping_(nullptr),
+      mappedBytes_(0), entryCount_(0), owned_(false) {
+}
+
+SharedFileTable::~SharedFileTable() {
+}
+
+bool SharedFileTable::create() {
+    logger_.error("Shared memory index is not supported on this platform");
+    return false;
+}
+
+bool SharedFileTable::publish(const FileClassifier&, const DuplicateFinder*) {
+    return false;
+}
+
+bool SharedFileTable::openLocked() {
+    return false;
+}
+
+bool SharedFileTable::ensureCapacity(std::size_t) {
+    return false;
+}
+
+void SharedFileTable::close() {
+}
+
+SharedFileTableClient::SharedFileTableClient(const std::string& name)
+    : name_(name), findByPath_(name.empty()), fd_(-1), mapping_(nullptr), mappedBytes_(0),
+      generation_(0) {
+}
+
+SharedFileTableClient::~SharedFileTableClient() {
+}
+
+bool SharedFileTableClient::open() {
+    lastError_ = "shared memory index is not supported on this platform";
+    return false;
+}
+
+bool SharedFileTableClient::lookup(const std::filesystem::path&, SharedFileRecord&) {
+    return open();
+}
+
+bool SharedFileTableClient::lookupNormalized(const std::string&, SharedFileRecord&) {
+    return open();
+}
+
+bool SharedFileTableClient::findDaemonFor(const std::string&) {
+    return false;
+}
+
+bool SharedFileTableClient::remap(std::size_t) {
+    return false;
+}
+
+void SharedFileTableClient::close() {
+}
+
+#endif // _WIN32
+
+//------------------------------------------------------------------------------
+// Accessors
+//------------------------------------------------------------------------------
+const std::string& SharedFileTable::getName() const {
+    return name_;
+}
+
+std::size_t SharedFileTable::getEntryCount() const {
+    return entryCount_;
+}
+
+std::uint64_t SharedFileTableClient::getGeneration() const {
+    return generation_;
+}
+
+const std::string& SharedFileTableClient::getLastError() const {
+    return lastError_;
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,125 @@
+//==============================================================================
+// SharedFileTable.h - Shared-Memory File Index Interface
+//==============================================================================
+
+#ifndef SHARED_FILE_TABLE_H
+#define SHARED_FILE_TABLE_H
+
+#include "DuplicateFinder.h"
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <string>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+class FileClassifier;
+
+//------------------------------------------------------------------------------
+// SharedFileRecord Structure
+// What a client learns about one indexed file
+//------------------------------------------------------------------------------
+struct SharedFileRecord {
+    std::string category;               // Category name, e.g. "Documents"
+    DuplicateStatus duplicateStatus;    // Exact-duplicate status
+    std::uint32_t duplicateGroup;       // Group index when not UNIQUE
+    long long sizeBytes;                // Size at publish time
+    std::time_t lastModified;           // Modification time at publish time
+};
+
+//------------------------------------------------------------------------------
+// SharedFileTable Class
+// Publisher side: the daemon owns a named POSIX shared-memory segment holding
+// an open-addressed table keyed by path hash. Every publish runs under a
+// seqlock (odd sequence = write in progress), so readers never take a lock.
+// The segment only grows; readers remap when the header says it got bigger.
+// The publisher holds an exclusive flock on the segment for its lifetime, so
+// a second daemon on the same name is refused instead of sharing the seqlock.
+//------------------------------------------------------------------------------
+class SharedFileTable {
+public:
+    // Constructor / Destructor (the destructor marks the table closed and unlinks it)
+    SharedFileTable(Logger& logger, const std::string& name);
+    ~SharedFileTable();
+
+    SharedFileTable(const SharedFileTable&) = delete;
+    SharedFileTable& operator=(const SharedFileTable&) = delete;
+
+    // Create the segment, or take over one of ours a crashed daemon left;
+    // fails while another daemon holds it. Readable by the daemon's user only
+    bool create();
+
+    // Segment name for a watched directory: SHM_NAME_PREFIX + path hash
+    static std::string defaultName(const std::filesystem::path& directory);
+
+    // Replace the published contents with the classifier's files
+    bool publish(const FileClassifier& classifier, const DuplicateFinder* duplicates);
+
+    // Get table information
+    const std::string& getName() const;
+    std::size_t getEntryCount() const;
+
+private:
+    Logger& logger_;            // Reference to logger
+    std::string name_;          // Segment name, e.g. "/smartcleaner_1f2e3d4c5b6a7980"
+    int fd_;                    // Segment descriptor, flock held (-1 when closed)
+    void* mapping_;             // Writable mapping of the whole segment
+    std::size_t mappedBytes_;   // Current segment size
+    std::size_t entryCount_;    // Files in the last publish
+    bool owned_;                // create() succeeded, so the destructor unlinks
+
+    // Helper methods
+    bool openLocked();
+    bool ensureCapacity(std::size_t requiredBytes);
+    void close();
+};
+
+//------------------------------------------------------------------------------
+// SharedFileTableClient Class
+// Reader side: maps the segment read-only and answers lookups with no system
+// call on the fast path. One client per thread; lookups are wait-free unless
+// a publish is in flight, in which case they retry. Without a name, each
+// lookup goes to the daemon watching the nearest directory above the path.
+//------------------------------------------------------------------------------
+class SharedFileTableClient {
+public:
+    // Constructor / Destructor ("" = find the daemon by path)
+    explicit SharedFileTableClient(const std::string& name);
+    ~SharedFileTableClient();
+
+    SharedFileTableClient(const SharedFileTableClient&) = delete;
+    SharedFileTableClient& operator=(const SharedFileTableClient&) = delete;
+
+    // Attach to the daemon's segment; false when no daemon is publishing
+    bool open();
+
+    // Look up a file; paths are normalized the same way the daemon does
+    bool lookup(const std::filesystem::path& path, SharedFileRecord& record);
+    bool lookupNormalized(const std::string& normalizedPath, SharedFileRecord& record);
+
+    // Get client state
+    std::uint64_t getGeneration() const;    // Publish count seen by the last lookup
+    const std::string& getLastError() const;
+
+private:
+    std::string name_;          // Segment name
+    bool findByPath_;           // No name given; name_ follows the looked-up path
+    std::string directory_;     // Watched directory of name_ when found by path
+    int fd_;                    // Read-only descriptor (-1 when closed)
+    const void* mapping_;       // Read-only mapping
+    std::size_t mappedBytes_;   // Bytes mapped
+    std::uint64_t generation_;  // Last sequence observed / 2
+    std::string lastError_;     // Message for the last failed call
+
+    // Helper methods
+    bool findDaemonFor(const std::string& normalizedPath);
+    bool remap(std::size_t bytes);
+    void close();
+};
+
+} // namespace DesktopCleaner
+
+#endif // SHARED_FILE_TABLE_H
@@ -0,0 +1,633 @@
+//==============================================================================
+// SimdKernels.cpp - Runtime-Dispatched Vector Kernels Implementation
+//==============================================================================
+//
+// Vector variants are compiled with per-function target attributes, so the
+// rest of the program keeps the baseline ISA and one binary runs everywhere.
+//
+//==============================================================================
+
+#include "SimdKernels.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <ostream>
+#include <random>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+#define SMARTCLEANER_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace DesktopCleaner {
+
+namespace {
+
+//==============================================================================
+// Scalar Reference Kernels
+//==============================================================================
+
+void lowerScalar(char* data, std::size_t length) {
+    for (std::size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c >= 'A' && c <= 'Z') {
+            data[i] = static_cast<char>(c | 0x20);
+        }
+    }
+}
+
+// Reflected Castagnoli polynomial, matching the SSE4.2 crc32 instruction
+std::array<std::uint32_t, 256> makeCrc32cTable() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+std::uint32_t crc32cScalar(std::uint32_t crc, const void* data, std::size_t length) {
+    static const std::array<std::uint32_t, 256> table = makeCrc32cTable();
+    const auto* bytes = static_cast<const unsigned char*>(data);
+
+    crc = ~crc;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+std::size_t selectScalar(const std::int64_t* values, std::size_t count,
+                         std::int64_t low, std::int64_t high, std::uint32_t* out) {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (values[i] >= low && values[i] <= high) {
+            out[found++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    return found;
+}
+
+// A gear hash only remembers its last 64 bytes, so any position can be
+// hashed from the 63 bytes before it and a buffer can be split anywhere.
+// Every level uses this loop: gather-based 4- and 8-stripe versions ran at
+// 35-45% of its speed, since they still need one table load per byte.
+const std::size_t GEAR_WARMUP = 63;
+
+// Positions [first, last) with first >= GEAR_WARMUP
+void gearRange(const unsigned char* data, std::size_t first, std::size_t last,
+               const std::uint64_t* gear, std::uint64_t mask, std::vector<std::uint32_t>& out) {
+    std::uint64_t hash = 0;
+    for (std::size_t i = first - GEAR_WARMUP; i < last; ++i) {
+        hash = (hash << 1) + gear[data[i]];
+        if (i >= first && (hash & mask) == 0) {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+void gearScalar(const unsigned char* data, std::size_t length, const std::uint64_t* gear,
+                std::uint64_t mask, std::vector<std::uint32_t>& out) {
+    if (length > GEAR_WARMUP) {
+        gearRange(data, GEAR_WARMUP, length, gear, mask, out);
+    }
+}
+
+std::size_t findInSetScalar(const unsigned char* data, std::size_t length, const ByteSet& set) {
+    for (std::size_t i = 0; i < length; ++i) {
+        if ((set.low[data[i] & 0x0F] & set.high[data[i] >> 4]) != 0) {
+            return i;
+        }
+    }
+    return length;
+}
+
+#ifdef SMARTCLEANER_SIMD_X86
+//==============================================================================
+// SSE2 / SSE4.2 Kernels
+//==============================================================================
+
+// Shift 'A'..'Z' to the bottom of the signed range so one compare finds them
+__attribute__((target("sse2")))
+void lowerSse2(char* data, std::size_t length) {
+    const __m128i shift = _mm_set1_epi8(static_cast<char>(128 - 'A'));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(bytes, shift), limit);
+        bytes = _mm_or_si128(bytes, _mm_and_si128(upper, caseBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), bytes);
+    }
+    lowerScalar(data + i, length - i);
+}
+
+__attribute__((target("sse4.2")))
+std::uint32_t crc32cSse42(std::uint32_t crc, const void* data, std::size_t length) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t state = ~crc;
+
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, bytes + i, 8);
+        state = _mm_crc32_u64(state, word);
+    }
+
+    std::uint32_t state32 = static_cast<std::uint32_t>(state);
+    for (; i < length; ++i) {
+        state32 = _mm_crc32_u8(state32, bytes[i]);
+    }
+    return ~state32;
+}
+
+// Two pshufb lookups classify 16 bytes at once (SSSE3, implied by SSE4.2)
+__attribute__((target("ssse3")))
+std::size_t findInSetSsse3(const unsigned char* data, std::size_t length, const ByteSet& set) {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i lowHit = _mm_shuffle_epi8(low, _mm_and_si128(bytes, nibble));
+        __m128i highHit = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        unsigned miss = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lowHit, highHit), zero)));
+        if (miss != 0xFFFFu) {
+            return i + static_cast<std::size_t>(__builtin_ctz(~miss));
+        }
+    }
+    return i + findInSetScalar(data + i, length - i, set);
+}
+
+//==============================================================================
+// AVX2 Kernels
+//==============================================================================
+
+__attribute__((target("avx2")))
+void lowerAvx2(char* data, std::size_t length) {
+    const __m256i shift = _mm256_set1_epi8(static_cast<char>(128 - 'A'));
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i upper = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(bytes, shift));
+        bytes = _mm256_or_si256(bytes, _mm256_and_si256(upper, caseBit));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), bytes);
+    }
+    lowerSse2(data + i, length - i);
+}
+
+__attribute__((target("avx2")))
+std::size_t findInSetAvx2(const unsigned char* data, std::size_t length, const ByteSet& set) {
+    // vpshufb looks up within each 128-bit lane, so both lanes get the tables
+    const __m256i low = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low)));
+    const __m256i high = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i lowHit = _mm256_shuffle_epi8(low, _mm256_and_si256(bytes, nibble));
+        __m256i highHit = _mm256_shuffle_epi8(
+            high, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        unsigned miss = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_and_si256(lowHit, highHit), zero)));
+        if (miss != 0xFFFFFFFFu) {
+            return i + static_cast<std::size_t>(__builtin_ctz(~miss));
+        }
+    }
+    return i + findInSetSsse3(data + i, length - i, set);
+}
+
+__attribute__((target("avx2,bmi")))
+std::size_t selectAvx2(const std::int64_t* values, std::size_t count,
+                       std::int64_t low, std::int64_t high, std::uint32_t* out) {
+    const __m256i lowVec = _mm256_set1_epi64x(low);
+    const __m256i highVec = _mm256_set1_epi64x(high);
+    std::size_t found = 0;
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(lowVec, v),
+                                          _mm256_cmpgt_epi64(v, highVec));
+        unsigned bits = ~static_cast<unsigned>(
+            _mm256_movemask_pd(_mm256_castsi256_pd(outside))) & 0xFu;
+        while (bits != 0) {
+            out[found++] = static_cast<std::uint32_t>(i + __builtin_ctz(bits));
+            bits &= bits - 1;
+        }
+    }
+
+    std::size_t tail = selectScalar(values + i, count - i, low, high, out + found);
+    for (std::size_t k = 0; k < tail; ++k) {
+        out[found + k] += static_cast<std::uint32_t>(i); // Rebase tail indices
+    }
+    return found + tail;
+}
+
+//==============================================================================
+// AVX-512 Kernels (F + BW)
+//==============================================================================
+
+// Masked loads/stores handle the tail without a scalar loop
+__attribute__((target("avx512f,avx512bw")))
+void lowerAvx512(char* data, std::size_t length) {
+    const __m512i a = _mm512_set1_epi8('A');
+    const __m512i span = _mm512_set1_epi8(25);
+    const __m512i caseBit = _mm512_set1_epi8(0x20);
+
+    for (std::size_t i = 0; i < length; i += 64) {
+        std::size_t remaining = length - i;
+        __mmask64 lanes = remaining >= 64 ? ~__mmask64(0) : ((__mmask64(1) << remaining) - 1);
+        __m512i bytes = _mm512_maskz_loadu_epi8(lanes, data + i);
+        __mmask64 upper = _mm512_cmple_epu8_mask(_mm512_sub_epi8(bytes, a), span);
+        bytes = _mm512_mask_add_epi8(bytes, upper, bytes, caseBit);
+        _mm512_mask_storeu_epi8(data + i, lanes, bytes);
+    }
+}
+
+// Masked-off tail lanes load as zero, which may be a member, so hits are
+// limited to the loaded lanes
+__attribute__((target("avx512f,avx512bw")))
+std::size_t findInSetAvx512(const unsigned char* data, std::size_t length, const ByteSet& set) {
+    // Tables repeated per 128-bit lane (the maskz form avoids an undefined source)
+    const __m512i low = _mm512_maskz_broadcast_i32x4(
+        ~__mmask16(0), _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.low)));
+    const __m512i high = _mm512_maskz_broadcast_i32x4(
+        ~__mmask16(0), _mm_loadu_si128(reinterpret_cast<const __m128i*>(set.high)));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+
+    for (std::size_t i = 0; i < length; i += 64) {
+        std::size_t remaining = length - i;
+        __mmask64 lanes = remaining >= 64 ? ~__mmask64(0) : ((__mmask64(1) << remaining) - 1);
+        __m512i bytes = _mm512_maskz_loadu_epi8(lanes, data + i);
+        __m512i lowHit = _mm512_shuffle_epi8(low, _mm512_and_si512(bytes, nibble));
+        __m512i highHit = _mm512_shuffle_epi8(
+            high, _mm512_and_si512(_mm512_srli_epi16(bytes, 4), nibble));
+        __mmask64 hits = _mm512_test_epi8_mask(lowHit, highHit) & lanes;
+        if (hits != 0) {
+            return i + static_cast<std::size_t>(__builtin_ctzll(hits));
+        }
+    }
+    return length;
+}
+
+__attribute__((target("avx512f")))
+std::size_t selectAvx512(const std::int64_t* values, std::size_t count,
+                         std::int64_t low, std::int64_t high, std::uint32_t* out) {
+    const __m512i lowVec = _mm512_set1_epi64(low);
+    const __m512i highVec = _mm512_set1_epi64(high);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                            8, 9, 10, 11, 12, 13, 14, 15);
+    std::size_t found = 0;
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i v0 = _mm512_loadu_si512(values + i);
+        __m512i v1 = _mm512_loadu_si512(values + i + 8);
+        __mmask8 m0 = _mm512_cmpge_epi64_mask(v0, lowVec) & _mm512_cmple_epi64_mask(v0, highVec);
+        __mmask8 m1 = _mm512_cmpge_epi64_mask(v1, lowVec) & _mm512_cmple_epi64_mask(v1, highVec);
+        __mmask16 hits = static_cast<__mmask16>(m0 | (static_cast<unsigned>(m1) << 8));
+
+        __m512i indices = _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int>(i)));
+        _mm512_mask_compressstoreu_epi32(out + found, hits, indices);
+        found += static_cast<std::size_t>(__builtin_popcount(hits));
+    }
+
+    std::size_t tail = selectScalar(values + i, count - i, low, high, out + found);
+    for (std::size_t k = 0; k < tail; ++k) {
+        out[found + k] += static_cast<std::uint32_t>(i);
+    }
+    return found + tail;
+}
+#endif // SMARTCLEANER_SIMD_X86
+
+//==============================================================================
+// Dispatch Tables
+//==============================================================================
+
+struct KernelTable {
+    IsaLevel level;
+    void (*lower)(char*, std::size_t);
+    std::uint32_t (*crc32c)(std::uint32_t, const void*, std::size_t);
+    std::size_t (*select)(const std::int64_t*, std::size_t, std::int64_t, std::int64_t,
+                          std::uint32_t*);
+    void (*gear)(const unsigned char*, std::size_t, const std::uint64_t*, std::uint64_t,
+                 std::vector<std::uint32_t>&);
+    std::size_t (*findInSet)(const unsigned char*, std::size_t, const ByteSet&);
+};
+
+const KernelTable SCALAR_TABLE = {
+    IsaLevel::SCALAR, lowerScalar, crc32cScalar, selectScalar, gearScalar, findInSetScalar };
+#ifdef SMARTCLEANER_SIMD_X86
+const KernelTable SSE42_TABLE = {
+    IsaLevel::SSE42, lowerSse2, crc32cSse42, selectScalar, gearScalar, findInSetSsse3 };
+const KernelTable AVX2_TABLE = {
+    IsaLevel::AVX2, lowerAvx2, crc32cSse42, selectAvx2, gearScalar, findInSetAvx2 };
+const KernelTable AVX512_TABLE = {
+    IsaLevel::AVX512, lowerAvx512, crc32cSse42, selectAvx512, gearScalar, findInSetAvx512 };
+#endif
+
+const KernelTable& tableFor(IsaLevel level) {
+#ifdef SMARTCLEANER_SIMD_X86
+    switch (level) {
+        case IsaLevel::AVX512: return AVX512_TABLE;
+        case IsaLevel::AVX2:   return AVX2_TABLE;
+        case IsaLevel::SSE42:  return SSE42_TABLE;
+        default:               break;
+    }
+#else
+    (void)level;
+#endif
+    return SCALAR_TABLE;
+}
+
+std::atomic<const KernelTable*> activeTable{nullptr};
+
+//------------------------------------------------------------------------------
+// Helper: Resolve the Active Table
+// Honors SMARTCLEANER_ISA, clamped to what the CPU can run
+//------------------------------------------------------------------------------
+const KernelTable* resolveTable() {
+    const KernelTable* table = activeTable.load(std::memory_order_acquire);
+    if (table != nullptr) {
+        return table;
+    }
+
+    IsaLevel level = SimdKernels::detectIsa();
+    IsaLevel forced;
+    const char* env = std::getenv("SMARTCLEANER_ISA");
+    if (env != nullptr && SimdKernels::parseIsa(env, forced)) {
+        level = std::min(level, forced);
+    }
+
+    table = &tableFor(level);
+    activeTable.store(table, std::memory_order_release);
+    return table;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Kernels
+//------------------------------------------------------------------------------
+void SimdKernels::asciiToLower(char* data, std::size_t length) {
+    resolveTable()->lower(data, length);
+}
+
+std::uint32_t SimdKernels::crc32c(std::uint32_t crc, const void* data, std::size_t length) {
+    return resolveTable()->crc32c(crc, data, length);
+}
+
+std::size_t SimdKernels::selectInRange(const std::int64_t* values, std::size_t count,
+                                       std::int64_t low, std::int64_t high,
+                                       std::uint32_t* outIndices) {
+    return resolveTable()->select(values, count, low, high, outIndices);
+}
+
+void SimdKernels::gearScan(const unsigned char* data, std::size_t length,
+                           const std::uint64_t* gear, std::uint64_t mask,
+                           std::vector<std::uint32_t>& outPositions) {
+    resolveTable()->gear(data, length, gear, mask, outPositions);
+}
+
+std::size_t SimdKernels::findInSet(const unsigned char* data, std::size_t length,
+                                   const ByteSet& set) {
+    return resolveTable()->findInSet(data, length, set);
+}
+
+//------------------------------------------------------------------------------
+// Byte Sets
+// Bits go to high nibbles in order of first appearance, wrapping after 8
+//------------------------------------------------------------------------------
+ByteSet SimdKernels::makeByteSet(const std::vector<unsigned char>& members) {
+    ByteSet set{};
+    int bitOfHigh[16];
+    std::fill(std::begin(bitOfHigh), std::end(bitOfHigh), -1);
+    int nextBit = 0;
+
+    for (unsigned char b : members) {
+        int& bit = bitOfHigh[b >> 4];
+        if (bit < 0) {
+            bit = nextBit++ % 8;
+        }
+        set.low[b & 0x0F] |= static_cast<std::uint8_t>(1u << bit);
+        set.high[b >> 4] |= static_cast<std::uint8_t>(1u << bit);
+    }
+    return set;
+}
+
+//------------------------------------------------------------------------------
+// Dispatch Control
+//------------------------------------------------------------------------------
+IsaLevel SimdKernels::detectIsa() {
+#ifdef SMARTCLEANER_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return IsaLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi")) {
+        return IsaLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return IsaLevel::SSE42;
+    }
+#endif
+    return IsaLevel::SCALAR;
+}
+
+IsaLevel SimdKernels::activeIsa() {
+    return resolveTable()->level;
+}
+
+bool SimdKernels::setIsa(IsaLevel level) {
+    if (level > detectIsa()) {
+        return false;
+    }
+    activeTable.store(&tableFor(level), std::memory_order_release);
+    return true;
+}
+
+std::vector<IsaLevel> SimdKernels::supportedIsas() {
+    std::vector<IsaLevel> levels;
+    for (IsaLevel level : { IsaLevel::SCALAR, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512 }) {
+        if (level <= detectIsa() && tableFor(level).level == level) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+//------------------------------------------------------------------------------
+// Naming
+//------------------------------------------------------------------------------
+std::string SimdKernels::isaName(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::SCALAR: return "scalar";
+        case IsaLevel::SSE42:  return "sse42";
+        case IsaLevel::AVX2:   return "avx2";
+        case IsaLevel::AVX512: return "avx512";
+        default:               return "unknown";
+    }
+}
+
+bool SimdKernels::parseIsa(const std::string& name, IsaLevel& level) {
+    for (IsaLevel candidate : { IsaLevel::SCALAR, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512 }) {
+        if (name == isaName(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+// Self-Test
+// Random lengths and misaligned offsets exercise every vector tail path
+//------------------------------------------------------------------------------
+bool SimdKernels::runSelfTest(std::ostream& out) {
+    std::mt19937_64 rng(12345);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    bool allPassed = true;
+
+    // Shared inputs
+    std::vector<char> text(1 << 20);
+    for (auto& c : text) {
+        c = static_cast<char>(byteDist(rng));
+    }
+    std::vector<std::int64_t> values(1 << 18);
+    std::uniform_int_distribution<std::int64_t> valueDist(-1000, 1000);
+    for (auto& v : values) {
+        v = valueDist(rng);
+    }
+    std::uint64_t gear[256];
+    for (auto& g : gear) {
+        g = rng();
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    const std::uint64_t gearMask = 0xFC00000000000000ULL; // ~1 hit per 64 bytes
+    const ByteSet sparseSet = makeByteSet({ 0x00, 0x7F });   // ~1 hit per 128 bytes
+
+    auto secondsFor = [](auto&& body, int repeats) {
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            body();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    out << std::left << std::setw(8) << "isa"
+        << std::right << std::setw(14) << "lower MB/s"
+        << std::setw(14) << "crc32c MB/s"
+        << std::setw(16) << "select Melem/s"
+        << std::setw(12) << "gear MB/s"
+        << std::setw(14) << "byteset MB/s"
+        << "  result" << '\n';
+
+    for (IsaLevel level : supportedIsas()) {
+        const KernelTable& table = tableFor(level);
+        bool passed = true;
+
+        // Correctness against the scalar reference
+        for (std::size_t length = 0; length <= 300 && passed; ++length) {
+            for (std::size_t offset = 0; offset < 4 && passed; ++offset) {
+                std::vector<char> expected(text.begin() + offset,
+                                           text.begin() + offset + length);
+                std::vector<char> actual = expected;
+                lowerScalar(expected.data(), expected.size());
+                table.lower(actual.data(), actual.size());
+                passed = expected == actual &&
+                         crc32cScalar(7, text.data() + offset, length) ==
+                             table.crc32c(7, text.data() + offset, length);
+
+                std::vector<std::uint32_t> want(length), got(length);
+                std::int64_t low = valueDist(rng), high = valueDist(rng);
+                want.resize(selectScalar(values.data() + offset, length, low, high, want.data()));
+                got.resize(table.select(values.data() + offset, length, low, high, got.data()));
+                passed = passed && want == got;
+            }
+        }
+        
+        // Gear scans: short, odd and full-buffer lengths
+        for (std::size_t length : { std::size_t(0), std::size_t(63), std::size_t(700),
+                                    std::size_t(4097), text.size() - 3 }) {
+            std::vector<std::uint32_t> want, got;
+            gearScalar(bytes + 3, length, gear, gearMask, want);
+            table.gear(bytes + 3, length, gear, gearMask, got);
+            passed = passed && want == got;
+        }
+
+        // Byte sets: narrow and wide (inexact) sets over every tail length
+        for (int round = 0; round < 64 && passed; ++round) {
+            std::vector<unsigned char> members(1 + round % 24);
+            for (auto& m : members) {
+                m = static_cast<unsigned char>(byteDist(rng));
+            }
+            ByteSet set = makeByteSet(members);
+            for (std::size_t length = 0; length <= 200 && passed; ++length) {
+                std::size_t offset = static_cast<std::size_t>(round) % 7;
+                passed = findInSetScalar(bytes + offset, length, set) ==
+                         table.findInSet(bytes + offset, length, set);
+            }
+        }
+
+        // Throughput on the full buffers
+        std::vector<char> scratch = text;
+        std::vector<std::uint32_t> indices(values.size());
+        volatile std::uint32_t sink = 0;
+        double lowerSeconds = secondsFor([&]() { table.lower(scratch.data(), scratch.size()); }, 64);
+        double crcSeconds = secondsFor([&]() { sink = table.crc32c(0, text.data(), text.size()); }, 64);
+        double selectSeconds = secondsFor([&]() {
+            sink = static_cast<std::uint32_t>(
+                table.select(values.data(), values.size(), -500, 500, indices.data()));
+        }, 64);
+        std::vector<std::uint32_t> positions;
+        double gearSeconds = secondsFor([&]() {
+            positions.clear();
+            table.gear(bytes, text.size(), gear, gearMask, positions);
+        }, 64);
+        double byteSetSeconds = secondsFor([&]() {
+            std::size_t position = 0;
+            while (position < text.size()) {
+                position += table.findInSet(bytes + position, text.size() - position, sparseSet) + 1;
+            }
+            sink = static_cast<std::uint32_t>(position);
+        }, 64);
+        (void)sink;
+
+        const double megabytes = 64.0 * text.size() / (1024.0 * 1024.0);
+        const double melems = 64.0 * values.size() / 1e6;
+        out << std::left << std::setw(8) << isaName(level) << std::right
+            << std::fixed << std::setprecision(0)
+            << std::setw(14) << megabytes / lowerSeconds
+            << std::setw(14) << megabytes / crcSeconds
+            << std::setw(16) << melems / selectSeconds
+            << std::setw(12) << megabytes / gearSeconds
+            << std::setw(14) << megabytes / byteSetSeconds
+            << "  " << (passed ? "PASS" : "FAIL") << '\n';
+
+        allPassed = allPassed && passed;
+    }
+
+    return allPassed;
+}
+
+} // namespace DesktopCleaner
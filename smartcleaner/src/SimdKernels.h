@@ -0,0 +1,78 @@
+//==============================================================================
+// SimdKernels.h - Runtime-Dispatched Vector Kernels Interface
+//==============================================================================
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Instruction Set Levels
+// Ordered: each level implies every level below it
+//------------------------------------------------------------------------------
+enum class IsaLevel {
+    SCALAR,    // Portable C++
+    SSE42,     // SSE2 lowercasing, SSSE3 byte sets, SSE4.2 CRC32C
+    AVX2,      // 256-bit kernels
+    AVX512     // 512-bit kernels with mask registers (AVX-512F + BW)
+};
+
+//------------------------------------------------------------------------------
+// Byte Set
+// Nibble tables for findInSet: byte b is a member when low[b & 15] & high[b >> 4]
+// is nonzero. makeByteSet gives each high nibble its own bit, so sets spanning
+// at most 8 distinct high nibbles (all ASCII letters, say) are exact; wider
+// sets share bits and may report extra candidates.
+//------------------------------------------------------------------------------
+struct ByteSet {
+    std::uint8_t low[16];
+    std::uint8_t high[16];
+};
+
+//------------------------------------------------------------------------------
+// SimdKernels Class
+// The best implementation for the running CPU is picked once, on first use.
+// SMARTCLEANER_ISA=scalar|sse42|avx2|avx512 or setIsa() forces a lower level.
+//------------------------------------------------------------------------------
+class SimdKernels {
+public:
+    // Kernels
+    static void asciiToLower(char* data, std::size_t length);
+    static std::uint32_t crc32c(std::uint32_t crc, const void* data, std::size_t length);
+    static std::size_t selectInRange(const std::int64_t* values, std::size_t count,
+                                     std::int64_t low, std::int64_t high,
+                                     std::uint32_t* outIndices);
+    // Appends every position i >= 63 where the gear hash of data[i-63..i]
+    // (h = (h << 1) + gear[byte]) has no bits of mask set, in ascending order
+    static void gearScan(const unsigned char* data, std::size_t length,
+                         const std::uint64_t* gear, std::uint64_t mask,
+                         std::vector<std::uint32_t>& outPositions);
+    // Position of the first byte in set, or length when there is none
+    static std::size_t findInSet(const unsigned char* data, std::size_t length,
+                                 const ByteSet& set);
+    static ByteSet makeByteSet(const std::vector<unsigned char>& members);
+
+    // Dispatch control
+    static IsaLevel detectIsa();
+    static IsaLevel activeIsa();
+    static bool setIsa(IsaLevel level);             // False if the CPU lacks it
+    static std::vector<IsaLevel> supportedIsas();
+
+    // Naming
+    static std::string isaName(IsaLevel level);
+    static bool parseIsa(const std::string& name, IsaLevel& level);
+
+    // Check every supported variant against the scalar reference and time it
+    static bool runSelfTest(std::ostream& out);
+};
+
+} // namespace DesktopCleaner
+
+#endif // SIMD_KERNELS_H
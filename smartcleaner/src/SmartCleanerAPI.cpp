@@ -0,0 +1,375 @@
+//==============================================================================
+// SmartCleanerAPI.cpp - C Interface Implementation
+//==============================================================================
+
+#include "SmartCleanerAPI.h"
+#include "ColdStorage.h"
+#include "Config.h"
+#include "FileClassifier.h"
+#include "FileMover.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include "SharedFileTable.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+
+//------------------------------------------------------------------------------
+// Session State
+// Everything here survives between calls; that is the point of a session
+//------------------------------------------------------------------------------
+struct sc_session {
+    sc_config config;                       // Effective configuration
+    std::string logDirectory;               // Owned copy of config.log_directory
+    mutable std::mutex mutex;               // Serializes calls on this session
+    Logger logger;                          // One log file per session
+    ThreadPool pool;                        // Warm worker threads
+    FileScanner scanner;                    // Reuses result buffers between scans
+    FileClassifier classifier;              // Extension table built once
+    std::string scannedDirectory;           // Directory of the last successful scan
+    std::chrono::steady_clock::time_point scannedAt; // When it finished
+    std::vector<std::string> categoryNames; // Categories of the last scan
+    std::vector<size_t> categoryCounts;     // Matching file counts
+    std::string lastError;                  // Message for sc_session_last_error
+
+    sc_session(const sc_config& cfg, const std::string& logDir)
+        : config(cfg),
+          logDirectory(logDir),
+          logger(logDir, false),
+          pool(static_cast<std::size_t>(std::max(cfg.thread_count, 0))),
+          scanner(logger),
+          classifier(logger) {
+        scanner.setLargeFileSizeMB(cfg.large_file_size_mb);
+        scanner.setOldFileAgeDays(cfg.old_file_age_days);
+    }
+};
+
+//------------------------------------------------------------------------------
+// Query Client State
+//------------------------------------------------------------------------------
+struct sc_query_client {
+    SharedFileTableClient table;            // Read-only mapping of the daemon's index
+
+    explicit sc_query_client(const std::string& name) : table(name) {}
+};
+
+namespace {
+
+//------------------------------------------------------------------------------
+// Helper: Copy a Result Into a Caller Struct of Possibly Older Size
+//------------------------------------------------------------------------------
+template <typename Result>
+bool copyResult(const Result& source, Result* target) {
+    if (target == nullptr) {
+        return true; // Results are optional
+    }
+    if (target->struct_size < sizeof(size_t)) {
+        return false;
+    }
+    std::size_t size = std::min(target->struct_size, sizeof(Result));
+    std::memcpy(reinterpret_cast<char*>(target) + sizeof(size_t),
+                reinterpret_cast<const char*>(&source) + sizeof(size_t),
+                size - sizeof(size_t));
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Scan and Classify Into the Session
+//------------------------------------------------------------------------------
+bool scanInto(sc_session* session, const std::string& directory) {
+    session->scannedDirectory.clear();
+    session->categoryNames.clear();
+    session->categoryCounts.clear();
+
+    if (!session->scanner.scanDirectory(directory)) {
+        session->lastError = "Failed to scan directory: " + directory;
+        return false;
+    }
+
+    session->classifier.classifyFiles(session->scanner.getFiles());
+    for (const auto& [category, files] : session->classifier.getCategorizedFiles()) {
+        session->categoryNames.push_back(category);
+        session->categoryCounts.push_back(files.size());
+    }
+
+    session->scannedDirectory = directory;
+    session->scannedAt = std::chrono::steady_clock::now();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Ensure the Session Holds a Recent Scan of directory
+// An older scan may list files that have since gone or miss new ones, so it
+// is taken again rather than acted on
+//------------------------------------------------------------------------------
+bool ensureScanned(sc_session* session, const std::string& directory) {
+    if (session->scannedDirectory == directory &&
+        std::chrono::steady_clock::now() - session->scannedAt <
+            std::chrono::seconds(API_SCAN_REUSE_SECONDS)) {
+        return true;
+    }
+    return scanInto(session, directory);
+}
+
+} // namespace
+
+extern "C" {
+
+//------------------------------------------------------------------------------
+// Library and Session Lifecycle
+//------------------------------------------------------------------------------
+int sc_api_version(void) {
+    return SC_API_VERSION;
+}
+
+void sc_config_init(sc_config* config) {
+    if (config == nullptr) {
+        return;
+    }
+    config->struct_size = sizeof(sc_config);
+    config->large_file_size_mb = DEFAULT_LARGE_FILE_SIZE_MB;
+    config->old_file_age_days = DEFAULT_OLD_FILE_AGE_DAYS;
+    config->dry_run = DEFAULT_DRY_RUN ? 1 : 0;
+    config->thread_count = 0;
+    config->log_directory = nullptr;
+}
+
+sc_session* sc_session_create(const sc_config* config) {
+    sc_config effective;
+    sc_config_init(&effective);
+
+    // Older callers pass a shorter struct; missing fields keep defaults
+    if (config != nullptr) {
+        if (config->struct_size < sizeof(size_t)) {
+            return nullptr;
+        }
+        std::size_t size = std::min(config->struct_size, sizeof(sc_config));
+        std::memcpy(&effective, config, size);
+        effective.struct_size = sizeof(sc_config);
+    }
+
+    try {
+        std::string logDirectory = effective.log_directory ? effective.log_directory : "";
+        auto* session = new sc_session(effective, logDirectory);
+        session->config.log_directory =
+            session->logDirectory.empty() ? nullptr : session->logDirectory.c_str();
+        return session;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void sc_session_destroy(sc_session* session) {
+    delete session;
+}
+
+const char* sc_session_last_error(const sc_session* session) {
+    if (session == nullptr) {
+        return "";
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return session->lastError.c_str();
+}
+
+//------------------------------------------------------------------------------
+// Operations
+//------------------------------------------------------------------------------
+sc_status sc_scan(sc_session* session, const char* directory, sc_scan_result* result) {
+    if (session == nullptr || directory == nullptr) {
+        return SC_ERROR_INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->lastError.clear();
+
+    try {
+        // An explicit scan always refreshes, even for the same directory
+        if (!scanInto(session, directory)) {
+            return SC_ERROR_SCAN_FAILED;
+        }
+
+        sc_scan_result scan = {};
+        scan.struct_size = sizeof(sc_scan_result);
+        scan.file_count = session->scanner.getFiles().size();
+        scan.large_file_count = session->scanner.getLargeFiles().size();
+        scan.old_file_count = session->scanner.getOldFiles().size();
+        for (const auto& file : session->scanner.getFiles()) {
+            scan.total_bytes += file.sizeBytes;
+        }
+
+        return copyResult(scan, result) ? SC_OK : SC_ERROR_INVALID_ARGUMENT;
+
+    } catch (const std::exception& e) {
+        session->lastError = e.what();
+        return SC_ERROR_INTERNAL;
+    } catch (...) {
+        session->lastError = "Unknown error";
+        return SC_ERROR_INTERNAL;
+    }
+}
+
+sc_status sc_organize(sc_session* session, const char* directory,
+                      sc_organize_result* result) {
+    if (session == nullptr || directory == nullptr) {
+        return SC_ERROR_INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->lastError.clear();
+
+    try {
+        if (!ensureScanned(session, directory)) {
+            return SC_ERROR_SCAN_FAILED;
+        }
+
+        FileMover mover(session->logger, session->config.dry_run != 0);
+        bool organized = mover.organizeFiles(directory,
+                                             session->classifier.getCategorizedFiles());
+
+        // Files have moved (or a dry run may be followed by a real one): rescan next time
+        session->scannedDirectory.clear();
+
+        if (!organized) {
+            session->lastError = "File organization failed";
+            return SC_ERROR_ORGANIZE_FAILED;
+        }
+
+        sc_organize_result organize = {};
+        organize.struct_size = sizeof(sc_organize_result);
+        organize.success_count = mover.getSuccessCount();
+        organize.fail_count = mover.getFailCount();
+        organize.warning_count = mover.getWarningCount();
+
+        return copyResult(organize, result) ? SC_OK : SC_ERROR_INVALID_ARGUMENT;
+
+    } catch (const std::exception& e) {
+        session->lastError = e.what();
+        return SC_ERROR_INTERNAL;
+    } catch (...) {
+        session->lastError = "Unknown error";
+        return SC_ERROR_INTERNAL;
+    }
+}
+
+sc_status sc_archive_old(sc_session* session, const char* directory,
+                         sc_organize_result* result) {
+    if (session == nullptr || directory == nullptr) {
+        return SC_ERROR_INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    session->lastError.clear();
+
+    if (!ColdStorage::isAvailable()) {
+        session->lastError = "Built without zstd support";
+        return SC_ERROR_UNSUPPORTED;
+    }
+
+    try {
+        if (!ensureScanned(session, directory)) {
+            return SC_ERROR_SCAN_FAILED;
+        }
+
+        ColdStorage coldStorage(session->logger, session->pool, session->config.dry_run != 0);
+        coldStorage.archiveFiles(directory, session->scanner.getOldFiles());
+        session->scannedDirectory.clear();
+
+        sc_organize_result archive = {};
+        archive.struct_size = sizeof(sc_organize_result);
+        archive.success_count = static_cast<int>(coldStorage.getArchivedFiles().size());
+        archive.fail_count = coldStorage.getFailCount();
+        archive.warning_count = coldStorage.getSkippedCount();
+
+        return copyResult(archive, result) ? SC_OK : SC_ERROR_INVALID_ARGUMENT;
+
+    } catch (const std::exception& e) {
+        session->lastError = e.what();
+        return SC_ERROR_INTERNAL;
+    } catch (...) {
+        session->lastError = "Unknown error";
+        return SC_ERROR_INTERNAL;
+    }
+}
+
+//------------------------------------------------------------------------------
+// Classification of the Last Scan
+//------------------------------------------------------------------------------
+size_t sc_category_count(const sc_session* session) {
+    if (session == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    return session->categoryNames.size();
+}
+
+const char* sc_category_name(const sc_session* session, size_t index) {
+    if (session == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    if (index >= session->categoryNames.size()) {
+        return nullptr;
+    }
+    return session->categoryNames[index].c_str();
+}
+
+size_t sc_category_file_count(const sc_session* session, size_t index) {
+    if (session == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(session->mutex);
+    if (index >= session->categoryCounts.size()) {
+        return 0;
+    }
+    return session->categoryCounts[index];
+}
+
+//------------------------------------------------------------------------------
+// Daemon Index Queries
+//------------------------------------------------------------------------------
+sc_query_client* sc_query_open(const char* shm_name) {
+    try {
+        return new sc_query_client(shm_name ? shm_name : "");
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void sc_query_close(sc_query_client* client) {
+    delete client;
+}
+
+sc_status sc_query_lookup(sc_query_client* client, const char* path, sc_file_record* record) {
+    if (client == nullptr || path == nullptr) {
+        return SC_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        SharedFileRecord found;
+        if (!client->table.lookup(path, found)) {
+            return SC_ERROR_NOT_FOUND;
+        }
+
+        sc_file_record local{};
+        local.struct_size = sizeof(local);
+        std::strncpy(local.category, found.category.c_str(), sizeof(local.category) - 1);
+        local.duplicate_status = static_cast<int>(found.duplicateStatus);
+        local.duplicate_group = found.duplicateGroup;
+        local.size_bytes = found.sizeBytes;
+        local.last_modified = static_cast<long long>(found.lastModified);
+        return copyResult(local, record) ? SC_OK : SC_ERROR_INVALID_ARGUMENT;
+    } catch (...) {
+        return SC_ERROR_INTERNAL;
+    }
+}
+
+const char* sc_query_last_error(const sc_query_client* client) {
+    return client ? client->table.getLastError().c_str() : "";
+}
+
+} // extern "C"
@@ -0,0 +1,152 @@
+/*==============================================================================
+ * SmartCleanerAPI.h - Stable C Interface for libsmartcleaner
+ *==============================================================================
+ *
+ * Sessions keep the logger, classifier tables, worker pool and the last scan
+ * warm, so embedders can run many scan/organize calls in one process.
+ *
+ * ABI rules: structs start with struct_size and only ever grow at the end;
+ * functions are never removed. Calls on one session are serialized; separate
+ * sessions may be used from different threads.
+ */
+
+#ifndef SMART_CLEANER_API_H
+#define SMART_CLEANER_API_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  define SC_API __declspec(dllexport)
+#elif defined(__GNUC__)
+#  define SC_API __attribute__((visibility("default")))
+#else
+#  define SC_API
+#endif
+
+#define SC_API_VERSION 2
+
+/*------------------------------------------------------------------------------
+ * Status Codes
+ *----------------------------------------------------------------------------*/
+typedef enum sc_status {
+    SC_OK = 0,
+    SC_ERROR_INVALID_ARGUMENT = -1,
+    SC_ERROR_SCAN_FAILED = -2,
+    SC_ERROR_ORGANIZE_FAILED = -3,
+    SC_ERROR_UNSUPPORTED = -4,
+    SC_ERROR_INTERNAL = -5,
+    SC_ERROR_NOT_FOUND = -6         /* Since version 2 */
+} sc_status;
+
+/*------------------------------------------------------------------------------
+ * Session Configuration
+ * Call sc_config_init() first so new fields get their defaults.
+ *----------------------------------------------------------------------------*/
+typedef struct sc_config {
+    size_t struct_size;             /* sizeof(sc_config) as compiled by caller */
+    long long large_file_size_mb;   /* Large file threshold */
+    int old_file_age_days;          /* Old file threshold */
+    int dry_run;                    /* Non-zero = log actions without moving */
+    int thread_count;               /* Worker threads, 0 = CPU limit (cgroup quota, cpuset, affinity) */
+    const char* log_directory;      /* NULL = no log file */
+} sc_config;
+
+/*------------------------------------------------------------------------------
+ * Operation Results
+ *----------------------------------------------------------------------------*/
+typedef struct sc_scan_result {
+    size_t struct_size;             /* sizeof(sc_scan_result) as compiled by caller */
+    size_t file_count;              /* Regular files found */
+    size_t large_file_count;        /* Files over the size threshold */
+    size_t old_file_count;          /* Files over the age threshold */
+    long long total_bytes;          /* Sum of file sizes */
+} sc_scan_result;
+
+typedef struct sc_organize_result {
+    size_t struct_size;             /* sizeof(sc_organize_result) as compiled by caller */
+    int success_count;              /* Files moved (or would be, in dry-run) */
+    int fail_count;                 /* Failed moves */
+    int warning_count;              /* Renamed on collision */
+} sc_organize_result;
+
+/*------------------------------------------------------------------------------
+ * Daemon Index Record (since version 2)
+ *----------------------------------------------------------------------------*/
+#define SC_DUPLICATE_UNIQUE 0       /* No other file has the same content */
+#define SC_DUPLICATE_ORIGINAL 1     /* Oldest copy in its group */
+#define SC_DUPLICATE_COPY 2         /* Newer copy of an original */
+#define SC_DUPLICATE_UNKNOWN 3      /* Could not be hashed */
+
+typedef struct sc_file_record {
+    size_t struct_size;             /* sizeof(sc_file_record) as compiled by caller */
+    char category[32];              /* NUL-terminated category name */
+    int duplicate_status;           /* SC_DUPLICATE_* */
+    unsigned int duplicate_group;   /* Group index when not unique */
+    long long size_bytes;           /* Size when the daemon last indexed it */
+    long long last_modified;        /* Unix time when the daemon last indexed it */
+} sc_file_record;
+
+typedef struct sc_session sc_session;
+typedef struct sc_query_client sc_query_client;
+
+/*------------------------------------------------------------------------------
+ * Library and Session Lifecycle
+ *----------------------------------------------------------------------------*/
+SC_API int sc_api_version(void);
+SC_API void sc_config_init(sc_config* config);
+SC_API sc_session* sc_session_create(const sc_config* config);
+SC_API void sc_session_destroy(sc_session* session);
+
+/* Message for the last failed call on this session ("" if none). Waits for
+ * a call in progress on another thread; the string stays valid until the
+ * next sc_scan, sc_organize or sc_archive_old on the session. */
+SC_API const char* sc_session_last_error(const sc_session* session);
+
+/*------------------------------------------------------------------------------
+ * Operations
+ * sc_organize and sc_archive_old reuse the session's last scan when it covered
+ * the same directory less than 30 seconds ago and scan again otherwise. A
+ * file changed since that scan is moved as it was classified then; call
+ * sc_scan first to act on a fresh scan. sc_archive_old needs a build with
+ * zstd support and reports archived / failed / skipped-as-incompressible in
+ * the success / fail / warning counts.
+ *----------------------------------------------------------------------------*/
+SC_API sc_status sc_scan(sc_session* session, const char* directory, sc_scan_result* result);
+SC_API sc_status sc_organize(sc_session* session, const char* directory,
+                             sc_organize_result* result);
+SC_API sc_status sc_archive_old(sc_session* session, const char* directory,
+                                sc_organize_result* result);
+
+/*------------------------------------------------------------------------------
+ * Classification of the Last Scan
+ * Safe to call while another thread uses the session. A returned name stays
+ * valid until the session scans again (sc_scan, or an sc_organize /
+ * sc_archive_old that rescans).
+ *----------------------------------------------------------------------------*/
+SC_API size_t sc_category_count(const sc_session* session);
+SC_API const char* sc_category_name(const sc_session* session, size_t index);
+SC_API size_t sc_category_file_count(const sc_session* session, size_t index);
+
+/*------------------------------------------------------------------------------
+ * Daemon Index Queries (since version 2)
+ * Lookups read the running daemon's shared-memory table directly: no socket,
+ * no lock, no scan. A client attaches lazily, re-attaches after the daemon
+ * restarts, and must only be used by one thread at a time. shm_name NULL
+ * sends each lookup to the daemon watching the nearest directory above the
+ * path, as --query does.
+ *----------------------------------------------------------------------------*/
+SC_API sc_query_client* sc_query_open(const char* shm_name);
+SC_API void sc_query_close(sc_query_client* client);
+SC_API sc_status sc_query_lookup(sc_query_client* client, const char* path,
+                                 sc_file_record* record);
+SC_API const char* sc_query_last_error(const sc_query_client* client);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SMART_CLEANER_API_H */
@@ -0,0 +1,86 @@
+/*==============================================================================
+ * SmartCleanerPlugin.h - C Interface for Classifier Plugins
+ *==============================================================================
+ *
+ * A plugin is a shared library loaded with --plugin=<PATH>. It exports
+ * SC_PLUGIN_ENTRY, which fills an sc_plugin_info describing the categories it
+ * can assign and its batch function.
+ *
+ * Files are handed over in batches of columns (names, extensions, sizes,
+ * mtimes) rather than one call per file, so a plugin can run tight loops over
+ * plain arrays. Batches of one scan are classified concurrently on the worker
+ * pool: classify_batch must be safe to call from several threads at once.
+ * Every column, and the category ids it writes, is only valid during the call.
+ *
+ * ABI rules follow SmartCleanerAPI.h: structs start with struct_size and only
+ * grow at the end; abi_version is bumped only for incompatible changes.
+ */
+
+#ifndef SMART_CLEANER_PLUGIN_H
+#define SMART_CLEANER_PLUGIN_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  define SC_PLUGIN_EXPORT __declspec(dllexport)
+#elif defined(__GNUC__)
+#  define SC_PLUGIN_EXPORT __attribute__((visibility("default")))
+#else
+#  define SC_PLUGIN_EXPORT
+#endif
+
+#define SC_PLUGIN_ABI_VERSION 1
+#define SC_PLUGIN_ENTRY "sc_classifier_plugin_init"
+
+/* Category id meaning "no opinion": the next plugin, then the built-in
+ * extension rules decide */
+#define SC_PLUGIN_NO_CATEGORY (-1)
+
+/*------------------------------------------------------------------------------
+ * Batch
+ * All arrays hold `count` elements. Extensions are lowercase with the leading
+ * dot ("" when there is none). category_ids arrives filled with
+ * SC_PLUGIN_NO_CATEGORY.
+ *----------------------------------------------------------------------------*/
+typedef struct sc_plugin_batch {
+    size_t struct_size;             /* sizeof(sc_plugin_batch) as compiled by the host */
+    size_t count;                   /* Files in this batch */
+    const char* const* names;       /* File names with extension */
+    const char* const* extensions;  /* Lowercase extensions */
+    const long long* sizes;         /* Apparent sizes in bytes */
+    const long long* mtimes;        /* Last modification, Unix time */
+    int* category_ids;              /* Out: index into categories, or SC_PLUGIN_NO_CATEGORY */
+} sc_plugin_batch;
+
+/*------------------------------------------------------------------------------
+ * Plugin Description
+ * Category names are folder names under the cleaned directory; they may be
+ * built-in ones ("Documents") or new ones. The strings and the array must
+ * stay valid until destroy is called.
+ *----------------------------------------------------------------------------*/
+typedef struct sc_plugin_info {
+    size_t struct_size;             /* sizeof(sc_plugin_info) as compiled by the host */
+    int abi_version;                /* Set to SC_PLUGIN_ABI_VERSION */
+    const char* name;               /* For logs */
+    size_t category_count;
+    const char* const* categories;
+
+    /* Returns 0 on success; on failure the batch keeps its built-in categories */
+    int (*classify_batch)(void* state, sc_plugin_batch* batch);
+
+    void* state;                    /* Passed back to classify_batch and destroy */
+    void (*destroy)(void* state);   /* Optional; called before the library is closed */
+} sc_plugin_info;
+
+/* The entry point: fill info (struct_size is preset by the host), return 0 */
+typedef int (*sc_plugin_init_fn)(sc_plugin_info* info);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* SMART_CLEANER_PLUGIN_H */
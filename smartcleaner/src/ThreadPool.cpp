@@ -0,0 +1,130 @@
+//==============================================================================
+// ThreadPool.cpp - Worker Pool Implementation
+//==============================================================================
+
+#include "ThreadPool.h"
+#include "ResourceLimits.h"
+#include <algorithm>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+ThreadPool::ThreadPool(std::size_t threadCount) : stopping_(false), activeCount_(0) {
+    if (threadCount == 0) {
+        // The container's CPU quota, not the host's core count
+        threadCount = ResourceLimits::cpuCount();
+    }
+    resize(threadCount);
+}
+
+//------------------------------------------------------------------------------
+// Destructor
+// Drains queued tasks before joining the workers
+//------------------------------------------------------------------------------
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    parkedCondition_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Resize
+// Growing starts threads only past the ones already parked; shrinking parks
+// the highest-numbered workers once they finish their current task
+//------------------------------------------------------------------------------
+void ThreadPool::resize(std::size_t threadCount) {
+    threadCount = std::max<std::size_t>(threadCount, 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        activeCount_ = threadCount;
+        for (std::size_t i = workers_.size(); i < threadCount; ++i) {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+    condition_.notify_all();
+    parkedCondition_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+// Status Methods
+//------------------------------------------------------------------------------
+std::size_t ThreadPool::getThreadCount() const {
+    return activeCount_;
+}
+
+//------------------------------------------------------------------------------
+// Run One Queued Task on the Calling Thread
+//------------------------------------------------------------------------------
+bool ThreadPool::runPendingTask() {
+    std::function<void()> task;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+    }
+
+    task();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Helper: Enqueue Task
+//------------------------------------------------------------------------------
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+//------------------------------------------------------------------------------
+// Helper: Worker Loop
+// Parked workers wait on their own condition, so the notify_one() for a new
+// task always reaches a worker that may take it
+//------------------------------------------------------------------------------
+void ThreadPool::workerLoop(std::size_t index) {
+    for (;;) {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stopping_) {
+                if (index >= activeCount_) {
+                    parkedCondition_.wait(lock);
+                } else if (tasks_.empty()) {
+                    condition_.wait(lock);
+                } else {
+                    break;
+                }
+            }
+
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        // Exceptions are captured by the packaged_task and surface via the future
+        task();
+    }
+}
+
+} // namespace DesktopCleaner
@@ -0,0 +1,127 @@
+//==============================================================================
+// ThreadPool.h - Worker Pool Interface
+//==============================================================================
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace DesktopCleaner {
+
+//------------------------------------------------------------------------------
+// ThreadPool Class
+// Runs submitted tasks on a set of worker threads. The set only changes
+// through resize(), which long-running processes use when their CPU limit does.
+//------------------------------------------------------------------------------
+class ThreadPool {
+public:
+    // Constructor & Destructor (0 threads = ResourceLimits::cpuCount())
+    explicit ThreadPool(std::size_t threadCount = 0);
+    ~ThreadPool();
+
+    // Prevent copying
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Queue a task; the returned future carries its result or exception
+    template <typename Func>
+    auto submit(Func&& func) -> std::future<decltype(func())>;
+
+    // Wait for a future, running queued tasks meanwhile. Tasks that wait on
+    // tasks they submitted must use this, or a full pool deadlocks.
+    template <typename Result>
+    void waitFor(const std::future<Result>& future);
+    bool runPendingTask();
+
+    // Run this many workers; extra threads are parked rather than joined
+    void resize(std::size_t threadCount);
+
+    // Status methods
+    std::size_t getThreadCount() const;
+
+private:
+    std::vector<std::thread> workers_;              // Worker threads
+    std::queue<std::function<void()>> tasks_;       // Pending tasks
+    std::mutex mutex_;                              // Guards tasks_, stopping_ and workers_
+    std::condition_variable condition_;             // Active workers: new work / shutdown / resize
+    std::condition_variable parkedCondition_;       // Parked workers: shutdown / resize only
+    bool stopping_;                                 // Set once in destructor
+    std::atomic<std::size_t> activeCount_;          // Workers below this index take tasks
+
+    // Helper methods
+    void enqueue(std::function<void()> task);
+    void workerLoop(std::size_t index);
+};
+
+// Call func(begin, end) for consecutive batches of [0, count) on the pool, or
+// inline without one; returns once every batch has run. Batches cover
+// disjoint ranges, so func writing only its own range needs no locking.
+template <typename Func>
+void runInBatches(ThreadPool* pool, std::size_t count, std::size_t batchSize, Func func);
+
+//------------------------------------------------------------------------------
+// Submit Task
+//------------------------------------------------------------------------------
+template <typename Func>
+auto ThreadPool::submit(Func&& func) -> std::future<decltype(func())> {
+    using Result = decltype(func());
+
+    // packaged_task is move-only; share it so std::function can copy the wrapper
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+    std::future<Result> result = task->get_future();
+    enqueue([task]() { (*task)(); });
+    return result;
+}
+
+//------------------------------------------------------------------------------
+// Helping Wait
+//------------------------------------------------------------------------------
+template <typename Result>
+void ThreadPool::waitFor(const std::future<Result>& future) {
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!runPendingTask()) {
+            future.wait_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Run In Batches
+//------------------------------------------------------------------------------
+template <typename Func>
+void runInBatches(ThreadPool* pool, std::size_t count, std::size_t batchSize, Func func) {
+    if (pool == nullptr) {
+        for (std::size_t begin = 0; begin < count; begin += batchSize) {
+            func(begin, std::min(count, begin + batchSize));
+        }
+        return;
+    }
+
+    std::vector<std::future<void>> batches;
+    for (std::size_t begin = 0; begin < count; begin += batchSize) {
+        std::size_t end = std::min(count, begin + batchSize);
+        batches.push_back(pool->submit([&func, begin, end]() { func(begin, end); }));
+    }
+    for (auto& batch : batches) {
+        pool->waitFor(batch);
+    }
+    for (auto& batch : batches) {
+        batch.get();
+    }
+}
+
+} // namespace DesktopCleaner
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,205 @@
+//==============================================================================
+// TraceRecorder.cpp - Filesystem Workload Trace Capture Implementation
+//==============================================================================
+
+#include "TraceRecorder.h"
+#include "ContentHash.h"
+#include "Logger.h"
+#include "Config.h"
+#include <atomic>
+#include <cstring>
+#include <random>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const char TRACE_MAGIC[8] = { 'S', 'C', 'T', 'R', 'A', 'C', 'E', '1' };
+const std::uint32_t TRACE_VERSION = 1;
+
+static_assert(sizeof(TraceRecord) == 64, "TraceRecord is an on-disk format");
+
+//------------------------------------------------------------------------------
+// Helper: Small Stable Number for the Calling Thread
+//------------------------------------------------------------------------------
+std::uint32_t currentThreadIndex() {
+    static std::atomic<std::uint32_t> nextIndex{ 0 };
+    thread_local std::uint32_t index = nextIndex.fetch_add(1);
+    return index;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor / Destructor
+//------------------------------------------------------------------------------
+TraceRecorder::TraceRecorder(Logger& logger)
+    : logger_(logger),
+      salt_(0),
+      origin_(std::chrono::steady_clock::now()),
+      recordCount_(0) {
+}
+
+TraceRecorder::~TraceRecorder() {
+    close();
+}
+
+//------------------------------------------------------------------------------
+// Lifecycle
+//------------------------------------------------------------------------------
+bool TraceRecorder::open(const std::string& tracePath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    output_.open(tracePath, std::ios::binary | std::ios::trunc);
+    if (!output_) {
+        logger_.error("Cannot create trace file: " + tracePath);
+        return false;
+    }
+
+    std::uint32_t header[2] = { TRACE_VERSION, static_cast<std::uint32_t>(sizeof(TraceRecord)) };
+    output_.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    output_.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    std::random_device entropy;
+    salt_ = (static_cast<std::uint64_t>(entropy()) << 32) ^ entropy();
+    origin_ = std::chrono::steady_clock::now();
+    tracePath_ = tracePath;
+    recordCount_ = 0;
+    buffer_.reserve(TRACE_FLUSH_RECORDS);
+
+    logger_.info("Recording workload trace: " + tracePath);
+    return true;
+}
+
+void TraceRecorder::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!output_.is_open()) {
+        return;
+    }
+    flushLocked();
+    output_.close();
+    logger_.info("Trace closed: " + std::to_string(recordCount_) + " operations");
+}
+
+//------------------------------------------------------------------------------
+// Recording
+//------------------------------------------------------------------------------
+std::uint64_t TraceRecorder::now() const {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin_).count());
+}
+
+void TraceRecorder::record(TraceOp op, const fs::path& path, long long sizeBytes,
+                           std::uint64_t startNs, bool ok, const fs::path* target) {
+    std::uint64_t endNs = now();
+    recordSpan(op, path, sizeBytes, startNs, endNs > startNs ? endNs - startNs : 0, ok, target);
+}
+
+void TraceRecorder::recordSpan(TraceOp op, const fs::path& path, long long sizeBytes,
+                               std::uint64_t startNs, std::uint64_t latencyNs, bool ok,
+                               const fs::path* target) {
+    // Hash outside the lock; it is the expensive part
+    TraceRecord entry{};
+    entry.pathHash = anonymize(path);
+    entry.parentHash = anonymize(path.parent_path());
+    if (target != nullptr) {
+        entry.targetHash = anonymize(*target);
+        entry.targetParentHash = anonymize(target->parent_path());
+    }
+    entry.sizeBytes = sizeBytes;
+    entry.startNs = startNs;
+    entry.latencyNs = latencyNs;
+    entry.op = static_cast<std::uint16_t>(op);
+    entry.flags = ok ? TRACE_FLAG_OK : 0;
+    entry.threadIndex = currentThreadIndex();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!output_.is_open()) {
+        return;
+    }
+    buffer_.push_back(entry);
+    recordCount_++;
+    if (buffer_.size() >= TRACE_FLUSH_RECORDS) {
+        flushLocked();
+    }
+}
+
+//------------------------------------------------------------------------------
+// Get Trace Information
+//------------------------------------------------------------------------------
+std::uint64_t TraceRecorder::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return recordCount_;
+}
+
+const std::string& TraceRecorder::getTracePath() const {
+    return tracePath_;
+}
+
+//------------------------------------------------------------------------------
+// Reading
+//------------------------------------------------------------------------------
+bool TraceRecorder::readTrace(const std::string& tracePath, std::vector<TraceRecord>& records,
+                              std::string& error) {
+    std::ifstream input(tracePath, std::ios::binary);
+    if (!input) {
+        error = "cannot open trace: " + tracePath;
+        return false;
+    }
+
+    char magic[sizeof(TRACE_MAGIC)];
+    std::uint32_t header[2] = { 0, 0 };
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!input || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+        error = "not a trace file: " + tracePath;
+        return false;
+    }
+    if (header[0] != TRACE_VERSION || header[1] != sizeof(TraceRecord)) {
+        error = "unsupported trace version " + std::to_string(header[0]);
+        return false;
+    }
+
+    records.clear();
+    TraceRecord entry;
+    while (input.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+        records.push_back(entry);
+    }
+    return true;
+}
+
+const char* TraceRecorder::opName(TraceOp op) {
+    switch (op) {
+        case TraceOp::LIST_DIR: return "list_dir";
+        case TraceOp::STAT:     return "stat";
+        case TraceOp::EXISTS:   return "exists";
+        case TraceOp::MKDIR:    return "mkdir";
+        case TraceOp::RENAME:   return "rename";
+        default:                return "unknown";
+    }
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+std::uint64_t TraceRecorder::anonymize(const fs::path& path) const {
+    std::string normalized = ContentHasher::normalizePath(path);
+    if (normalized.size() > 1 && normalized.back() == fs::path::preferred_separator) {
+        normalized.pop_back(); // "dir/" and "dir" are the same directory
+    }
+    std::uint64_t hash = ContentHasher::hashBytes(normalized.data(), normalized.size(), salt_);
+    return hash != 0 ? hash : 1; // 0 means "no path"
+}
+
+void TraceRecorder::flushLocked() {
+    if (!buffer_.empty()) {
+        output_.write(reinterpret_cast<const char*>(buffer_.data()),
+                      static_cast<std::streamsize>(buffer_.size() * sizeof(TraceRecord)));
+        buffer_.clear();
+    }
+    output_.flush();
+}
+
+} // namespace DesktopCleaner
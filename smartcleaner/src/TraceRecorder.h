@@ -0,0 +1,112 @@
+//==============================================================================
+// TraceRecorder.h - Filesystem Workload Trace Capture Interface
+//==============================================================================
+//
+// Trace file: 16-byte header ("SCTRACE1", version, record size) followed by
+// fixed-size little-endian TraceRecord entries in completion order.
+//
+// Paths are anonymized: each is replaced by a 64-bit hash keyed with a random
+// salt that is never written out, so the trace keeps the tree's shape (which
+// path is which, what lives where) without any names.
+//
+//==============================================================================
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declaration
+class Logger;
+
+//------------------------------------------------------------------------------
+// Traced Operations
+// Values are part of the trace format; append only
+//------------------------------------------------------------------------------
+enum class TraceOp : std::uint16_t {
+    LIST_DIR = 1,     // Directory enumeration; sizeBytes = entries seen
+    STAT = 2,         // Size + mtime of one file
+    EXISTS = 3,       // Existence check; TRACE_FLAG_OK = it existed
+    MKDIR = 4,        // Directory creation
+    RENAME = 5        // Move path -> target
+};
+
+const std::uint16_t TRACE_FLAG_OK = 1;    // Operation succeeded / path existed
+
+//------------------------------------------------------------------------------
+// TraceRecord Structure (64 bytes on disk)
+//------------------------------------------------------------------------------
+struct TraceRecord {
+    std::uint64_t pathHash;             // Anonymized path
+    std::uint64_t parentHash;           // Anonymized parent directory
+    std::uint64_t targetHash;           // RENAME destination, else 0
+    std::uint64_t targetParentHash;     // RENAME destination directory, else 0
+    std::int64_t sizeBytes;             // File size (or entry count for LIST_DIR)
+    std::uint64_t startNs;              // Start time since the trace began
+    std::uint64_t latencyNs;            // Time the operation took
+    std::uint16_t op;                   // TraceOp
+    std::uint16_t flags;                // TRACE_FLAG_*
+    std::uint32_t threadIndex;          // Small per-thread number
+};
+
+//------------------------------------------------------------------------------
+// TraceRecorder Class
+// Thread-safe; records are buffered and written in batches
+//------------------------------------------------------------------------------
+class TraceRecorder {
+public:
+    // Constructor / Destructor (the destructor flushes and closes)
+    explicit TraceRecorder(Logger& logger);
+    ~TraceRecorder();
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Lifecycle
+    bool open(const std::string& tracePath);
+    void close();
+
+    // Recording: take now() before the operation, then record() after it
+    std::uint64_t now() const;
+    void record(TraceOp op, const std::filesystem::path& path, long long sizeBytes,
+                std::uint64_t startNs, bool ok = true,
+                const std::filesystem::path* target = nullptr);
+    void recordSpan(TraceOp op, const std::filesystem::path& path, long long sizeBytes,
+                    std::uint64_t startNs, std::uint64_t latencyNs, bool ok = true,
+                    const std::filesystem::path* target = nullptr);
+
+    // Get trace information
+    std::uint64_t getRecordCount() const;
+    const std::string& getTracePath() const;
+
+    // Reading (for the replay tool)
+    static bool readTrace(const std::string& tracePath, std::vector<TraceRecord>& records,
+                          std::string& error);
+    static const char* opName(TraceOp op);
+
+private:
+    Logger& logger_;                                    // Reference to logger
+    std::string tracePath_;                             // Output file
+    std::ofstream output_;                              // Open while recording
+    std::uint64_t salt_;                                // Hash key; never persisted
+    std::chrono::steady_clock::time_point origin_;      // Time zero
+    mutable std::mutex mutex_;                          // Guards buffer_ and output_
+    std::vector<TraceRecord> buffer_;                   // Records not yet written
+    std::uint64_t recordCount_;                         // Records so far
+
+    // Helper methods
+    std::uint64_t anonymize(const std::filesystem::path& path) const;
+    void flushLocked();
+};
+
+} // namespace DesktopCleaner
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,206 @@
+//==============================================================================
+// WorkPlanner.cpp - Time-Budgeted Move Planning Implementation
+//==============================================================================
+
+#include "WorkPlanner.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+namespace DesktopCleaner {
+
+namespace {
+
+const std::string STATE_HEADER = "smartcleaner-plan 1";
+
+fs::path statePath(const std::string& baseDirectory) {
+    return fs::path(baseDirectory) / PLAN_STATE_FILE;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Constructor
+//------------------------------------------------------------------------------
+WorkPlanner::WorkPlanner(Logger& logger, const FileScanner& scanner)
+    : logger_(logger),
+      scanner_(scanner),
+      windows_(0),
+      movedFiles_(0),
+      movedBytes_(0),
+      remaining_(0) {
+}
+
+//------------------------------------------------------------------------------
+// Build Plan
+//------------------------------------------------------------------------------
+std::vector<PlannedMove> WorkPlanner::buildPlan(
+    const std::map<std::string, std::vector<FileInfo>>& categorizedFiles) const {
+    std::vector<PlannedMove> plan;
+    for (const auto& [category, files] : categorizedFiles) {
+        for (const auto& file : files) {
+            bool large = scanner_.isLargeFile(file);
+            bool old = scanner_.isOldFile(file);
+            int tier = large ? (old ? 0 : 1) : (old ? 2 : 3);
+            plan.push_back({ file, category, tier });
+        }
+    }
+
+    std::sort(plan.begin(), plan.end(), [this](const PlannedMove& a, const PlannedMove& b) {
+        bool aFailed = failedPaths_.count(a.file.path.string()) > 0;
+        bool bFailed = failedPaths_.count(b.file.path.string()) > 0;
+        if (aFailed != bFailed) {
+            return bFailed;
+        }
+        if (a.tier != b.tier) {
+            return a.tier < b.tier;
+        }
+        if (a.file.allocatedBytes != b.file.allocatedBytes) {
+            return a.file.allocatedBytes > b.file.allocatedBytes;
+        }
+        return a.file.path < b.file.path;
+    });
+    return plan;
+}
+
+//------------------------------------------------------------------------------
+// Load Resume State
+//------------------------------------------------------------------------------
+bool WorkPlanner::loadState(const std::string& baseDirectory) {
+    std::ifstream input(statePath(baseDirectory));
+    if (!input) {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(input, line) || line != STATE_HEADER) {
+        logger_.warning("Ignoring unreadable plan state: " + statePath(baseDirectory).string());
+        return false;
+    }
+    while (std::getline(input, line)) {
+        std::size_t space = line.find(' ');
+        std::string key = line.substr(0, space);
+        std::string value = space == std::string::npos ? "" : line.substr(space + 1);
+        try {
+            if (key == "windows") {
+                windows_ = std::stoi(value);
+            } else if (key == "moved") {
+                std::size_t split = value.find(' ');
+                movedFiles_ = std::stoll(value.substr(0, split));
+                movedBytes_ = split == std::string::npos ? 0 : std::stoll(value.substr(split + 1));
+            } else if (key == "remaining") {
+                remaining_ = std::stoll(value);
+            } else if (key == "failed" && !value.empty()) {
+                failedPaths_.insert(value);
+            }
+        } catch (const std::exception&) {
+            logger_.warning("Ignoring bad plan state line: " + line);
+        }
+    }
+
+    logger_.info("Resuming plan after " + std::to_string(windows_) + " windows (" +
+                 std::to_string(remaining_) + " moves were left, " +
+                 std::to_string(failedPaths_.size()) + " failed)");
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Save Resume State
+// Written to a temporary file and renamed, so a kill mid-write keeps the old one
+//------------------------------------------------------------------------------
+bool WorkPlanner::saveState(const std::string& baseDirectory, const std::vector<PlannedMove>& plan,
+                            std::size_t attempted, const std::vector<std::string>& failedPaths) {
+    std::unordered_set<std::string> failedNow(failedPaths.begin(), failedPaths.end());
+    long long files = movedFiles_;
+    long long bytes = movedBytes_;
+    for (std::size_t i = 0; i < attempted && i < plan.size(); ++i) {
+        if (failedNow.count(plan[i].file.path.string()) == 0) {
+            files++;
+            bytes += plan[i].file.sizeBytes;
+        }
+    }
+    // Earlier failures that this window did not reach are still failures
+    for (std::size_t i = attempted; i < plan.size(); ++i) {
+        const std::string path = plan[i].file.path.string();
+        if (failedPaths_.count(path) > 0) {
+            failedNow.insert(path);
+        }
+    }
+
+    fs::path target = statePath(baseDirectory);
+    fs::path temporary = target;
+    temporary += ".tmp";
+    {
+        std::ofstream output(temporary, std::ios::trunc);
+        if (!output) {
+            logger_.error("Cannot write plan state: " + temporary.string());
+            return false;
+        }
+        output << STATE_HEADER << '\n';
+        output << "windows " << (windows_ + 1) << '\n';
+        output << "moved " << files << ' ' << bytes << '\n';
+        output << "remaining " << (plan.size() - std::min(attempted, plan.size())) << '\n';
+        for (const auto& path : failedNow) {
+            if (path.find('\n') == std::string::npos) {
+                output << "failed " << path << '\n';
+            }
+        }
+        if (!output.flush()) {
+            logger_.error("Cannot write plan state: " + temporary.string());
+            return false;
+        }
+    }
+
+    std::error_code error;
+    fs::rename(temporary, target, error);
+    if (error) {
+        logger_.error("Cannot save plan state: " + target.string() + " - " + error.message());
+        return false;
+    }
+    logger_.info("Plan state saved: " + target.string());
+    return true;
+}
+
+void WorkPlanner::clearState(const std::string& baseDirectory) {
+    std::error_code error;
+    if (fs::remove(statePath(baseDirectory), error)) {
+        logger_.info("Plan complete, state removed");
+    }
+}
+
+//------------------------------------------------------------------------------
+// Totals Carried Over
+//------------------------------------------------------------------------------
+int WorkPlanner::getWindowCount() const {
+    return windows_;
+}
+
+long long WorkPlanner::getPreviousMovedFiles() const {
+    return movedFiles_;
+}
+
+long long WorkPlanner::getPreviousMovedBytes() const {
+    return movedBytes_;
+}
+
+long long WorkPlanner::getPreviousRemaining() const {
+    return remaining_;
+}
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+const char* WorkPlanner::tierName(int tier) {
+    switch (tier) {
+        case 0: return "large and old";
+        case 1: return "large";
+        case 2: return "old";
+        default: return "other";
+    }
+}
+
+} // namespace DesktopCleaner
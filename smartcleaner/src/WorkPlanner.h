@@ -0,0 +1,73 @@
+//==============================================================================
+// WorkPlanner.h - Time-Budgeted Move Planning Interface
+//==============================================================================
+
+#ifndef WORK_PLANNER_H
+#define WORK_PLANNER_H
+
+#include "FileScanner.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace DesktopCleaner {
+
+// Forward declarations
+class Logger;
+
+//------------------------------------------------------------------------------
+// PlannedMove Structure
+//------------------------------------------------------------------------------
+struct PlannedMove {
+    FileInfo file;                  // File to move
+    std::string category;           // Target folder under the base directory
+    int tier;                       // 0 = large and old, 1 = large, 2 = old, 3 = other
+};
+
+//------------------------------------------------------------------------------
+// WorkPlanner Class
+// Orders moves by value for --time-budget runs: large and old files first,
+// then large, then old, each by bytes allocated, so a window that ends early
+// has already done the moves that free the most space. What a window leaves
+// behind is recorded in PLAN_STATE_FILE in the base directory; files that
+// failed in an earlier window go last so they cannot eat every window.
+//------------------------------------------------------------------------------
+class WorkPlanner {
+public:
+    // Constructor (the scanner supplies the large/old predicates)
+    WorkPlanner(Logger& logger, const FileScanner& scanner);
+
+    // Planning
+    std::vector<PlannedMove> buildPlan(
+        const std::map<std::string, std::vector<FileInfo>>& categorizedFiles) const;
+
+    // Resume state; loadState is false when there is none
+    bool loadState(const std::string& baseDirectory);
+    bool saveState(const std::string& baseDirectory, const std::vector<PlannedMove>& plan,
+                   std::size_t attempted, const std::vector<std::string>& failedPaths);
+    void clearState(const std::string& baseDirectory);
+
+    // Totals carried over from earlier windows
+    int getWindowCount() const;
+    long long getPreviousMovedFiles() const;
+    long long getPreviousMovedBytes() const;
+    long long getPreviousRemaining() const;
+
+    // Helpers
+    static const char* tierName(int tier);
+
+private:
+    Logger& logger_;                                // Reference to logger
+    const FileScanner& scanner_;                    // Large/old predicates
+    int windows_;                                   // Windows run before this one
+    long long movedFiles_;                          // Moved in earlier windows
+    long long movedBytes_;
+    long long remaining_;                           // Left by the last window
+    std::unordered_set<std::string> failedPaths_;   // Failed in an earlier window
+};
+
+} // namespace DesktopCleaner
+
+#endif // WORK_PLANNER_H
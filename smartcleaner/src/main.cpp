@@ -6,41 +6,175 @@
 #include "FileScanner.h"
 #include "FileClassifier.h"
 #include "FileMover.h"
+#include "ColdStorage.h"
+#include "ProgressReporter.h"
+#include "SimdKernels.h"
+#include "ThreadPool.h"
+#include "DuplicateFinder.h"
+#include "SharedFileTable.h"
+#include "JobService.h"
+#include "ContentHash.h"
+#include "TraceRecorder.h"
+#include "PerfCounters.h"
+#include "NearDuplicateFinder.h"
+#include "ChunkAnalyzer.h"
+#include "PerceptualHash.h"
+#include "WorkPlanner.h"
+#include "LogIndex.h"
+#include "ResourceLimits.h"
+#include "ConcurrencyController.h"
+#include "ClassifierPlugins.h"
+#include "KeywordClassifier.h"
+#include "FileIndex.h"
+#include "LiveStats.h"
+#include "DirectoryWatcher.h"
+#include "CacheDetector.h"
+#include "ExtensionSketch.h"
 #include "Config.h"
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <filesystem>
 #include <string>
 #include <cstdlib>
+#include <chrono>
+#include <unordered_set>
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <csignal>
+#include <thread>
+#include <memory>
+#include <vector>
 
 namespace fs = std::filesystem;
 using namespace DesktopCleaner;
 
+//------------------------------------------------------------------------------
+// Command-Line Options
+//------------------------------------------------------------------------------
+struct CommandLineOptions {
+    std::string directory;                                  // Target directory
+    bool dryRun = DEFAULT_DRY_RUN;                          // Preview only
+    long long sizeThresholdMB = DEFAULT_LARGE_FILE_SIZE_MB; // Large file threshold
+    int ageThresholdDays = DEFAULT_OLD_FILE_AGE_DAYS;       // Old file threshold
+    bool coldTier = false;                                  // Archive old files to Cold/
+    std::string restorePath;                                // Archive to restore, if any
+    int threadCount = 0;                                    // Worker threads (0 = auto)
+    bool verbose = false;                                   // Echo per-file events
+    int progressRate = DEFAULT_PROGRESS_REDRAWS_PER_SECOND; // Status line redraws/s
+    std::string isa;                                        // Forced kernel ISA, if any
+    bool isaSelfTest = false;                               // Verify/benchmark kernels and exit
+    bool daemon = false;                                    // Index-only loop publishing to shm
+    int daemonInterval = DEFAULT_DAEMON_INTERVAL_SECONDS;   // Seconds between daemon passes
+    std::string shmName;                                    // Shared-memory segment ("" = by directory)
+    std::string queryPath;                                  // File to look up in the daemon's index
+    std::string whereisPath;                                // File to look up in the log indices
+    bool serve = false;                                     // Daemon also accepts socket jobs
+    std::string socketPath;                                 // Job service socket ("" = default)
+    std::string submitType;                                 // Job to send to the service, if any
+    int priority = DEFAULT_JOB_PRIORITY;                    // Priority of the submitted job
+    std::string tracePath;                                  // Record a workload trace here
+    bool perf = false;                                      // Per-phase hardware counters
+    std::string nearDupes;                                  // "report" or "resolve" (empty = off)
+    NearDuplicateRefine nearRefine = NearDuplicateRefine::NONE; // Near-duplicate cluster check
+    bool nearRefineSet = false;                             // --near-refine given explicitly
+    bool chunkReport = false;                               // Measure chunk-level dedupe potential
+    int similarImages = -1;                                 // Max dHash distance (-1 = off)
+    bool paranoid = false;                                  // Re-read cross-device copies from disk
+    int timeBudgetMinutes = 0;                              // Stop moving after this (0 = no limit)
+    std::vector<std::string> pluginPaths;                   // Classifier plugins, in priority order
+    bool keywords = false;                                  // Route documents by keyword rules
+    std::string keywordRulesPath;                           // Rules file (empty = built-in rules)
+    bool index = false;                                     // Keep the persisted segment index
+    bool watch = false;                                     // Daemon keeps live stats from events
+    bool caches = false;                                    // Report rebuildable cache directories
+    bool unknownReport = false;                             // Sketch extensions that fall to Others
+    std::string unknownSketchPath;                          // Sketch file (empty = in DIRECTORY)
+    std::vector<std::string> mergeSketchPaths;              // Other runs' sketches, report only
+};
+
+// Set from SIGINT/SIGTERM; the daemon loop polls it
+volatile std::sig_atomic_t g_stopRequested = 0;
+
 //------------------------------------------------------------------------------
 // Function Prototypes
 //------------------------------------------------------------------------------
 void printHeader();
 void printUsage();
 void printSeparator();
-bool parseArguments(int argc, char* argv[], std::string& directory, 
-                   bool& dryRun, long long& sizeThreshold, int& ageThreshold);
+bool parseArguments(int argc, char* argv[], CommandLineOptions& options);
 std::string getDefaultDesktopPath();
 void displayAnalysis(const FileScanner& scanner);
+void displayNearDuplicates(const NearDuplicateFinder& nearDuplicates);
+void displayChunkReport(const ChunkAnalyzer& chunks);
+void displaySimilarImages(const PerceptualHasher& hasher);
+void displayCacheReport(const CacheDetector& detector);
+void displayUnknownExtensions(const ExtensionSketch& sketch);
+void displayPlanOutcome(const WorkPlanner& planner, const std::vector<PlannedMove>& plan,
+                        const FileMover& mover);
+int runRestore(const CommandLineOptions& options);
+int runDaemon(CommandLineOptions& options);
+std::size_t applyWatchEvents(const std::string& directory, const std::vector<std::string>& names,
+                             const FileScanner& scanner, FileClassifier& classifier,
+                             LiveStats& liveStats);
+int runQuery(const CommandLineOptions& options);
+int runSubmit(const CommandLineOptions& options);
+int runWhereIs(const CommandLineOptions& options);
 
 //------------------------------------------------------------------------------
 // Main Function
 //------------------------------------------------------------------------------
 int main(int argc, char* argv[]) {
+    // Keep stdout fully buffered; it is flushed at exit and before each redraw
+    std::ios::sync_with_stdio(false);
+    
     // Parse command-line arguments
-    std::string targetDirectory;
-    bool dryRun = DEFAULT_DRY_RUN;
-    long long sizeThresholdMB = DEFAULT_LARGE_FILE_SIZE_MB;
-    int ageThresholdDays = DEFAULT_OLD_FILE_AGE_DAYS;
+    CommandLineOptions options;
     
-    if (!parseArguments(argc, argv, targetDirectory, dryRun, 
-                       sizeThresholdMB, ageThresholdDays)) {
+    if (!parseArguments(argc, argv, options)) {
         return 1;
     }
     
+    // Kernel selection must happen before any scanning
+    if (!options.isa.empty()) {
+        IsaLevel level;
+        if (!SimdKernels::parseIsa(options.isa, level) || !SimdKernels::setIsa(level)) {
+            std::cerr << "Error: ISA not available on this CPU: " << options.isa << std::endl;
+            return 1;
+        }
+    }
+    
+    if (options.isaSelfTest) {
+        std::cout << "Detected ISA: " << SimdKernels::isaName(SimdKernels::detectIsa()) << '\n';
+        return SimdKernels::runSelfTest(std::cout) ? 0 : 1;
+    }
+    
+    // Restore, query and daemon modes bypass the scan/organize pipeline
+    if (!options.restorePath.empty()) {
+        return runRestore(options);
+    }
+    if (!options.queryPath.empty()) {
+        return runQuery(options);
+    }
+    if (!options.whereisPath.empty()) {
+        return runWhereIs(options);
+    }
+    if (!options.submitType.empty()) {
+        return runSubmit(options);
+    }
+    if (options.daemon) {
+        return runDaemon(options);
+    }
+    
+    std::string& targetDirectory = options.directory;
+    const bool dryRun = options.dryRun;
+    const long long sizeThresholdMB = options.sizeThresholdMB;
+    const int ageThresholdDays = options.ageThresholdDays;
+    
+    // A time budget covers the whole run, scan included
+    const auto runStarted = std::chrono::steady_clock::now();
+    
     // Use current directory if no path specified
     if (targetDirectory.empty()) {
         targetDirectory = fs::current_path().string();
@@ -60,87 +194,400 @@ int main(int argc, char* argv[]) {
     if (!logger.isOpen()) {
         std::cerr << "Warning: Logging may not work properly" << std::endl;
     }
+    logger.setVerboseConsole(options.verbose);
+    
+    ProgressReporter progress(logger, options.progressRate);
+    
+    TraceRecorder trace(logger);
+    if (!options.tracePath.empty() && !trace.open(options.tracePath)) {
+        std::cerr << "Error: Cannot create trace file: " << options.tracePath << std::endl;
+        return 1;
+    }
+    TraceRecorder* tracePointer = options.tracePath.empty() ? nullptr : &trace;
+    
+    // Counters are best-effort: without permission the run goes on uncounted.
+    // Opened before any pool starts, so worker threads inherit them
+    PerfCounters perf(logger);
+    if (options.perf) {
+        perf.open();
+    }
+    PerfCounters* perfPointer = perf.isActive() ? &perf : nullptr;
     
     // Log configuration
     logger.info("Target directory: " + targetDirectory);
     logger.info("Dry-run mode: " + std::string(dryRun ? "true" : "false"));
     logger.info("Large file threshold: " + std::to_string(sizeThresholdMB) + " MB");
     logger.info("Old file threshold: " + std::to_string(ageThresholdDays) + " days");
+    logger.info("Resource limits: " + ResourceLimits::describe());
+    
+    std::cout << "\nScanning directory: " << targetDirectory << '\n';
+    std::cout << "Dry-run mode: " << (dryRun ? "ON" : "OFF") << '\n';
+    std::cout << "Large file threshold: " << sizeThresholdMB << " MB" << '\n';
+    std::cout << "Old file threshold: " << ageThresholdDays << " days" << '\n';
+    
+    // Stats and renames learn how much parallelism each device takes
+    ConcurrencyController ioController(logger);
     
-    std::cout << "\nScanning directory: " << targetDirectory << std::endl;
-    std::cout << "Dry-run mode: " << (dryRun ? "ON" : "OFF") << std::endl;
-    std::cout << "Large file threshold: " << sizeThresholdMB << " MB" << std::endl;
-    std::cout << "Old file threshold: " << ageThresholdDays << " days" << std::endl;
+    ClassifierPlugins plugins(logger);
+    for (const auto& path : options.pluginPaths) {
+        if (!plugins.load(path)) {
+            std::cerr << "Error: Cannot load classifier plugin: " << path << std::endl;
+            return 1;
+        }
+    }
+    KeywordClassifier keywords(logger);
+    if (!options.keywordRulesPath.empty() && !keywords.loadRules(options.keywordRulesPath)) {
+        std::cerr << "Error: Cannot load keyword rules: " << options.keywordRulesPath << std::endl;
+        return 1;
+    }
     
     try {
         // Step 1: Scan Directory
         printSeparator();
-        std::cout << "[SCAN] Scanning files..." << std::endl;
+        std::cout << "[SCAN] Scanning files..." << '\n';
         
         FileScanner scanner(logger);
         scanner.setLargeFileSizeMB(sizeThresholdMB);
         scanner.setOldFileAgeDays(ageThresholdDays);
+        scanner.setProgressReporter(&progress);
+        scanner.setTraceRecorder(tracePointer);
+        scanner.setConcurrencyController(&ioController);
+        
+        progress.beginPhase("SCAN");
+        bool scanned = false;
+        {
+            PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::SCAN);
+            scanned = scanner.scanDirectory(targetDirectory);
+        }
+        progress.endPhase();
         
-        if (!scanner.scanDirectory(targetDirectory)) {
+        if (!scanned) {
             logger.error("Failed to scan directory");
             std::cerr << "Error: Failed to scan directory" << std::endl;
             return 1;
         }
         
         const auto& files = scanner.getFiles();
-        std::cout << "[SCAN] Found " << files.size() << " files" << std::endl;
+        std::cout << "[SCAN] Found " << files.size() << " files" << '\n';
         
         if (files.empty()) {
-            std::cout << "\nNo files to organize. Exiting." << std::endl;
+            std::cout << "\nNo files to organize. Exiting." << '\n';
             return 0;
         }
         
         // Step 2: Classify Files
         printSeparator();
-        std::cout << "[CLASSIFY] Categorizing files..." << std::endl;
+        std::cout << "[CLASSIFY] Categorizing files..." << '\n';
         
+        // Plugin batches and keyword reads get their own pool only when used
+        std::unique_ptr<ThreadPool> classifyPool;
+        if (!plugins.empty() || options.keywords) {
+            classifyPool = std::make_unique<ThreadPool>(static_cast<size_t>(options.threadCount));
+        }
         FileClassifier classifier(logger);
-        classifier.classifyFiles(files);
+        classifier.setPlugins(&plugins, classifyPool.get());
+        classifier.setKeywordClassifier(options.keywords ? &keywords : nullptr);
+        {
+            PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::CLASSIFY);
+            classifier.classifyFiles(files);
+        }
         
         const auto& categorizedFiles = classifier.getCategorizedFiles();
         
         // Display classification results
-        for (const auto& category : getAllCategories()) {
+        for (const auto& category : classifier.getCategoryNames()) {
             auto filesInCategory = classifier.getFilesInCategory(category);
             if (!filesInCategory.empty()) {
                 std::cout << "  " << category << ": " 
-                         << filesInCategory.size() << " files" << std::endl;
+                         << filesInCategory.size() << " files" << '\n';
+            }
+        }
+        
+        // Step 2a: Persisted Index (optional; dry runs leave the directory alone)
+        std::unique_ptr<FileIndex> fileIndex;
+        if (options.index && !dryRun) {
+            fileIndex = std::make_unique<FileIndex>(logger, targetDirectory);
+            long long changes = fileIndex->open() ? fileIndex->syncDirectory(classifier) : -1;
+            if (changes < 0) {
+                std::cerr << "Warning: Index not updated; see the log" << std::endl;
+                fileIndex.reset();
+            } else {
+                std::cout << "[INDEX] " << changes << " changes written ("
+                          << fileIndex->getSegmentCount() << " segments)" << '\n';
             }
         }
         
         // Step 3: Analyze Files (Large & Old)
         printSeparator();
-        displayAnalysis(scanner);
+        {
+            PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::ANALYZE);
+            displayAnalysis(scanner);
+        }
+        
+        // Step 3a: Chunk-Level Duplication in Large Files (optional)
+        if (options.chunkReport) {
+            printSeparator();
+            if (scanner.getLargeFiles().empty()) {
+                std::cout << "[CHUNKS] No large files to chunk" << '\n';
+            } else {
+                ThreadPool pool(static_cast<size_t>(options.threadCount));
+                ChunkAnalyzer chunks(logger, pool);
+                bool chunked = false;
+                {
+                    PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::ANALYZE);
+                    chunked = chunks.analyzeFiles(scanner.getLargeFiles());
+                }
+                if (chunked) {
+                    displayChunkReport(chunks);
+                } else {
+                    std::cout << "[CHUNKS] No large file could be read" << '\n';
+                }
+            }
+        }
+        
+        // Step 3b: Visually Similar Images (optional)
+        if (options.similarImages >= 0) {
+            printSeparator();
+            ThreadPool pool(static_cast<size_t>(options.threadCount));
+            PerceptualHasher hasher(logger, pool);
+            hasher.setMaxDistance(options.similarImages);
+            {
+                PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::ANALYZE);
+                hasher.findSimilar(classifier.getFilesInCategory(CATEGORY_IMAGES));
+            }
+            displaySimilarImages(hasher);
+        }
+        
+        // Reclaimable cache directories below DIRECTORY (optional, report only)
+        if (options.caches) {
+            printSeparator();
+            ThreadPool pool(static_cast<size_t>(options.threadCount));
+            CacheDetector detector(logger, pool);
+            bool searched = false;
+            {
+                PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::ANALYZE);
+                searched = detector.findCaches(targetDirectory);
+            }
+            if (searched) {
+                displayCacheReport(detector);
+            }
+        }
+        
+        // Extensions that fell to Others, over all runs so far (optional)
+        if (options.unknownReport) {
+            printSeparator();
+            std::string sketchPath = options.unknownSketchPath.empty()
+                ? (fs::path(targetDirectory) / UNKNOWN_SKETCH_FILE).string()
+                : options.unknownSketchPath;
+            ExtensionSketch sketch(logger);
+            std::error_code sketchError;
+            if (fs::exists(sketchPath, sketchError) && !sketch.mergeFile(sketchPath)) {
+                std::cerr << "Warning: Starting a new sketch; cannot read " << sketchPath << std::endl;
+            }
+            sketch.addFiles(classifier.getFilesInCategory(CATEGORY_OTHERS));
+            
+            // Saved before other sketches are folded in, so their counts are
+            // never stored twice; a dry run saves nothing, so repeating one
+            // does not count the same files again
+            if (!dryRun && !sketch.save(sketchPath)) {
+                std::cerr << "Warning: Extension sketch not saved; see the log" << std::endl;
+            }
+            for (const auto& path : options.mergeSketchPaths) {
+                if (!sketch.mergeFile(path)) {
+                    std::cerr << "Error: Cannot merge extension sketch: " << path << std::endl;
+                    return 1;
+                }
+            }
+            displayUnknownExtensions(sketch);
+        }
+        
+        auto filesToOrganize = categorizedFiles;
+        
+        // Step 3c: Near-Duplicate Names (optional)
+        if (!options.nearDupes.empty()) {
+            printSeparator();
+            ThreadPool pool(static_cast<size_t>(options.threadCount));
+            NearDuplicateFinder nearDuplicates(logger, pool);
+            nearDuplicates.setRefinement(options.nearRefine);
+            {
+                PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::ANALYZE);
+                nearDuplicates.findClusters(files);
+            }
+            displayNearDuplicates(nearDuplicates);
+            
+            // Resolving files superseded versions under their own folder instead
+            // of their category; the newest member of each cluster stays put
+            if (options.nearDupes == "resolve" && !nearDuplicates.getClusters().empty()) {
+                std::vector<FileInfo> superseded = nearDuplicates.getSuperseded();
+                std::unordered_set<std::string> supersededPaths;
+                for (const auto& file : superseded) {
+                    supersededPaths.insert(file.path.string());
+                }
+                for (auto& [category, categoryFiles] : filesToOrganize) {
+                    categoryFiles.erase(
+                        std::remove_if(categoryFiles.begin(), categoryFiles.end(),
+                                       [&supersededPaths](const FileInfo& file) {
+                                           return supersededPaths.count(file.path.string()) > 0;
+                                       }),
+                        categoryFiles.end());
+                }
+                filesToOrganize[NEAR_DUPLICATES_DIRECTORY] = std::move(superseded);
+                std::cout << "  Superseded versions go to " << NEAR_DUPLICATES_DIRECTORY << "/" << '\n';
+            }
+        }
+        
+        // Step 3d: Cold-Tier Old Files (optional)
+        std::vector<MovedFile> archiveJournal;
+        if (options.coldTier && !scanner.getOldFiles().empty()) {
+            printSeparator();
+            std::cout << "[COLD] " << (dryRun ? "[DRY-RUN] " : "")
+                      << "Compressing old files into " << COLD_DIRECTORY << "/..." << '\n';
+            
+            ColdStorage coldStorage(logger, dryRun, options.threadCount);
+            if (!ColdStorage::isAvailable()) {
+                std::cerr << "Error: Cold tier requires a build with zstd support" << std::endl;
+                return 1;
+            }
+            coldStorage.setProgressReporter(&progress);
+            
+            long long oldBytes = 0;
+            for (const auto& file : scanner.getOldFiles()) {
+                oldBytes += file.sizeBytes;
+            }
+            progress.beginPhase("COLD", static_cast<long long>(scanner.getOldFiles().size()), oldBytes);
+            {
+                PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::MOVE);
+                coldStorage.archiveFiles(targetDirectory, scanner.getOldFiles());
+            }
+            progress.endPhase();
+            
+            std::cout << "  Archived: " << coldStorage.getArchivedFiles().size()
+                      << " (" << coldStorage.getBytesIn() << " -> "
+                      << coldStorage.getBytesOut() << " bytes)" << '\n';
+            std::cout << "  Skipped (incompressible): " << coldStorage.getSkippedCount() << '\n';
+            std::cout << "  Failed: " << coldStorage.getFailCount() << '\n';
+            archiveJournal = coldStorage.getArchiveJournal();
+            
+            // Archived files no longer exist in place, so leave them out of organizing
+            std::unordered_set<std::string> archived;
+            for (const auto& file : coldStorage.getArchivedFiles()) {
+                archived.insert(file.path.string());
+            }
+            for (auto& [category, categoryFiles] : filesToOrganize) {
+                categoryFiles.erase(
+                    std::remove_if(categoryFiles.begin(), categoryFiles.end(),
+                                   [&archived](const FileInfo& file) {
+                                       return archived.count(file.path.string()) > 0;
+                                   }),
+                    categoryFiles.end());
+            }
+        }
         
         // Step 4: Move Files
         printSeparator();
         std::cout << "[ORGANIZE] " << (dryRun ? "[DRY-RUN] " : "") 
-                  << "Organizing files..." << std::endl;
+                  << "Organizing files..." << '\n';
         
+        ThreadPool moverPool(static_cast<size_t>(options.threadCount));
         FileMover mover(logger, dryRun);
+        mover.setProgressReporter(&progress);
+        mover.setTraceRecorder(tracePointer);
+        mover.setThreadPool(&moverPool);
+        mover.setParanoid(options.paranoid);
+        mover.setConcurrencyController(&ioController);
+        
+        long long organizeCount = 0;
+        long long organizeBytes = 0;
+        for (const auto& [category, categoryFiles] : filesToOrganize) {
+            organizeCount += static_cast<long long>(categoryFiles.size());
+            for (const auto& file : categoryFiles) {
+                organizeBytes += file.sizeBytes;
+            }
+        }
+        
+        // A time budget moves the most valuable files first and may stop early
+        WorkPlanner planner(logger, scanner);
+        std::vector<PlannedMove> plan;
+        if (options.timeBudgetMinutes > 0) {
+            planner.loadState(targetDirectory);
+            plan = planner.buildPlan(filesToOrganize);
+        }
         
-        if (!mover.organizeFiles(targetDirectory, categorizedFiles)) {
+        progress.beginPhase("ORGANIZE", organizeCount, organizeBytes);
+        bool organized = false;
+        {
+            PerfCounters::ScopedPhase phase(perfPointer, PerfPhase::MOVE);
+            if (options.timeBudgetMinutes > 0) {
+                auto deadline = runStarted + std::chrono::minutes(options.timeBudgetMinutes);
+                organized = mover.organizePlanned(targetDirectory, plan, deadline);
+            } else {
+                organized = mover.organizeFiles(targetDirectory, filesToOrganize);
+            }
+        }
+        progress.endPhase();
+        
+        if (organized && options.timeBudgetMinutes > 0) {
+            displayPlanOutcome(planner, plan, mover);
+            if (!dryRun) {
+                if (mover.getAttemptedCount() < plan.size() || !mover.getFailedPaths().empty()) {
+                    planner.saveState(targetDirectory, plan, mover.getAttemptedCount(),
+                                      mover.getFailedPaths());
+                } else {
+                    planner.clearState(targetDirectory);
+                }
+            }
+        }
+        
+        if (!organized) {
             logger.error("File organization failed");
             std::cerr << "Error: File organization failed" << std::endl;
             return 1;
         }
         
+        // The journals bring the index up to date without rescanning: moved
+        // files under their new names, archived ones as their archives
+        if (fileIndex) {
+            std::vector<MovedFile> journal = mover.getMoveJournal();
+            journal.insert(journal.end(), archiveJournal.begin(), archiveJournal.end());
+            if (fileIndex->applyMoves(journal)) {
+                std::cout << "[INDEX] " << mover.getMoveJournal().size() << " moves and "
+                          << archiveJournal.size() << " archives applied ("
+                          << fileIndex->getSegmentCount() << " segments)" << '\n';
+            } else {
+                std::cerr << "Warning: Moves not recorded in the index; see the log" << std::endl;
+            }
+        }
+        
         // Step 5: Display Summary
         printSeparator();
-        std::cout << "\n✓ Operation completed successfully!\n" << std::endl;
+        std::cout << "\n✓ Operation completed successfully!\n" << '\n';
+        
+        std::cout << "Summary:" << '\n';
+        std::cout << "  Total files: " << files.size() << '\n';
+        std::cout << "  Successfully moved: " << mover.getSuccessCount() << '\n';
+        std::cout << "  Failed: " << mover.getFailCount() << '\n';
+        std::cout << "  Warnings: " << mover.getWarningCount() << '\n';
         
-        std::cout << "Summary:" << std::endl;
-        std::cout << "  Total files: " << files.size() << std::endl;
-        std::cout << "  Successfully moved: " << mover.getSuccessCount() << std::endl;
-        std::cout << "  Failed: " << mover.getFailCount() << std::endl;
-        std::cout << "  Warnings: " << mover.getWarningCount() << std::endl;
+        ioController.logSummary();
+        if (options.verbose) {
+            for (const auto& device : ioController.getStats()) {
+                std::cout << "  I/O in flight on device " << device.device << ": "
+                          << device.limit << " (peak " << device.peakLimit << ")" << '\n';
+            }
+        }
+        
+        if (tracePointer) {
+            trace.close();
+            std::cout << "  Traced operations: " << trace.getRecordCount()
+                      << " (" << trace.getTracePath() << ")" << '\n';
+        }
+        
+        if (options.perf) {
+            std::cout << '\n';
+            perf.report(std::cout);
+        }
         
-        std::cout << "\nLog file: " << logger.getLogFilePath() << std::endl;
+        std::cout << "\nLog file: " << logger.getLogFilePath() << '\n';
         
         printSeparator();
         
@@ -158,7 +605,7 @@ int main(int argc, char* argv[]) {
 //------------------------------------------------------------------------------
 void printHeader() {
     printSeparator();
-    std::cout << "  " << APP_NAME << " v" << APP_VERSION << std::endl;
+    std::cout << "  " << APP_NAME << " v" << APP_VERSION << '\n';
     printSeparator();
 }
 
@@ -166,31 +613,66 @@ void printHeader() {
 // Print Usage Information
 //------------------------------------------------------------------------------
 void printUsage() {
-    std::cout << "Usage: desktop_cleaner [OPTIONS] [DIRECTORY]\n" << std::endl;
-    std::cout << "Options:" << std::endl;
-    std::cout << "  --dry-run           Preview actions without moving files" << std::endl;
-    std::cout << "  --size=<MB>         Large file threshold in MB (default: 100)" << std::endl;
-    std::cout << "  --age=<DAYS>        Old file threshold in days (default: 90)" << std::endl;
-    std::cout << "  --help              Display this help message" << std::endl;
-    std::cout << "\nExamples:" << std::endl;
-    std::cout << "  desktop_cleaner --dry-run ~/Desktop" << std::endl;
-    std::cout << "  desktop_cleaner --size=50 --age=30 /path/to/folder" << std::endl;
-    std::cout << "  desktop_cleaner C:\\Users\\YourName\\Desktop" << std::endl;
+    std::cout << "Usage: desktop_cleaner [OPTIONS] [DIRECTORY]\n" << '\n';
+    std::cout << "Options:" << '\n';
+    std::cout << "  --dry-run           Preview actions without moving files" << '\n';
+    std::cout << "  --size=<MB>         Large file threshold in MB (default: 100)" << '\n';
+    std::cout << "  --age=<DAYS>        Old file threshold in days (default: 90)" << '\n';
+    std::cout << "  --cold              Compress old files into Cold/ instead of moving them" << '\n';
+    std::cout << "  --restore=<FILE>    Restore a Cold/ archive next to its Cold/ folder" << '\n';
+    std::cout << "  --threads=<N>       Worker threads (default: CPUs the container allows)" << '\n';
+    std::cout << "  --verbose           Print every file operation to the console" << '\n';
+    std::cout << "  --progress-rate=<N> Status line redraws per second, 0 = off (default: 4)" << '\n';
+    std::cout << "  --isa=<LEVEL>       Force kernels: scalar, sse42, avx2 or avx512" << '\n';
+    std::cout << "  --isa-selftest      Check and time every kernel variant, then exit" << '\n';
+    std::cout << "  --daemon            Re-index DIRECTORY periodically into shared memory (no moves)" << '\n';
+    std::cout << "  --interval=<SEC>    Seconds between daemon passes (default: 60)" << '\n';
+    std::cout << "  --shm-name=<NAME>   Shared-memory segment name (default: derived from DIRECTORY)" << '\n';
+    std::cout << "  --query=<FILE>      Print category and duplicate status from the daemon or --index" << '\n';
+    std::cout << "  --whereis=<FILE>    Show where earlier runs moved FILE (from logs/ indices)" << '\n';
+    std::cout << "  --serve             With --daemon, accept jobs on the Unix socket" << '\n';
+    std::cout << "  --watch             With --daemon, keep live totals from change events (stats job)" << '\n';
+    std::cout << "  --socket=<PATH>     Job service socket (default: $XDG_RUNTIME_DIR/smartcleaner.sock," << '\n';
+    std::cout << "                      or /run/smartcleaner/smartcleaner.sock for root)" << '\n';
+    std::cout << "  --submit=<JOB>      Send scan, organize, dedupe, query or stats to the service" << '\n';
+    std::cout << "  --priority=<0-9>    Priority among your own submitted jobs (default: 5)" << '\n';
+    std::cout << "  --trace=<FILE>      Record an anonymized trace of filesystem operations" << '\n';
+    std::cout << "  --perf              Report hardware counters per phase (Linux perf_event)" << '\n';
+    std::cout << "  --near-dupes[=MODE] Cluster near-duplicate names: report (default) or resolve" << '\n';
+    std::cout << "  --near-refine=<R>   Confirm clusters by none, size or content (resolve: content)" << '\n';
+    std::cout << "  --chunk-report      Measure chunk-level dedupe potential of large files" << '\n';
+    std::cout << "  --caches            Rank cache directories below DIRECTORY (node_modules, ...)" << '\n';
+    std::cout << "  --unknown-report    Top extensions that fell to Others, over all runs" << '\n';
+    std::cout << "  --merge-sketch=<F>  Add another run's or host's sketch to that report" << '\n';
+    std::cout << "  --similar-images[=N] Group visually similar images within N bits (default: 8)" << '\n';
+    std::cout << "  --paranoid          Re-read cross-device copies from disk before unlinking" << '\n';
+    std::cout << "  --time-budget=<MIN> Move the most valuable files first; stop after MIN minutes" << '\n';
+    std::cout << "  --plugin=<LIB>      Load a classifier plugin (repeatable; first loaded wins)" << '\n';
+    std::cout << "  --keywords[=RULES]  Route invoices, contracts, payslips out of Documents by content" << '\n';
+    std::cout << "  --index             Keep a persisted index of the directory (updated by churn)" << '\n';
+    std::cout << "  --help              Display this help message" << '\n';
+    std::cout << "\nExamples:" << '\n';
+    std::cout << "  desktop_cleaner --dry-run ~/Desktop" << '\n';
+    std::cout << "  desktop_cleaner --size=50 --age=30 /path/to/folder" << '\n';
+    std::cout << "  desktop_cleaner --cold --age=365 ~/Desktop" << '\n';
+    std::cout << "  desktop_cleaner --daemon --interval=30 ~/Desktop" << '\n';
+    std::cout << "  desktop_cleaner --query=~/Desktop/report.pdf" << '\n';
+    std::cout << "  desktop_cleaner --submit=organize --priority=7 /srv/shared/inbox" << '\n';
+    std::cout << "  desktop_cleaner C:\\Users\\YourName\\Desktop" << '\n';
 }
 
 //------------------------------------------------------------------------------
 // Print Separator Line
 //------------------------------------------------------------------------------
 void printSeparator() {
-    std::cout << CONSOLE_SEPARATOR << std::endl;
+    std::cout << CONSOLE_SEPARATOR << '\n';
 }
 
 //------------------------------------------------------------------------------
 // Parse Command-Line Arguments
 //------------------------------------------------------------------------------
-bool parseArguments(int argc, char* argv[], std::string& directory, 
-                   bool& dryRun, long long& sizeThreshold, int& ageThreshold) {
-    directory = "";
+bool parseArguments(int argc, char* argv[], CommandLineOptions& options) {
+    options.directory = "";
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -200,12 +682,12 @@ bool parseArguments(int argc, char* argv[], std::string& directory,
             return false;
         }
         else if (arg == "--dry-run") {
-            dryRun = true;
+            options.dryRun = true;
         }
         else if (arg.find("--size=") == 0) {
             try {
-                sizeThreshold = std::stoll(arg.substr(7));
-                if (sizeThreshold <= 0) {
+                options.sizeThresholdMB = std::stoll(arg.substr(7));
+                if (options.sizeThresholdMB <= 0) {
                     std::cerr << "Error: Size threshold must be positive" << std::endl;
                     return false;
                 }
@@ -216,8 +698,8 @@ bool parseArguments(int argc, char* argv[], std::string& directory,
         }
         else if (arg.find("--age=") == 0) {
             try {
-                ageThreshold = std::stoi(arg.substr(6));
-                if (ageThreshold <= 0) {
+                options.ageThresholdDays = std::stoi(arg.substr(6));
+                if (options.ageThresholdDays <= 0) {
                     std::cerr << "Error: Age threshold must be positive" << std::endl;
                     return false;
                 }
@@ -226,6 +708,188 @@ bool parseArguments(int argc, char* argv[], std::string& directory,
                 return false;
             }
         }
+        else if (arg == "--cold") {
+            options.coldTier = true;
+        }
+        else if (arg.find("--restore=") == 0) {
+            options.restorePath = arg.substr(10);
+        }
+        else if (arg == "--verbose" || arg == "-v") {
+            options.verbose = true;
+        }
+        else if (arg.find("--progress-rate=") == 0) {
+            try {
+                options.progressRate = std::stoi(arg.substr(16));
+                if (options.progressRate < 0) {
+                    std::cerr << "Error: Progress rate cannot be negative" << std::endl;
+                    return false;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid progress rate: " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg.find("--isa=") == 0) {
+            options.isa = arg.substr(6);
+        }
+        else if (arg == "--isa-selftest") {
+            options.isaSelfTest = true;
+        }
+        else if (arg.find("--threads=") == 0) {
+            try {
+                options.threadCount = std::stoi(arg.substr(10));
+                if (options.threadCount < 0) {
+                    std::cerr << "Error: Thread count cannot be negative" << std::endl;
+                    return false;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid thread count: " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--daemon") {
+            options.daemon = true;
+        }
+        else if (arg.find("--interval=") == 0) {
+            try {
+                options.daemonInterval = std::stoi(arg.substr(11));
+                if (options.daemonInterval <= 0) {
+                    std::cerr << "Error: Interval must be positive" << std::endl;
+                    return false;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid interval: " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg.find("--shm-name=") == 0) {
+            options.shmName = arg.substr(11);
+            if (options.shmName.empty() || options.shmName[0] != '/') {
+                options.shmName = "/" + options.shmName;
+            }
+        }
+        else if (arg.find("--whereis=") == 0) {
+            options.whereisPath = arg.substr(10);
+        }
+        else if (arg.find("--query=") == 0) {
+            options.queryPath = arg.substr(8);
+        }
+        else if (arg == "--near-dupes" || arg.find("--near-dupes=") == 0) {
+            options.nearDupes = arg == "--near-dupes" ? "report" : arg.substr(13);
+            if (options.nearDupes != "report" && options.nearDupes != "resolve") {
+                std::cerr << "Error: Near-duplicate mode must be report or resolve" << std::endl;
+                return false;
+            }
+        }
+        else if (arg.find("--near-refine=") == 0) {
+            if (!NearDuplicateFinder::parseRefinement(arg.substr(14), options.nearRefine)) {
+                std::cerr << "Error: Near-duplicate refinement must be none, size or content" << std::endl;
+                return false;
+            }
+            options.nearRefineSet = true;
+        }
+        else if (arg == "--caches") {
+            options.caches = true;
+        }
+        else if (arg == "--unknown-report") {
+            options.unknownReport = true;
+        }
+        else if (arg.find("--unknown-report=") == 0) {
+            options.unknownReport = true;
+            options.unknownSketchPath = arg.substr(17);
+        }
+        else if (arg.find("--merge-sketch=") == 0) {
+            options.unknownReport = true;
+            options.mergeSketchPaths.push_back(arg.substr(15));
+        }
+        else if (arg == "--chunk-report") {
+            options.chunkReport = true;
+        }
+        else if (arg == "--similar-images" || arg.find("--similar-images=") == 0) {
+            options.similarImages = PHASH_DEFAULT_MAX_DISTANCE;
+            if (arg != "--similar-images") {
+                try {
+                    options.similarImages = std::stoi(arg.substr(17));
+                } catch (const std::exception& e) {
+                    options.similarImages = -1;
+                }
+                if (options.similarImages < 0 || options.similarImages > PHASH_MAX_DISTANCE_LIMIT) {
+                    std::cerr << "Error: Similar-image distance must be 0-" << PHASH_MAX_DISTANCE_LIMIT << std::endl;
+                    return false;
+                }
+            }
+        }
+        else if (arg.find("--time-budget=") == 0) {
+            try {
+                options.timeBudgetMinutes = std::stoi(arg.substr(14));
+                if (options.timeBudgetMinutes < 1 || options.timeBudgetMinutes > MAX_TIME_BUDGET_MINUTES) {
+                    std::cerr << "Error: Time budget must be 1-" << MAX_TIME_BUDGET_MINUTES << " minutes" << std::endl;
+                    return false;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid time budget: " << arg << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "--paranoid") {
+            options.paranoid = true;
+        }
+        else if (arg.find("--plugin=") == 0) {
+            if (arg.size() == 9) {
+                std::cerr << "Error: --plugin needs a library path" << std::endl;
+                return false;
+            }
+            options.pluginPaths.push_back(arg.substr(9));
+        }
+        else if (arg == "--index") {
+            options.index = true;
+        }
+        else if (arg == "--keywords") {
+            options.keywords = true;
+        }
+        else if (arg.find("--keywords=") == 0) {
+            if (arg.size() == 11) {
+                std::cerr << "Error: --keywords= needs a rules file" << std::endl;
+                return false;
+            }
+            options.keywords = true;
+            options.keywordRulesPath = arg.substr(11);
+        }
+        else if (arg == "--perf") {
+            options.perf = true;
+        }
+        else if (arg.find("--trace=") == 0) {
+            options.tracePath = arg.substr(8);
+        }
+        else if (arg == "--serve") {
+            options.serve = true;
+        }
+        else if (arg == "--watch") {
+            options.watch = true;
+        }
+        else if (arg.find("--socket=") == 0) {
+            options.socketPath = arg.substr(9);
+        }
+        else if (arg.find("--submit=") == 0) {
+            options.submitType = arg.substr(9);
+            JobType type;
+            if (!JobService::parseJobType(options.submitType, type)) {
+                std::cerr << "Error: Unknown job type: " << options.submitType << std::endl;
+                return false;
+            }
+        }
+        else if (arg.find("--priority=") == 0) {
+            try {
+                options.priority = std::stoi(arg.substr(11));
+                if (options.priority < 0 || options.priority > MAX_JOB_PRIORITY) {
+                    std::cerr << "Error: Priority must be 0-" << MAX_JOB_PRIORITY << std::endl;
+                    return false;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Invalid priority: " << arg << std::endl;
+                return false;
+            }
+        }
         else if (arg[0] == '-') {
             std::cerr << "Error: Unknown option: " << arg << std::endl;
             std::cerr << "Use --help for usage information" << std::endl;
@@ -233,7 +897,18 @@ bool parseArguments(int argc, char* argv[], std::string& directory,
         }
         else {
             // Assume it's a directory path
-            directory = arg;
+            options.directory = arg;
+        }
+    }
+    
+    // Resolve moves files, and similar names alone also match series such as
+    // "Track 01".."Track 12": it confirms clusters by content unless told size
+    if (options.nearDupes == "resolve") {
+        if (!options.nearRefineSet) {
+            options.nearRefine = NearDuplicateRefine::CONTENT;
+        } else if (options.nearRefine == NearDuplicateRefine::NONE) {
+            std::cerr << "Error: --near-dupes=resolve needs --near-refine=size or content" << std::endl;
+            return false;
         }
     }
     
@@ -247,28 +922,32 @@ void displayAnalysis(const FileScanner& scanner) {
     const auto& largeFiles = scanner.getLargeFiles();
     const auto& oldFiles = scanner.getOldFiles();
     
-    std::cout << "[ANALYZE] File analysis:" << std::endl;
+    std::cout << "[ANALYZE] File analysis:" << '\n';
     
     // Display large files
     if (!largeFiles.empty()) {
-        std::cout << "  Large files (" << largeFiles.size() << "):" << std::endl;
+        std::cout << "  Large files (" << largeFiles.size() << "):" << '\n';
         for (size_t i = 0; i < std::min(size_t(5), largeFiles.size()); ++i) {
             const auto& file = largeFiles[i];
-            double sizeMB = static_cast<double>(file.sizeBytes) / (1024.0 * 1024.0);
+            double sizeMB = static_cast<double>(file.allocatedBytes) / (1024.0 * 1024.0);
             std::cout << "    - " << file.name << " (" 
-                     << std::fixed << std::setprecision(1) << sizeMB << " MB)" 
-                     << std::endl;
+                     << std::fixed << std::setprecision(1) << sizeMB << " MB";
+            if (file.allocatedBytes < file.sizeBytes / 2) {
+                std::cout << " on disk, sparse: "
+                          << static_cast<double>(file.sizeBytes) / (1024.0 * 1024.0) << " MB apparent";
+            }
+            std::cout << ")" << '\n';
         }
         if (largeFiles.size() > 5) {
-            std::cout << "    ... and " << (largeFiles.size() - 5) << " more" << std::endl;
+            std::cout << "    ... and " << (largeFiles.size() - 5) << " more" << '\n';
         }
     } else {
-        std::cout << "  No large files detected" << std::endl;
+        std::cout << "  No large files detected" << '\n';
     }
     
     // Display old files
     if (!oldFiles.empty()) {
-        std::cout << "  Old files (" << oldFiles.size() << "):" << std::endl;
+        std::cout << "  Old files (" << oldFiles.size() << "):" << '\n';
         for (size_t i = 0; i < std::min(size_t(5), oldFiles.size()); ++i) {
             const auto& file = oldFiles[i];
             auto now = std::chrono::system_clock::now();
@@ -276,12 +955,589 @@ void displayAnalysis(const FileScanner& scanner) {
             int ageDays = static_cast<int>((nowTimeT - file.lastModified) / (60 * 60 * 24));
             
             std::cout << "    - " << file.name << " (" 
-                     << ageDays << " days old)" << std::endl;
+                     << ageDays << " days old)" << '\n';
         }
         if (oldFiles.size() > 5) {
-            std::cout << "    ... and " << (oldFiles.size() - 5) << " more" << std::endl;
+            std::cout << "    ... and " << (oldFiles.size() - 5) << " more" << '\n';
         }
     } else {
-        std::cout << "  No old files detected" << std::endl;
+        std::cout << "  No old files detected" << '\n';
+    }
+}
+
+//------------------------------------------------------------------------------
+// Display Near-Duplicate Clusters
+//------------------------------------------------------------------------------
+void displayNearDuplicates(const NearDuplicateFinder& nearDuplicates) {
+    const auto& clusters = nearDuplicates.getClusters();
+    
+    std::cout << "[NEAR-DUPES] " << clusters.size() << " clusters of similarly named files" << '\n';
+    for (size_t i = 0; i < std::min(NEAR_DUPE_MAX_LISTED, clusters.size()); ++i) {
+        const auto& cluster = clusters[i];
+        std::cout << "  " << cluster.files[0].name << " (" << cluster.files.size() << " versions)" << '\n';
+        for (size_t j = 1; j < cluster.files.size(); ++j) {
+            std::cout << "    - " << cluster.files[j].name << '\n';
+        }
+    }
+    if (clusters.size() > NEAR_DUPE_MAX_LISTED) {
+        std::cout << "  ... and " << (clusters.size() - NEAR_DUPE_MAX_LISTED) << " more" << '\n';
+    }
+    
+    double supersededMB = static_cast<double>(nearDuplicates.getSupersededBytes()) / (1024.0 * 1024.0);
+    std::cout << "  Older versions: " << std::fixed << std::setprecision(1)
+              << supersededMB << " MB" << '\n';
+}
+
+//------------------------------------------------------------------------------
+// Display Chunk-Level Dedupe Potential
+//------------------------------------------------------------------------------
+void displayChunkReport(const ChunkAnalyzer& chunks) {
+    const double mb = 1024.0 * 1024.0;
+    const auto& files = chunks.getFiles();
+    const auto& pairs = chunks.getPairs();
+    long long total = chunks.getTotalBytes();
+    long long saved = total - chunks.getUniqueBytes();
+    
+    std::cout << "[CHUNKS] Content-defined chunking of " << files.size() << " large files" << '\n';
+    std::cout << "  Chunks: " << chunks.getChunkCount() << " ("
+              << chunks.getUniqueChunkCount() << " unique)" << '\n';
+    std::cout << std::fixed << std::setprecision(1)
+              << "  Block-level dedupe would save " << saved / mb << " of " << total / mb
+              << " MB (" << (total > 0 ? 100.0 * saved / total : 0.0) << "%)" << '\n';
+    
+    if (!pairs.empty()) {
+        std::cout << "  Most shared file pairs:" << '\n';
+        for (size_t i = 0; i < std::min(CDC_MAX_LISTED_PAIRS, pairs.size()); ++i) {
+            const auto& first = files[pairs[i].first].file;
+            const auto& second = files[pairs[i].second].file;
+            long long smaller = std::min(first.sizeBytes, second.sizeBytes);
+            std::cout << "    - " << first.name << " <-> " << second.name << ": "
+                      << pairs[i].sharedBytes / mb << " MB shared ("
+                      << (smaller > 0 ? 100.0 * pairs[i].sharedBytes / smaller : 0.0)
+                      << "% of the smaller)" << '\n';
+        }
+        if (pairs.size() > CDC_MAX_LISTED_PAIRS) {
+            std::cout << "    ... and " << (pairs.size() - CDC_MAX_LISTED_PAIRS) << " more" << '\n';
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Display Reclaimable Cache Directories
+//------------------------------------------------------------------------------
+void displayCacheReport(const CacheDetector& detector) {
+    const double mb = 1024.0 * 1024.0;
+    const auto& caches = detector.getCaches();
+    
+    std::cout << "[CACHES] Searched " << detector.getDirectoriesSearched() << " directories" << '\n';
+    if (caches.empty()) {
+        std::cout << "  No cache directories found" << '\n';
+        return;
+    }
+    
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << caches.size() << " cache directories hold "
+              << detector.getTotalAllocatedBytes() / mb << " MB on disk" << '\n';
+    std::cout << "  Ranked by size x days since last change:" << '\n';
+    std::time_t now = std::time(nullptr);
+    for (size_t i = 0; i < std::min(CACHE_MAX_LISTED, caches.size()); ++i) {
+        const auto& cache = caches[i];
+        long long idleDays = std::max<long long>(0, (now - cache.newestModified) / (60 * 60 * 24));
+        std::cout << "    " << (i + 1) << ". " << cache.path << " [" << cache.kind << "]: "
+                  << cache.allocatedBytes / mb << " MB, " << cache.fileCount << " files, idle "
+                  << idleDays << " days" << '\n';
+    }
+    if (caches.size() > CACHE_MAX_LISTED) {
+        std::cout << "    ... and " << (caches.size() - CACHE_MAX_LISTED) << " more" << '\n';
+    }
+}
+
+//------------------------------------------------------------------------------
+// Display Extensions That Fell to Others
+// Estimates may overcount by their error, never undercount
+//------------------------------------------------------------------------------
+void displayUnknownExtensions(const ExtensionSketch& sketch) {
+    const double mb = 1024.0 * 1024.0;
+    long long totalFiles = sketch.getTotalFiles();
+    long long totalBytes = sketch.getTotalBytes();
+    
+    std::cout << std::fixed << std::setprecision(1)
+              << "[UNKNOWN] " << totalFiles << " files (" << totalBytes / mb
+              << " MB) have fallen to Others" << '\n';
+    if (totalFiles == 0) {
+        return;
+    }
+    
+    auto label = [](const ExtensionEstimate& estimate) {
+        return estimate.extension.empty() ? std::string("(none)") : estimate.extension;
+    };
+    std::cout << "  Most files:" << '\n';
+    for (const auto& estimate : sketch.topByFiles(UNKNOWN_MAX_LISTED)) {
+        std::cout << "    " << label(estimate) << ": " << (estimate.error > 0 ? "~" : "")
+                  << estimate.weight << " files (" << 100.0 * estimate.weight / totalFiles << "%";
+        if (estimate.error > 0) {
+            std::cout << ", error <= " << estimate.error;
+        }
+        std::cout << ")" << '\n';
+    }
+    if (totalBytes > 0) {
+        std::cout << "  Most bytes:" << '\n';
+        for (const auto& estimate : sketch.topByBytes(UNKNOWN_MAX_LISTED)) {
+            std::cout << "    " << label(estimate) << ": " << (estimate.error > 0 ? "~" : "")
+                      << estimate.weight / mb << " MB (" << 100.0 * estimate.weight / totalBytes << "%";
+            if (estimate.error > 0) {
+                std::cout << ", error <= " << estimate.error / mb << " MB";
+            }
+            std::cout << ")" << '\n';
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// Display Groups of Visually Similar Images
+//------------------------------------------------------------------------------
+void displaySimilarImages(const PerceptualHasher& hasher) {
+    const auto& groups = hasher.getGroups();
+    
+    std::cout << "[IMAGES] Hashed " << hasher.getHashedCount() << " images";
+    if (hasher.getSkippedCount() > 0) {
+        std::cout << " (" << hasher.getSkippedCount() << " unsupported or unreadable)";
+    }
+    std::cout << '\n';
+    if (groups.empty()) {
+        std::cout << "  No visually similar images found" << '\n';
+        return;
+    }
+    
+    std::cout << "  " << groups.size() << " groups of similar images:" << '\n';
+    for (size_t i = 0; i < std::min(PHASH_MAX_LISTED, groups.size()); ++i) {
+        const auto& keeper = groups[i].images[0];
+        std::cout << "    Keep " << keeper.file.name << " (" << keeper.width << "x"
+                  << keeper.height << ")" << '\n';
+        for (size_t j = 1; j < groups[i].images.size(); ++j) {
+            const auto& image = groups[i].images[j];
+            std::cout << "      ~ " << image.file.name << " (" << image.width << "x"
+                      << image.height << ", " << PerceptualHasher::distance(keeper.hash, image.hash)
+                      << " bits apart)" << '\n';
+        }
+    }
+    if (groups.size() > PHASH_MAX_LISTED) {
+        std::cout << "    ... and " << (groups.size() - PHASH_MAX_LISTED) << " more groups" << '\n';
+    }
+}
+
+//------------------------------------------------------------------------------
+// Display Time-Budgeted Run Outcome
+//------------------------------------------------------------------------------
+void displayPlanOutcome(const WorkPlanner& planner, const std::vector<PlannedMove>& plan,
+                        const FileMover& mover) {
+    const double mb = 1024.0 * 1024.0;
+    std::size_t attempted = mover.getAttemptedCount();
+    long long doneBytes = 0;
+    long long leftBytes = 0;
+    long long tierDone[4] = {};
+    long long tierTotal[4] = {};
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        (i < attempted ? doneBytes : leftBytes) += plan[i].file.allocatedBytes;
+        tierTotal[plan[i].tier]++;
+        if (i < attempted) {
+            tierDone[plan[i].tier]++;
+        }
+    }
+    
+    std::cout << "[PLAN] " << (mover.stoppedAtDeadline() ? "Time budget reached: " : "Plan finished: ")
+              << attempted << " of " << plan.size() << " moves done ("
+              << std::fixed << std::setprecision(1) << doneBytes / mb << " MB)";
+    if (!mover.getFailedPaths().empty()) {
+        std::cout << ", " << mover.getFailedPaths().size() << " failed (retried last next window)";
+    }
+    std::cout << '\n';
+    for (int tier = 0; tier < 4; ++tier) {
+        if (tierTotal[tier] > 0) {
+            std::cout << "  " << WorkPlanner::tierName(tier) << ": " << tierDone[tier]
+                      << " / " << tierTotal[tier] << '\n';
+        }
+    }
+    if (planner.getWindowCount() > 0) {
+        std::cout << "  Earlier windows: " << planner.getWindowCount() << " ("
+                  << planner.getPreviousMovedFiles() << " files, "
+                  << planner.getPreviousMovedBytes() / mb << " MB moved)" << '\n';
+    }
+    if (attempted < plan.size()) {
+        std::cout << "  Left for the next window: " << (plan.size() - attempted) << " files ("
+                  << leftBytes / mb << " MB); state in " << PLAN_STATE_FILE << '\n';
+    }
+}
+
+//------------------------------------------------------------------------------
+// Restore a Cold-Tier Archive
+// Defaults to the directory that holds the archive's Cold/ folder
+//------------------------------------------------------------------------------
+int runRestore(const CommandLineOptions& options) {
+    fs::path archive(options.restorePath);
+    std::string targetDirectory = options.directory;
+    
+    if (targetDirectory.empty()) {
+        targetDirectory = archive.parent_path().parent_path().string();
+        if (targetDirectory.empty()) {
+            targetDirectory = fs::current_path().string();
+        }
+    }
+    
+    if (!fs::exists(archive)) {
+        std::cerr << "Error: Archive does not exist: " << options.restorePath << std::endl;
+        return 1;
+    }
+    
+    printHeader();
+    
+    Logger logger;
+    ColdStorage coldStorage(logger, options.dryRun, 1);
+    
+    std::cout << "\n[RESTORE] " << archive.filename().string() 
+              << " → " << targetDirectory << '\n';
+    
+    if (!coldStorage.restoreFile(archive.string(), targetDirectory)) {
+        std::cerr << "Error: Restore failed" << std::endl;
+        return 1;
+    }
+    
+    std::cout << "\nLog file: " << logger.getLogFilePath() << '\n';
+    printSeparator();
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// Daemon Mode
+// Scans, classifies and hashes duplicates every interval, then publishes the
+// result to shared memory for --query and libsmartcleaner clients. Never moves
+// files.
+//------------------------------------------------------------------------------
+void handleStopSignal(int) {
+    g_stopRequested = 1;
+}
+
+int runDaemon(CommandLineOptions& options) {
+    std::string& targetDirectory = options.directory;
+    if (targetDirectory.empty()) {
+        targetDirectory = fs::current_path().string();
+    }
+    if (!fs::exists(targetDirectory)) {
+        std::cerr << "Error: Directory does not exist: " << targetDirectory << std::endl;
+        return 1;
+    }
+    
+    targetDirectory = ContentHasher::normalizePath(targetDirectory);
+    if (options.shmName.empty()) {
+        options.shmName = SharedFileTable::defaultName(targetDirectory);
     }
+    
+    printHeader();
+    
+    Logger logger;
+    logger.setVerboseConsole(options.verbose);
+    logger.info("Daemon mode: " + targetDirectory + " -> " + options.shmName +
+                " every " + std::to_string(options.daemonInterval) + "s");
+    logger.info("Resource limits: " + ResourceLimits::describe());
+    
+    ThreadPool pool(static_cast<size_t>(options.threadCount));
+    ConcurrencyController ioController(logger);
+    FileScanner scanner(logger);
+    scanner.setLargeFileSizeMB(options.sizeThresholdMB);
+    scanner.setOldFileAgeDays(options.ageThresholdDays);
+    scanner.setConcurrencyController(&ioController);
+    ClassifierPlugins plugins(logger);
+    for (const auto& path : options.pluginPaths) {
+        if (!plugins.load(path)) {
+            std::cerr << "Error: Cannot load classifier plugin: " << path << std::endl;
+            return 1;
+        }
+    }
+    KeywordClassifier keywords(logger);
+    if (!options.keywordRulesPath.empty() && !keywords.loadRules(options.keywordRulesPath)) {
+        std::cerr << "Error: Cannot load keyword rules: " << options.keywordRulesPath << std::endl;
+        return 1;
+    }
+    FileClassifier classifier(logger);
+    classifier.setPlugins(&plugins, &pool);
+    classifier.setKeywordClassifier(options.keywords ? &keywords : nullptr);
+    DuplicateFinder duplicates(logger, pool);
+    
+    std::unique_ptr<FileIndex> fileIndex;
+    if (options.index) {
+        fileIndex = std::make_unique<FileIndex>(logger, targetDirectory);
+        if (!fileIndex->open()) {
+            std::cerr << "Error: Cannot open index in " << fileIndex->getDirectory() << std::endl;
+            return 1;
+        }
+    }
+    
+    // Watch mode: events reclassify just the files they name, with a
+    // classifier of their own so the last full pass stays intact
+    DirectoryWatcher watcher(logger);
+    LiveStats liveStats(targetDirectory, options.ageThresholdDays);
+    FileClassifier eventClassifier(logger);
+    eventClassifier.setPlugins(&plugins, &pool);
+    eventClassifier.setKeywordClassifier(options.keywords ? &keywords : nullptr);
+    if (options.watch && !watcher.start(targetDirectory)) {
+        std::cout << "[DAEMON] Change events unavailable; live totals follow the passes" << std::endl;
+    }
+    
+    SharedFileTable table(logger, options.shmName);
+    if (!table.create()) {
+        std::cerr << "Error: Cannot create shared memory " << options.shmName << std::endl;
+        return 1;
+    }
+    
+    JobService service(logger, pool, options.socketPath);
+    service.setLargeFileSizeMB(options.sizeThresholdMB);
+    service.setOldFileAgeDays(options.ageThresholdDays);
+    service.setLiveStats(options.watch ? &liveStats : nullptr);
+    if (options.serve && !service.start()) {
+        std::cerr << "Error: Cannot start job service on " << service.getSocketPath() << std::endl;
+        return 1;
+    }
+    
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+    
+    std::cout << "\n[DAEMON] Indexing " << targetDirectory << " into " << options.shmName
+              << " every " << options.daemonInterval << "s (Ctrl+C to stop)" << std::endl;
+    if (options.serve) {
+        std::cout << "[DAEMON] Accepting jobs on " << service.getSocketPath() << std::endl;
+    }
+    
+    while (!g_stopRequested) {
+        auto passStart = std::chrono::steady_clock::now();
+        
+        // A container's quota can be changed while the daemon runs
+        if (ResourceLimits::refresh()) {
+            logger.info("Resource limits changed: " + ResourceLimits::describe());
+            std::cout << "[DAEMON] Resource limits now " << ResourceLimits::describe() << std::endl;
+            if (options.threadCount == 0) {
+                pool.resize(ResourceLimits::cpuCount());
+            }
+        }
+        
+        try {
+            if (scanner.scanDirectory(targetDirectory)) {
+                classifier.classifyFiles(scanner.getFiles());
+                duplicates.findDuplicates(scanner.getFiles());
+                service.seedScanCache(targetDirectory, scanner);
+                if (fileIndex && fileIndex->syncDirectory(classifier) < 0) {
+                    logger.error("Daemon index update failed; retrying next pass");
+                }
+                if (options.watch) {
+                    liveStats.reconcile(classifier, scanner, std::time(nullptr));
+                }
+                if (table.publish(classifier, &duplicates)) {
+                    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - passStart).count();
+                    std::cout << "[DAEMON] Published " << table.getEntryCount() << " files, "
+                              << duplicates.getGroups().size() << " duplicate groups ("
+                              << elapsedMs << " ms)" << std::endl;
+                }
+            } else {
+                logger.error("Daemon scan failed; keeping the previous index");
+            }
+        } catch (const std::exception& e) {
+            logger.error("Daemon pass failed: " + std::string(e.what()));
+        }
+        
+        // Sleep in short steps so a signal stops the daemon promptly; while
+        // watching, the steps are waits for change events instead. Lost
+        // events end the wait, since only a pass can recover the totals.
+        auto wakeAt = passStart + std::chrono::seconds(options.daemonInterval);
+        while (!g_stopRequested && std::chrono::steady_clock::now() < wakeAt) {
+            if (!watcher.isActive()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(WATCH_POLL_MILLISECONDS));
+                if (options.watch) {
+                    liveStats.advance(std::time(nullptr));
+                }
+                continue;
+            }
+            std::vector<std::string> names;
+            bool complete = watcher.poll(WATCH_POLL_MILLISECONDS, names);
+            try {
+                std::size_t updated = applyWatchEvents(targetDirectory, names, scanner,
+                                                       eventClassifier, liveStats);
+                if (updated > 0) {
+                    logger.info("Watch: " + std::to_string(names.size()) + " events, " +
+                                std::to_string(updated) + " files updated, " +
+                                std::to_string(liveStats.getFileCount()) + " tracked");
+                }
+            } catch (const std::exception& e) {
+                logger.error("Watch update failed: " + std::string(e.what()));
+                complete = false;
+            }
+            liveStats.advance(std::time(nullptr));
+            if (!complete) {
+                break;
+            }
+        }
+    }
+    
+    service.stop();
+    logger.info("Daemon stopping");
+    std::cout << "[DAEMON] Stopped" << std::endl;
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Apply Watch Events
+// Each named file is looked at once, however many events it had: present
+// files are restatted and classified as one batch, missing ones removed.
+// Returns the number of files looked at.
+//------------------------------------------------------------------------------
+std::size_t applyWatchEvents(const std::string& directory, const std::vector<std::string>& names,
+                             const FileScanner& scanner, FileClassifier& classifier,
+                             LiveStats& liveStats) {
+    std::unordered_set<std::string> unique(names.begin(), names.end());
+    if (unique.empty()) {
+        return 0;
+    }
+    
+    std::vector<FileInfo> present;
+    for (const auto& name : unique) {
+        fs::path path = fs::path(directory) / name;
+        FileInfo info;
+        if (scanner.statFile(path, info)) {
+            present.push_back(std::move(info));
+        } else {
+            liveStats.remove(path.string());
+        }
+    }
+    
+    std::time_t now = std::time(nullptr);
+    classifier.classifyFiles(present);
+    for (const auto& [category, files] : classifier.getCategorizedFiles()) {
+        for (const auto& file : files) {
+            liveStats.upsert(file, category, scanner.isLargeFile(file), now);
+        }
+    }
+    return unique.size();
+}
+
+//------------------------------------------------------------------------------
+// Find a File in Earlier Runs' Logs
+// Binary-searches each run's sidecar index, newest run first, and prints the
+// indexed log records; the log text itself is never scanned
+//------------------------------------------------------------------------------
+int runWhereIs(const CommandLineOptions& options) {
+    auto started = std::chrono::steady_clock::now();
+    std::uint64_t key = LogIndex::keyFor(options.whereisPath);
+    
+    // A run's index is one or more segments, <log>.<n>.idx (or <log>.idx from
+    // older versions). Log names embed the start time, so name order is run order
+    std::map<fs::path, std::vector<fs::path>, std::greater<fs::path>> runs;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(LOG_DIRECTORY, error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind(LOG_FILE_PREFIX, 0) != 0 || entry.path().extension() != LOG_INDEX_EXTENSION) {
+            continue;
+        }
+        fs::path logPath = entry.path();
+        logPath.replace_extension();
+        std::string segment = logPath.extension().string();
+        if (segment.size() > 1 &&
+            std::all_of(segment.begin() + 1, segment.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            logPath.replace_extension();
+        }
+        runs[logPath].push_back(entry.path());
+    }
+    
+    std::cout << "[WHEREIS] " << ContentHasher::normalizePath(options.whereisPath) << '\n';
+    size_t found = 0;
+    size_t searched = 0;
+    for (auto& [logPath, segments] : runs) {
+        if (searched == WHEREIS_MAX_RUNS) {
+            break;
+        }
+        searched++;
+        // Newest segment first; segment numbers are zero-padded
+        std::sort(segments.begin(), segments.end(), std::greater<fs::path>());
+        std::ifstream log(logPath);
+        for (const auto& indexPath : segments) {
+            std::vector<std::uint64_t> offsets;
+            if (!LogIndex::lookup(indexPath.string(), key, offsets) || offsets.empty()) {
+                continue;
+            }
+            for (auto offset = offsets.rbegin(); offset != offsets.rend(); ++offset) {
+                std::string line;
+                log.clear();
+                log.seekg(static_cast<std::streamoff>(*offset));
+                if (std::getline(log, line)) {
+                    std::cout << "  " << logPath.filename().string() << ": " << line << '\n';
+                    found++;
+                }
+            }
+        }
+    }
+    
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started).count();
+    if (found == 0) {
+        std::cout << "  No record in the last " << searched << " indexed runs" << '\n';
+    }
+    std::cout << "  (" << searched << " runs searched in " << elapsedMs << " ms)" << '\n';
+    return found > 0 ? 0 : 1;
+}
+
+//------------------------------------------------------------------------------
+// Query the Daemon's Index
+// Prints "<category> <duplicate status> <size>" tab-separated for scripts;
+// answers from a persisted index carry "-" as the duplicate status
+//------------------------------------------------------------------------------
+int runQuery(const CommandLineOptions& options) {
+    SharedFileTableClient client(options.shmName);
+    SharedFileRecord record;
+    
+    if (!client.lookup(options.queryPath, record)) {
+        // Without a live answer, fall back to a persisted --index
+        std::string indexed = FileIndex::findIndexFor(options.queryPath);
+        if (!indexed.empty()) {
+            Logger quiet("", false);
+            FileIndex index(quiet, indexed);
+            IndexRecord found;
+            if (index.openReadOnly() &&
+                index.lookup(ContentHasher::normalizePath(options.queryPath), found)) {
+                std::cout << found.category << "\t-\t" << found.sizeBytes << '\n';
+                return 0;
+            }
+        }
+        std::cerr << "Error: " << client.getLastError() << std::endl;
+        return 1;
+    }
+    
+    std::cout << record.category << '\t'
+              << duplicateStatusName(record.duplicateStatus) << '\t'
+              << record.sizeBytes << '\n';
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+// Submit a Job to the Service
+// Relative paths are resolved here; the service only accepts absolute ones
+//------------------------------------------------------------------------------
+int runSubmit(const CommandLineOptions& options) {
+    std::string path = "-";
+    if (options.submitType != "stats") {
+        std::string target = options.directory.empty() ? fs::current_path().string()
+                                                       : options.directory;
+        path = ContentHasher::normalizePath(target);
+    }
+    
+    std::string request = options.submitType + " " + std::to_string(options.priority) + " " +
+                          (options.dryRun ? "dry-run" : "-") + " " + path;
+    
+    std::string response;
+    bool delivered = JobService::submitJob(options.socketPath, request, response);
+    
+    std::cout << response;
+    
+    // Success is a final "OK" line
+    std::string lastLine = response.substr(0, response.size() > 0 ? response.size() - 1 : 0);
+    lastLine = lastLine.substr(lastLine.rfind('\n') == std::string::npos ? 0 : lastLine.rfind('\n') + 1);
+    return delivered && lastLine == "OK" ? 0 : 1;
 }
@@ -0,0 +1,165 @@
+//==============================================================================
+// ColdStorageTest.cpp - Cold Tier Archive / Restore Round Trip
+//==============================================================================
+
+#include "TestSupport.h"
+#include "ColdStorage.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include "Config.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#ifdef SMARTCLEANER_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Compressible text: a frame expands to far more than the restore buffer
+std::string makeContents(std::size_t bytes, unsigned seed) {
+    static const char* words[] = { "cleaner ", "archive ", "restore ", "frame ", "cold " };
+    std::mt19937 random(seed);
+    std::string contents;
+    contents.reserve(bytes);
+    while (contents.size() < bytes) {
+        contents += words[random() % 5];
+    }
+    contents.resize(bytes);
+    return contents;
+}
+
+std::string readFile(const fs::path& path) {
+    std::ifstream input(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+}
+
+void roundTrip(const fs::path& directory, const std::string& name, std::size_t bytes) {
+    Logger logger("", false);
+    FileScanner scanner(logger);
+    fs::path original = directory / name;
+    std::string contents = makeContents(bytes, static_cast<unsigned>(bytes));
+    std::ofstream(original, std::ios::binary) << contents;
+
+    FileInfo info;
+    CHECK(scanner.statFile(original, info));
+
+    ColdStorage storage(logger, false, 2);
+    CHECK(storage.archiveFiles(directory.string(), { info }));
+    CHECK(storage.getArchivedFiles().size() == 1);
+    CHECK(!fs::exists(original));
+
+    fs::path archive = directory / COLD_DIRECTORY / (name + COLD_FILE_EXTENSION);
+    CHECK(fs::exists(archive));
+    CHECK(storage.restoreFile(archive.string(), directory.string()));
+    CHECK(!fs::exists(archive));
+    CHECK(readFile(original) == contents);
+}
+
+// Same-named files archived together, next to an archive already there: each
+// gets a name of its own and nothing is replaced or left half-written
+void archiveCollisions(const fs::path& directory) {
+    Logger logger("", false);
+    FileScanner scanner(logger);
+    fs::create_directories(directory / COLD_DIRECTORY);
+    fs::path existing = directory / COLD_DIRECTORY / ("dup.txt" + COLD_FILE_EXTENSION);
+    std::ofstream(existing, std::ios::binary) << "an older archive";
+
+    std::vector<FileInfo> files;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 3; ++i) {
+        fs::path folder = directory / ("folder" + std::to_string(i));
+        fs::create_directories(folder);
+        contents.push_back(makeContents(100000 + i, static_cast<unsigned>(i)));
+        std::ofstream(folder / "dup.txt", std::ios::binary) << contents.back();
+        FileInfo info;
+        CHECK(scanner.statFile(folder / "dup.txt", info));
+        files.push_back(info);
+    }
+
+    ColdStorage storage(logger, false, 3);
+    CHECK(storage.archiveFiles(directory.string(), files));
+    CHECK(storage.getArchivedFiles().size() == 3);
+    CHECK(readFile(existing) == "an older archive");
+
+    std::vector<fs::path> archives;
+    for (const auto& entry : fs::directory_iterator(directory / COLD_DIRECTORY)) {
+        CHECK(entry.path().extension() != ".part");
+        if (entry.path() != existing && entry.path().filename().string().find("dup") == 0) {
+            archives.push_back(entry.path());
+        }
+    }
+    CHECK(archives.size() == 3);
+
+    fs::path restored = directory / "restored";
+    fs::create_directories(restored);
+    std::vector<std::string> found;
+    for (const auto& archive : archives) {
+        CHECK(storage.restoreFile(archive.string(), restored.string()));
+        found.push_back(readFile(restored / archive.stem()));
+    }
+    std::sort(found.begin(), found.end());
+    std::sort(contents.begin(), contents.end());
+    CHECK(found == contents);
+}
+
+#ifdef SMARTCLEANER_WITH_ZSTD
+// An archive written elsewhere: a streaming compressor that flushes every few
+// kilobytes leaves short blocks that straddle the restore buffer's boundaries
+void restoreFlushedArchive(const fs::path& directory) {
+    Logger logger("", false);
+    std::string contents = makeContents(5 * 1000 * 1000 + 321, 7);
+    std::string archive;
+    std::vector<char> buffer(ZSTD_CStreamOutSize());
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    const std::size_t flushBytes = 7777;
+    for (std::size_t offset = 0; offset < contents.size(); offset += flushBytes) {
+        std::size_t length = std::min(flushBytes, contents.size() - offset);
+        bool last = offset + length == contents.size();
+        ZSTD_inBuffer in = { contents.data() + offset, length, 0 };
+        std::size_t remaining;
+        do {
+            ZSTD_outBuffer out = { buffer.data(), buffer.size(), 0 };
+            remaining = ZSTD_compressStream2(context, &out, &in, last ? ZSTD_e_end : ZSTD_e_flush);
+            CHECK(!ZSTD_isError(remaining));
+            archive.append(buffer.data(), out.pos);
+        } while (remaining != 0 && !ZSTD_isError(remaining));
+    }
+    ZSTD_freeCCtx(context);
+
+    fs::create_directories(directory / COLD_DIRECTORY);
+    fs::path archivePath = directory / COLD_DIRECTORY / ("flushed.txt" + COLD_FILE_EXTENSION);
+    std::ofstream(archivePath, std::ios::binary) << archive;
+
+    ColdStorage storage(logger, false, 1);
+    CHECK(storage.restoreFile(archivePath.string(), directory.string()));
+    CHECK(readFile(directory / "flushed.txt") == contents);
+}
+#endif
+
+} // namespace
+
+int main() {
+    if (!ColdStorage::isAvailable()) {
+        std::cout << "Built without zstd; cold tier not tested" << std::endl;
+        return TEST_SKIPPED;
+    }
+
+    ScratchDirectory scratch;
+    roundTrip(scratch.path(), "small.txt", 1 << 20);                    // One frame
+    roundTrip(scratch.path(), "large.txt",                              // Several frames
+              static_cast<std::size_t>(COLD_CHUNK_SIZE_BYTES) * 2 + 12345);
+    archiveCollisions(scratch.path());
+#ifdef SMARTCLEANER_WITH_ZSTD
+    restoreFlushedArchive(scratch.path());
+#endif
+    return testResult();
+}
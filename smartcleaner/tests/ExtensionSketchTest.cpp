@@ -0,0 +1,157 @@
+//==============================================================================
+// ExtensionSketchTest.cpp - Space-Saving Bounds Before and After Merging
+//==============================================================================
+
+#include "TestSupport.h"
+#include "ExtensionSketch.h"
+#include "Logger.h"
+#include "Config.h"
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Truth {
+    std::map<std::string, long long> files;
+    std::map<std::string, long long> bytes;
+    long long totalFiles = 0;
+    long long totalBytes = 0;
+};
+
+// Far more distinct extensions than counters, heavily skewed; each part
+// favours different extensions so the merge has to reconcile them
+std::vector<FileInfo> makeFiles(unsigned seed, std::size_t count, Truth& truth) {
+    std::mt19937 random(seed);
+    std::vector<double> weights;
+    for (int rank = 1; rank <= 4000; ++rank) {
+        weights.push_back(1.0 / rank);
+    }
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::uniform_int_distribution<long long> size(1, 1 << 20);
+
+    std::vector<FileInfo> files;
+    for (std::size_t i = 0; i < count; ++i) {
+        int rank = pick(random);
+        FileInfo file;
+        file.extension = rank == 0 ? "" : ".x" + std::to_string((rank * 7 + seed * 131) % 4000);
+        file.name = "f" + file.extension;
+        file.sizeBytes = size(random);
+        file.allocatedBytes = file.sizeBytes;
+        file.lastModified = 0;
+        files.push_back(file);
+
+        truth.files[file.extension]++;
+        truth.bytes[file.extension] += file.sizeBytes;
+        truth.totalFiles++;
+        truth.totalBytes += file.sizeBytes;
+    }
+    return files;
+}
+
+// Every estimate brackets the true weight with at most total / capacity
+// error, and every extension heavier than that is tracked
+void checkBounds(const std::vector<ExtensionEstimate>& estimates,
+                 const std::map<std::string, long long>& truth, long long total) {
+    const long long maxError = total / static_cast<long long>(UNKNOWN_SKETCH_CAPACITY);
+    CHECK(estimates.size() <= UNKNOWN_SKETCH_CAPACITY);
+
+    std::map<std::string, const ExtensionEstimate*> tracked;
+    for (const auto& estimate : estimates) {
+        tracked[estimate.extension] = &estimate;
+        auto found = truth.find(estimate.extension);
+        long long actual = found == truth.end() ? 0 : found->second;
+        CHECK(estimate.error >= 0);
+        CHECK(estimate.error <= maxError);
+        CHECK(estimate.weight >= actual);
+        CHECK(estimate.weight - estimate.error <= actual);
+    }
+    for (const auto& [extension, weight] : truth) {
+        if (weight > maxError) {
+            CHECK(tracked.count(extension) == 1);
+        }
+    }
+}
+
+void checkSketch(const ExtensionSketch& sketch, const Truth& truth) {
+    CHECK(sketch.getTotalFiles() == truth.totalFiles);
+    CHECK(sketch.getTotalBytes() == truth.totalBytes);
+    checkBounds(sketch.topByFiles(UNKNOWN_SKETCH_CAPACITY), truth.files, truth.totalFiles);
+    checkBounds(sketch.topByBytes(UNKNOWN_SKETCH_CAPACITY), truth.bytes, truth.totalBytes);
+
+    auto top = sketch.topByFiles(10);
+    CHECK(top.size() == 10);
+    for (std::size_t i = 1; i < top.size(); ++i) {
+        CHECK(top[i - 1].weight >= top[i].weight);
+    }
+}
+
+bool sameEstimates(const std::vector<ExtensionEstimate>& a, const std::vector<ExtensionEstimate>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].extension != b[i].extension || a[i].weight != b[i].weight ||
+            a[i].error != b[i].error) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    Logger logger("", false);
+    ScratchDirectory scratch;
+
+    // One sketch over its own files
+    Truth all;
+    ExtensionSketch merged(logger);
+    {
+        Truth single;
+        merged.addFiles(makeFiles(1, 30000, single));
+        makeFiles(1, 30000, all);
+        checkSketch(merged, single);
+    }
+
+    // Merged in memory and from saved files, the bounds still hold on the union
+    ExtensionSketch second(logger);
+    second.addFiles(makeFiles(2, 20000, all));
+    merged.merge(second);
+    checkSketch(merged, all);
+
+    ExtensionSketch third(logger);
+    third.addFiles(makeFiles(3, 25000, all));
+    std::string thirdPath = (scratch.path() / "third.sketch").string();
+    CHECK(third.save(thirdPath));
+    CHECK(merged.mergeFile(thirdPath));
+    checkSketch(merged, all);
+
+    // A saved sketch loads back counter for counter
+    std::string mergedPath = (scratch.path() / "merged.sketch").string();
+    CHECK(merged.save(mergedPath));
+    ExtensionSketch reloaded(logger);
+    CHECK(reloaded.mergeFile(mergedPath));
+    CHECK(reloaded.getTotalFiles() == merged.getTotalFiles());
+    CHECK(sameEstimates(reloaded.topByFiles(UNKNOWN_SKETCH_CAPACITY),
+                        merged.topByFiles(UNKNOWN_SKETCH_CAPACITY)));
+    CHECK(sameEstimates(reloaded.topByBytes(UNKNOWN_SKETCH_CAPACITY),
+                        merged.topByBytes(UNKNOWN_SKETCH_CAPACITY)));
+
+    // Foreign or damaged files are refused and leave the sketch alone
+    std::string badPath = (scratch.path() / "bad.sketch").string();
+    std::ofstream(badPath) << "not a sketch\n";
+    CHECK(!reloaded.mergeFile(badPath));
+    CHECK(!reloaded.mergeFile((scratch.path() / "missing.sketch").string()));
+    CHECK(reloaded.getTotalFiles() == merged.getTotalFiles());
+
+    return testResult();
+}
@@ -0,0 +1,148 @@
+//==============================================================================
+// FileIndexTest.cpp - Segmented Index Put / Lookup / Compaction / Reopen
+//==============================================================================
+
+#include "TestSupport.h"
+#include "FileIndex.h"
+#include "Logger.h"
+#include "Config.h"
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+IndexRecord makeRecord(const fs::path& base, int number, const std::string& category) {
+    IndexRecord record;
+    record.path = (base / category / ("file" + std::to_string(number) + ".txt")).string();
+    record.category = category;
+    record.sizeBytes = 1000 + number;
+    record.lastModified = 1700000000 + number;
+    return record;
+}
+
+// Every expected record is found as written, and paths not expected are not
+void checkContents(const FileIndex& index, const std::map<std::string, IndexRecord>& expected,
+                   const std::vector<std::string>& absent) {
+    for (const auto& [path, want] : expected) {
+        IndexRecord found;
+        CHECK(index.lookup(path, found));
+        CHECK(found.category == want.category);
+        CHECK(found.sizeBytes == want.sizeBytes);
+        CHECK(found.lastModified == want.lastModified);
+    }
+    for (const auto& path : absent) {
+        IndexRecord found;
+        CHECK(!index.lookup(path, found));
+    }
+
+    std::vector<IndexRecord> all = index.loadAll();
+    CHECK(all.size() == expected.size());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        CHECK(expected.count(all[i].path) == 1);
+        CHECK(i == 0 || all[i - 1].path < all[i].path);
+    }
+}
+
+bool waitForSegments(const FileIndex& index, std::size_t atMost) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (index.getSegmentCount() > atMost) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    ScratchDirectory scratch;
+    const fs::path& base = scratch.path();
+    Logger logger("", false);
+
+    std::map<std::string, IndexRecord> expected;
+    std::vector<std::string> absent = { (base / "Documents" / "never.txt").string() };
+
+    {
+        FileIndex index(logger, base.string());
+        CHECK(index.open());
+        CHECK(index.getSegmentCount() == 0);
+        checkContents(index, expected, absent);
+
+        // Put: one segment per apply, the last change per path winning
+        std::vector<IndexRecord> batch;
+        for (int i = 0; i < 500; ++i) {
+            batch.push_back(makeRecord(base, i, "Documents"));
+        }
+        IndexRecord superseded = makeRecord(base, 7, "Archives");
+        superseded.path = makeRecord(base, 7, "Documents").path;
+        batch.insert(batch.begin(), superseded);
+        CHECK(index.apply(batch));
+        for (int i = 0; i < 500; ++i) {
+            IndexRecord record = makeRecord(base, i, "Documents");
+            expected[record.path] = record;
+        }
+        CHECK(index.getSegmentCount() == 1);
+        checkContents(index, expected, absent);
+
+        // A second writer is locked out; a reader is not
+        FileIndex second(logger, base.string());
+        CHECK(!second.open());
+        FileIndex reader(logger, base.string());
+        CHECK(reader.openReadOnly());
+        CHECK(!reader.apply({ makeRecord(base, 9999, "Images") }));
+        checkContents(reader, expected, absent);
+
+        // Updates and tombstones in newer segments hide older records
+        std::vector<IndexRecord> changes;
+        for (int i = 0; i < 50; ++i) {
+            IndexRecord moved = makeRecord(base, i, "Images");
+            moved.path = makeRecord(base, i, "Documents").path;
+            changes.push_back(moved);
+            expected[moved.path] = moved;
+        }
+        for (int i = 50; i < 100; ++i) {
+            IndexRecord gone = makeRecord(base, i, "Documents");
+            gone.deleted = true;
+            changes.push_back(gone);
+            expected.erase(gone.path);
+            absent.push_back(gone.path);
+        }
+        CHECK(index.apply(changes));
+        checkContents(index, expected, absent);
+
+        // Equal-sized batches form a run that the background thread merges
+        for (int round = 0; round < 2 * static_cast<int>(INDEX_COMPACT_FANIN); ++round) {
+            std::vector<IndexRecord> small;
+            for (int i = 0; i < 10; ++i) {
+                IndexRecord record = makeRecord(base, 1000 + round * 10 + i, "Music");
+                small.push_back(record);
+                expected[record.path] = record;
+            }
+            CHECK(index.apply(small));
+        }
+        CHECK(waitForSegments(index, INDEX_COMPACT_FANIN));
+        checkContents(index, expected, absent);
+    }
+
+    // Reopen: everything comes back from the manifest and segment files
+    {
+        FileIndex index(logger, base.string());
+        CHECK(index.open());
+        CHECK(index.getSegmentCount() >= 1);
+        CHECK(index.getSegmentCount() <= INDEX_COMPACT_FANIN);
+        checkContents(index, expected, absent);
+        CHECK(FileIndex::findIndexFor(base / "Documents" / "any.txt") == base.string());
+    }
+
+    return testResult();
+}
@@ -0,0 +1,161 @@
+//==============================================================================
+// KeywordClassifierTest.cpp - Keyword Automaton Against a Naive Search
+//==============================================================================
+
+#include "TestSupport.h"
+#include "KeywordClassifier.h"
+#include "FileClassifier.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include "Config.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string foldAscii(std::string text) {
+    for (auto& c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return text;
+}
+
+// Lowest rule with any keyword anywhere in text, ASCII letters folded
+int referenceMatch(const std::vector<KeywordClassifier::Rule>& rules, const std::string& text) {
+    std::string folded = foldAscii(text);
+    for (std::size_t rule = 0; rule < rules.size(); ++rule) {
+        for (const auto& keyword : rules[rule].second) {
+            if (folded.find(foldAscii(keyword)) != std::string::npos) {
+                return static_cast<int>(rule);
+            }
+        }
+    }
+    return -1;
+}
+
+int match(const KeywordClassifier& classifier, const std::string& text) {
+    return classifier.match(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+}
+
+// Overlapping keywords ("he" inside "she" inside "ushers") and failure links
+// that cross rules; random text over a small alphabet hits them constantly
+void checkAgainstReference() {
+    Logger logger("", false);
+    KeywordClassifier classifier(logger);
+    std::vector<KeywordClassifier::Rule> rules = {
+        { "Ushers",  { "ushers", "HIS" } },
+        { "Hers",    { "hers", "she s" } },
+        { "He",      { "he" } },
+        { "Symbols", { "a\xC3\xA9z", "~~" } },
+    };
+    CHECK(classifier.setRules(rules));
+    CHECK(classifier.getCategories().size() == 4);
+    CHECK(classifier.getCategories()[0] == "Ushers");
+
+    CHECK(match(classifier, "") == -1);
+    CHECK(match(classifier, "nothing to see") == -1);
+    CHECK(match(classifier, "the") == 2);
+    CHECK(match(classifier, "USHERS") == 0);
+    CHECK(match(classifier, "his") == 0);
+    CHECK(match(classifier, "she said") == 1);     // "she s" beats the inner "he"
+    CHECK(match(classifier, "shed") == 2);
+    CHECK(match(classifier, "she saw hers") == 1);
+    CHECK(match(classifier, "xa\xC3\xA9zx") == 3);
+    CHECK(match(classifier, "xA\xC3\xA9Zx") == 3);
+    CHECK(match(classifier, "xa\xC3\x89zx") == -1);   // Only ASCII letters fold
+
+    std::mt19937 random(99);
+    const std::string alphabet = "usherHISx ~a\xC3\xA9z";
+    std::uniform_int_distribution<std::size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<std::size_t> length(0, 40);
+    for (int round = 0; round < 20000; ++round) {
+        std::string text;
+        for (std::size_t i = length(random); i > 0; --i) {
+            text += alphabet[pick(random)];
+        }
+        int expected = referenceMatch(rules, text);
+        int actual = match(classifier, text);
+        CHECK(actual == expected);
+        if (actual != expected) {
+            std::cout << "  text \"" << text << "\"" << std::endl;
+            break;
+        }
+    }
+}
+
+void checkRuleFiles(const fs::path& directory) {
+    Logger logger("", false);
+    KeywordClassifier classifier(logger);
+
+    fs::path rulesPath = directory / "rules.txt";
+    std::ofstream(rulesPath) << "# Sorting rules\n"
+                             << "\n"
+                             << "Receipts: total paid , receipt no\n"
+                             << "Minutes: minutes of the meeting\n";
+    CHECK(classifier.loadRules(rulesPath.string()));
+    CHECK(classifier.getCategories().size() == 2);
+    CHECK(match(classifier, "Receipt No. 42") == 0);
+    CHECK(match(classifier, "TOTAL PAID: 10") == 0);
+    CHECK(match(classifier, "Minutes of the Meeting") == 1);
+
+    // A bad rule file or category leaves the working rules in place
+    std::ofstream(directory / "bad.txt") << "no colon here\n";
+    CHECK(!classifier.loadRules((directory / "bad.txt").string()));
+    CHECK(!classifier.setRules({ { "..", { "escape" } } }));
+    CHECK(!classifier.setRules({ { CATEGORY_DOCUMENTS, { "loop" } } }));
+    CHECK(FileClassifier::isValidCategoryName(CATEGORY_DOCUMENTS, true));
+    CHECK(!FileClassifier::isValidCategoryName(COLD_DIRECTORY, true));
+    CHECK(classifier.getCategories().size() == 2);
+    CHECK(match(classifier, "receipt no") == 0);
+}
+
+void checkClassifyFiles(const fs::path& directory) {
+    Logger logger("", false);
+    KeywordClassifier classifier(logger);
+    CHECK(classifier.setRules({ { "Invoices", { "amount due" } }, { "Letters", { "dear sir" } } }));
+
+    FileScanner scanner(logger);
+    auto makeFile = [&](const std::string& name, const std::string& contents) {
+        fs::path path = directory / name;
+        std::ofstream(path, std::ios::binary) << contents;
+        FileInfo info;
+        CHECK(scanner.statFile(path, info));
+        return info;
+    };
+
+    std::string padding(KEYWORD_PREFIX_BYTES, '.');
+    std::vector<FileInfo> files = {
+        makeFile("a.txt", "Amount Due: 12"),
+        makeFile("b.csv", "x,dear sir,y"),
+        makeFile("c.bin", "amount due"),                  // Not text-like
+        makeFile("d.txt", padding + "amount due"),        // Past the prefix read
+        makeFile("e.txt", "plain"),
+    };
+
+    ThreadPool pool(2);
+    std::vector<int> expected = { 0, 1, -1, -1, -1 };
+    CHECK(classifier.classify(files, &pool) == expected);
+    CHECK(classifier.classify(files, nullptr) == expected);
+}
+
+} // namespace
+
+int main() {
+    ScratchDirectory scratch;
+    checkAgainstReference();
+    checkRuleFiles(scratch.path());
+    checkClassifyFiles(scratch.path());
+    return testResult();
+}
@@ -0,0 +1,244 @@
+//==============================================================================
+// LiveStatsTest.cpp - Timer-Wheel Ageing Against Totals Recomputed From Scratch
+//==============================================================================
+
+#include "TestSupport.h"
+#include "LiveStats.h"
+#include "Config.h"
+#include <ctime>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::time_t DAY = 24 * 60 * 60;
+const int OLD_DAYS = 45;                            // Not an age bucket boundary
+const fs::path BASE = "/home/someone/Desktop";
+
+struct Model {
+    std::string category;
+    long long sizeBytes;
+    std::time_t lastModified;
+    bool large;
+};
+
+// The stats reply, or the same numbers worked out from the model
+struct Snapshot {
+    std::string totals;
+    std::map<std::string, std::string> categories;
+    std::map<std::string, std::string> subtrees;
+    std::vector<std::string> sizes;
+    std::vector<std::string> ages;
+
+    bool operator==(const Snapshot& other) const {
+        return totals == other.totals && categories == other.categories &&
+               subtrees == other.subtrees && sizes == other.sizes && ages == other.ages;
+    }
+};
+
+Snapshot parse(const std::string& reply) {
+    Snapshot snapshot;
+    std::istringstream lines(reply);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        long long files = 0, bytes = 0, large = 0, old = 0;
+        std::string name;
+        fields >> key;
+        if (key == "live-category") {
+            fields >> files >> bytes >> large >> old >> name;
+            snapshot.categories[name] = std::to_string(files) + " " + std::to_string(bytes) + " " +
+                                        std::to_string(large) + " " + std::to_string(old);
+        } else if (key == "live-subtree") {
+            fields >> files >> bytes >> name;
+            snapshot.subtrees[name] = std::to_string(files) + " " + std::to_string(bytes);
+        } else if (key == "live-size") {
+            fields >> files >> bytes;
+            snapshot.sizes.push_back(std::to_string(files) + " " + std::to_string(bytes));
+        } else if (key == "live-age") {
+            fields >> files >> bytes;
+            snapshot.ages.push_back(std::to_string(files) + " " + std::to_string(bytes));
+        } else {
+            fields >> files;
+            snapshot.totals += std::to_string(files) + " ";
+        }
+    }
+    return snapshot;
+}
+
+Snapshot recompute(const std::map<std::string, Model>& files, std::time_t now) {
+    struct Sum { long long files = 0, bytes = 0, large = 0, old = 0; };
+    auto add = [](Sum& sum, const Model& file, bool old) {
+        sum.files++;
+        sum.bytes += file.sizeBytes;
+        sum.large += file.large ? 1 : 0;
+        sum.old += old ? 1 : 0;
+    };
+
+    Sum total;
+    std::map<std::string, Sum> categories, subtrees;
+    std::vector<Sum> sizes(STATS_SIZE_BUCKET_BYTES.size() + 1);
+    std::vector<Sum> ages(STATS_AGE_BUCKET_DAYS.size() + 1);
+    for (const auto& [path, file] : files) {
+        std::time_t age = now - file.lastModified;
+        bool old = age >= OLD_DAYS * DAY;
+        add(total, file, old);
+        add(categories[file.category], file, old);
+
+        std::size_t size = 0;
+        while (size < STATS_SIZE_BUCKET_BYTES.size() && file.sizeBytes >= STATS_SIZE_BUCKET_BYTES[size]) {
+            size++;
+        }
+        add(sizes[size], file, old);
+        std::size_t bucket = 0;
+        while (bucket < STATS_AGE_BUCKET_DAYS.size() && age >= STATS_AGE_BUCKET_DAYS[bucket] * DAY) {
+            bucket++;
+        }
+        add(ages[bucket], file, old);
+
+        add(subtrees["."], file, old);
+        fs::path relative;
+        for (const auto& part : fs::path(path).parent_path().lexically_relative(BASE)) {
+            if (part == ".") {
+                continue;
+            }
+            relative /= part;
+            add(subtrees[relative.generic_string()], file, old);
+        }
+    }
+
+    auto pair = [](const Sum& sum) { return std::to_string(sum.files) + " " + std::to_string(sum.bytes); };
+    Snapshot snapshot;
+    snapshot.totals = std::to_string(total.files) + " " + std::to_string(total.bytes) + " " +
+                      std::to_string(total.large) + " " + std::to_string(total.old) + " ";
+    for (const auto& [name, sum] : categories) {
+        snapshot.categories[name] = pair(sum) + " " + std::to_string(sum.large) + " " +
+                                    std::to_string(sum.old);
+    }
+    for (const auto& [name, sum] : subtrees) {
+        snapshot.subtrees[name] = pair(sum);
+    }
+    for (const auto& sum : sizes) {
+        snapshot.sizes.push_back(pair(sum));
+    }
+    for (const auto& sum : ages) {
+        snapshot.ages.push_back(pair(sum));
+    }
+    return snapshot;
+}
+
+FileInfo toFileInfo(const std::string& path, const Model& model) {
+    FileInfo info;
+    info.path = path;
+    info.name = fs::path(path).filename().string();
+    info.extension = fs::path(path).extension().string();
+    info.sizeBytes = model.sizeBytes;
+    info.allocatedBytes = model.sizeBytes;
+    info.lastModified = model.lastModified;
+    return info;
+}
+
+} // namespace
+
+int main() {
+    LiveStats stats(BASE.string() + "/", OLD_DAYS);
+
+    // Whole ticks from a tick boundary: a boundary crossed during a tick
+    // shows once that tick has been advanced past
+    std::time_t now = std::time(nullptr) / STATS_WHEEL_TICK_SECONDS * STATS_WHEEL_TICK_SECONDS;
+
+    std::mt19937_64 random(7);
+    const std::vector<std::string> directories = { "", "Documents", "Documents/Tax", "Images" };
+    const std::vector<std::string> categories = { "Documents", "Images", "Other" };
+    std::uniform_int_distribution<long long> size(0, 600LL * 1024 * 1024);
+    std::uniform_int_distribution<std::time_t> age(0, 400 * DAY);
+
+    std::map<std::string, Model> files;
+    int nextName = 0;
+    auto upsert = [&](const std::string& path, const Model& model) {
+        files[path] = model;
+        stats.upsert(toFileInfo(path, model), model.category, model.large, now);
+    };
+    auto addFile = [&](std::time_t lastModified) {
+        std::string directory = directories[random() % directories.size()];
+        fs::path path = BASE / directory / ("file" + std::to_string(nextName++) + ".dat");
+        long long bytes = size(random);
+        upsert(path.string(), Model{ categories[random() % categories.size()], bytes, lastModified,
+                                     bytes >= 100LL * 1024 * 1024 });
+    };
+
+    // Random ages, plus files one tick short of every boundary
+    for (int i = 0; i < 300; ++i) {
+        addFile(now - age(random));
+    }
+    for (int days : { 1, 7, OLD_DAYS, 30, 90, 365 }) {
+        addFile(now - days * DAY + STATS_WHEEL_TICK_SECONDS);
+        addFile(now - days * DAY + 1);
+    }
+    CHECK(stats.getFileCount() == files.size());
+    CHECK(parse(stats.format()) == recompute(files, now));
+
+    std::uniform_int_distribution<long long> shortStep(1, 90);
+    std::uniform_int_distribution<long long> longStep(100, 5 * 1440);
+    for (int step = 0; step < 400; ++step) {
+        // Mostly a few ticks; now and then days, and once more than two revolutions
+        long long ticks = step == 200 ? 3 * static_cast<long long>(STATS_WHEEL_SLOTS) + 17
+                                      : step % 25 == 0 ? longStep(random) : shortStep(random);
+        now += static_cast<std::time_t>(ticks) * STATS_WHEEL_TICK_SECONDS;
+        stats.advance(now);
+
+        // Edits between ticks: new files, touched files (their old timers go
+        // stale), removals
+        switch (random() % 4) {
+        case 0:
+            addFile(now - age(random));
+            break;
+        case 1: {
+            auto it = std::next(files.begin(), static_cast<long>(random() % files.size()));
+            Model touched = it->second;
+            touched.lastModified = now - static_cast<std::time_t>(random() % 3600);
+            touched.sizeBytes += 1;
+            upsert(it->first, touched);
+            break;
+        }
+        case 2: {
+            auto it = std::next(files.begin(), static_cast<long>(random() % files.size()));
+            stats.remove(it->first);
+            files.erase(it);
+            break;
+        }
+        default:
+            break;
+        }
+
+        Snapshot actual = parse(stats.format());
+        Snapshot expected = recompute(files, now);
+        CHECK(actual == expected);
+        if (!(actual == expected)) {
+            std::cout << "  after step " << step << std::endl;
+            break;
+        }
+    }
+    CHECK(stats.getFileCount() == files.size());
+
+    // Removing everything leaves nothing behind, and stale timers fire harmlessly
+    while (!files.empty()) {
+        stats.remove(files.begin()->first);
+        files.erase(files.begin());
+    }
+    now += 400 * DAY;
+    stats.advance(now);
+    CHECK(stats.getFileCount() == 0);
+    CHECK(parse(stats.format()) == recompute(files, now));
+
+    return testResult();
+}
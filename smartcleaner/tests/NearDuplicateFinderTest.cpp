@@ -0,0 +1,105 @@
+//==============================================================================
+// NearDuplicateFinderTest.cpp - Name Keys and Cluster Refinement
+//==============================================================================
+
+#include "TestSupport.h"
+#include "NearDuplicateFinder.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string key(const std::string& name) {
+    return NearDuplicateFinder::normalizedKey(name);
+}
+
+// Copy markers, version suffixes and separators fall away
+void checkCopiesShareKey() {
+    CHECK(key("report.pdf") == "report.pdf");
+    CHECK(key("report (1).pdf") == "report.pdf");
+    CHECK(key("report [2].pdf") == "report.pdf");
+    CHECK(key("report_final_v2.pdf") == "report.pdf");
+    CHECK(key("report-v1.3.pdf") == "report.pdf");
+    CHECK(key("Copy of report.pdf") == "report.pdf");
+    CHECK(key("Copy 2 of report.pdf") == "report.pdf");
+    CHECK(key("report copy 2.pdf") == "report.pdf");
+    CHECK(key("report version 3.pdf") == "report.pdf");
+    CHECK(key("REPORT.PDF") == "report.pdf");
+}
+
+// Bare sequence numbers are part of the name
+void checkSeriesKeepTheirNumbers() {
+    CHECK(key("Track 01.mp3") != key("Track 12.mp3"));
+    CHECK(key("Chapter 1.pdf") != key("Chapter 2.pdf"));
+    CHECK(key("IMG_0001.jpg") != key("IMG_0002.jpg"));
+    CHECK(key("Track 01 (1).mp3") == key("Track 01.mp3"));
+}
+
+// The extension is kept, and a name is never reduced to nothing
+void checkEdges() {
+    CHECK(key("report.pdf") != key("report.docx"));
+    CHECK(key("final.txt") == "final.txt");
+    CHECK(key("v2.txt") == "v2.txt");
+    CHECK(key("Makefile") == "makefile");
+}
+
+FileInfo writeFile(const fs::path& path, const std::string& contents, long long age) {
+    std::ofstream(path, std::ios::binary) << contents;
+    fs::last_write_time(path, fs::file_time_type::clock::now() - std::chrono::hours(age));
+    Logger logger("", false);
+    FileScanner scanner(logger);
+    FileInfo info;
+    CHECK(scanner.statFile(path, info));
+    return info;
+}
+
+// Content refinement keeps only members that really are the same document
+void checkContentRefinement() {
+    ScratchDirectory scratch;
+    std::vector<FileInfo> files = {
+        writeFile(scratch.path() / "notes.txt", "meeting notes", 1),
+        writeFile(scratch.path() / "notes (1).txt", "meeting notes", 2),
+        writeFile(scratch.path() / "notes_old.txt", "something else entirely", 3),
+        writeFile(scratch.path() / "Track 01.mp3", "same bytes", 1),
+        writeFile(scratch.path() / "Track 02.mp3", "same bytes", 2),
+    };
+
+    Logger logger("", false);
+    ThreadPool pool(2);
+    NearDuplicateFinder finder(logger, pool);
+
+    finder.findClusters(files);
+    CHECK(finder.getClusters().size() == 1);
+    CHECK(finder.getClusters()[0].files.size() == 3);
+
+    finder.setRefinement(NearDuplicateRefine::CONTENT);
+    finder.findClusters(files);
+    CHECK(finder.getClusters().size() == 1);
+    if (finder.getClusters().size() == 1) {
+        const auto& cluster = finder.getClusters()[0];
+        CHECK(cluster.files.size() == 2);
+        CHECK(cluster.files[0].name == "notes.txt");     // Newest is kept
+        CHECK(finder.getSuperseded().size() == 1);
+        CHECK(finder.getSuperseded()[0].name == "notes (1).txt");
+    }
+}
+
+} // namespace
+
+int main() {
+    checkCopiesShareKey();
+    checkSeriesKeepTheirNumbers();
+    checkEdges();
+    checkContentRefinement();
+    return testResult();
+}
@@ -0,0 +1,103 @@
+//==============================================================================
+// SharedFileTableTest.cpp - Segment Ownership, Names and Lookups
+//==============================================================================
+
+#include "TestSupport.h"
+#include "SharedFileTable.h"
+#include "FileClassifier.h"
+#include "FileScanner.h"
+#include "Logger.h"
+#include "Config.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool segmentExists(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    ::close(fd);
+    return true;
+}
+
+// One name per directory, however the directory is spelled
+void checkNames(const fs::path& base) {
+    std::string name = SharedFileTable::defaultName(base / "Desktop");
+    CHECK(name.compare(0, SHM_NAME_PREFIX.size(), SHM_NAME_PREFIX) == 0);
+    CHECK(name == SharedFileTable::defaultName(base / "Desktop" / ""));
+    CHECK(name == SharedFileTable::defaultName(base / "Desktop" / "x" / ".."));
+    CHECK(name != SharedFileTable::defaultName(base / "Downloads"));
+}
+
+// One daemon per segment: a second is refused and leaves the first alone
+void checkOwnership(const fs::path& base) {
+    Logger logger("", false);
+    fs::path watched = base / "Desktop";
+    fs::create_directories(watched / "Sub");
+    std::ofstream(watched / "Sub" / "notes.txt") << "notes";
+    std::string name = SharedFileTable::defaultName(watched);
+
+    FileScanner scanner(logger);
+    FileInfo info;
+    CHECK(scanner.statFile(watched / "Sub" / "notes.txt", info));
+    FileClassifier classifier(logger);
+    classifier.classifyFiles({ info });
+
+    auto first = std::make_unique<SharedFileTable>(logger, name);
+    CHECK(first->create());
+    CHECK(first->publish(classifier, nullptr));
+
+    SharedFileTable second(logger, name);
+    CHECK(!second.create());
+
+    // The refused daemon neither reset nor unlinked the live segment
+    SharedFileTableClient named(name);
+    SharedFileRecord record;
+    CHECK(named.lookup(watched / "Sub" / "notes.txt", record));
+    CHECK(record.category == "Documents");
+    CHECK(record.sizeBytes == 5);
+
+    // Without a name the client finds the daemon from the path
+    SharedFileTableClient byPath("");
+    CHECK(byPath.lookup(watched / "Sub" / "notes.txt", record));
+    CHECK(!byPath.lookup(watched / "Sub" / "missing.txt", record));
+    CHECK(byPath.getLastError().find("not indexed") == 0);
+    CHECK(!byPath.lookup(base / "elsewhere.txt", record));
+    CHECK(byPath.getLastError().find("no daemon") == 0);
+
+    // Once the first daemon exits the name is free again
+    first.reset();
+    CHECK(!segmentExists(name));
+    CHECK(!byPath.lookup(watched / "Sub" / "notes.txt", record));
+    SharedFileTable third(logger, name);
+    CHECK(third.create());
+    CHECK(segmentExists(name));
+}
+
+} // namespace
+
+int main() {
+#ifdef _WIN32
+    return TEST_SKIPPED;
+#else
+    ScratchDirectory scratch;
+    checkNames(scratch.path());
+    checkOwnership(scratch.path());
+    return testResult();
+#endif
+}
@@ -0,0 +1,231 @@
+//==============================================================================
+// SimdKernelsTest.cpp - Every Supported ISA Against a Scalar Reference
+//==============================================================================
+//
+// The references below are written from the kernel contracts in
+// SimdKernels.h, not copied from SimdKernels.cpp, so a bug shared by the
+// scalar and vector paths shows up too.
+//
+//==============================================================================
+
+#include "TestSupport.h"
+#include "SimdKernels.h"
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DesktopCleaner;
+using namespace DesktopCleaner::Testing;
+
+namespace {
+
+//------------------------------------------------------------------------------
+// References
+//------------------------------------------------------------------------------
+void referenceLower(std::string& text) {
+    for (auto& c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+}
+
+std::uint32_t referenceCrc32c(std::uint32_t crc, const unsigned char* data, std::size_t length) {
+    crc = ~crc;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1u) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+std::vector<std::uint32_t> referenceSelect(const std::int64_t* values, std::size_t count,
+                                           std::int64_t low, std::int64_t high) {
+    std::vector<std::uint32_t> indices;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (values[i] >= low && values[i] <= high) {
+            indices.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return indices;
+}
+
+std::vector<std::uint32_t> referenceGear(const unsigned char* data, std::size_t length,
+                                         const std::uint64_t* gear, std::uint64_t mask) {
+    std::vector<std::uint32_t> positions;
+    for (std::size_t i = 63; i < length; ++i) {
+        std::uint64_t hash = 0;
+        for (std::size_t j = i - 63; j <= i; ++j) {
+            hash = (hash << 1) + gear[data[j]];
+        }
+        if ((hash & mask) == 0) {
+            positions.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return positions;
+}
+
+std::size_t referenceFind(const unsigned char* data, std::size_t length, const ByteSet& set) {
+    for (std::size_t i = 0; i < length; ++i) {
+        if ((set.low[data[i] & 0x0F] & set.high[data[i] >> 4]) != 0) {
+            return i;
+        }
+    }
+    return length;
+}
+
+//------------------------------------------------------------------------------
+// Checks for the active ISA
+//------------------------------------------------------------------------------
+void checkLower(const std::string& text) {
+    for (std::size_t length = 0; length <= 300; ++length) {
+        for (std::size_t offset = 0; offset < 4; ++offset) {
+            std::string expected = text.substr(offset, length);
+            std::string actual = expected;
+            referenceLower(expected);
+            SimdKernels::asciiToLower(&actual[0], actual.size());
+            CHECK(actual == expected);
+        }
+    }
+}
+
+void checkCrc32c(const std::string& text) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    CHECK(SimdKernels::crc32c(0, "123456789", 9) == 0xE3069283u);   // Standard check value
+    for (std::size_t length = 0; length <= 300; ++length) {
+        for (std::size_t offset = 0; offset < 8; ++offset) {
+            CHECK(SimdKernels::crc32c(7, bytes + offset, length) ==
+                  referenceCrc32c(7, bytes + offset, length));
+        }
+    }
+    // Chaining over a split gives the CRC of the whole
+    std::uint32_t first = SimdKernels::crc32c(0, bytes, 1000);
+    CHECK(SimdKernels::crc32c(first, bytes + 1000, 3333) == referenceCrc32c(0, bytes, 4333));
+}
+
+void checkSelect(std::mt19937_64& random) {
+    std::uniform_int_distribution<std::int64_t> small(-50, 50);
+    std::vector<std::int64_t> values(1000);
+    for (auto& value : values) {
+        value = small(random);
+    }
+    values[10] = std::numeric_limits<std::int64_t>::min();
+    values[11] = std::numeric_limits<std::int64_t>::max();
+
+    std::vector<std::pair<std::int64_t, std::int64_t>> ranges = {
+        { -10, 10 }, { 0, 0 }, { 5, -5 }, { 50, 50 },
+        { std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max() },
+        { std::numeric_limits<std::int64_t>::max(), std::numeric_limits<std::int64_t>::max() },
+    };
+    for (int i = 0; i < 20; ++i) {
+        ranges.emplace_back(small(random), small(random));
+    }
+
+    std::vector<std::uint32_t> indices(values.size());
+    for (const auto& [low, high] : ranges) {
+        for (std::size_t count : { std::size_t(0), std::size_t(1), std::size_t(7),
+                                   std::size_t(33), std::size_t(999) }) {
+            for (std::size_t offset = 0; offset < 3; ++offset) {
+                auto expected = referenceSelect(values.data() + offset, count, low, high);
+                indices.assign(values.size(), 0);
+                indices.resize(SimdKernels::selectInRange(values.data() + offset, count,
+                                                          low, high, indices.data()));
+                CHECK(indices == expected);
+            }
+        }
+    }
+}
+
+void checkGear(const std::string& text, std::mt19937_64& random) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    std::uint64_t gear[256];
+    for (auto& value : gear) {
+        value = random();
+    }
+    const std::uint64_t mask = 0xF000000000000000ULL;   // ~1 hit in 16
+    for (std::size_t length : { std::size_t(0), std::size_t(63), std::size_t(64),
+                                std::size_t(65), std::size_t(700), std::size_t(4097) }) {
+        std::vector<std::uint32_t> positions = { 12345 };   // Appended to, not replaced
+        SimdKernels::gearScan(bytes + 3, length, gear, mask, positions);
+        auto expected = referenceGear(bytes + 3, length, gear, mask);
+        expected.insert(expected.begin(), 12345);
+        CHECK(positions == expected);
+    }
+}
+
+void checkFindInSet(const std::string& text, std::mt19937_64& random) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (int round = 0; round < 64; ++round) {
+        std::vector<unsigned char> members(1 + round % 24);
+        for (auto& member : members) {
+            member = static_cast<unsigned char>(byte(random));
+        }
+        ByteSet set = SimdKernels::makeByteSet(members);
+        for (std::size_t length = 0; length <= 200; ++length) {
+            std::size_t offset = static_cast<std::size_t>(round) % 7;
+            CHECK(SimdKernels::findInSet(bytes + offset, length, set) ==
+                  referenceFind(bytes + offset, length, set));
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// ISA-Independent Checks
+//------------------------------------------------------------------------------
+
+// Sets within 8 high nibbles are exact; members are always found
+void checkByteSets() {
+    std::vector<unsigned char> letters;
+    for (unsigned char c = 'A'; c <= 'Z'; ++c) {
+        letters.push_back(c);
+        letters.push_back(static_cast<unsigned char>(c + 32));
+    }
+    ByteSet set = SimdKernels::makeByteSet(letters);
+    for (int b = 0; b < 256; ++b) {
+        bool isLetter = (b >= 'A' && b <= 'Z') || (b >= 'a' && b <= 'z');
+        bool inSet = (set.low[b & 0x0F] & set.high[b >> 4]) != 0;
+        CHECK(inSet == isLetter);
+    }
+
+    std::vector<unsigned char> wide;
+    for (int b = 0; b < 256; b += 13) {
+        wide.push_back(static_cast<unsigned char>(b));
+    }
+    ByteSet wideSet = SimdKernels::makeByteSet(wide);
+    for (unsigned char member : wide) {
+        CHECK((wideSet.low[member & 0x0F] & wideSet.high[member >> 4]) != 0);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::mt19937_64 random(2024);
+    std::string text(8192, '\0');
+    for (auto& c : text) {
+        c = static_cast<char>(random() & 0xFF);
+    }
+    text.replace(100, 26, "ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+    text.replace(200, 4, "@[`{");   // Neighbours of the letter ranges
+
+    checkByteSets();
+
+    IsaLevel detected = SimdKernels::activeIsa();
+    for (IsaLevel level : SimdKernels::supportedIsas()) {
+        std::cout << "Checking " << SimdKernels::isaName(level) << std::endl;
+        CHECK(SimdKernels::setIsa(level));
+        CHECK(SimdKernels::activeIsa() == level);
+        checkLower(text);
+        checkCrc32c(text);
+        checkSelect(random);
+        checkGear(text, random);
+        checkFindInSet(text, random);
+    }
+    SimdKernels::setIsa(detected);
+    return testResult();
+}
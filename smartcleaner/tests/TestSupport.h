@@ -0,0 +1,82 @@
+//==============================================================================
+// TestSupport.h - Checks and Scratch Directories for the Unit Tests
+//==============================================================================
+//
+// Each test is one executable registered with ctest. It exits 0 when every
+// CHECK held, 1 otherwise, and TEST_SKIPPED (77) when the build lacks what it
+// tests.
+//
+//==============================================================================
+
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+namespace DesktopCleaner {
+namespace Testing {
+
+const int TEST_SKIPPED = 77;
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline int testResult() {
+    if (failureCount() == 0) {
+        std::cout << "All checks passed" << std::endl;
+        return 0;
+    }
+    std::cout << failureCount() << " checks failed" << std::endl;
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+// ScratchDirectory: a fresh directory under the system temp directory,
+// removed with everything in it when the test is done
+//------------------------------------------------------------------------------
+class ScratchDirectory {
+public:
+    ScratchDirectory() {
+        std::string pattern =
+            (std::filesystem::temp_directory_path() / "smartcleaner_test_XXXXXX").string();
+        if (mkdtemp(&pattern[0]) == nullptr) {
+            std::cerr << "Cannot create a scratch directory" << std::endl;
+            std::exit(1);
+        }
+        path_ = pattern;
+    }
+
+    ~ScratchDirectory() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+} // namespace Testing
+} // namespace DesktopCleaner
+
+// Records a failure and carries on, so one run reports every broken check
+#define CHECK(condition)                                                          \
+    do {                                                                          \
+        if (!(condition)) {                                                       \
+            std::cout << __FILE__ << ":" << __LINE__ << ": CHECK failed: "        \
+                      << #condition << std::endl;                                 \
+            DesktopCleaner::Testing::failureCount()++;                            \
+        }                                                                         \
+    } while (false)
+
+#endif // TEST_SUPPORT_H